@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/accelerators/anderson.hpp>
+#include <alpaqa/accelerators/internal/limited-memory-qr.hpp>
+#include <bench-util/random.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// Adds a new column to a full QR factorization after removing the oldest
+/// one, which is how the factorization is used by Anderson acceleration.
+/// Arguments: number of rows n and number of columns m.
+void BM_LimitedMemoryQRSlide(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    mat V = random_mat(rng, n, 2 * m);
+    alpaqa::LimitedMemoryQR<config_t> qr{n, m};
+    for (index_t i = 0; i < m; ++i)
+        qr.add_column(V.col(i));
+    index_t i = m;
+    for (auto _ : state) {
+        qr.remove_column();
+        qr.add_column(V.col(i));
+        i = (i + 1) % V.cols();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * m);
+}
+
+/// Arguments: number of rows n and number of columns m.
+void BM_LimitedMemoryQRAddColumn(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    mat V = random_mat(rng, n, m);
+    alpaqa::LimitedMemoryQR<config_t> qr{n, m};
+    for (auto _ : state) {
+        qr.reset();
+        for (index_t i = 0; i < m; ++i)
+            qr.add_column(V.col(i));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * m);
+}
+
+/// One step of Anderson acceleration with a full history. The function
+/// values and residuals are random, the cost does not depend on them.
+/// Arguments: problem size n and memory m.
+void BM_AndersonAccelCompute(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    const length_t K = 2 * m + 1;
+    mat G = random_mat(rng, n, K), R = random_mat(rng, n, K);
+    alpaqa::AndersonAccel<config_t> aa{{.memory = m}, n};
+    vec x(n);
+    aa.initialize(G.col(0), R.col(0));
+    index_t k = 1;
+    for (auto _ : state) {
+        aa.compute(G.col(k), crvec{R.col(k)}, x);
+        k = (k + 1) % K;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * m);
+}
+
+} // namespace
+
+BENCHMARK(BM_LimitedMemoryQRSlide)
+    ->ArgNames({"n", "m"})
+    ->ArgsProduct({{100, 1'000, 10'000, 100'000}, {5, 20}});
+BENCHMARK(BM_LimitedMemoryQRAddColumn)
+    ->ArgNames({"n", "m"})
+    ->ArgsProduct({{100, 10'000}, {5, 20}});
+BENCHMARK(BM_AndersonAccelCompute)
+    ->ArgNames({"n", "m"})
+    ->ArgsProduct({{100, 1'000, 10'000, 100'000}, {5, 20}});
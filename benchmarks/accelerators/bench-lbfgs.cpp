@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/accelerators/lbfgs.hpp>
+#include <bench-util/random.hpp>
+
+#include <vector>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// L-BFGS with a full history of (s, y) pairs of a strongly convex quadratic
+/// with a diagonal Hessian.
+alpaqa::LBFGS<config_t> make_lbfgs(rng_t &rng, length_t n, length_t memory) {
+    alpaqa::LBFGS<config_t> lbfgs{{.memory = memory}, n};
+    vec h = 1 + random_vec(rng, n).cwiseAbs().array();
+    for (index_t i = 0; i < memory; ++i) {
+        vec s = random_vec(rng, n);
+        vec y = h.cwiseProduct(s);
+        lbfgs.update_sy(s, y, s.squaredNorm());
+    }
+    return lbfgs;
+}
+
+/// Arguments: problem size n and memory m.
+void BM_LBFGSApply(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    auto lbfgs = make_lbfgs(rng, n, m);
+    vec q0 = random_vec(rng, n), q(n);
+    for (auto _ : state) {
+        q = q0;
+        benchmark::DoNotOptimize(lbfgs.apply(q, 1));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/// Arguments: problem size n, memory m and the percentage of indices in the
+/// mask J.
+void BM_LBFGSApplyMasked(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    const auto f = static_cast<real_t>(state.range(2)) / 100;
+    rng_t rng{12345};
+    auto lbfgs = make_lbfgs(rng, n, m);
+    indexvec J = random_indices(rng, n, f);
+    vec q0 = random_vec(rng, n), q(n);
+    for (auto _ : state) {
+        q = q0;
+        benchmark::DoNotOptimize(lbfgs.apply_masked(q, 1, J));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * J.size());
+}
+
+/// Same as @ref BM_LBFGSApplyMasked, but with the mask stored in a
+/// std::vector, as used by the structured PANOC direction.
+void BM_LBFGSApplyMaskedStdVec(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    const auto f = static_cast<real_t>(state.range(2)) / 100;
+    rng_t rng{12345};
+    auto lbfgs  = make_lbfgs(rng, n, m);
+    indexvec Jv = random_indices(rng, n, f);
+    std::vector<index_t> J{Jv.begin(), Jv.end()};
+    vec q0 = random_vec(rng, n), q(n);
+    for (auto _ : state) {
+        q = q0;
+        benchmark::DoNotOptimize(lbfgs.apply_masked(q, 1, J));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(J.size()));
+}
+
+/// Arguments: problem size n and memory m.
+void BM_LBFGSUpdate(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto m = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    auto lbfgs = make_lbfgs(rng, n, m);
+    vec s = random_vec(rng, n), y = 2 * s;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lbfgs.update_sy(s, y, s.squaredNorm()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+BENCHMARK(BM_LBFGSApply)
+    ->ArgNames({"n", "m"})
+    ->ArgsProduct({{100, 1'000, 10'000, 100'000}, {5, 20}});
+BENCHMARK(BM_LBFGSApplyMasked)
+    ->ArgNames({"n", "m", "J%"})
+    ->ArgsProduct({{100, 1'000, 10'000, 100'000}, {5, 20}, {10, 90}});
+BENCHMARK(BM_LBFGSApplyMaskedStdVec)
+    ->ArgNames({"n", "m", "J%"})
+    ->ArgsProduct({{1'000, 100'000}, {20}, {10, 90}});
+BENCHMARK(BM_LBFGSUpdate)
+    ->ArgNames({"n", "m"})
+    ->ArgsProduct({{100, 10'000}, {20}});
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+
+#include <random>
+
+namespace bench_util {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+/// Each benchmark creates its own generator with a fixed seed, so the data
+/// does not depend on which other benchmarks ran before it.
+using rng_t = std::mt19937;
+
+/// Vector with normally distributed elements.
+inline vec random_vec(rng_t &rng, length_t n, real_t scale = 1) {
+    std::normal_distribution<real_t> nrml{0, scale};
+    return vec::NullaryExpr(n, [&] { return nrml(rng); });
+}
+
+/// Matrix with normally distributed elements.
+inline mat random_mat(rng_t &rng, length_t rows, length_t cols,
+                      real_t scale = 1) {
+    std::normal_distribution<real_t> nrml{0, scale};
+    return mat::NullaryExpr(rows, cols, [&] { return nrml(rng); });
+}
+
+/// Sorted random subset of {0, …, n-1}, where each index is included with
+/// probability @p fraction.
+inline indexvec random_indices(rng_t &rng, length_t n, real_t fraction) {
+    std::bernoulli_distribution keep{fraction};
+    indexvec J(n);
+    length_t nJ = 0;
+    for (index_t i = 0; i < n; ++i)
+        if (keep(rng))
+            J(nJ++) = i;
+    J.conservativeResize(nJ);
+    return J;
+}
+
+} // namespace bench_util
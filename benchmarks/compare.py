@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Compare two result files of the alpaqa benchmarks.
+
+The result files are the JSON files written by Google Benchmark, e.g. using
+the ``alpaqa-benchmarks-run`` target, or by running
+``alpaqa-benchmarks --benchmark_out=results.json --benchmark_out_format=json``.
+When the benchmarks were repeated, the given aggregate (the median by default)
+is compared, otherwise the average of all iterations is used.
+
+Example::
+
+    python3 benchmarks/compare.py baseline.json contender.json --threshold 5
+"""
+
+import argparse
+import json
+import math
+import sys
+from typing import Dict
+
+_TIME_UNITS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(filename: str, metric: str, aggregate: str) -> Dict[str, float]:
+    """Return the given time metric (in nanoseconds) of all benchmarks in the
+    file, keyed by the benchmark name."""
+    with open(filename) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    aggregates, iterations = {}, {}
+    for b in benchmarks:
+        if "error_occurred" in b and b["error_occurred"]:
+            continue
+        t = b[metric] * _TIME_UNITS[b.get("time_unit", "ns")]
+        name = b.get("run_name", b["name"])
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == aggregate:
+                aggregates[name] = t
+        else:
+            iterations.setdefault(name, []).append(t)
+    results = {n: sum(ts) / len(ts) for n, ts in iterations.items()}
+    results.update(aggregates)
+    return results
+
+
+def format_time(t: float) -> str:
+    for unit in ("s", "ms", "us"):
+        if t >= _TIME_UNITS[unit]:
+            return f"{t / _TIME_UNITS[unit]:.3f} {unit}"
+    return f"{t:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("baseline", help="JSON results of the baseline")
+    parser.add_argument("contender", help="JSON results to compare to the baseline")
+    parser.add_argument(
+        "--metric",
+        choices=("cpu_time", "real_time"),
+        default="cpu_time",
+        help="time to compare (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--aggregate",
+        default="median",
+        help="aggregate to compare for repeated benchmarks (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5,
+        help="relative change (in percent) that is reported as a regression "
+        "or improvement (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--filter", default="", help="only compare benchmarks containing this string"
+    )
+    parser.add_argument(
+        "--fail-on-regression",
+        action="store_true",
+        help="exit with status 1 if any benchmark regressed by more than the "
+        "threshold",
+    )
+    args = parser.parse_args()
+
+    base = load_results(args.baseline, args.metric, args.aggregate)
+    cont = load_results(args.contender, args.metric, args.aggregate)
+    names = [n for n in base if n in cont and args.filter in n]
+    if not names:
+        print("No common benchmarks found", file=sys.stderr)
+        sys.exit(2)
+
+    width = max(len(n) for n in names)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Contender':>12}  {'Change':>8}")
+    print("-" * (width + 40))
+    regressions, log_ratios = [], []
+    for name in names:
+        ratio = cont[name] / base[name]
+        log_ratios.append(math.log(ratio))
+        change = 100 * (ratio - 1)
+        mark = ""
+        if change > args.threshold:
+            mark = "  slower"
+            regressions.append(name)
+        elif change < -args.threshold:
+            mark = "  faster"
+        print(
+            f"{name:<{width}}  {format_time(base[name]):>12}  "
+            f"{format_time(cont[name]):>12}  {change:>+7.1f}%{mark}"
+        )
+    print("-" * (width + 40))
+    geomean = 100 * (math.exp(sum(log_ratios) / len(log_ratios)) - 1)
+    print(f"Geometric mean of changes: {geomean:+.1f}% ({len(names)} benchmarks)")
+    for missing, other in ((base, cont), (cont, base)):
+        only = [n for n in missing if n not in other and args.filter in n]
+        if only:
+            which = "baseline" if missing is base else "contender"
+            print(f"Only in {which}: {', '.join(only)}")
+    if regressions:
+        print(f"{len(regressions)} benchmark(s) regressed by more than {args.threshold}%")
+        if args.fail_on_regression:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/functions/elastic-net.hpp>
+#include <alpaqa/functions/indicator-linf-ball.hpp>
+#include <alpaqa/functions/indicator-simplex.hpp>
+#include <alpaqa/functions/l1-norm.hpp>
+#include <alpaqa/functions/l21-norm.hpp>
+#include <bench-util/random.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// Evaluates the proximal operator of @p h on a random vector of the size
+/// given by the first benchmark argument.
+template <class H>
+void bench_prox(benchmark::State &state, H h, real_t scale = 1) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    vec x = random_vec(rng, n, scale), y(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(alpaqa::prox(h, x, y, 0.5));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * 2 *
+                            static_cast<int64_t>(sizeof(real_t)));
+}
+
+/// Contiguous groups of the given size.
+indexvec group_starts(length_t n, length_t size) {
+    return indexvec::LinSpaced((n + size - 1) / size, 0,
+                               size * ((n + size - 1) / size - 1));
+}
+
+/// Classic sort-based simplex projection, as a baseline for @ref Simplex.
+void BM_SimplexSort(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    vec x = random_vec(rng, n), μ(n), y(n);
+    for (auto _ : state) {
+        μ = x;
+        std::sort(μ.begin(), μ.end(), std::greater<>{});
+        real_t s = 0, θ = 0;
+        for (index_t j = 0; j < n; ++j) {
+            s += μ(j);
+            real_t t = (s - 1) / static_cast<real_t>(j + 1);
+            if (μ(j) - t > 0)
+                θ = t;
+        }
+        y = (x.array() - θ).max(0);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * 2 *
+                            static_cast<int64_t>(sizeof(real_t)));
+}
+
+void BM_L1Norm(benchmark::State &state) {
+    bench_prox(state, alpaqa::functions::L1Norm<config_t>{0.1});
+}
+void BM_L21NormGroups(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    bench_prox(state,
+               alpaqa::functions::L21Norm<config_t>{0.1, group_starts(n, 8)});
+}
+void BM_ElasticNet(benchmark::State &state) {
+    bench_prox(state, alpaqa::functions::ElasticNet<config_t>{0.1, 0.5});
+}
+void BM_LInfBall(benchmark::State &state) {
+    bench_prox(state, alpaqa::functions::LInfBall<config_t>{0.5});
+}
+void BM_Simplex(benchmark::State &state) {
+    bench_prox(state, alpaqa::functions::Simplex<config_t>{1});
+}
+void BM_L1Ball(benchmark::State &state) {
+    bench_prox(state, alpaqa::functions::L1Ball<config_t>{1});
+}
+
+} // namespace
+
+BENCHMARK(BM_L1Norm)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_L21NormGroups)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_ElasticNet)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_LInfBall)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_Simplex)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_SimplexSort)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_L1Ball)->RangeMultiplier(10)->Range(100, 1'000'000);
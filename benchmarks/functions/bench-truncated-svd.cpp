@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/functions/truncated-svd.hpp>
+#include <bench-util/random.hpp>
+
+#include <Eigen/QR>
+#include <Eigen/SVD>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// Square matrix with @p r singular values in [2, 10] and the remaining ones
+/// in [0, 0.5], so that the rank above the threshold of 1 is @p r.
+mat low_rank_plus_noise(rng_t &rng, length_t n, length_t r) {
+    Eigen::HouseholderQR<mat> qr_u{random_mat(rng, n, n)},
+        qr_v{random_mat(rng, n, n)};
+    mat U = qr_u.householderQ(), V = qr_v.householderQ();
+    vec σ(n);
+    σ.topRows(r).setLinSpaced(10, 2);
+    σ.bottomRows(n - r).setLinSpaced(0.5, 0);
+    return U * σ.asDiagonal() * V.transpose();
+}
+
+/// Partial SVD of a sequence of slightly perturbed matrices, as in the
+/// iterations of a proximal method, warm-started using the previous
+/// decomposition. Arguments: size n and number of singular values r above
+/// the threshold.
+void BM_TruncatedSVD(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto r = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    mat A = low_rank_plus_noise(rng, n, r);
+    mat E = random_mat(rng, n, n, 1e-3);
+    alpaqa::functions::TruncatedSVD<config_t> svd{n, n};
+    bool flip = false;
+    for (auto _ : state) {
+        svd.compute_truncated(flip ? mat(A + E) : A, 1);
+        benchmark::DoNotOptimize(svd.matrixU().data());
+        benchmark::ClobberMemory();
+        flip = !flip;
+    }
+    state.counters["iter/svd"] =
+        static_cast<double>(svd.get_num_iterations()) /
+        static_cast<double>(svd.get_num_computations());
+}
+
+/// Full (thin) SVD using Eigen's divide and conquer algorithm, as a baseline
+/// for @ref BM_TruncatedSVD.
+void BM_BDCSVD(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    const auto r = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    mat A = low_rank_plus_noise(rng, n, r);
+    mat E = random_mat(rng, n, n, 1e-3);
+    Eigen::BDCSVD<mat> svd{n, n, Eigen::ComputeThinU | Eigen::ComputeThinV};
+    bool flip = false;
+    for (auto _ : state) {
+        svd.compute(flip ? mat(A + E) : A);
+        benchmark::DoNotOptimize(svd.matrixU().data());
+        benchmark::ClobberMemory();
+        flip = !flip;
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_TruncatedSVD)
+    ->ArgNames({"n", "r"})
+    ->ArgsProduct({{100, 400}, {2, 10}});
+BENCHMARK(BM_BDCSVD)->ArgNames({"n", "r"})->ArgsProduct({{100, 400}, {2, 10}});
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/inner/directions/panoc/structured-newton.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+#include <bench-util/random.hpp>
+
+#include <Eigen/QR>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+using Reg = alpaqa::StructuredNewtonRegularization;
+
+/// Unconstrained quadratic with a symmetric Hessian with the given eigenvalues
+/// and random eigenvectors.
+alpaqa::FunctionalProblem<config_t> make_quadratic(rng_t &rng, crvec λ) {
+    const auto n = λ.size();
+    Eigen::HouseholderQR<mat> qr{random_mat(rng, n, n)};
+    mat Q = qr.householderQ();
+    mat H = Q * λ.asDiagonal() * Q.transpose();
+    alpaqa::FunctionalProblem<config_t> problem{n, 0};
+    problem.f      = [H](crvec x) { return x.dot(H * x) / 2; };
+    problem.grad_f = [H](crvec x, rvec g) { g = H * x; };
+    problem.g      = [](crvec, rvec) {};
+    problem.grad_g_prod = [](crvec, crvec, rvec g) { g.setZero(); };
+    problem.hess_L = [H](crvec, crvec, real_t scale, rmat out) {
+        out = scale * H;
+    };
+    return problem;
+}
+
+/// Computes the structured Newton direction of a dense quadratic problem
+/// without active constraints, i.e. the cost of evaluating the Hessian and
+/// solving the regularized Newton system.
+/// Arguments: problem size n, regularization method and whether the Hessian
+/// is indefinite.
+void BM_StructuredNewtonDirection(benchmark::State &state) {
+    const auto n          = static_cast<length_t>(state.range(0));
+    const auto method     = static_cast<Reg>(state.range(1));
+    const bool indefinite = state.range(2) != 0;
+    rng_t rng{12345};
+    vec λ = vec::LinSpaced(n, indefinite ? -1 : 1, 10);
+    auto qp = make_quadratic(rng, λ);
+    alpaqa::TypeErasedProblem<config_t> problem{&qp};
+    alpaqa::StructuredNewtonDirection<config_t> dir{{.method = method}};
+    const real_t γ = 1;
+    vec y(0), Σ(0), x = vec::Zero(n), grad = random_vec(rng, n);
+    vec x̂ = x - γ * grad, p = x̂ - x, q(n);
+    dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dir.apply(γ, x, x̂, p, grad, q));
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(enum_name(method));
+}
+
+} // namespace
+
+BENCHMARK(BM_StructuredNewtonDirection)
+    ->ArgNames({"n", "method", "indef"})
+    ->ArgsProduct({
+        {16, 64, 256, 512},
+        {static_cast<int64_t>(Reg::EigenvalueClipping),
+         static_cast<int64_t>(Reg::ShiftedCholesky),
+         static_cast<int64_t>(Reg::ModifiedLDLT)},
+        {0, 1},
+    });
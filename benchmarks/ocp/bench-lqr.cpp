@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/inner/directions/panoc-ocp/lqr.hpp>
+#include <alpaqa/util/index-set.hpp>
+#include <bench-util/random.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// Random time-varying linear-quadratic problem with box constraints on the
+/// inputs, with the same structure as the Gauss-Newton subproblems of
+/// PANOC-OCP. About half of the inputs are active.
+struct RandomLQR {
+    RandomLQR(rng_t &rng, length_t N, length_t nx, length_t nu)
+        : dim{N, nx, nu}, AB{random_mat(rng, nx, (nx + nu) * N, 0.3)},
+          Q{spd(rng, nx)}, R{spd(rng, nu)}, S{random_mat(rng, nu, nx, 0.1)},
+          qr{random_vec(rng, (nx + nu) * N + nx)}, u{random_vec(rng, nu * N)},
+          J{N, nu} {
+        J.update([&](index_t, index_t) { return inactive(rng); });
+    }
+
+    static mat spd(rng_t &rng, length_t n) {
+        mat A = random_mat(rng, n, n);
+        return A.transpose() * A + mat::Identity(n, n);
+    }
+
+    alpaqa::Dim<config_t> dim;
+    mat AB, Q, R, S;
+    vec qr, u;
+    std::bernoulli_distribution inactive{0.5};
+    alpaqa::detail::IndexSet<config_t> J;
+
+    void factor(alpaqa::StatefulLQRFactor<config_t> &lqr, bool cholesky) {
+        auto [N, nx, nu] = dim;
+        auto ABk = [&](index_t i) -> crmat {
+            return AB.middleCols(i * (nx + nu), nx + nu);
+        };
+        auto Qk = [&](index_t) { return [&](rmat out) { out += Q; }; };
+        auto Rk = [&](index_t) {
+            return [&](crindexvec mask, rmat out) { out += R(mask, mask); };
+        };
+        auto Sk = [&](index_t) {
+            return [&](crindexvec mask, rmat out) {
+                out += S(mask, Eigen::indexing::all);
+            };
+        };
+        auto Rk_prod = [&](index_t) {
+            return [&](crindexvec mask_J, crindexvec mask_K, crvec v,
+                       rvec out) {
+                out.noalias() += R(mask_J, mask_K) * v(mask_K);
+            };
+        };
+        auto Sk_prod = [&](index_t) {
+            return [&](crindexvec mask_K, crvec v, rvec out) {
+                out.noalias() +=
+                    S(mask_K, Eigen::indexing::all).transpose() * v(mask_K);
+            };
+        };
+        auto qk = [&](index_t k) -> crvec {
+            return qr.segment(k * (nx + nu), nx);
+        };
+        auto rk = [&](index_t k) -> crvec {
+            return qr.segment(k * (nx + nu) + nx, nu);
+        };
+        auto uk = [&](index_t k) -> crvec { return u.segment(k * nu, nu); };
+        auto Jk = [&](index_t k) -> crindexvec { return J.indices(k); };
+        auto Kk = [&](index_t k) -> crindexvec { return J.compl_indices(k); };
+        lqr.factor_masked(ABk, Qk, Rk, Sk, Rk_prod, Sk_prod, qk, rk, uk, Jk,
+                          Kk, cholesky);
+    }
+
+    void solve(alpaqa::StatefulLQRFactor<config_t> &lqr, rvec Δu, rvec Δx) {
+        auto [N, nx, nu] = dim;
+        auto ABk = [&](index_t i) -> crmat {
+            return AB.middleCols(i * (nx + nu), nx + nu);
+        };
+        auto Jk = [&](index_t k) -> crindexvec { return J.indices(k); };
+        lqr.solve_masked(ABk, Jk, Δu, Δx);
+    }
+};
+
+/// Arguments: horizon N, number of states nx, number of inputs nu, and
+/// whether to use a Cholesky (1) or LU (0) factorization.
+void BM_LQRFactorMasked(benchmark::State &state) {
+    const auto N  = static_cast<length_t>(state.range(0));
+    const auto nx = static_cast<length_t>(state.range(1));
+    const auto nu = static_cast<length_t>(state.range(2));
+    const bool cholesky = state.range(3) != 0;
+    rng_t rng{12345};
+    RandomLQR problem{rng, N, nx, nu};
+    alpaqa::StatefulLQRFactor<config_t> lqr{{N, nx, nu}};
+    for (auto _ : state) {
+        problem.factor(lqr, cholesky);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+/// Arguments: horizon N, number of states nx and number of inputs nu.
+void BM_LQRSolveMasked(benchmark::State &state) {
+    const auto N  = static_cast<length_t>(state.range(0));
+    const auto nx = static_cast<length_t>(state.range(1));
+    const auto nu = static_cast<length_t>(state.range(2));
+    rng_t rng{12345};
+    RandomLQR problem{rng, N, nx, nu};
+    alpaqa::StatefulLQRFactor<config_t> lqr{{N, nx, nu}};
+    problem.factor(lqr, true);
+    mat e0 = lqr.e;
+    vec Δu = problem.u, Δx(2 * nx);
+    for (auto _ : state) {
+        lqr.e = e0; // solve_masked updates e in-place
+        problem.solve(lqr, Δu, Δx);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+/// Computing the active and inactive index sets of the inputs.
+/// Arguments: horizon N and number of inputs nu.
+void BM_IndexSetUpdate(benchmark::State &state) {
+    const auto N  = static_cast<length_t>(state.range(0));
+    const auto nu = static_cast<length_t>(state.range(1));
+    rng_t rng{12345};
+    vec u = random_vec(rng, N * nu);
+    alpaqa::detail::IndexSet<config_t> J{N, nu};
+    for (auto _ : state) {
+        J.update([&](index_t t, index_t i) { return u(t * nu + i) > 0; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N * nu);
+}
+
+/// Computing the complement of an index set (e.g. K from J).
+/// Arguments: number of indices n.
+void BM_IndexSetComplement(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    indexvec J = random_indices(rng, n, 0.5), K(n - J.size());
+    for (auto _ : state) {
+        alpaqa::detail::IndexSet<config_t>::compute_complement(J, K, n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+BENCHMARK(BM_LQRFactorMasked)
+    ->ArgNames({"N", "nx", "nu", "chol"})
+    ->Args({30, 4, 2, 1})
+    ->Args({30, 12, 4, 1})
+    ->Args({30, 12, 4, 0})
+    ->Args({50, 40, 10, 1})
+    ->Args({50, 40, 10, 0});
+BENCHMARK(BM_LQRSolveMasked)
+    ->ArgNames({"N", "nx", "nu"})
+    ->Args({30, 4, 2})
+    ->Args({30, 12, 4})
+    ->Args({50, 40, 10});
+BENCHMARK(BM_IndexSetUpdate)
+    ->ArgNames({"N", "nu"})
+    ->ArgsProduct({{30, 100}, {2, 10}});
+BENCHMARK(BM_IndexSetComplement)->ArgName("n")->Arg(10)->Arg(100)->Arg(1'000);
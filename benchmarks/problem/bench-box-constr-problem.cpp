@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <bench-util/random.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+
+/// Kind of ℓ₁-regularization, selected by the second benchmark argument.
+enum L1Reg { None = 0, Scalar = 1, Vector = 2 };
+
+/// Problem with bounds [-1, 1] on all variables, so that roughly half of the
+/// variables end up at one of the bounds for the random iterates and
+/// gradients used in the benchmarks.
+alpaqa::BoxConstrProblem<config_t> make_problem(rng_t &rng, length_t n,
+                                                L1Reg reg) {
+    alpaqa::BoxConstrProblem<config_t> problem{n, 0};
+    problem.C.lowerbound.setConstant(-1);
+    problem.C.upperbound.setConstant(+1);
+    if (reg == Scalar)
+        problem.l1_reg = vec::Constant(1, 0.1);
+    else if (reg == Vector)
+        problem.l1_reg = random_vec(rng, n, 0.1).cwiseAbs();
+    return problem;
+}
+
+/// Arguments: problem size n and kind of ℓ₁-regularization.
+void BM_BoxConstrProxGradStep(benchmark::State &state) {
+    const auto n   = static_cast<length_t>(state.range(0));
+    const auto reg = static_cast<L1Reg>(state.range(1));
+    rng_t rng{12345};
+    auto problem = make_problem(rng, n, reg);
+    vec x = random_vec(rng, n), grad_ψ = random_vec(rng, n), x̂(n), p(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            problem.eval_prox_grad_step(0.5, x, grad_ψ, x̂, p));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * 4 *
+                            static_cast<int64_t>(sizeof(real_t)));
+}
+
+/// Arguments: problem size n and kind of ℓ₁-regularization.
+void BM_BoxConstrInactiveIndices(benchmark::State &state) {
+    const auto n   = static_cast<length_t>(state.range(0));
+    const auto reg = static_cast<L1Reg>(state.range(1));
+    rng_t rng{12345};
+    auto problem = make_problem(rng, n, reg);
+    vec x = random_vec(rng, n), grad_ψ = random_vec(rng, n);
+    indexvec J(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            problem.eval_inactive_indices_res_lna(0.5, x, grad_ψ, J));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+BENCHMARK(BM_BoxConstrProxGradStep)
+    ->ArgNames({"n", "l1"})
+    ->ArgsProduct({{100, 10'000, 1'000'000}, {None, Scalar, Vector}});
+BENCHMARK(BM_BoxConstrInactiveIndices)
+    ->ArgNames({"n", "l1"})
+    ->ArgsProduct({{100, 10'000, 1'000'000}, {None, Scalar, Vector}});
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/problem/sparsity-conversions.hpp>
+#include <alpaqa/problem/sparsity.hpp>
+#include <bench-util/random.hpp>
+
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+namespace sp = alpaqa::sparsity;
+using Sparsity = sp::Sparsity<config_t>;
+
+/// Random square sparse matrix in compressed column storage, with sorted row
+/// indices. About @p density percent of the elements are nonzero.
+struct RandomCSC {
+    RandomCSC(rng_t &rng, length_t n, real_t density) {
+        std::bernoulli_distribution nonzero{density / 100};
+        std::vector<Eigen::Triplet<real_t, index_t>> triplets;
+        for (index_t c = 0; c < n; ++c)
+            for (index_t r = 0; r < n; ++r)
+                if (nonzero(rng))
+                    triplets.emplace_back(r, c, 1);
+        Eigen::SparseMatrix<real_t, Eigen::ColMajor, index_t> S(n, n);
+        S.setFromTriplets(triplets.begin(), triplets.end());
+        S.makeCompressed();
+        inner_idx = Eigen::Map<const indexvec>(S.innerIndexPtr(), S.nonZeros());
+        outer_ptr = Eigen::Map<const indexvec>(S.outerIndexPtr(), n + 1);
+        values    = random_vec(rng, S.nonZeros());
+    }
+    indexvec inner_idx, outer_ptr;
+    vec values;
+};
+
+/// Function that evaluates the source matrix, as passed to
+/// @ref sp::SparsityConverter::convert_values by the problem adapters.
+auto eval_values(crvec values) {
+    return [values](rvec v) { v = values; };
+}
+
+/// Sparse Hessian to dense. Arguments: size n and density (%).
+void BM_SparsityCSCToDense(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    RandomCSC A{rng, n, static_cast<real_t>(state.range(1))};
+    sp::SparseCSC<config_t, index_t> csc{
+        .rows      = n,
+        .cols      = n,
+        .symmetry  = sp::Symmetry::Unsymmetric,
+        .inner_idx = A.inner_idx,
+        .outer_ptr = A.outer_ptr,
+        .order     = sp::SparseCSC<config_t, index_t>::SortedRows,
+    };
+    sp::SparsityConverter<Sparsity, sp::Dense<config_t>> cvt{Sparsity{csc}};
+    vec dense(n * n);
+    for (auto _ : state) {
+        cvt.convert_values(eval_values(A.values), dense);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * A.values.size());
+}
+
+/// Upper triangle of a dense symmetric Hessian to sparse CSC.
+/// Arguments: size n.
+void BM_SparsityDenseUpperToCSC(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    sp::Dense<config_t> dense{
+        .rows     = n,
+        .cols     = n,
+        .symmetry = sp::Symmetry::Upper,
+    };
+    using CSC = sp::SparseCSC<config_t, index_t>;
+    sp::SparsityConverter<Sparsity, CSC> cvt{Sparsity{dense}};
+    vec values = random_vec(rng, n * n), result(cvt.get_sparsity().nnz());
+    for (auto _ : state) {
+        cvt.convert_values(eval_values(values), result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * result.size());
+}
+
+/// Sparse COO to dense. Arguments: size n and density (%).
+void BM_SparsityCOOToDense(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    RandomCSC A{rng, n, static_cast<real_t>(state.range(1))};
+    indexvec rows = A.inner_idx, cols(A.inner_idx.size());
+    for (index_t c = 0; c < n; ++c)
+        cols.segment(A.outer_ptr(c), A.outer_ptr(c + 1) - A.outer_ptr(c))
+            .setConstant(c);
+    sp::SparseCOO<config_t, index_t> coo{
+        .rows        = n,
+        .cols        = n,
+        .symmetry    = sp::Symmetry::Unsymmetric,
+        .row_indices = rows,
+        .col_indices = cols,
+        .order       = sp::SparseCOO<config_t, index_t>::SortedByColsAndRows,
+    };
+    sp::SparsityConverter<Sparsity, sp::Dense<config_t>> cvt{Sparsity{coo}};
+    vec dense(n * n);
+    for (auto _ : state) {
+        cvt.convert_values(eval_values(A.values), dense);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * A.values.size());
+}
+
+#if ALPAQA_HAVE_COO_CSC_CONVERSIONS
+/// Unsorted sparse COO to CSC, which permutes the values.
+/// Arguments: size n and density (%).
+void BM_SparsityCOOUnsortedToCSC(benchmark::State &state) {
+    const auto n = static_cast<length_t>(state.range(0));
+    rng_t rng{12345};
+    RandomCSC A{rng, n, static_cast<real_t>(state.range(1))};
+    const auto nnz = A.inner_idx.size();
+    indexvec perm(nnz), rows(nnz), cols(nnz);
+    std::iota(perm.begin(), perm.end(), index_t{0});
+    std::shuffle(perm.begin(), perm.end(), rng);
+    for (index_t c = 0; c < n; ++c)
+        for (index_t l = A.outer_ptr(c); l < A.outer_ptr(c + 1); ++l)
+            rows(perm(l)) = A.inner_idx(l), cols(perm(l)) = c;
+    sp::SparseCOO<config_t, index_t> coo{
+        .rows        = n,
+        .cols        = n,
+        .symmetry    = sp::Symmetry::Unsymmetric,
+        .row_indices = rows,
+        .col_indices = cols,
+        .order       = sp::SparseCOO<config_t, index_t>::Unsorted,
+    };
+    using CSC = sp::SparseCSC<config_t, index_t>;
+    sp::SparsityConverter<Sparsity, CSC> cvt{Sparsity{coo},
+                                             {.order = CSC::SortedRows}};
+    vec result(nnz);
+    for (auto _ : state) {
+        cvt.convert_values(eval_values(A.values), result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * nnz);
+}
+#endif
+
+} // namespace
+
+BENCHMARK(BM_SparsityCSCToDense)
+    ->ArgNames({"n", "density%"})
+    ->ArgsProduct({{100, 1'000}, {1, 10}});
+BENCHMARK(BM_SparsityDenseUpperToCSC)->ArgName("n")->Arg(100)->Arg(1'000);
+BENCHMARK(BM_SparsityCOOToDense)
+    ->ArgNames({"n", "density%"})
+    ->ArgsProduct({{100, 1'000}, {1, 10}});
+#if ALPAQA_HAVE_COO_CSC_CONVERSIONS
+BENCHMARK(BM_SparsityCOOUnsortedToCSC)
+    ->ArgNames({"n", "density%"})
+    ->ArgsProduct({{100, 1'000}, {1, 10}});
+#endif
@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+#include <bench-util/random.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using namespace bench_util;
+namespace syn   = alpaqa::synthetic;
+using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+
+syn::ChainOCP make_chain(const benchmark::State &state) {
+    return {{.N = state.range(0), .nx = state.range(1)}};
+}
+syn::LogisticRegression make_logreg(const benchmark::State &state) {
+    return {{.samples = state.range(0), .features = state.range(1)}};
+}
+/// The second argument is the average number of nonzeros per column.
+syn::RandomQP make_qp(const benchmark::State &state) {
+    const auto n = state.range(0), nnz_col = state.range(1);
+    return {{
+        .n       = n,
+        .m       = n / 2,
+        .density = static_cast<real_t>(nnz_col) / static_cast<real_t>(n),
+    }};
+}
+syn::ChainedRosenbrock make_rosenbrock(const benchmark::State &state) {
+    return {{.n = state.range(0)}};
+}
+
+/// Evaluation of the cost, its gradient, the constraints, the gradient of the
+/// augmented Lagrangian and the (sparse) Hessian of the augmented Lagrangian
+/// in a random point, i.e. the functions needed by a second-order solver in
+/// one iteration.
+template <auto make_problem>
+void BM_SyntheticEval(benchmark::State &state) {
+    rng_t rng{12345};
+    auto problem = make_problem(state);
+    TEProblem p{&problem};
+    const auto n = p.get_n(), m = p.get_m();
+    vec x = problem.initial_guess + random_vec(rng, n, 0.1),
+        y = random_vec(rng, m), Σ = vec::Constant(m, 10), grad_f(n), g(m),
+        grad_ψ(n), work_n(n), work_m(m),
+        H(get_nnz(p.get_hess_ψ_sparsity()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.eval_f_grad_f(x, grad_f));
+        p.eval_g(x, g);
+        p.eval_grad_ψ(x, y, Σ, grad_ψ, work_n, work_m);
+        p.eval_hess_ψ(x, y, Σ, 1, H);
+        benchmark::ClobberMemory();
+    }
+    state.counters["n"]   = static_cast<double>(n);
+    state.counters["m"]   = static_cast<double>(m);
+    state.counters["nnz"] = static_cast<double>(H.size());
+}
+
+/// Full solve using PANOC with L-BFGS and the augmented Lagrangian method.
+template <auto make_problem>
+void BM_SyntheticSolve(benchmark::State &state) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    auto problem      = make_problem(state);
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-6;
+    almparam.dual_tolerance = 1e-6;
+    PANOCSolver::Params panocparam;
+    panocparam.max_iter = 100'000;
+    ALMSolver solver{almparam, {panocparam, {{.memory = 20}}}};
+    unsigned inner_iter = 0;
+    for (auto _ : state) {
+        vec x = problem.initial_guess, y = vec::Zero(problem.get_m());
+        auto stats = solver(TEProblem{&problem}, x, y);
+        if (stats.status != alpaqa::SolverStatus::Converged)
+            state.SkipWithError("Solver did not converge");
+        inner_iter = stats.inner.iterations;
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["iter"] = inner_iter;
+}
+
+} // namespace
+
+BENCHMARK(BM_SyntheticEval<make_chain>)
+    ->Name("BM_SyntheticEval/chain")
+    ->ArgNames({"N", "nx"})
+    ->ArgsProduct({{10, 100, 1'000}, {8, 32}});
+BENCHMARK(BM_SyntheticEval<make_logreg>)
+    ->Name("BM_SyntheticEval/logreg")
+    ->ArgNames({"samples", "features"})
+    ->Args({1'000, 200})
+    ->Args({10'000, 200})
+    ->Args({10'000, 2'000});
+BENCHMARK(BM_SyntheticEval<make_qp>)
+    ->Name("BM_SyntheticEval/qp")
+    ->ArgNames({"n", "nnz_col"})
+    ->ArgsProduct({{100, 1'000, 10'000}, {2, 10}});
+BENCHMARK(BM_SyntheticEval<make_rosenbrock>)
+    ->Name("BM_SyntheticEval/rosenbrock")
+    ->ArgName("n")
+    ->Arg(100)
+    ->Arg(10'000)
+    ->Arg(1'000'000);
+
+BENCHMARK(BM_SyntheticSolve<make_chain>)
+    ->Name("BM_SyntheticSolve/chain")
+    ->ArgNames({"N", "nx"})
+    ->Args({10, 8})
+    ->Args({20, 8})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SyntheticSolve<make_logreg>)
+    ->Name("BM_SyntheticSolve/logreg")
+    ->ArgNames({"samples", "features"})
+    ->Args({1'000, 200})
+    ->Args({10'000, 200})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SyntheticSolve<make_qp>)
+    ->Name("BM_SyntheticSolve/qp")
+    ->ArgNames({"n", "nnz_col"})
+    ->Args({100, 5})
+    ->Args({1'000, 5})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SyntheticSolve<make_rosenbrock>)
+    ->Name("BM_SyntheticSolve/rosenbrock")
+    ->ArgName("n")
+    ->Arg(100)
+    ->Arg(300)
+    ->Unit(benchmark::kMillisecond);
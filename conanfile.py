@@ -26,6 +26,7 @@ class AlpaqaRecipe(ConanFile):
         "with_matlab": False,
         "with_drivers": True,
         "with_gradient_checker": False,
+        "with_benchmarks": False,
         "with_casadi": True,
         "with_external_casadi": False,
         "with_cutest": False,
@@ -60,6 +61,7 @@ class AlpaqaRecipe(ConanFile):
         "interfaces/*",
         "python/*",
         "test/*",
+        "benchmarks/*",
         "LICENSE",
         "README.md",
     )
@@ -74,11 +76,13 @@ class AlpaqaRecipe(ConanFile):
         if self.options.with_json:
             self.requires("nlohmann_json/3.11.2", transitive_headers=True)
         if self.options.with_python:
-            self.requires("pybind11/2.11.1")
+            self.requires("pybind11/2.13.6")
         if self.options.with_matlab:
             self.requires("utfcpp/4.0.1")
         if self.options.with_blas:
             self.requires("openblas/0.3.24")
+        if self.options.with_benchmarks:
+            self.requires("benchmark/1.8.3")
 
     def config_options(self):
         if self.settings.get_safe("os") == "Windows":
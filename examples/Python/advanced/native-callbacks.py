@@ -0,0 +1,96 @@
+# %% alpaqa native callbacks example
+
+import alpaqa as pa
+import numpy as np
+from numba import cfunc, carray, types
+from concurrent.futures import ThreadPoolExecutor
+from time import perf_counter
+
+# %% Define the problem functions
+
+# Chained Rosenbrock function
+#
+# minimize  Σ (1 - x_i)² + 100 (x_{i+1} - x_i²)²
+
+n = 16
+
+
+class PythonRosenbrock(pa.UnconstrProblem):
+    """Problem functions implemented in Python using NumPy."""
+
+    def __init__(self):
+        super().__init__(n)
+
+    def eval_f(self, x):
+        return np.sum((1 - x[:-1]) ** 2 + 100 * (x[1:] - x[:-1] ** 2) ** 2)
+
+    def eval_grad_f(self, x, grad_f):
+        r = x[1:] - x[:-1] ** 2
+        grad_f[:] = 0
+        grad_f[:-1] = -2 * (1 - x[:-1]) - 400 * x[:-1] * r
+        grad_f[1:] += 200 * r
+
+
+# Native versions of the same functions, compiled using Numba, with the C
+# signatures expected by alpaqa (see alpaqa_problem_functions_t)
+real_p = types.CPointer(types.float64)
+
+
+@cfunc(types.float64(types.voidptr, real_p), nopython=True)
+def eval_f(instance, x_):
+    x = carray(x_, (n,))
+    f = 0.0
+    for i in range(n - 1):
+        f += (1 - x[i]) ** 2 + 100 * (x[i + 1] - x[i] ** 2) ** 2
+    return f
+
+
+@cfunc(types.void(types.voidptr, real_p, real_p), nopython=True)
+def eval_grad_f(instance, x_, g_):
+    x, g = carray(x_, (n,)), carray(g_, (n,))
+    g[:] = 0
+    for i in range(n - 1):
+        r = x[i + 1] - x[i] ** 2
+        g[i] += -2 * (1 - x[i]) - 400 * x[i] * r
+        g[i + 1] += 200 * r
+
+
+class NativeRosenbrock(pa.UnconstrProblem):
+    """Problem functions implemented as native function pointers."""
+
+    def __init__(self):
+        super().__init__(n)
+        self.native_functions = {
+            "eval_f": eval_f,
+            "eval_grad_f": eval_grad_f,
+        }
+
+
+# %% Solve the problems and compare the run times
+
+x0 = np.full(n, -1.2)
+num_solves = 200
+num_threads = 4
+
+
+def solve(problem_type):
+    # Solvers and problems cannot be shared between threads, so create new ones
+    problem = pa.Problem(problem_type())
+    solver = pa.PANOCSolver({"max_iter": 10_000}, pa.LBFGSDirection({"memory": 10}))
+    x, stats = solver(problem, {"tolerance": 1e-10}, x0)
+    assert stats["status"] == pa.SolverStatus.Converged
+    return stats["iterations"]
+
+
+def benchmark(problem_type, threads):
+    t0 = perf_counter()
+    with ThreadPoolExecutor(threads) as pool:
+        iterations = list(pool.map(solve, [problem_type] * num_solves))
+    return (perf_counter() - t0) / num_solves, iterations[0]
+
+
+for problem_type in (PythonRosenbrock, NativeRosenbrock):
+    for threads in (1, num_threads):
+        t, it = benchmark(problem_type, threads)
+        name = problem_type.__name__
+        print(f"{name:>16}, {threads} thread(s): {t * 1e6:9.1f} µs/solve ({it} iterations)")
@@ -0,0 +1,225 @@
+#include <synthetic-problems/export.h>
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/dl/dl-problem.h>
+#include <alpaqa/params/params.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace syn = alpaqa::synthetic;
+
+/// Exposes one of the synthetic problems through the DL API.
+/// The problem is selected using the `problem.generator` option (`chain`,
+/// `logreg`, `qp` or `rosenbrock`), all other `problem.<key>=<value>`
+/// options set the parameters of the generator.
+template <class P>
+struct Problem {
+    alpaqa_problem_functions_t funcs{};
+    P problem;
+    std::string name = problem.get_name();
+
+    static constexpr bool has_hess_ψ = requires(const P &p) {
+        p.eval_hess_ψ(p.initial_guess, p.initial_guess, p.initial_guess, 1,
+                      std::declval<rvec>());
+    };
+
+    static alpaqa_sparsity_t convert(const alpaqa::Sparsity<config_t> &sp) {
+        using SparseCSC = alpaqa::sparsity::SparseCSC<config_t, int>;
+        const auto &csc = std::get<SparseCSC>(sp.value);
+        alpaqa_sparsity_t result{};
+        result.kind       = alpaqa_sparsity_t::alpaqa_sparsity_sparse_csc;
+        result.sparse_csc = {
+            .rows      = csc.rows,
+            .cols      = csc.cols,
+            .symmetry  = static_cast<alpaqa_symmetry>(csc.symmetry),
+            .nnz       = csc.nnz(),
+            .inner_idx = csc.inner_idx.data(),
+            .outer_ptr = csc.outer_ptr.data(),
+            .order     = alpaqa_sparse_csc_t::alpaqa_sparse_csc_sorted_rows,
+        };
+        return result;
+    }
+
+    length_t n() const { return problem.get_n(); }
+    length_t m() const { return problem.get_m(); }
+
+    real_t eval_f(const real_t *x) const {
+        return problem.eval_f(cmvec{x, n()});
+    }
+    void eval_grad_f(const real_t *x, real_t *grad_fx) const {
+        problem.eval_grad_f(cmvec{x, n()}, mvec{grad_fx, n()});
+    }
+    real_t eval_f_grad_f(const real_t *x, real_t *grad_fx) const {
+        return problem.eval_f_grad_f(cmvec{x, n()}, mvec{grad_fx, n()});
+    }
+    void eval_g(const real_t *x, real_t *gx) const {
+        problem.eval_g(cmvec{x, n()}, mvec{gx, m()});
+    }
+    void eval_grad_g_prod(const real_t *x, const real_t *y,
+                          real_t *grad_gxy) const {
+        problem.eval_grad_g_prod(cmvec{x, n()}, cmvec{y, m()},
+                                 mvec{grad_gxy, n()});
+    }
+    void eval_jac_g(const real_t *x, real_t *J_values) const {
+        auto nnz = get_nnz(problem.get_jac_g_sparsity());
+        problem.eval_jac_g(cmvec{x, n()}, mvec{J_values, nnz});
+    }
+    alpaqa_sparsity_t get_jac_g_sparsity() const {
+        return convert(problem.get_jac_g_sparsity());
+    }
+    void eval_hess_L_prod(const real_t *x, const real_t *y, real_t scale,
+                          const real_t *v, real_t *Hv) const {
+        problem.eval_hess_L_prod(cmvec{x, n()}, cmvec{y, m()}, scale,
+                                 cmvec{v, n()}, mvec{Hv, n()});
+    }
+    void eval_hess_L(const real_t *x, const real_t *y, real_t scale,
+                     real_t *H_values) const {
+        auto nnz = get_nnz(problem.get_hess_L_sparsity());
+        problem.eval_hess_L(cmvec{x, n()}, cmvec{y, m()}, scale,
+                            mvec{H_values, nnz});
+    }
+    alpaqa_sparsity_t get_hess_L_sparsity() const {
+        return convert(problem.get_hess_L_sparsity());
+    }
+    /// The bounds @p zl and @p zu are the current bounds of the general
+    /// constraints, which are used to determine the active constraints.
+    void eval_hess_ψ_prod(const real_t *x, const real_t *y, const real_t *Σ,
+                          real_t scale, const real_t *zl, const real_t *zu,
+                          const real_t *v, real_t *Hv) {
+        update_D(zl, zu);
+        problem.eval_hess_ψ_prod(cmvec{x, n()}, cmvec{y, m()}, cmvec{Σ, m()},
+                                 scale, cmvec{v, n()}, mvec{Hv, n()});
+    }
+    void eval_hess_ψ(const real_t *x, const real_t *y, const real_t *Σ,
+                     real_t scale, const real_t *zl, const real_t *zu,
+                     real_t *H_values) {
+        update_D(zl, zu);
+        auto nnz = get_nnz(problem.get_hess_ψ_sparsity());
+        problem.eval_hess_ψ(cmvec{x, n()}, cmvec{y, m()}, cmvec{Σ, m()},
+                            scale, mvec{H_values, nnz});
+    }
+    alpaqa_sparsity_t get_hess_ψ_sparsity() const {
+        return convert(problem.get_hess_ψ_sparsity());
+    }
+    void update_D(const real_t *zl, const real_t *zu) {
+        problem.D.lowerbound = cmvec{zl, m()};
+        problem.D.upperbound = cmvec{zu, m()};
+    }
+
+    void initialize_box_C(real_t *lb, real_t *ub) const {
+        mvec{lb, n()} = problem.C.lowerbound;
+        mvec{ub, n()} = problem.C.upperbound;
+    }
+    void initialize_box_D(real_t *lb, real_t *ub) const {
+        mvec{lb, m()} = problem.D.lowerbound;
+        mvec{ub, m()} = problem.D.upperbound;
+    }
+    void initialize_l1_reg(real_t *lambda, length_t *size) const {
+        if (!lambda)
+            *size = problem.l1_reg.size();
+        else
+            mvec{lambda, *size} = problem.l1_reg;
+    }
+
+    explicit Problem(const typename P::Params &params) : problem{params} {
+        using alpaqa::member_caller;
+        using Pr                  = Problem;
+        funcs.n                   = n();
+        funcs.m                   = m();
+        funcs.name                = name.c_str();
+        funcs.eval_f              = member_caller<&Pr::eval_f>();
+        funcs.eval_grad_f         = member_caller<&Pr::eval_grad_f>();
+        funcs.eval_f_grad_f       = member_caller<&Pr::eval_f_grad_f>();
+        funcs.eval_g              = member_caller<&Pr::eval_g>();
+        funcs.eval_grad_g_prod    = member_caller<&Pr::eval_grad_g_prod>();
+        funcs.eval_jac_g          = member_caller<&Pr::eval_jac_g>();
+        funcs.get_jac_g_sparsity  = member_caller<&Pr::get_jac_g_sparsity>();
+        funcs.eval_hess_L_prod    = member_caller<&Pr::eval_hess_L_prod>();
+        funcs.eval_hess_L         = member_caller<&Pr::eval_hess_L>();
+        funcs.get_hess_L_sparsity = member_caller<&Pr::get_hess_L_sparsity>();
+        if constexpr (has_hess_ψ) {
+            funcs.eval_hess_ψ_prod = member_caller<&Pr::eval_hess_ψ_prod>();
+            funcs.eval_hess_ψ      = member_caller<&Pr::eval_hess_ψ>();
+            funcs.get_hess_ψ_sparsity =
+                member_caller<&Pr::get_hess_ψ_sparsity>();
+        }
+        funcs.initialize_box_C = member_caller<&Pr::initialize_box_C>();
+        funcs.initialize_box_D = member_caller<&Pr::initialize_box_D>();
+        if (problem.l1_reg.size() > 0)
+            funcs.initialize_l1_reg = member_caller<&Pr::initialize_l1_reg>();
+    }
+};
+
+/// Parse the options, create the problem, and expose it through the DL API.
+template <class P>
+alpaqa_problem_register_t make_problem(std::span<std::string_view> opts,
+                                       std::span<unsigned> used) {
+    typename P::Params params;
+    for (size_t i = 0; i < opts.size(); ++i) {
+        if (used[i])
+            continue;
+        auto [key, value] = alpaqa::params::split_key(opts[i], '=');
+        alpaqa::params::set_param(
+            params, {.full_key = opts[i], .key = key, .value = value});
+        ++used[i];
+    }
+    auto problem = std::make_unique<Problem<P>>(params);
+    alpaqa_problem_register_t result;
+    result.functions = &problem->funcs;
+    result.instance  = problem.release();
+    result.cleanup   = [](void *instance) {
+        delete static_cast<Problem<P> *>(instance);
+    };
+    return result;
+}
+
+/// Main entry point of this file, it is called by the
+/// @ref alpaqa::dl::DLProblem class.
+extern "C" SYNTHETIC_PROBLEMS_EXPORT alpaqa_problem_register_t
+register_alpaqa_problem(alpaqa_register_arg_t user_data_v) noexcept try {
+    // Check and convert user arguments
+    if (!user_data_v.data)
+        throw std::invalid_argument("Missing user data");
+    if (user_data_v.type != alpaqa_register_arg_strings)
+        throw std::invalid_argument("Invalid user data type");
+    using param_t    = std::span<std::string_view>;
+    const auto &opts = *reinterpret_cast<param_t *>(user_data_v.data);
+    std::vector<unsigned> used(opts.size());
+    // The name of the registration function is handled by the loader
+    for (size_t i = 0; i < opts.size(); ++i)
+        if (opts[i].starts_with("register="))
+            ++used[i];
+    // Which problem to generate
+    std::string_view generator = "chain";
+    alpaqa::params::set_params(generator, "generator", opts, used);
+    if (generator == "chain")
+        return make_problem<syn::ChainOCP>(opts, used);
+    if (generator == "logreg")
+        return make_problem<syn::LogisticRegression>(opts, used);
+    if (generator == "qp")
+        return make_problem<syn::RandomQP>(opts, used);
+    if (generator == "rosenbrock")
+        return make_problem<syn::ChainedRosenbrock>(opts, used);
+    throw std::invalid_argument(
+        "Unknown generator '" + std::string(generator) +
+        "' (expected 'chain', 'logreg', 'qp' or 'rosenbrock')");
+} catch (...) {
+    return {.exception = new alpaqa_exception_ptr_t{std::current_exception()}};
+}
+
+/// Returns the alpaqa DL ABI version. This version is verified for
+/// compatibility by the @ref alpaqa::dl::DLProblem constructor before
+/// registering the problem.
+extern "C" SYNTHETIC_PROBLEMS_EXPORT alpaqa_dl_abi_version_t
+register_alpaqa_problem_version() {
+    return ALPAQA_DL_ABI_VERSION;
+}
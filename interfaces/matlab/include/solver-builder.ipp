@@ -4,6 +4,7 @@
 #include <alpaqa/inner/directions/panoc/anderson.hpp>
 #include <alpaqa/inner/directions/panoc/lbfgs.hpp>
 #include <alpaqa/inner/directions/panoc/structured-lbfgs.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
 #include <alpaqa/inner/directions/pantr/newton-tr.hpp>
 #include <alpaqa/inner/panoc.hpp>
 #include <alpaqa/inner/pantr.hpp>
@@ -217,6 +218,8 @@ solver_runner_func make_pantr_like_solver(std::string_view direction,
     std::map<std::string_view, solver_builder_func> builders{
         {"newtontr", //
          builder(tag_t<alpaqa::NewtonTRDirection<config_t>>())},
+        {"lsr1tr", //
+         builder(tag_t<alpaqa::LSR1TRDirection<config_t>>())},
     };
     if (direction.empty())
         direction = "newtontr";
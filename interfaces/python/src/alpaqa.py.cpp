@@ -8,6 +8,8 @@ using namespace py::literals;
 
 void register_counters(py::module_ &m);
 void register_enums(py::module_ &m);
+void register_solve_handle(py::module_ &m);
+void register_tracing(py::module_ &m);
 
 template <alpaqa::Config Conf>
 void register_problems(py::module_ &m);
@@ -93,7 +95,13 @@ void register_classes_for(py::module_ &m) {
     register_prox<Conf>(m);
 }
 
+// The module does not rely on the GIL for thread safety, so it supports
+// free-threaded builds of Python (pybind11 2.13 or later).
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(MODULE_NAME, m, py::mod_gil_not_used()) {
+#else
 PYBIND11_MODULE(MODULE_NAME, m) {
+#endif
     m.doc()               = "Python interface to alpaqa's C++ implementation.";
     m.attr("__version__") = ALPAQA_VERSION_FULL;
     m.attr("build_time")  = ALPAQA_BUILD_TIME;
@@ -119,6 +127,8 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 
     register_counters(m);
     register_enums(m);
+    register_solve_handle(m);
+    register_tracing(m);
 
     auto m_double = m.def_submodule("float64", "Double precision");
     register_classes_for<alpaqa::EigenConfigd>(m_double);
@@ -38,6 +38,11 @@ py::dict stats_to_dict(const PANOCStats<Conf> &s) {
         "ε"_a                      = s.ε,
         "elapsed_time"_a           = s.elapsed_time,
         "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_direction_apply"_a   = s.time_direction_apply,
+        "time_direction_update"_a  = s.time_direction_update,
+        "time_linesearch"_a        = s.time_linesearch,
         "iterations"_a             = s.iterations,
         "linesearch_failures"_a    = s.linesearch_failures,
         "linesearch_backtracks"_a  = s.linesearch_backtracks,
@@ -60,6 +65,11 @@ py::dict stats_to_dict(const InnerStatsAccumulator<PANOCStats<Conf>> &s) {
     return py::dict{
         "elapsed_time"_a           = s.elapsed_time,
         "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_direction_apply"_a   = s.time_direction_apply,
+        "time_direction_update"_a  = s.time_direction_update,
+        "time_linesearch"_a        = s.time_linesearch,
         "iterations"_a             = s.iterations,
         "linesearch_failures"_a    = s.linesearch_failures,
         "linesearch_backtracks"_a  = s.linesearch_backtracks,
@@ -84,6 +94,9 @@ py::dict stats_to_dict(const FISTAStats<Conf> &s) {
         "ε"_a                      = s.ε,
         "elapsed_time"_a           = s.elapsed_time,
         "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_linesearch"_a        = s.time_linesearch,
         "iterations"_a             = s.iterations,
         "stepsize_backtracks"_a    = s.stepsize_backtracks,
         "final_γ"_a                = s.final_γ,
@@ -96,10 +109,16 @@ template <Config Conf>
 py::dict stats_to_dict(const InnerStatsAccumulator<FISTAStats<Conf>> &s) {
     using namespace py::literals;
     return py::dict{
-        "elapsed_time"_a = s.elapsed_time, "time_progress_callback"_a = s.time_progress_callback,
-        "iterations"_a = s.iterations,     "stepsize_backtracks"_a = s.stepsize_backtracks,
-        "final_γ"_a = s.final_γ,           "final_ψ"_a = s.final_ψ,
-        "final_h"_a = s.final_h,
+        "elapsed_time"_a           = s.elapsed_time,
+        "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_linesearch"_a        = s.time_linesearch,
+        "iterations"_a             = s.iterations,
+        "stepsize_backtracks"_a    = s.stepsize_backtracks,
+        "final_γ"_a                = s.final_γ,
+        "final_ψ"_a                = s.final_ψ,
+        "final_h"_a                = s.final_h,
     };
 }
 
@@ -209,6 +228,11 @@ py::dict stats_to_dict(const ZeroFPRStats<Conf> &s) {
         "ε"_a                      = s.ε,
         "elapsed_time"_a           = s.elapsed_time,
         "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_direction_apply"_a   = s.time_direction_apply,
+        "time_direction_update"_a  = s.time_direction_update,
+        "time_linesearch"_a        = s.time_linesearch,
         "iterations"_a             = s.iterations,
         "linesearch_failures"_a    = s.linesearch_failures,
         "linesearch_backtracks"_a  = s.linesearch_backtracks,
@@ -232,6 +256,11 @@ py::dict stats_to_dict(const InnerStatsAccumulator<ZeroFPRStats<Conf>> &s) {
         "elapsed_time"_a           = s.elapsed_time,
         "iterations"_a             = s.iterations,
         "time_progress_callback"_a = s.time_progress_callback,
+        "time_evaluations"_a       = s.time_evaluations,
+        "time_prox"_a              = s.time_prox,
+        "time_direction_apply"_a   = s.time_direction_apply,
+        "time_direction_update"_a  = s.time_direction_update,
+        "time_linesearch"_a        = s.time_linesearch,
         "linesearch_failures"_a    = s.linesearch_failures,
         "linesearch_backtracks"_a  = s.linesearch_backtracks,
         "stepsize_backtracks"_a    = s.stepsize_backtracks,
@@ -255,6 +284,10 @@ py::dict stats_to_dict(const PANTRStats<Conf> &s) {
         "ε"_a                         = s.ε,
         "elapsed_time"_a              = s.elapsed_time,
         "time_progress_callback"_a    = s.time_progress_callback,
+        "time_evaluations"_a          = s.time_evaluations,
+        "time_prox"_a                 = s.time_prox,
+        "time_direction_apply"_a      = s.time_direction_apply,
+        "time_direction_update"_a     = s.time_direction_update,
         "iterations"_a                = s.iterations,
         "accelerated_step_rejected"_a = s.accelerated_step_rejected,
         "stepsize_backtracks"_a       = s.stepsize_backtracks,
@@ -273,6 +306,10 @@ py::dict stats_to_dict(const InnerStatsAccumulator<PANTRStats<Conf>> &s) {
     return py::dict{
         "elapsed_time"_a              = s.elapsed_time,
         "time_progress_callback"_a    = s.time_progress_callback,
+        "time_evaluations"_a          = s.time_evaluations,
+        "time_prox"_a                 = s.time_prox,
+        "time_direction_apply"_a      = s.time_direction_apply,
+        "time_direction_update"_a     = s.time_direction_update,
         "iterations"_a                = s.iterations,
         "accelerated_step_rejected"_a = s.accelerated_step_rejected,
         "stepsize_backtracks"_a       = s.stepsize_backtracks,
@@ -295,6 +332,8 @@ py::dict stats_to_dict(const typename ALMSolver<Inner>::Stats &s) {
         "ε"_a                          = s.ε,
         "δ"_a                          = s.δ,
         "norm_penalty"_a               = s.norm_penalty,
+        "accelerated_iterations"_a     = s.accelerated_iterations,
+        "acceleration_rejections"_a    = s.acceleration_rejections,
         "status"_a                     = s.status,
         "inner"_a                      = *s.inner.as_dict,
     };
@@ -1,4 +1,6 @@
 #include <alpaqa/accelerators/lbfgs.hpp>
+#include <alpaqa/accelerators/steihaugcg.hpp>
+#include <alpaqa/inner/directions/panoc/structured-newton.hpp>
 #include <alpaqa/inner/internal/panoc-stop-crit.hpp>
 #include <alpaqa/inner/internal/solverstatus.hpp>
 #include <alpaqa/problem/sparsity.hpp>
@@ -14,6 +16,24 @@ void register_enums(py::module_ &m) {
         .value("BasedOnCurvature", alpaqa::LBFGSStepSize::BasedOnCurvature)
         .export_values();
 
+    using SteihaugCGPreconditioner = alpaqa::SteihaugCGPreconditioner;
+    py::enum_<SteihaugCGPreconditioner>(
+        m, "SteihaugCGPreconditioner",
+        "C++ documentation: :cpp:enum:`alpaqa::SteihaugCGPreconditioner`")
+        .value("None_", SteihaugCGPreconditioner::None)
+        .value("HessianDiagonal", SteihaugCGPreconditioner::HessianDiagonal)
+        .value("JacobianColumnNorms", SteihaugCGPreconditioner::JacobianColumnNorms)
+        .value("LBFGS", SteihaugCGPreconditioner::LBFGS)
+        .value("Custom", SteihaugCGPreconditioner::Custom);
+
+    using StructuredNewtonRegularization = alpaqa::StructuredNewtonRegularization;
+    py::enum_<StructuredNewtonRegularization>(
+        m, "StructuredNewtonRegularization",
+        "C++ documentation: :cpp:enum:`alpaqa::StructuredNewtonRegularization`")
+        .value("EigenvalueClipping", StructuredNewtonRegularization::EigenvalueClipping)
+        .value("ShiftedCholesky", StructuredNewtonRegularization::ShiftedCholesky)
+        .value("ModifiedLDLT", StructuredNewtonRegularization::ModifiedLDLT);
+
     py::enum_<alpaqa::sparsity::Symmetry>(
         m, "Symmetry", "C++ documentation: :cpp:enum:`alpaqa::sparsity::Symmetry`")
         .value("Unsymmetric", alpaqa::sparsity::Symmetry::Unsymmetric)
@@ -13,6 +13,38 @@ using namespace py::literals;
 
 #include <dict/stats-to-dict.hpp>
 #include <inner/type-erased-inner-solver.hpp>
+#include <util/async.hpp>
+#include <util/progress-callback.hpp>
+
+#include <memory>
+#include <optional>
+
+/// Checks the sizes and presence of the arguments of an inner solver.
+/// @return Whether the multipliers and constraint violation should be returned.
+template <class Problem, class Vec>
+bool check_inner_solve_args(const Problem &problem, std::optional<Vec> &x, std::optional<Vec> &y,
+                            std::optional<Vec> &Σ) {
+    alpaqa::util::check_dim_msg<Vec>(x, problem.get_n(),
+                                     "Length of x does not match problem size problem.n");
+    bool ret_y = y.has_value();
+    if (!y && problem.get_m() > 0)
+        throw std::invalid_argument("Missing argument y");
+    alpaqa::util::check_dim_msg<Vec>(y, problem.get_m(),
+                                     "Length of y does not match problem size problem.m");
+    if (!Σ && problem.get_m() > 0)
+        throw std::invalid_argument("Missing argument Σ");
+    alpaqa::util::check_dim_msg<Vec>(Σ, problem.get_m(),
+                                     "Length of Σ does not match problem size problem.m");
+    return ret_y;
+}
+
+/// Packs the results of an inner solver in a Python tuple.
+template <class Vec, class Stats>
+py::tuple inner_solve_result(bool ret_y, Vec x, Vec y, Vec err_z, Stats &stats) {
+    return ret_y ? py::make_tuple(std::move(x), std::move(y), std::move(err_z),
+                                  alpaqa::conv::stats_to_dict(stats))
+                 : py::make_tuple(std::move(x), alpaqa::conv::stats_to_dict(stats));
+}
 
 /// Python interface to the inner solvers, checks the argument sizes and
 /// presence, and returns a Python tuple.
@@ -22,23 +54,50 @@ auto checked_inner_solve() {
     return [](Solver &solver, const Problem &problem,
               const alpaqa::InnerSolveOptions<config_t> &opts, std::optional<vec> x,
               std::optional<vec> y, std::optional<vec> Σ, bool async, bool suppress_interrupt) {
-        alpaqa::util::check_dim_msg<vec>(x, problem.get_n(),
-                                         "Length of x does not match problem size problem.n");
-        bool ret_y = y.has_value();
-        if (!y && problem.get_m() > 0)
-            throw std::invalid_argument("Missing argument y");
-        alpaqa::util::check_dim_msg<vec>(y, problem.get_m(),
-                                         "Length of y does not match problem size problem.m");
-        if (!Σ && problem.get_m() > 0)
-            throw std::invalid_argument("Missing argument Σ");
-        alpaqa::util::check_dim_msg<vec>(Σ, problem.get_m(),
-                                         "Length of Σ does not match problem size problem.m");
+        bool ret_y         = check_inner_solve_args(problem, x, y, Σ);
         vec err_z          = vec::Zero(problem.get_m());
         auto invoke_solver = [&] { return solver(problem, opts, *x, *y, *Σ, err_z); };
         auto &&stats       = async_solve(async, suppress_interrupt, solver, invoke_solver, problem);
-        return ret_y ? py::make_tuple(std::move(*x), std::move(*y), std::move(err_z),
-                                      alpaqa::conv::stats_to_dict(stats))
-                     : py::make_tuple(std::move(*x), alpaqa::conv::stats_to_dict(stats));
+        return inner_solve_result(ret_y, std::move(*x), std::move(*y), std::move(err_z), stats);
+    };
+}
+
+/// Python interface to the inner solvers' `submit` method: same as
+/// @ref checked_inner_solve, but returns a @ref SolveHandle immediately,
+/// without waiting for the solver to finish.
+template <class Solver, class Problem>
+auto checked_inner_submit() {
+    USING_ALPAQA_CONFIG_TEMPLATE(Solver::config_t);
+    return [](py::object solver_obj, py::object problem_obj,
+              const alpaqa::InnerSolveOptions<config_t> &opts, std::optional<vec> x,
+              std::optional<vec> y, std::optional<vec> Σ, bool suppress_interrupt) {
+        // Implicit conversions to the type-erased problem create a temporary,
+        // which the handle has to keep alive
+        if (!py::isinstance<Problem>(problem_obj))
+            problem_obj = py::cast(py::cast<Problem>(problem_obj));
+        auto &solver        = py::cast<Solver &>(solver_obj);
+        const auto &problem = py::cast<const Problem &>(problem_obj);
+        bool ret_y          = check_inner_solve_args(problem, x, y, Σ);
+        struct Args {
+            alpaqa::InnerSolveOptions<config_t> opts;
+            vec x, y, Σ, err_z;
+        };
+        auto args = std::make_shared<Args>(Args{
+            .opts  = opts,
+            .x     = std::move(*x),
+            .y     = std::move(*y),
+            .Σ     = std::move(*Σ),
+            .err_z = vec::Zero(problem.get_m()),
+        });
+        auto invoke_solver = [&solver, &problem, args] {
+            return solver(problem, args->opts, args->x, args->y, args->Σ, args->err_z);
+        };
+        auto make_result = [ret_y, args](auto &&stats) -> py::object {
+            return inner_solve_result(ret_y, std::move(args->x), std::move(args->y),
+                                      std::move(args->err_z), stats);
+        };
+        return async_submit(suppress_interrupt, py::make_tuple(solver_obj, problem_obj), solver,
+                            std::move(invoke_solver), std::move(make_result), problem);
     };
 }
 
@@ -60,18 +119,28 @@ inline const char *checked_inner_solve_doc() {
            "         * Statistics\n\n";
 }
 
+inline const char *checked_inner_submit_doc() {
+    return "Start solving the given problem in the background, and return immediately.\n\n"
+           "The arguments are the same as for :py:meth:`__call__`. The solver and the problem "
+           "cannot be used by other threads until the result has been retrieved.\n\n"
+           ":return: A :py:class:`alpaqa.SolveHandle`, whose ``result()`` method returns the "
+           "same values as :py:meth:`__call__`.\n\n";
+}
+
 template <class Solver, class Problem, class InnerSolverType>
 void register_inner_solver_methods(py::class_<Solver> &cls) {
     cls.def("__call__", checked_inner_solve<Solver, Problem>(), "problem"_a, "opts"_a = py::dict(),
             "x"_a = py::none(), "y"_a = py::none(), "Σ"_a = py::none(), py::kw_only{},
             "asynchronous"_a = true, "suppress_interrupt"_a = false, checked_inner_solve_doc())
+        .def("submit", checked_inner_submit<Solver, Problem>(), "problem"_a,
+             "opts"_a = py::dict(), "x"_a = py::none(), "y"_a = py::none(), "Σ"_a = py::none(),
+             py::kw_only{}, "suppress_interrupt"_a = false, checked_inner_submit_doc())
         .def_property_readonly("name", &Solver::get_name)
         .def("stop", &Solver::stop)
         .def("__str__", &Solver::get_name);
     if constexpr (requires { &Solver::set_progress_callback; })
-        cls.def(
-            "set_progress_callback", &Solver::set_progress_callback, "callback"_a,
-            "Specify a callable that is invoked with some intermediate results on each iteration "
-            "of the algorithm.");
+        cls.def("set_progress_callback", set_throttled_progress_callback<Solver>(), "callback"_a,
+                py::kw_only{}, "every"_a = 1, "min_interval"_a = py::none(),
+                set_throttled_progress_callback_doc());
     inner_solver_class<InnerSolverType>.template implicitly_convertible_to<Solver>();
 }
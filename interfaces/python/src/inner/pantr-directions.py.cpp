@@ -8,6 +8,7 @@
 namespace py = pybind11;
 using namespace py::literals;
 
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
 #include <alpaqa/inner/directions/pantr/newton-tr.hpp>
 
 #include <dict/stats-to-dict.hpp>
@@ -55,6 +56,36 @@ void register_pantr_directions(py::module_ &m) {
         "direction"_a, "Explicit conversion.");
     py::implicitly_convertible<NewtonTRDir, TypeErasedTRDirection>();
 
+    // ----------------------------------------------------------------------------------------- //
+    using LSR1Params = alpaqa::LSR1Params<config_t>;
+    register_dataclass<LSR1Params>(m, "LSR1Params",
+                                   "C++ documentation: :cpp:class:`alpaqa::LSR1Params`");
+
+    using LSR1TRDirParams = alpaqa::LSR1TRDirectionParams<config_t>;
+    register_dataclass<LSR1TRDirParams>(
+        m, "LSR1TRDirectionParams",
+        "C++ documentation: :cpp:class:`alpaqa::LSR1TRDirectionParams`");
+
+    using LSR1TRDir = alpaqa::LSR1TRDirection<config_t>;
+    py::class_<LSR1TRDir> lsr1_dir(m, "LSR1TRDirection",
+                                   "C++ documentation: :cpp:class:`alpaqa::LSR1TRDirection`");
+    lsr1_dir //
+        .def(py::init([](params_or_dict<LSR1Params> accelerator_params,
+                         params_or_dict<LSR1TRDirParams> direction_params) {
+                 return LSR1TRDir{var_kwargs_to_struct(accelerator_params),
+                                  var_kwargs_to_struct(direction_params)};
+             }),
+             "accelerator_params"_a = py::dict{}, "direction_params"_a = py::dict{})
+        .def_property_readonly(
+            "params",
+            py::cpp_function(&LSR1TRDir::get_params, py::return_value_policy::reference_internal))
+        .def("__str__", &LSR1TRDir::get_name);
+
+    te_direction.def(
+        py::init(&alpaqa::erase_tr_direction_with_params_dict<LSR1TRDir, const LSR1TRDir &>),
+        "direction"_a, "Explicit conversion.");
+    py::implicitly_convertible<LSR1TRDir, TypeErasedTRDirection>();
+
     // ----------------------------------------------------------------------------------------- //
     // Catch-all, must be last
     te_direction //
@@ -106,6 +106,37 @@ void register_alm(py::module_ &m) {
              ":return: * Solution :math:`x`\n"
              "         * Lagrange multipliers :math:`y` at the solution\n"
              "         * Statistics\n\n")
+        .def(
+            "submit",
+            [](py::object self, py::object problem, std::optional<vec> x, std::optional<vec> y,
+               bool suppress_interrupt) {
+                // Implicit conversions to the type-erased problems create
+                // temporaries, which the handle has to keep alive
+                if (!py::isinstance<TEProblem>(problem)) {
+#if ALPAQA_WITH_OCP
+                    if (!py::isinstance<TEOCProblem>(problem)) {
+                        try {
+                            problem = py::cast(py::cast<TEProblem>(problem));
+                        } catch (py::cast_error &) {
+                            problem = py::cast(py::cast<TEOCProblem>(problem));
+                        }
+                    }
+#else
+                    problem = py::cast(py::cast<TEProblem>(problem));
+#endif
+                }
+                auto p = py::cast<typename TEALMSolver::Problem>(problem);
+                return py::cast<TEALMSolver &>(self).submit(
+                    p, py::make_tuple(self, problem), std::move(x), std::move(y),
+                    suppress_interrupt);
+            },
+            "problem"_a, "x"_a = std::nullopt, "y"_a = std::nullopt, py::kw_only{},
+            "suppress_interrupt"_a = false,
+            "Start solving the given problem in the background, and return immediately.\n\n"
+            "The arguments are the same as for :py:meth:`__call__`. The solver and the problem "
+            "cannot be used by other threads until the result has been retrieved.\n\n"
+            ":return: A :py:class:`alpaqa.SolveHandle`, whose ``result()`` method returns the "
+            "same values as :py:meth:`__call__`.\n\n")
         .def("stop", &TEALMSolver::stop)
         .def_property_readonly("name", &TEALMSolver::get_name)
         .def("__str__", &TEALMSolver::get_name)
@@ -7,6 +7,7 @@
 #include <alpaqa/problem/type-erased-problem.hpp>
 #include <alpaqa/util/demangled-typename.hpp>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <variant>
@@ -45,6 +46,8 @@ struct ALMSolverVTable : util::BasicVTable {
     // clang-format off
     required_function_t<py::tuple(const Problem &, std::optional<vec> x, std::optional<vec> y, bool async, bool suppress_interrupt)>
         call = nullptr;
+    required_function_t<SolveHandle(const Problem &, py::object keep_alive, std::optional<vec> x, std::optional<vec> y, bool suppress_interrupt)>
+        submit = nullptr;
     required_function_t<void()>
         stop = nullptr;
     required_function_t<std::string() const>
@@ -80,6 +83,20 @@ struct ALMSolverVTable : util::BasicVTable {
             };
             return std::visit(call_solver, p);
         };
+        submit = [](void *self_, const Problem &p, py::object keep_alive, std::optional<vec> x,
+                    std::optional<vec> y, bool suppress_interrupt) {
+            auto &self         = *std::launder(reinterpret_cast<T *>(self_));
+            auto submit_solver = [&]<class P>(const P *p) -> SolveHandle {
+                if constexpr (!std::is_same_v<P, typename T::Problem>)
+                    throw std::invalid_argument("Unsupported problem type (expected '" +
+                                                demangled_typename(typeid(typename T::Problem)) +
+                                                "', got '" + demangled_typename(typeid(P)) + "')");
+                else
+                    return safe_submit_solver(self, p, std::move(keep_alive), x, y,
+                                              suppress_interrupt);
+            };
+            return std::visit(submit_solver, p);
+        };
     }
     ALMSolverVTable() = default;
 
@@ -97,6 +114,28 @@ struct ALMSolverVTable : util::BasicVTable {
         return py::make_tuple(std::move(*x), std::move(*y),
                               alpaqa::conv::stats_to_dict<InnerSolver>(std::move(stats)));
     }
+
+    template <class T>
+    static SolveHandle safe_submit_solver(T &self, const auto &p, py::object keep_alive,
+                                          std::optional<vec> &x, std::optional<vec> &y,
+                                          bool suppress_interrupt) {
+        using InnerSolver = typename T::InnerSolver;
+        alpaqa::util::check_dim_msg<vec>(x, p->get_n(),
+                                         "Length of x does not match problem size problem.n");
+        alpaqa::util::check_dim_msg<vec>(y, p->get_m(),
+                                         "Length of y does not match problem size problem.m");
+        struct Args {
+            vec x, y;
+        };
+        auto args          = std::make_shared<Args>(Args{std::move(*x), std::move(*y)});
+        auto invoke_solver = [&self, p, args] { return self(*p, args->x, args->y); };
+        auto make_result   = [args](auto &&stats) -> py::object {
+            return py::make_tuple(std::move(args->x), std::move(args->y),
+                                  alpaqa::conv::stats_to_dict<InnerSolver>(std::move(stats)));
+        };
+        return async_submit(suppress_interrupt, std::move(keep_alive), self,
+                            std::move(invoke_solver), std::move(make_result), *p);
+    }
 };
 
 template <Config Conf = DefaultConfig, class Allocator = std::allocator<std::byte>>
@@ -125,6 +164,10 @@ class TypeErasedALMSolver : public util::TypeErased<ALMSolverVTable<Conf>, Alloc
                               bool async, bool suppress_interrupt) {
         return call(vtable.call, p, x, y, async, suppress_interrupt);
     }
+    decltype(auto) submit(const Problem &p, py::object keep_alive, std::optional<vec> x,
+                          std::optional<vec> y, bool suppress_interrupt) {
+        return call(vtable.submit, p, std::move(keep_alive), x, y, suppress_interrupt);
+    }
     decltype(auto) stop() { return call(vtable.stop); }
     decltype(auto) get_name() const { return call(vtable.get_name); }
     decltype(auto) get_params() const { return call(vtable.get_params); }
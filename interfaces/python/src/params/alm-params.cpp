@@ -18,6 +18,7 @@ PARAMS_TABLE_DEF(alpaqa::ALMParams<Conf>,                       //
                  PARAMS_MEMBER(print_interval),                 //
                  PARAMS_MEMBER(print_precision),                //
                  PARAMS_MEMBER(single_penalty_factor),          //
+                 PARAMS_MEMBER(anderson_memory),                //
 );
 
 PARAMS_TABLE_INST(alpaqa::ALMParams<alpaqa::EigenConfigd>);
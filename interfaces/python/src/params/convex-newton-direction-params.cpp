@@ -10,6 +10,9 @@ template <alpaqa::Config Conf>
 PARAMS_TABLE_DEF(alpaqa::ConvexNewtonDirectionParams<Conf>, //
                  PARAMS_MEMBER(hessian_vec_factor),         //
                  PARAMS_MEMBER(quadratic),                  //
+                 PARAMS_MEMBER(update_factorization),       //
+                 PARAMS_MEMBER(max_update_fraction),        //
+                 PARAMS_MEMBER(regularization_tolerance),   //
 );
 
 // clang-format off
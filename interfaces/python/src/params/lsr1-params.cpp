@@ -0,0 +1,13 @@
+#include "lsr1-params.hpp"
+
+template <alpaqa::Config Conf>
+PARAMS_TABLE_DEF(alpaqa::LSR1Params<Conf>, //
+                 PARAMS_MEMBER(memory),    //
+                 PARAMS_MEMBER(min_abs_s), //
+                 PARAMS_MEMBER(min_rcond), //
+);
+
+PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigd>);
+ALPAQA_IF_FLOAT(PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigf>);)
+ALPAQA_IF_LONGD(PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigl>);)
+ALPAQA_IF_QUADF(PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigq>);)
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <alpaqa/accelerators/lsr1.hpp>
+#include <dict/kwargs-to-struct.hpp>
+
+template <alpaqa::Config Conf>
+PARAMS_TABLE_DECL(alpaqa::LSR1Params<Conf>);
+
+extern PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigd>);
+ALPAQA_IF_FLOAT(extern PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigf>);)
+ALPAQA_IF_LONGD(extern PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigl>);)
+ALPAQA_IF_QUADF(extern PARAMS_TABLE_INST(alpaqa::LSR1Params<alpaqa::EigenConfigq>);)
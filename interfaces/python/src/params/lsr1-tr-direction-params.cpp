@@ -0,0 +1,11 @@
+#include "lsr1-tr-direction-params.hpp"
+
+template <alpaqa::Config Conf>
+PARAMS_TABLE_DEF(alpaqa::LSR1TRDirectionParams<Conf>, //
+                 PARAMS_MEMBER(hessian_vec_factor),   //
+);
+
+PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigd>);
+ALPAQA_IF_FLOAT(PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigf>);)
+ALPAQA_IF_LONGD(PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigl>);)
+ALPAQA_IF_QUADF(PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigq>);)
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
+#include <params/params.hpp>
+
+template <alpaqa::Config Conf>
+PARAMS_TABLE_DECL(alpaqa::LSR1TRDirectionParams<Conf>);
+
+extern PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigd>);
+ALPAQA_IF_FLOAT(extern PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigf>);)
+ALPAQA_IF_LONGD(extern PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigl>);)
+ALPAQA_IF_QUADF(extern PARAMS_TABLE_INST(alpaqa::LSR1TRDirectionParams<alpaqa::EigenConfigq>);)
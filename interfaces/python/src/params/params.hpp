@@ -6,6 +6,8 @@
 #include "inner-solve-options.hpp"
 #include "lbfgs-direction-params.hpp"
 #include "lbfgs-params.hpp"
+#include "lsr1-params.hpp"
+#include "lsr1-tr-direction-params.hpp"
 #include "newton-tr-direction-params.hpp"
 #include "panoc-params.hpp"
 #include "fista-params.hpp"
@@ -1,11 +1,14 @@
 #include "steihaug-params.hpp"
 
 template <alpaqa::Config Conf>
-PARAMS_TABLE_DEF(alpaqa::SteihaugCGParams<Conf>, //
-                 PARAMS_MEMBER(tol_scale),       //
-                 PARAMS_MEMBER(tol_scale_root),  //
-                 PARAMS_MEMBER(tol_max),         //
-                 PARAMS_MEMBER(max_iter_factor), //
+PARAMS_TABLE_DEF(alpaqa::SteihaugCGParams<Conf>,  //
+                 PARAMS_MEMBER(tol_scale),        //
+                 PARAMS_MEMBER(tol_scale_root),   //
+                 PARAMS_MEMBER(tol_max),          //
+                 PARAMS_MEMBER(max_iter_factor),  //
+                 PARAMS_MEMBER(preconditioner),   //
+                 PARAMS_MEMBER(precond_min_diag), //
+                 PARAMS_MEMBER(precond_memory),   //
 );
 
 PARAMS_TABLE_INST(alpaqa::SteihaugCGParams<alpaqa::EigenConfigd>);
@@ -2,6 +2,7 @@
 
 template <alpaqa::Config Conf>
 PARAMS_TABLE_DEF(alpaqa::StructuredNewtonRegularizationParams<Conf>, //
+                 PARAMS_MEMBER(method),                              //
                  PARAMS_MEMBER(min_eig),                             //
                  PARAMS_MEMBER(print_eig),                           //
 );
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <pybind11/pybind11.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace py = pybind11;
+
+/// Native function pointers that implement the problem functions of a
+/// problem class defined in Python. They are called directly, without
+/// acquiring the GIL or converting arguments to NumPy arrays.
+///
+/// The signatures are the same as the ones in
+/// @ref alpaqa_problem_functions_t, i.e. a user-provided `void *instance`
+/// pointer, followed by pointers to contiguous arrays of `real_t` for the
+/// vector arguments. For example:
+///
+///     real_t eval_f(void *instance, const real_t *x);
+///     void eval_grad_f(void *instance, const real_t *x, real_t *grad_fx);
+///
+/// The Python problem provides these as a `native_functions` attribute, a
+/// dict that maps the function names to their addresses. Addresses can be
+/// integers, Numba `cfunc` objects, or ctypes function pointers. The optional
+/// `"instance"` entry is passed as the first argument to all functions.
+/// Functions that are not listed fall back to the corresponding Python
+/// methods.
+template <alpaqa::Config Conf>
+struct PyNativeFunctions {
+    USING_ALPAQA_CONFIG(Conf);
+
+    void *instance = nullptr;
+    // clang-format off
+    void (*eval_proj_diff_g)(void *, const real_t *z, real_t *e) = nullptr;
+    void (*eval_proj_multipliers)(void *, real_t *y, real_t M) = nullptr;
+    real_t (*eval_prox_grad_step)(void *, real_t γ, const real_t *x, const real_t *grad_ψ, real_t *x̂, real_t *p) = nullptr;
+    index_t (*eval_inactive_indices_res_lna)(void *, real_t γ, const real_t *x, const real_t *grad_ψ, index_t *J) = nullptr;
+    real_t (*eval_f)(void *, const real_t *x) = nullptr;
+    void (*eval_grad_f)(void *, const real_t *x, real_t *grad_fx) = nullptr;
+    void (*eval_g)(void *, const real_t *x, real_t *gx) = nullptr;
+    void (*eval_grad_g_prod)(void *, const real_t *x, const real_t *y, real_t *grad_gxy) = nullptr;
+    void (*eval_grad_gi)(void *, const real_t *x, index_t i, real_t *grad_gi) = nullptr;
+    void (*eval_hess_L_prod)(void *, const real_t *x, const real_t *y, real_t scale, const real_t *v, real_t *Hv) = nullptr;
+    real_t (*eval_f_grad_f)(void *, const real_t *x, real_t *grad_fx) = nullptr;
+    real_t (*eval_f_g)(void *, const real_t *x, real_t *g) = nullptr;
+    void (*eval_grad_f_grad_g_prod)(void *, const real_t *x, const real_t *y, real_t *grad_f, real_t *grad_gxy) = nullptr;
+    void (*eval_grad_L)(void *, const real_t *x, const real_t *y, real_t *grad_L, real_t *work_n) = nullptr;
+    // clang-format on
+
+    /// Keeps the Python objects that own the native functions alive.
+    py::object owner;
+
+    /// Load the native functions from the `native_functions` attribute of the
+    /// given Python problem object (if any). Requires the GIL.
+    void load(py::handle problem) {
+        auto funcs = py::getattr(problem, "native_functions", py::none());
+        if (funcs.is_none())
+            return;
+        if (!py::isinstance<py::dict>(funcs))
+            throw std::invalid_argument("native_functions should be a dict");
+        auto dict = py::reinterpret_borrow<py::dict>(funcs);
+        for (auto item : dict)
+            if (auto name = py::cast<std::string>(py::str(item.first)); !known(name))
+                throw std::invalid_argument("Unknown native function: " + name);
+        auto set = [&](const char *name, auto &func) {
+            if (!dict.contains(name))
+                return;
+            py::object f = dict[name];
+            using F      = std::remove_reference_t<decltype(func)>;
+            func         = reinterpret_cast<F>(address(f, name));
+        };
+        if (dict.contains("instance")) {
+            py::object inst = dict["instance"];
+            instance        = reinterpret_cast<void *>(address(inst, "instance"));
+        }
+        set("eval_proj_diff_g", eval_proj_diff_g);
+        set("eval_proj_multipliers", eval_proj_multipliers);
+        set("eval_prox_grad_step", eval_prox_grad_step);
+        set("eval_inactive_indices_res_lna", eval_inactive_indices_res_lna);
+        set("eval_f", eval_f);
+        set("eval_grad_f", eval_grad_f);
+        set("eval_g", eval_g);
+        set("eval_grad_g_prod", eval_grad_g_prod);
+        set("eval_grad_gi", eval_grad_gi);
+        set("eval_hess_L_prod", eval_hess_L_prod);
+        set("eval_f_grad_f", eval_f_grad_f);
+        set("eval_f_g", eval_f_g);
+        set("eval_grad_f_grad_g_prod", eval_grad_f_grad_g_prod);
+        set("eval_grad_L", eval_grad_L);
+        owner = std::move(dict);
+    }
+
+  private:
+    /// Get the address of a native function from an integer, a Numba `cfunc`,
+    /// or a ctypes function pointer.
+    static std::uintptr_t address(py::handle f, const char *name) {
+        if (py::isinstance<py::int_>(f))
+            return py::cast<std::uintptr_t>(f);
+        if (py::hasattr(f, "address")) // Numba cfunc
+            return py::cast<std::uintptr_t>(f.attr("address"));
+        auto ctypes = py::module_::import("ctypes");
+        if (py::isinstance(f, ctypes.attr("_CFuncPtr")) ||
+            py::isinstance(f, ctypes.attr("c_void_p"))) {
+            py::object addr = ctypes.attr("cast")(f, ctypes.attr("c_void_p")).attr("value");
+            return addr.is_none() ? 0 : py::cast<std::uintptr_t>(addr);
+        }
+        throw std::invalid_argument("Unsupported type for native function " + std::string(name) +
+                                    ": expected int, Numba cfunc or ctypes function pointer");
+    }
+
+    static bool known(const std::string &k) {
+        for (const char *name : {
+                 "instance",
+                 "eval_proj_diff_g",
+                 "eval_proj_multipliers",
+                 "eval_prox_grad_step",
+                 "eval_inactive_indices_res_lna",
+                 "eval_f",
+                 "eval_grad_f",
+                 "eval_g",
+                 "eval_grad_g_prod",
+                 "eval_grad_gi",
+                 "eval_hess_L_prod",
+                 "eval_f_grad_f",
+                 "eval_f_g",
+                 "eval_grad_f_grad_g_prod",
+                 "eval_grad_L",
+             })
+            if (k == name)
+                return true;
+        return false;
+    }
+};
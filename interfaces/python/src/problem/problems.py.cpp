@@ -36,6 +36,7 @@ template struct ALPAQA_PYTHON_EXPORT
     alpaqa::detail::function_wrapper_t<py::object(void *, py::args, py::kwargs)>;
 #endif
 
+#include <problem/native-functions.hpp>
 #include <util/copy.hpp>
 #include <util/member.hpp>
 
@@ -462,27 +463,28 @@ void register_problems(py::module_ &m) {
     struct PyProblem {
         USING_ALPAQA_CONFIG(Conf);
         py::object o;
+        PyNativeFunctions<config_t> native;
 
-        PyProblem(py::object o) : o{std::move(o)} {}
+        PyProblem(py::object o) : o{std::move(o)} { native.load(this->o); }
 
         // clang-format off
-        void eval_proj_diff_g(crvec z, rvec e) const { py::gil_scoped_acquire gil; o.attr("eval_proj_diff_g")(z, e); }
-        void eval_proj_multipliers(rvec y, real_t M) const { py::gil_scoped_acquire gil; o.attr("eval_proj_multipliers")(y, M); }
-        real_t eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂, rvec p) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_prox_grad_step")(γ, x, grad_ψ, x̂, p)); }
-        index_t eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ, rindexvec J) const { py::gil_scoped_acquire gil; return py::cast<index_t>(o.attr("eval_inactive_indices_res_lna")(γ, x, grad_ψ, J)); }
-        real_t eval_f(crvec x) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f")(x)); }
-        void eval_grad_f(crvec x, rvec grad_fx) const { py::gil_scoped_acquire gil; o.attr("eval_grad_f")(x, grad_fx); }
-        void eval_g(crvec x, rvec gx) const { py::gil_scoped_acquire gil; o.attr("eval_g")(x, gx); }
-        void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const { py::gil_scoped_acquire gil; o.attr("eval_grad_g_prod")(x, y, grad_gxy); }
-        void eval_grad_gi(crvec x, index_t i, rvec grad_gi) const { py::gil_scoped_acquire gil; o.attr("eval_grad_gi")(x, i, grad_gi); }
-        void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v, rvec Hv) const { py::gil_scoped_acquire gil; o.attr("eval_hess_L_prod")(x, y, scale, v, Hv); }
+        void eval_proj_diff_g(crvec z, rvec e) const { if (native.eval_proj_diff_g) return native.eval_proj_diff_g(native.instance, z.data(), e.data()); py::gil_scoped_acquire gil; o.attr("eval_proj_diff_g")(z, e); }
+        void eval_proj_multipliers(rvec y, real_t M) const { if (native.eval_proj_multipliers) return native.eval_proj_multipliers(native.instance, y.data(), M); py::gil_scoped_acquire gil; o.attr("eval_proj_multipliers")(y, M); }
+        real_t eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂, rvec p) const { if (native.eval_prox_grad_step) return native.eval_prox_grad_step(native.instance, γ, x.data(), grad_ψ.data(), x̂.data(), p.data()); py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_prox_grad_step")(γ, x, grad_ψ, x̂, p)); }
+        index_t eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ, rindexvec J) const { if (native.eval_inactive_indices_res_lna) return native.eval_inactive_indices_res_lna(native.instance, γ, x.data(), grad_ψ.data(), J.data()); py::gil_scoped_acquire gil; return py::cast<index_t>(o.attr("eval_inactive_indices_res_lna")(γ, x, grad_ψ, J)); }
+        real_t eval_f(crvec x) const { if (native.eval_f) return native.eval_f(native.instance, x.data()); py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f")(x)); }
+        void eval_grad_f(crvec x, rvec grad_fx) const { if (native.eval_grad_f) return native.eval_grad_f(native.instance, x.data(), grad_fx.data()); py::gil_scoped_acquire gil; o.attr("eval_grad_f")(x, grad_fx); }
+        void eval_g(crvec x, rvec gx) const { if (native.eval_g) return native.eval_g(native.instance, x.data(), gx.data()); py::gil_scoped_acquire gil; o.attr("eval_g")(x, gx); }
+        void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const { if (native.eval_grad_g_prod) return native.eval_grad_g_prod(native.instance, x.data(), y.data(), grad_gxy.data()); py::gil_scoped_acquire gil; o.attr("eval_grad_g_prod")(x, y, grad_gxy); }
+        void eval_grad_gi(crvec x, index_t i, rvec grad_gi) const { if (native.eval_grad_gi) return native.eval_grad_gi(native.instance, x.data(), i, grad_gi.data()); py::gil_scoped_acquire gil; o.attr("eval_grad_gi")(x, i, grad_gi); }
+        void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v, rvec Hv) const { if (native.eval_hess_L_prod) return native.eval_hess_L_prod(native.instance, x.data(), y.data(), scale, v.data(), Hv.data()); py::gil_scoped_acquire gil; o.attr("eval_hess_L_prod")(x, y, scale, v, Hv); }
         // void eval_hess_L(crvec x, crvec y, rmat H) const { py::gil_scoped_acquire gil; o.attr("eval_hess_L")(x, y, H); } // TODO
         void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v, rvec Hv) const { py::gil_scoped_acquire gil; o.attr("eval_hess_ψ_prod")(x, y, Σ, scale, v, Hv); }
         // void eval_hess_ψ(crvec x, crvec y, crvec Σ, rmat H) const { py::gil_scoped_acquire gil; o.attr("eval_hess_ψ")(x, y, Σ, H); } // TODO
-        real_t eval_f_grad_f(crvec x, rvec grad_fx) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f_grad_f")(x, grad_fx)); }
-        real_t eval_f_g(crvec x, rvec g) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f_g")(x, g)); }
-        void eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f, rvec grad_gxy) const { py::gil_scoped_acquire gil; o.attr("eval_grad_f_grad_g_prod")(x, y, grad_f, grad_gxy); }
-        void eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const { py::gil_scoped_acquire gil; o.attr("eval_grad_L")(x, y, grad_L, work_n); }
+        real_t eval_f_grad_f(crvec x, rvec grad_fx) const { if (native.eval_f_grad_f) return native.eval_f_grad_f(native.instance, x.data(), grad_fx.data()); py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f_grad_f")(x, grad_fx)); }
+        real_t eval_f_g(crvec x, rvec g) const { if (native.eval_f_g) return native.eval_f_g(native.instance, x.data(), g.data()); py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_f_g")(x, g)); }
+        void eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f, rvec grad_gxy) const { if (native.eval_grad_f_grad_g_prod) return native.eval_grad_f_grad_g_prod(native.instance, x.data(), y.data(), grad_f.data(), grad_gxy.data()); py::gil_scoped_acquire gil; o.attr("eval_grad_f_grad_g_prod")(x, y, grad_f, grad_gxy); }
+        void eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const { if (native.eval_grad_L) return native.eval_grad_L(native.instance, x.data(), y.data(), grad_L.data(), work_n.data()); py::gil_scoped_acquire gil; o.attr("eval_grad_L")(x, y, grad_L, work_n); }
         real_t eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_ψ")(x, y, Σ, ŷ)); }
         void eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const { py::gil_scoped_acquire gil; o.attr("eval_grad_ψ")(x, y, Σ, grad_ψ, work_n, work_m); }
         real_t eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const { py::gil_scoped_acquire gil; return py::cast<real_t>(o.attr("eval_ψ_grad_ψ")(x, y, Σ, grad_ψ, work_n, work_m)); }
@@ -491,16 +493,16 @@ void register_problems(py::module_ &m) {
         const Box &get_box_C() const { py::gil_scoped_acquire gil; alpaqa::ScopedMallocAllower ma; C = py::cast<Box>(o.attr("get_box_C")()); return C; }
         const Box &get_box_D() const { py::gil_scoped_acquire gil; alpaqa::ScopedMallocAllower ma; D = py::cast<Box>(o.attr("get_box_D")()); return D; }
 
-        [[nodiscard]] bool provides_eval_inactive_indices_res_lna() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_inactive_indices_res_lna") && (!py::hasattr(o, "provides_eval_inactive_indices_res_lna") || py::cast<bool>(o.attr("provides_eval_inactive_indices_res_lna")())); }
-        [[nodiscard]] bool provides_eval_grad_gi() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_gi") && (!py::hasattr(o, "provides_eval_grad_gi") || py::cast<bool>(o.attr("provides_eval_grad_gi")())); }
-        [[nodiscard]] bool provides_eval_hess_L_prod() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_hess_L_prod") && (!py::hasattr(o, "provides_eval_hess_L_prod") || py::cast<bool>(o.attr("provides_eval_hess_L_prod")())); }
+        [[nodiscard]] bool provides_eval_inactive_indices_res_lna() const { if (native.eval_inactive_indices_res_lna) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_inactive_indices_res_lna") && (!py::hasattr(o, "provides_eval_inactive_indices_res_lna") || py::cast<bool>(o.attr("provides_eval_inactive_indices_res_lna")())); }
+        [[nodiscard]] bool provides_eval_grad_gi() const { if (native.eval_grad_gi) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_gi") && (!py::hasattr(o, "provides_eval_grad_gi") || py::cast<bool>(o.attr("provides_eval_grad_gi")())); }
+        [[nodiscard]] bool provides_eval_hess_L_prod() const { if (native.eval_hess_L_prod) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_hess_L_prod") && (!py::hasattr(o, "provides_eval_hess_L_prod") || py::cast<bool>(o.attr("provides_eval_hess_L_prod")())); }
         // [[nodiscard]] bool provides_eval_hess_L() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_hess_L") && (!py::hasattr(o, "provides_eval_hess_L") || py::cast<bool>(o.attr("provides_eval_hess_L")())); }
         [[nodiscard]] bool provides_eval_hess_ψ_prod() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_hess_ψ_prod") && (!py::hasattr(o, "provides_eval_hess_ψ_prod") || py::cast<bool>(o.attr("provides_eval_hess_ψ_prod")())); }
         // [[nodiscard]] bool provides_eval_hess_ψ() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_hess_ψ") && (!py::hasattr(o, "provides_eval_hess_ψ") || py::cast<bool>(o.attr("provides_eval_hess_ψ")())); }
-        [[nodiscard]] bool provides_eval_f_grad_f() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_f_grad_f") && (!py::hasattr(o, "provides_eval_f_grad_f") || py::cast<bool>(o.attr("provides_eval_f_grad_f")())); }
-        [[nodiscard]] bool provides_eval_f_g() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_f_g") && (!py::hasattr(o, "provides_eval_f_g") || py::cast<bool>(o.attr("provides_eval_f_g")())); }
-        [[nodiscard]] bool provides_eval_grad_f_grad_g_prod() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_f_grad_g_prod") && (!py::hasattr(o, "provides_eval_grad_f_grad_g_prod") || py::cast<bool>(o.attr("provides_eval_grad_f_grad_g_prod")())); }
-        [[nodiscard]] bool provides_eval_grad_L() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_L") && (!py::hasattr(o, "provides_eval_grad_L") || py::cast<bool>(o.attr("provides_eval_grad_L")())); }
+        [[nodiscard]] bool provides_eval_f_grad_f() const { if (native.eval_f_grad_f) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_f_grad_f") && (!py::hasattr(o, "provides_eval_f_grad_f") || py::cast<bool>(o.attr("provides_eval_f_grad_f")())); }
+        [[nodiscard]] bool provides_eval_f_g() const { if (native.eval_f_g) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_f_g") && (!py::hasattr(o, "provides_eval_f_g") || py::cast<bool>(o.attr("provides_eval_f_g")())); }
+        [[nodiscard]] bool provides_eval_grad_f_grad_g_prod() const { if (native.eval_grad_f_grad_g_prod) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_f_grad_g_prod") && (!py::hasattr(o, "provides_eval_grad_f_grad_g_prod") || py::cast<bool>(o.attr("provides_eval_grad_f_grad_g_prod")())); }
+        [[nodiscard]] bool provides_eval_grad_L() const { if (native.eval_grad_L) return true; py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_L") && (!py::hasattr(o, "provides_eval_grad_L") || py::cast<bool>(o.attr("provides_eval_grad_L")())); }
         [[nodiscard]] bool provides_eval_ψ() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_ψ") && (!py::hasattr(o, "provides_eval_ψ") || py::cast<bool>(o.attr("provides_eval_ψ")())); }
         [[nodiscard]] bool provides_eval_grad_ψ() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_grad_ψ") && (!py::hasattr(o, "provides_eval_grad_ψ") || py::cast<bool>(o.attr("provides_eval_grad_ψ")())); }
         [[nodiscard]] bool provides_eval_ψ_grad_ψ() const { py::gil_scoped_acquire gil; return py::hasattr(o, "eval_ψ_grad_ψ") && (!py::hasattr(o, "provides_eval_ψ_grad_ψ") || py::cast<bool>(o.attr("provides_eval_ψ_grad_ψ")())); }
@@ -599,9 +601,16 @@ void register_problems(py::module_ &m) {
             m, "CUTEstProblem",
             "C++ documentation: :cpp:class:`alpaqa::CUTEstProblem`\n\n"
             "See :py:class:`alpaqa.Problem` for the full documentation.");
+        using alpaqa::CUTEstLoadMode;
+        py::enum_<CUTEstLoadMode>(cutest_problem, "LoadMode",
+                                  "C++ documentation: :cpp:enum:`alpaqa::CUTEstLoadMode`")
+            .value("Shared", CUTEstLoadMode::Shared)
+            .value("Namespace", CUTEstLoadMode::Namespace)
+            .value("Copy", CUTEstLoadMode::Copy);
         cutest_problem.def(
-            py::init<const char *, const char *, bool>(), "so_filename"_a,
+            py::init<const char *, const char *, bool, CUTEstLoadMode>(), "so_filename"_a,
             "outsdiff_filename"_a = nullptr, "sparse"_a = false,
+            "load_mode"_a = CUTEstLoadMode::Shared,
             "Load a CUTEst problem from the given shared library and OUTSDIF.d file");
         default_copy_methods(cutest_problem);
         problem_methods(cutest_problem);
@@ -7,8 +7,12 @@
 namespace py = pybind11;
 using namespace py::literals;
 
+#include <alpaqa/functions/elastic-net.hpp>
 #include <alpaqa/functions/indicator-box.hpp>
+#include <alpaqa/functions/indicator-linf-ball.hpp>
+#include <alpaqa/functions/indicator-simplex.hpp>
 #include <alpaqa/functions/l1-norm.hpp>
+#include <alpaqa/functions/l21-norm.hpp>
 #include <alpaqa/functions/nuclear-norm.hpp>
 #include <alpaqa/functions/prox.hpp>
 
@@ -91,6 +95,33 @@ void register_prox(py::module_ &m) {
             "Vector of singular values of the last input of the prox method.");
     register_prox_func<config_t, NuclearNorm>(m);
 
+    using TruncatedNuclearNorm = alpaqa::functions::TruncatedNuclearNorm<config_t>;
+    py::class_<TruncatedNuclearNorm>(
+        funcs, "TruncatedNuclearNorm",
+        "C++ documentation :cpp:class:`alpaqa::functions::TruncatedNuclearNorm`\n"
+        "Nuclear norm that only computes the singular values above the soft-thresholding step "
+        "size, using a warm-started truncated singular value decomposition.")
+        .def(py::init<real_t>(), "λ"_a)
+        .def(py::init<real_t, length_t, length_t>(), "λ"_a, "rows"_a, "cols"_a)
+        .def_readonly("λ", &TruncatedNuclearNorm::λ, "Regularization factor.")
+        .def_readonly("singular_values", &TruncatedNuclearNorm::singular_values,
+                      "Vector of singular values of the last output of the prox method.\n\n"
+                      ".. seealso:: :py:func:`alpaqa.prox`")
+        .def_property_readonly(
+            "U", [](const TruncatedNuclearNorm &self) -> mat { return self.svd.matrixU(); },
+            "Left singular vectors.")
+        .def_property_readonly(
+            "V", [](const TruncatedNuclearNorm &self) -> mat { return self.svd.matrixV(); },
+            "Right singular vectors.")
+        .def_property_readonly(
+            "singular_values_input",
+            [](const TruncatedNuclearNorm &self) -> vec { return self.svd.singularValues(); },
+            "Vector of the largest singular values of the last input of the prox method.")
+        .def_property_readonly(
+            "rank", [](const TruncatedNuclearNorm &self) { return self.svd.get_rank(); },
+            "Rank of the last output of the prox method.");
+    register_prox_func<config_t, TruncatedNuclearNorm>(m);
+
     using L1Norm = alpaqa::functions::L1Norm<config_t>;
     py::class_<L1Norm>(funcs, "L1Norm",
                        "C++ documentation :cpp:class:`alpaqa::functions::L1Norm`\n"
@@ -111,6 +142,56 @@ void register_prox(py::module_ &m) {
         .def_readonly("λ", &L1NormElementwise::λ, "Regularization factors.");
     register_prox_func<config_t, L1NormElementwise>(m);
 
+    using L21Norm = alpaqa::functions::L21Norm<config_t>;
+    py::class_<L21Norm>(funcs, "L21Norm",
+                        "C++ documentation :cpp:class:`alpaqa::functions::L21Norm`\n"
+                        "ℓ₂,₁-norm or group lasso regularizer. Without group indices, every "
+                        "column of the input is a group.\n\n"
+                        ".. seealso:: :py:func:`alpaqa.prox`")
+        .def(py::init<real_t>(), "λ"_a = 1)
+        .def(py::init<real_t, indexvec>(), "λ"_a, "group_starts"_a)
+        .def_readonly("λ", &L21Norm::λ, "Regularization factor.")
+        .def_readonly("group_starts", &L21Norm::group_starts,
+                      "Index of the first element of each group.");
+    register_prox_func<config_t, L21Norm>(m);
+
+    using ElasticNet = alpaqa::functions::ElasticNet<config_t>;
+    py::class_<ElasticNet>(funcs, "ElasticNet",
+                           "C++ documentation :cpp:class:`alpaqa::functions::ElasticNet`\n"
+                           "Elastic net regularizer λ1‖x‖₁ + ½λ2‖x‖₂².\n\n"
+                           ".. seealso:: :py:func:`alpaqa.prox`")
+        .def(py::init<real_t, real_t>(), "λ1"_a = 1, "λ2"_a = 1)
+        .def_readonly("λ1", &ElasticNet::λ1, "ℓ₁ regularization factor.")
+        .def_readonly("λ2", &ElasticNet::λ2, "ℓ₂ regularization factor.");
+    register_prox_func<config_t, ElasticNet>(m);
+
+    using LInfBall = alpaqa::functions::LInfBall<config_t>;
+    py::class_<LInfBall>(funcs, "LInfBall",
+                         "C++ documentation :cpp:class:`alpaqa::functions::LInfBall`\n"
+                         "Indicator function of the ℓ∞-ball.\n\n"
+                         ".. seealso:: :py:func:`alpaqa.prox`")
+        .def(py::init<real_t>(), "radius"_a = 1)
+        .def_readonly("radius", &LInfBall::radius, "Radius of the ball.");
+    register_prox_func<config_t, LInfBall>(m);
+
+    using Simplex = alpaqa::functions::Simplex<config_t>;
+    py::class_<Simplex>(funcs, "Simplex",
+                        "C++ documentation :cpp:class:`alpaqa::functions::Simplex`\n"
+                        "Indicator function of the simplex {x | x ≥ 0, Σ x = radius}.\n\n"
+                        ".. seealso:: :py:func:`alpaqa.prox`")
+        .def(py::init<real_t>(), "radius"_a = 1)
+        .def_readonly("radius", &Simplex::radius, "Sum of the elements.");
+    register_prox_func<config_t, Simplex>(m);
+
+    using L1Ball = alpaqa::functions::L1Ball<config_t>;
+    py::class_<L1Ball>(funcs, "L1Ball",
+                       "C++ documentation :cpp:class:`alpaqa::functions::L1Ball`\n"
+                       "Indicator function of the ℓ₁-ball.\n\n"
+                       ".. seealso:: :py:func:`alpaqa.prox`")
+        .def(py::init<real_t>(), "radius"_a = 1)
+        .def_readonly("radius", &L1Ball::radius, "Radius of the ball.");
+    register_prox_func<config_t, L1Ball>(m);
+
     using Box = alpaqa::Box<config_t>;
     register_prox_func<config_t, Box>(m);
 }
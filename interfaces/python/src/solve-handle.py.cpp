@@ -0,0 +1,32 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <chrono>
+#include <optional>
+
+#include <util/async.hpp>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+void register_solve_handle(py::module_ &m) {
+    py::class_<SolveHandle>(m, "SolveHandle",
+                            "Handle to a solver that is running in the background, returned by "
+                            "the ``submit`` methods of the solvers.\n\n"
+                            "If the handle is destroyed before the solver finishes, the solver "
+                            "is stopped.")
+        .def("done", &SolveHandle::done, "Check whether the solver has finished, without blocking.")
+        .def("stop", &SolveHandle::stop,
+             "Ask the solver to stop early. The (partial) result can still be retrieved using "
+             ":py:meth:`result`.")
+        .def(
+            "result",
+            [](SolveHandle &h, std::optional<double> timeout) {
+                return h.result(timeout ? std::optional{std::chrono::duration<double>{*timeout}}
+                                        : std::nullopt);
+            },
+            "timeout"_a = py::none(),
+            "Wait for the solver to finish, and return its result.\n\n"
+            ":param timeout: Maximum time to wait (in seconds), or ``None`` to wait indefinitely.\n"
+            ":raises TimeoutError: If the solver did not finish within the given timeout.\n"
+            ":return: The same values as returned by the solver's ``__call__`` method.\n\n");
+}
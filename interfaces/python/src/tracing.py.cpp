@@ -0,0 +1,48 @@
+#include <alpaqa/util/trace.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+void register_tracing(py::module_ &m) {
+    auto tracing = m.def_submodule(
+        "tracing", "Timeline of the solver execution, which can be exported in the Chrome Trace "
+                   "Event format and visualized using Perfetto (https://ui.perfetto.dev).\n\n"
+                   "C++ documentation: :cpp:any:`alpaqa::tracing`");
+#ifdef ALPAQA_WITH_TRACING
+    tracing.attr("available") = true;
+#else
+    tracing.attr("available") = false;
+#endif
+    tracing.attr("default_capacity") = alpaqa::tracing::default_capacity;
+    tracing.def("start", &alpaqa::tracing::start, "capacity"_a = alpaqa::tracing::default_capacity,
+                "Discard all previously recorded events, and start recording new events in all "
+                "threads, with room for at most ``capacity`` events per thread.\n\n"
+                "Problem evaluations are only recorded for problems with evaluation counters.");
+    tracing.def("stop", &alpaqa::tracing::stop, "Stop recording events.");
+    tracing.def("clear", &alpaqa::tracing::clear,
+                "Stop recording events and free the buffers of all threads.");
+    tracing.def("is_enabled", &alpaqa::tracing::is_enabled,
+                "Check whether events are currently being recorded.");
+    tracing.def("num_events", &alpaqa::tracing::num_events,
+                "The number of events recorded since the last call to :py:func:`start`.");
+    tracing.def("num_dropped_events", &alpaqa::tracing::num_dropped_events,
+                "The number of events that were dropped because the buffer of their thread was "
+                "full.");
+    tracing.def(
+        "write_chrome_trace",
+        [](const std::string &path) {
+            std::ofstream f{path};
+            if (!f)
+                throw std::runtime_error("Unable to open " + path);
+            py::gil_scoped_release release;
+            alpaqa::tracing::write_chrome_trace(f);
+        },
+        "path"_a,
+        "Write all events recorded since the last call to :py:func:`start` to the given file, "
+        "in the Chrome Trace Event format (JSON).");
+}
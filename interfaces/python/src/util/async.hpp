@@ -1,22 +1,80 @@
 #pragma once
 
 #include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
 namespace py = pybind11;
 
 #include <chrono>
 #include <exception>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <tuple>
 #include <utility>
 using namespace std::chrono_literals;
 
 #include "stream-replacer.hpp"
 #include "thread-checker.hpp"
+#include "thread-pool.hpp"
+
+/// Wait for an asynchronous solver to finish, while periodically checking for
+/// Python signals (e.g. Ctrl+C). Waiting is done on the future's condition
+/// variable, so this returns as soon as the solver is done; the 50 ms time
+/// slices only bound the latency of handling signals. If a signal arrives,
+/// @p stop is called to ask the solver to stop early.
+/// @return False if the @p timeout expired before the solver finished.
+/// @note   Requires the GIL.
+template <class Future, class Stop>
+bool wait_interruptible(Future &future, Stop &&stop, bool suppress_interrupt,
+                        std::optional<std::chrono::duration<double>> timeout = std::nullopt) {
+    using clock   = std::chrono::steady_clock;
+    std::optional<clock::time_point> deadline;
+    if (timeout)
+        deadline = clock::now() + std::chrono::duration_cast<clock::duration>(*timeout);
+    {
+        py::gil_scoped_release gil;
+        while (true) {
+            auto slice = clock::now() + 50ms;
+            if (deadline && *deadline < slice)
+                slice = *deadline;
+            if (future.wait_until(slice) == std::future_status::ready)
+                return true;
+            if (deadline && clock::now() >= *deadline)
+                return false;
+            py::gil_scoped_acquire gil;
+            // Check if Python received a signal (e.g. Ctrl+C)
+            if (PyErr_CheckSignals() != 0)
+                break;
+        }
+        // Nicely ask the solver to stop
+        stop();
+        // It should return a result soon
+        if (future.wait_for(15s) != std::future_status::ready) {
+            // If it doesn't, we terminate the entire program, because the
+            // solver uses variables that are owned by the caller, so we
+            // cannot safely return without waiting for the solver to finish.
+            std::terminate();
+        }
+    }
+    if (PyErr_Occurred()) {
+        if (PyErr_ExceptionMatches(PyExc_KeyboardInterrupt) && suppress_interrupt)
+            PyErr_Clear(); // Clear the KeyboardInterrupt exception
+        else
+            throw py::error_already_set();
+    }
+    return true;
+}
 
 template <class Solver, class Invoker, class... CheckedArgs>
 auto async_solve(bool async, bool suppress_interrupt, Solver &solver, Invoker &invoke_solver,
                  CheckedArgs &...checked_args) {
     if (!async) {
+        // Even without releasing the GIL, other threads can run while the
+        // solver calls back into Python (and always in free-threaded builds),
+        // so the solver and its output stream must not be shared
+        ThreadChecker solver_checker{solver};
         // Replace the output stream
         StreamReplacer stream{&solver};
         // Invoke the solver synchronously
@@ -28,35 +86,140 @@ auto async_solve(bool async, bool suppress_interrupt, Solver &solver, Invoker &i
         std::tuple checkers{ThreadChecker{checked_args}...};
         // Replace the output stream
         StreamReplacer stream{&solver};
-        // Invoke the solver asynchronously
-        auto stats = std::async(std::launch::async, invoke_solver);
+        // Invoke the solver asynchronously, on one of the pool's workers
+        auto stats = SolverThreadPool::instance().submit(std::ref(invoke_solver));
+        wait_interruptible(stats, [&] { solver.stop(); }, suppress_interrupt);
+        return std::move(stats).get();
+    }
+}
+
+/// Future-like handle to a solver invocation that was started in the
+/// background using the `submit` method of a solver.
+/// The methods can be called from multiple Python threads at the same time.
+class SolveHandle {
+  public:
+    /// Type-erased state of the pending solver invocation: the solver, the
+    /// problem and the in- and outputs are all owned by the handle.
+    struct State {
+        virtual ~State()                 = default;
+        virtual void stop()              = 0;
+        virtual py::object make_result() = 0;
+        /// Stop checking the solver and the problem for concurrent use, and
+        /// restore the solver's output stream.
+        virtual void release() = 0;
+        bool suppress_interrupt = false;
+
+        std::mutex mtx; ///< Protects the members below
+        bool finished = false;
+        std::optional<py::object> result;
+        std::exception_ptr error;
+    };
+
+    SolveHandle(std::unique_ptr<State> state, std::future<void> future)
+        : state{std::move(state)}, future{std::move(future).share()} {}
+    SolveHandle(const SolveHandle &)            = delete;
+    SolveHandle &operator=(const SolveHandle &) = delete;
+    SolveHandle(SolveHandle &&)                 = default;
+    /// Deleted, because it would destroy the state of the current solve
+    /// while the solver may still be using it.
+    SolveHandle &operator=(SolveHandle &&) = delete;
+    /// The solver accesses the state owned by this handle, so if the handle
+    /// is destroyed before the solver finished, the solver is stopped.
+    ~SolveHandle() {
+        if (state && !done()) {
+            state->stop();
+            py::gil_scoped_release gil;
+            future.wait();
+        }
+    }
+
+    /// Check whether the solver has finished, without blocking.
+    bool done() const { return future.wait_for(0s) == std::future_status::ready; }
+    /// Ask the solver to stop early. The result can still be retrieved using
+    /// @ref result.
+    void stop() {
+        if (!done())
+            state->stop();
+    }
+    /// Wait for the solver to finish, and return its result.
+    /// @throws TimeoutError if the @p timeout expired before the solver
+    ///         finished.
+    py::object result(std::optional<std::chrono::duration<double>> timeout) {
+        if (!wait_interruptible(future, [&] { state->stop(); }, state->suppress_interrupt,
+                                timeout)) {
+            PyErr_SetString(PyExc_TimeoutError, "Solver did not finish within the timeout");
+            throw py::error_already_set();
+        }
+        // Never block on the mutex while holding the GIL: the thread that
+        // holds the mutex may need the GIL to create the result
+        std::unique_lock lck{state->mtx, std::defer_lock};
         {
             py::gil_scoped_release gil;
-            while (stats.wait_for(50ms) != std::future_status::ready) {
-                py::gil_scoped_acquire gil;
-                // Check if Python received a signal (e.g. Ctrl+C)
-                if (PyErr_CheckSignals() != 0) {
-                    // Nicely ask the solver to stop
-                    solver.stop();
-                    // It should return a result soon
-                    if (py::gil_scoped_release gil;
-                        stats.wait_for(15s) != std::future_status::ready) {
-                        // If it doesn't, we terminate the entire program,
-                        // because the solver uses variables local to this
-                        // function, so we cannot safely return without
-                        // waiting for the solver to finish.
-                        std::terminate();
-                    }
-                    if (PyErr_Occurred()) {
-                        if (PyErr_ExceptionMatches(PyExc_KeyboardInterrupt) && suppress_interrupt)
-                            PyErr_Clear(); // Clear the KeyboardInterrupt exception
-                        else
-                            throw py::error_already_set();
-                    }
-                    break;
-                }
+            lck.lock();
+        }
+        if (!state->finished) {
+            try {
+                future.get(); // rethrows exceptions of the solver
+                state->result = state->make_result();
+            } catch (...) {
+                state->error = std::current_exception();
             }
+            // Release the solver and the problem, so they can be used again
+            state->release();
+            state->finished = true;
         }
-        return std::move(stats).get();
+        if (state->error)
+            std::rethrow_exception(state->error);
+        return *state->result;
     }
-}
\ No newline at end of file
+
+  private:
+    std::unique_ptr<State> state;
+    std::shared_future<void> future;
+};
+
+/// Start a solver on the thread pool, and return a handle to its result.
+/// @p invoke_solver runs on a worker thread, without the GIL, and returns the
+/// solver statistics, @p make_result converts them to the Python result, with
+/// the GIL held.
+/// @p keep_alive references the Python objects (solver and problem) that
+/// @p solver and @p checked_args belong to. The solver and the arguments are
+/// considered in use until the result has been retrieved.
+template <class Solver, class Invoker, class MakeResult, class... CheckedArgs>
+SolveHandle async_submit(bool suppress_interrupt, py::object keep_alive, Solver &solver,
+                         Invoker invoke_solver, MakeResult make_result,
+                         CheckedArgs &...checked_args) {
+    using Stats = std::remove_cvref_t<std::invoke_result_t<Invoker &>>;
+    struct State : SolveHandle::State {
+        State(py::object keep_alive, Solver &solver, Invoker invoke_solver,
+              MakeResult make_result, CheckedArgs &...checked_args)
+            : keep_alive{std::move(keep_alive)}, solver{solver},
+              invoke_solver{std::move(invoke_solver)}, finish{std::move(make_result)} {
+            solver_checker.emplace(solver);
+            checkers.emplace(ThreadChecker{checked_args}...);
+            stream.emplace(&solver);
+        }
+        py::object keep_alive;
+        Solver &solver;
+        std::optional<ThreadChecker<Solver>> solver_checker;
+        std::optional<std::tuple<ThreadChecker<CheckedArgs>...>> checkers;
+        std::optional<StreamReplacer<Solver>> stream;
+        Invoker invoke_solver;
+        MakeResult finish;
+        std::optional<Stats> stats;
+
+        void stop() override { solver.stop(); }
+        py::object make_result() override { return finish(std::move(*stats)); }
+        void release() override {
+            stream.reset();
+            checkers.reset();
+            solver_checker.reset();
+        }
+    };
+    auto state = std::make_unique<State>(std::move(keep_alive), solver, std::move(invoke_solver),
+                                         std::move(make_result), checked_args...);
+    state->suppress_interrupt = suppress_interrupt;
+    auto future = SolverThreadPool::instance().submit(
+        [s = state.get()] { s->stats.emplace(s->invoke_solver()); });
+    return {std::move(state), std::move(future)};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <alpaqa/inner/internal/solverstatus.hpp>
+
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+namespace py = pybind11;
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+/// Progress callback that forwards the progress information of a solver to a
+/// Python function.
+///
+/// Acquiring the GIL and creating the Python progress info object on every
+/// iteration slows down small problems considerably, so the number of calls
+/// can be limited to every @ref every iterations, and to at most one call per
+/// @ref min_interval. These checks happen in C++, before the GIL is acquired.
+/// The last call of each solve (with a status other than
+/// @ref alpaqa::SolverStatus::Busy) is always forwarded.
+///
+/// The vectors in the progress info are passed to Python as read-only NumPy
+/// views of the solver's internal storage, without copying. They are only
+/// valid during the callback.
+template <class ProgressInfo>
+struct ThrottledProgressCallback {
+    using clock = std::chrono::steady_clock;
+
+    ThrottledProgressCallback(py::function callback, unsigned every,
+                              std::optional<std::chrono::duration<double>> min_interval)
+        : callback{new py::function{std::move(callback)}, release_with_gil}, every{every},
+          min_interval{min_interval ? std::chrono::duration_cast<clock::duration>(*min_interval)
+                                    : clock::duration::zero()} {
+        if (every == 0)
+            throw std::invalid_argument("Callback interval 'every' should be positive");
+        if (this->min_interval < clock::duration::zero())
+            throw std::invalid_argument("Callback interval 'min_interval' cannot be negative");
+    }
+
+    void operator()(const ProgressInfo &info) {
+        if (info.status == alpaqa::SolverStatus::Busy) {
+            if (info.k % every != 0)
+                return;
+            if (min_interval > clock::duration::zero()) {
+                auto now = clock::now();
+                if (info.k > 0 && now - last_call < min_interval)
+                    return;
+                last_call = now;
+            }
+        }
+        py::gil_scoped_acquire gil;
+        (*callback)(info);
+    }
+
+  private:
+    /// The solvers (and therefore their callbacks) can be copied and
+    /// destroyed without holding the GIL, so the Python function is shared
+    /// between copies, and only released with the GIL held.
+    static void release_with_gil(py::function *f) {
+        py::gil_scoped_acquire gil;
+        delete f;
+    }
+
+    std::shared_ptr<py::function> callback;
+    unsigned every;
+    clock::duration min_interval;
+    clock::time_point last_call{};
+};
+
+/// Python binding of the solvers' `set_progress_callback` method.
+template <class Solver>
+auto set_throttled_progress_callback() {
+    using ProgressInfo = typename Solver::ProgressInfo;
+    return [](py::object self, std::optional<py::function> callback, unsigned every,
+              std::optional<double> min_interval) {
+        auto &solver = py::cast<Solver &>(self);
+        if (!callback)
+            solver.set_progress_callback(nullptr);
+        else
+            solver.set_progress_callback(ThrottledProgressCallback<ProgressInfo>{
+                std::move(*callback), every,
+                min_interval ? std::optional{std::chrono::duration<double>{*min_interval}}
+                             : std::nullopt});
+        return self;
+    };
+}
+
+inline const char *set_throttled_progress_callback_doc() {
+    return "Specify a callable that is invoked with some intermediate results on each iteration "
+           "of the algorithm.\n\n"
+           ":param callback: Function that is called with the progress information, or ``None`` "
+           "to remove the callback. The vectors in the progress information are read-only views "
+           "of the solver's internal storage, which are only valid during the callback: use "
+           "``numpy.copy`` to save them for later.\n"
+           ":param every: Only invoke the callback every ``every`` iterations.\n"
+           ":param min_interval: Minimum time (in seconds) between two invocations of the "
+           "callback.\n\n"
+           "Iterations that are skipped because of ``every`` or ``min_interval`` do not acquire "
+           "the GIL. The final iteration of each solve is always reported.\n\n";
+}
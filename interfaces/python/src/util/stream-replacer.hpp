@@ -3,6 +3,16 @@
 #include <pybind11/iostream.h>
 #include <utility>
 
+/// Redirects the output stream `os` of a solver to Python's `sys.stdout` for
+/// the lifetime of this object.
+///
+/// Thread safety: each instance has its own buffer, so different solvers can
+/// be redirected concurrently. The buffer acquires the GIL whenever it writes
+/// to Python, so the solver may run on any thread. The `os` member of the
+/// solver itself is not protected, so the caller must make sure that the
+/// solver is not used by other threads while it is redirected (e.g. using a
+/// @ref ThreadChecker). Constructing and destroying an instance requires the
+/// GIL (or an attached thread state in free-threaded builds).
 template <class T>
 class StreamReplacer {
     pybind11::detail::pythonbuf buffer{pybind11::module_::import("sys").attr("stdout")};
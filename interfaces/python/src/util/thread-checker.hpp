@@ -2,6 +2,7 @@
 
 #include <alpaqa/util/demangled-typename.hpp>
 #include <alpaqa/util/type-erasure.hpp>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <stdexcept>
@@ -18,17 +19,23 @@ template <class T>
 void get_identity(const T *) = delete;
 } // namespace alpaqa
 
+/// Throws an exception if the same object is used by multiple threads at the
+/// same time. The set of objects in use is protected by a mutex rather than by
+/// the GIL, for free-threaded builds of Python.
 template <class T>
 class ThreadChecker {
     using set_t      = std::set<decltype(alpaqa::get_identity(std::declval<T>()))>;
     using iterator_t = typename set_t::iterator;
     static set_t set;
+    static std::mutex mtx;
     std::optional<iterator_t> iterator;
 
   public:
     ThreadChecker(const T &t) {
+        std::unique_lock lck{mtx};
         auto [iter, inserted] = set.insert(alpaqa::get_identity(t));
         if (!inserted) {
+            lck.unlock();
             std::string name = "instance of type " + demangled_typename(typeid(T));
             if constexpr (requires { t.get_name(); })
                 name = "instance of " + std::string(t.get_name());
@@ -38,8 +45,10 @@ class ThreadChecker {
         iterator = iter;
     }
     ~ThreadChecker() {
-        if (iterator)
+        if (iterator) {
+            std::lock_guard lck{mtx};
             set.erase(*iterator);
+        }
     }
     ThreadChecker(const ThreadChecker &)            = delete;
     ThreadChecker &operator=(const ThreadChecker &) = delete;
@@ -53,3 +62,5 @@ class ThreadChecker {
 
 template <class T>
 typename ThreadChecker<T>::set_t ThreadChecker<T>::set;
+template <class T>
+std::mutex ThreadChecker<T>::mtx;
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/// Persistent pool of worker threads that run the asynchronous solver calls.
+///
+/// Creating a new thread for every solver invocation is relatively expensive
+/// compared to the solve time of small problems, so threads are reused
+/// instead. The pool grows when all workers are busy: solver calls can block
+/// for a long time, and callbacks running on a worker may start solvers
+/// themselves, so queuing tasks behind busy workers could deadlock. Workers
+/// that have been idle for @ref idle_timeout exit again.
+class SolverThreadPool {
+  public:
+    /// How long idle workers wait for new work before exiting.
+    static constexpr std::chrono::seconds idle_timeout{30};
+
+    /// Global instance used by the solvers.
+    static SolverThreadPool &instance() {
+        // Intentionally leaked: the workers are detached, and destroying the
+        // pool while they are blocked would require joining them during
+        // static destruction (which deadlocks on some platforms).
+        static auto *pool = new SolverThreadPool;
+        return *pool;
+    }
+
+    /// Run @p f on one of the workers. Completion (and any exceptions) are
+    /// reported through the returned future.
+    template <class F>
+    std::future<std::invoke_result_t<F &>> submit(F f) {
+        using R   = std::invoke_result_t<F &>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+        auto fut  = task->get_future();
+        auto st   = current_state();
+        std::unique_lock lck{st->mtx};
+        st->queue.emplace_back([task] { (*task)(); });
+        if (st->idle >= st->queue.size()) {
+            lck.unlock();
+            st->cv.notify_one();
+        } else {
+            ++st->idle; // counted as idle until it picks up its first task
+            std::thread{worker, st}.detach();
+        }
+        return fut;
+    }
+
+  private:
+    struct State {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::function<void()>> queue;
+        std::size_t idle = 0;
+    };
+    std::mutex state_mtx; ///< Protects @ref state and @ref pid
+    std::shared_ptr<State> state = std::make_shared<State>();
+#ifndef _WIN32
+    pid_t pid = ::getpid();
+#endif
+
+    static void worker(std::shared_ptr<State> state) {
+        std::unique_lock lck{state->mtx};
+        while (true) {
+            auto has_work = [&] { return !state->queue.empty(); };
+            if (!state->cv.wait_for(lck, idle_timeout, has_work))
+                break;
+            auto task = std::move(state->queue.front());
+            state->queue.pop_front();
+            --state->idle;
+            lck.unlock();
+            task(); // exceptions are stored in the future by packaged_task
+            lck.lock();
+            ++state->idle;
+        }
+        --state->idle;
+    }
+
+    /// Get the shared state of the workers. After a fork, the child process
+    /// has none of the parent's workers, so it starts over with an empty pool.
+    /// The references held by the parent's workers are never released in the
+    /// child, so the old state is simply abandoned.
+    std::shared_ptr<State> current_state() {
+        std::lock_guard lck{state_mtx};
+#ifndef _WIN32
+        if (pid_t current = ::getpid(); current != pid) {
+            pid   = current;
+            state = std::make_shared<State>();
+        }
+#endif
+        return state;
+    }
+};
@@ -1,3 +1,4 @@
+import contextlib
 import os
 from os.path import join, expanduser
 import tempfile
@@ -5,6 +6,11 @@ import shutil
 import sys
 import typing
 
+if sys.platform == "win32":
+    import msvcrt
+else:
+    import fcntl
+
 
 def _is_truthy(s: typing.Optional[str]):
     if s is None:
@@ -44,6 +50,48 @@ def get_alpaqa_cache_dir():
     return join(get_cache_dir(), "alpaqa", "cache")
 
 
+def _lock_file(f: typing.BinaryIO):
+    if sys.platform == "win32":
+        f.seek(0)
+        while True:
+            try:  # LK_LOCK gives up after 10 attempts, so keep retrying
+                msvcrt.locking(f.fileno(), msvcrt.LK_LOCK, 1)
+                return
+            except OSError:
+                pass
+    else:
+        fcntl.flock(f.fileno(), fcntl.LOCK_EX)
+
+
+def _unlock_file(f: typing.BinaryIO):
+    if sys.platform == "win32":
+        f.seek(0)
+        msvcrt.locking(f.fileno(), msvcrt.LK_UNLCK, 1)
+    else:
+        fcntl.flock(f.fileno(), fcntl.LOCK_UN)
+
+
+@contextlib.contextmanager
+def cache_lock(key: str, alpaqa_cache_dir=None):
+    """
+    Context manager that grants exclusive access to the cache entry ``key``.
+
+    The lock is implemented using the lock file ``{key}.lock`` in the cache
+    directory, so it protects the entry against concurrent use by other threads
+    as well as by other processes. Lock files are never removed, because another
+    process may be waiting for them.
+    """
+    if alpaqa_cache_dir is None:
+        alpaqa_cache_dir = get_alpaqa_cache_dir()
+    os.makedirs(alpaqa_cache_dir, exist_ok=True)
+    with open(join(alpaqa_cache_dir, f"{key}.lock"), "a+b") as f:
+        _lock_file(f)
+        try:
+            yield
+        finally:
+            _unlock_file(f)
+
+
 def clean(alpaqa_cache_dir=None):
     if alpaqa_cache_dir is None:
         alpaqa_cache_dir = get_alpaqa_cache_dir()
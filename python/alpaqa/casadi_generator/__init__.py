@@ -215,7 +215,7 @@ def _add_parameter(f: cs.Function, expected_inputs: int) -> Tuple[cs.Function, c
                            f"(expected {expected_inputs} inputs with optional "
                            f"additional parameter)")
 
-def generate_casadi_control_problem(
+def _prepare_casadi_control_problem(
     f: cs.Function,
     l: cs.Function,
     l_N: cs.Function,
@@ -223,19 +223,12 @@ def generate_casadi_control_problem(
     h_N: cs.Function = None,
     c: cs.Function = None,
     c_N: cs.Function = None,
-    name: str = "alpaqa_control_problem",
-) -> cs.CodeGenerator:
-    """Convert the dynamics and cost functions into a CasADi code generator.
-
-    :param f:            Dynamics.
-    :param name: Optional string description of the problem (used for filename).
-
-    :return: Code generator that generates the functions and derivatives used by
-             the solvers.
-    """
+) -> Dict[str, cs.Function]:
+    """Convert the dynamics and cost functions, their derivatives, etc. into
+    CasADi functions."""
 
-    cgname = f"{name}.c"
-    cg = cs.CodeGenerator(cgname)
+    functions: Dict[str, cs.Function] = {}
+    add = lambda func: functions.setdefault(func.name(), func)
 
     assert f.n_in() in [2, 3]
     assert f.n_out() == 1
@@ -255,21 +248,21 @@ def generate_casadi_control_problem(
     v_var = cs.SX.sym("v", nx)
 
     # dynamics and their derivatives
-    cg.add(cs.Function(
+    add(cs.Function(
         "f",
         [x_var, u_var, p_var],
         [f(x_var, u_var, p_var)],
         [f.name_in(i) for i in range(3)],
         [f.name_out(0)],
     ))
-    cg.add(cs.Function(
+    add(cs.Function(
         "jacobian_f",
         [x_var, u_var, p_var],
         [cs.densify(cs.jacobian(f(x_var, u_var, p_var), xu_var))],
         [f.name_in(i) for i in range(3)],
         ["jac_" + f.name_out(0)],
     ))
-    cg.add(cs.Function(
+    add(cs.Function(
         "grad_f_prod",
         [x_var, u_var, p_var, v_var],
         [cs.jtimes(f(x_var, u_var, p_var), xu_var, v_var, True)],
@@ -292,7 +285,7 @@ def generate_casadi_control_problem(
     nh = h.size1_out(0)
     assert h.size2_out(0) == 1
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "h",
         [x_var, u_var, p_var],
         [h(x_var, u_var, p_var)],
@@ -313,7 +306,7 @@ def generate_casadi_control_problem(
     nh_N = h_N.size1_out(0)
     assert h_N.size2_out(0) == 1
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "h_N",
         [x_var, p_var],
         [h_N(x_var, p_var)],
@@ -334,7 +327,7 @@ def generate_casadi_control_problem(
 
     h_var = cs.SX.sym("h", *l.sx_in(0).shape)
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "l",
         [h_var, p_var],
         [l(h_var, p_var)],
@@ -342,7 +335,7 @@ def generate_casadi_control_problem(
         [l.name_out(0)],
     ))
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "qr",
         [xu_var, h_var, p_var],
         [cs.jtimes(h(x_var, u_var, p_var), xu_var, cs.gradient(l(h_var, p_var), h_var), True)],
@@ -356,7 +349,7 @@ def generate_casadi_control_problem(
     Jhx = cs.jacobian(h(x_var, u_var, p_var), x_var)
     Λ = cs.hessian(l(h_var, p_var), h_var)[0]
     Q = Jhx.T @ Λ @ Jhx
-    cg.add(cs.Function(
+    add(cs.Function(
         "Q",
         [xu_var, h_var, p_var],
         [Q],
@@ -369,7 +362,7 @@ def generate_casadi_control_problem(
     # JhᵀΛJh = cs.jtimes(h(x_var, u_var, p_var), u_var, cs.transpose(JhTΛ), True)
     Jhu = cs.jacobian(h(x_var, u_var, p_var), u_var)
     R = Jhu.T @ Λ @ Jhu
-    cg.add(cs.Function(
+    add(cs.Function(
         "R",
         [xu_var, h_var, p_var],
         [R],
@@ -381,7 +374,7 @@ def generate_casadi_control_problem(
     # JhᵀΛ = cs.jtimes(h(x_var, u_var, p_var), x_var, cs.hessian(l(h_var, p_var), h_var)[0], True)
     # JhᵀΛJh = cs.jtimes(h(x_var, u_var, p_var), u_var, cs.transpose(JhTΛ), True)
     S = Jhu.T @ Λ @ Jhx
-    cg.add(cs.Function(
+    add(cs.Function(
         "S",
         [xu_var, h_var, p_var],
         [S],
@@ -402,7 +395,7 @@ def generate_casadi_control_problem(
 
     hN_var = cs.SX.sym("hN", *l_N.sx_in(0).shape)
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "l_N",
         [hN_var, p_var],
         [l_N(hN_var, p_var)],
@@ -410,7 +403,7 @@ def generate_casadi_control_problem(
         [l_N.name_out(0)],
     ))
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "q_N",
         [x_var, hN_var, p_var],
         [cs.jtimes(h_N(x_var, p_var), x_var, cs.gradient(l_N(hN_var, p_var), hN_var), True)],
@@ -424,7 +417,7 @@ def generate_casadi_control_problem(
     JhN = cs.jacobian(h_N(x_var, p_var), x_var)
     ΛN = cs.hessian(l_N(hN_var, p_var), hN_var)[0]
     Q_N = JhN.T @ ΛN @ JhN
-    cg.add(cs.Function(
+    add(cs.Function(
         "Q_N",
         [x_var, hN_var, p_var],
         [Q_N],
@@ -448,7 +441,7 @@ def generate_casadi_control_problem(
 
     w_var = cs.SX.sym("w", nc)
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "c",
         [x_var, p_var],
         [c(x_var, p_var)],
@@ -456,7 +449,7 @@ def generate_casadi_control_problem(
         [c.name_out(0)],
     ))
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "grad_c_prod",
         [x_var, p_var, w_var],
         [cs.jtimes(c(x_var, p_var), x_var, w_var, True) if nc > 0 else cs.DM.zeros(nx)],
@@ -470,7 +463,7 @@ def generate_casadi_control_problem(
     # JhᵀMJh = cs.jtimes(c(x_var, p_var), x_var, cs.transpose(JhᵀM), True)
     Jc = cs.jacobian(c(x_var, p_var), x_var)
     JhᵀMJh = Jc.T @ cs.diag(m_var) @ Jc
-    cg.add(cs.Function(
+    add(cs.Function(
         "gn_hess_c",
         [x_var, p_var, m_var],
         [JhᵀMJh],
@@ -494,7 +487,7 @@ def generate_casadi_control_problem(
 
     wN_var = cs.SX.sym("wN", nc_N)
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "c_N",
         [x_var, p_var],
         [c_N(x_var, p_var)],
@@ -502,7 +495,7 @@ def generate_casadi_control_problem(
         [c_N.name_out(0)],
     ))
 
-    cg.add(cs.Function(
+    add(cs.Function(
         "grad_c_prod_N",
         [x_var, p_var, wN_var],
         [cs.jtimes(c_N(x_var, p_var), x_var, wN_var, True) if nc_N > 0 else cs.DM.zeros(nx)],
@@ -513,7 +506,7 @@ def generate_casadi_control_problem(
     mN_var = cs.SX.sym("mN", nc_N)
     JcN = cs.jacobian(c_N(x_var, p_var), x_var)
     JhᵀMJhN = JcN.T @ cs.diag(mN_var) @ JcN
-    cg.add(cs.Function(
+    add(cs.Function(
         "gn_hess_c_N",
         [x_var, p_var, mN_var],
         [JhᵀMJhN],
@@ -521,6 +514,33 @@ def generate_casadi_control_problem(
         ["gn_hess_" + c_N.name_out(0)],
     ))
 
+    return functions
+
+def generate_casadi_control_problem(
+    f: cs.Function,
+    l: cs.Function,
+    l_N: cs.Function,
+    h: cs.Function = None,
+    h_N: cs.Function = None,
+    c: cs.Function = None,
+    c_N: cs.Function = None,
+    name: str = "alpaqa_control_problem",
+) -> cs.CodeGenerator:
+    """Convert the dynamics and cost functions into a CasADi code generator.
+
+    :param f:            Dynamics.
+    :param name: Optional string description of the problem (used for filename).
+
+    :return: Code generator that generates the functions and derivatives used by
+             the solvers.
+    """
+
+    functions = _prepare_casadi_control_problem(f, l, l_N, h, h_N, c, c_N)
+
+    cgname = f"{name}.c"
+    cg = cs.CodeGenerator(cgname)
+    for func in functions.values():
+        cg.add(func)
     return cg
 
 def write_casadi_problem_data(sofile, C, D, param, l1_reg, penalty_alm_split, name):
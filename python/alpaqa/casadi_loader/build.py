@@ -0,0 +1,276 @@
+"""Compilation of the C code generated by CasADi, and caching of the resulting
+shared libraries."""
+
+from __future__ import annotations
+
+import casadi as cs
+import contextlib
+from dataclasses import dataclass, field
+import glob
+import hashlib
+import os
+from os.path import join, splitext
+import pickle
+import platform
+import shutil
+import subprocess
+from textwrap import dedent
+import typing
+from typing import Callable, Dict, Iterator, List, Optional
+import warnings
+from .. import __version__
+from ..cache import get_alpaqa_cache_dir, cache_lock, _is_truthy
+
+
+def _python_sysconfig_platform_to_cmake_platform_win(
+    plat_name: str | None,
+) -> str | None:
+    """Convert a sysconfig platform string to the corresponding value of
+    https://cmake.org/cmake/help/latest/variable/CMAKE_GENERATOR_PLATFORM.html"""
+    return {
+        None: None,
+        "win32": "Win32",
+        "win-amd64": "x64",
+        "win-arm32": "ARM",
+        "win-arm64": "ARM64",
+    }.get(plat_name)
+
+
+def _get_windows_architecture() -> str:
+    import sysconfig
+
+    plat = sysconfig.get_platform()
+    arch = _python_sysconfig_platform_to_cmake_platform_win(plat)
+    if arch is None:
+        raise RuntimeError(f"Unknown Windows platform architecture {plat}")
+    return arch
+
+
+def _get_cmake_bin() -> str:
+    """
+    Get the path to the CMake executable:
+
+    1. The ``ALPAQA_CMAKE_PROGRAM`` environment variable, if set;
+    2. The path obtained from ``cmake.CMAKE_BIN_DIR``, if available;
+    3. Simply ``"cmake"``.
+    """
+    cmake_bin = os.getenv("ALPAQA_CMAKE_PROGRAM")
+    if not cmake_bin:
+        with contextlib.suppress(ImportError, AttributeError):
+            import cmake
+
+            cmake_bin = join(cmake.CMAKE_BIN_DIR, "cmake")
+    return cmake_bin or "cmake"
+
+
+# MSVC equivalents of the GCC/Clang optimization levels
+_MSVC_OPTIMIZATION = {
+    "0": "/Od",
+    "1": "/O1",
+    "2": "/O2",
+    "3": "/O2",
+    "s": "/O1",
+    "fast": "/O2",
+}
+
+
+@dataclass
+class CompileOptions:
+    """
+    Options for compiling the C code generated by CasADi.
+
+    The defaults are taken from the environment variables
+    ``ALPAQA_BUILD_CONFIG``, ``ALPAQA_OPTIMIZATION``, ``ALPAQA_NATIVE`` and
+    ``ALPAQA_BUILD_PARALLEL``.
+    All options except for :py:attr:`parallel` are part of the cache key, so
+    changing them causes the problem to be recompiled.
+    """
+
+    build_config: str = field(
+        default_factory=lambda: os.getenv("ALPAQA_BUILD_CONFIG", "Release")
+    )
+    """CMake build configuration (e.g. ``"Release"`` or ``"Debug"``)."""
+    optimization: Optional[str] = field(
+        default_factory=lambda: os.getenv("ALPAQA_OPTIMIZATION") or None
+    )
+    """Optimization level: ``"0"``, ``"1"``, ``"2"``, ``"3"``, ``"s"`` or
+    ``"fast"``, or ``None`` to use the default of the build configuration."""
+    native: bool = field(
+        default_factory=lambda: _is_truthy(os.getenv("ALPAQA_NATIVE"))
+    )
+    """Optimize for the current machine (``-march=native``). Not supported by
+    MSVC, where it is ignored. The resulting binaries may not run on other
+    machines."""
+    flags: List[str] = field(default_factory=list)
+    """Additional flags that are passed to the C compiler."""
+    parallel: Optional[int] = field(
+        default_factory=lambda: int(os.getenv("ALPAQA_BUILD_PARALLEL") or 0) or None
+    )
+    """Number of translation units to compile in parallel, or ``None`` to use
+    the default of the build tool."""
+
+    def __post_init__(self):
+        if self.optimization is not None:
+            self.optimization = str(self.optimization)
+            if self.optimization not in _MSVC_OPTIMIZATION:
+                raise ValueError(f"Invalid optimization level '{self.optimization}'")
+
+    def _compile_options(self) -> List[str]:
+        """CMake target_compile_options arguments."""
+        opts = []
+        if self.optimization is not None:
+            msvc = _MSVC_OPTIMIZATION[self.optimization]
+            gcc = f"-O{self.optimization}"
+            opts += [f"$<IF:$<C_COMPILER_ID:MSVC>,{msvc},{gcc}>"]
+        if self.native:
+            opts += ["$<$<NOT:$<C_COMPILER_ID:MSVC>>:-march=native>"]
+        opts += self.flags
+        return opts
+
+    def _cache_key(self) -> tuple:
+        # The compiler and its flags are selected by the environment during the
+        # first CMake configure step, so they are part of the key as well.
+        env = tuple(os.getenv(v) for v in ("CC", "CFLAGS", "ALPAQA_CMAKE_PROGRAM"))
+        return self.build_config, self._compile_options(), env
+
+
+def _hash_parts(parts: typing.Iterable) -> str:
+    """Hash CasADi functions and other (picklable) values."""
+    h = hashlib.sha256()
+    for part in parts:
+        if isinstance(part, cs.Function):
+            data = part.serialize().encode()
+        elif isinstance(part, str):
+            data = part.encode()
+        elif isinstance(part, dict):
+            data = pickle.dumps(sorted(part.items()), protocol=4)
+        else:
+            data = pickle.dumps(part, protocol=4)
+        h.update(len(data).to_bytes(8, "little"))
+        h.update(data)
+    return h.hexdigest()[:32]
+
+
+def _find_library(probdir: str, name: str) -> Optional[str]:
+    sofile = glob.glob(join(probdir, "lib", name + ".*"))
+    if len(sofile) == 0:
+        return None
+    elif len(sofile) > 1:
+        warnings.warn(f"Multiple compiled CasADi problem files were found for '{name}'")
+    return sofile[0]
+
+
+def _compile(
+    projdir: str,
+    probdir: str,
+    name: str,
+    functions: Dict[str, cs.Function],
+    options: CompileOptions,
+) -> str:
+    builddir = join(projdir, "build")
+    shutil.rmtree(projdir, ignore_errors=True)  # left over by a failed build
+    os.makedirs(builddir)
+
+    # Generate one translation unit per function, so they can be compiled in
+    # parallel, and so that a single large function does not slow down the
+    # compilation of all others
+    def generate(funcname, func):
+        codegen = cs.CodeGenerator(f"{name}_{funcname}.c")
+        codegen.add(func)
+        return os.path.basename(codegen.generate(join(projdir, "")))
+
+    cfiles = " ".join(generate(n, f) for n, f in functions.items())
+    compile_options = " ".join(f'"{opt}"' for opt in options._compile_options())
+    if compile_options:
+        compile_options = f"target_compile_options({name} PRIVATE {compile_options})"
+
+    # CMake configure script
+    cmakelists = f"""\
+        cmake_minimum_required(VERSION 3.17)
+        project(CasADi-{name} LANGUAGES C)
+        set(CMAKE_SHARED_LIBRARY_PREFIX "")
+        add_library({name} SHARED {cfiles})
+        {compile_options}
+        install(FILES $<TARGET_FILE:{name}>
+                DESTINATION lib)
+        install(FILES {cfiles}
+                DESTINATION src)
+        """
+    with open(join(projdir, "CMakeLists.txt"), "w") as f:
+        f.write(dedent(cmakelists))
+
+    # Run CMake
+    cmake = _get_cmake_bin()
+    # Configure
+    configure_cmd = [cmake, "-B", builddir, "-S", projdir]
+    if platform.system() == "Windows":
+        configure_cmd += ["-A", _get_windows_architecture()]
+    else:
+        configure_cmd += ["-G", "Ninja Multi-Config"]
+    # Build
+    build_cmd = [cmake, "--build", builddir, "--config", options.build_config, "-j"]
+    if options.parallel:
+        build_cmd += [str(options.parallel)]
+    # Install into a temporary directory first, so an interrupted installation
+    # is never mistaken for a valid cache entry
+    tmpdir = probdir + ".tmp"
+    shutil.rmtree(tmpdir, ignore_errors=True)
+    install_cmd = [
+        cmake,
+        "--install",
+        builddir,
+        "--config",
+        options.build_config,
+        "--prefix",
+        tmpdir,
+    ]
+    subprocess.run(configure_cmd, check=True)
+    subprocess.run(build_cmd, check=True)
+    subprocess.run(install_cmd, check=True)
+    if _find_library(tmpdir, name) is None:
+        raise RuntimeError(f"Unable to find compiled CasADi problem '{name}'")
+    shutil.rmtree(probdir, ignore_errors=True)
+    os.rename(tmpdir, probdir)
+    return _find_library(probdir, name)
+
+
+@contextlib.contextmanager
+def compiled_casadi_functions(
+    name: str,
+    key: typing.Iterable,
+    prepare: Callable[[], Dict[str, cs.Function]],
+    options: Optional[CompileOptions] = None,
+) -> Iterator[str]:
+    """
+    Context manager that yields the path to a shared library containing the
+    functions returned by ``prepare()``, compiling them only if the cache
+    does not contain them yet.
+
+    :param name:    Name of the library.
+    :param key:     CasADi functions and other values that (together with the
+                    compile options) uniquely determine the functions returned
+                    by ``prepare``. They are hashed to obtain the cache key, so
+                    identical problems are never compiled twice, not even by
+                    different processes.
+    :param prepare: Function that returns the CasADi functions to compile.
+    :param options: Compiler options.
+
+    The cache entry is locked until the context is exited, so other threads
+    and processes cannot modify its files (e.g. the CSV file with the
+    problem data) in the meantime.
+    """
+    if options is None:
+        options = CompileOptions()
+    cachedir = get_alpaqa_cache_dir()
+    key = (__version__, cs.__version__, name, *key, options._cache_key())
+    digest = _hash_parts(key)
+    probdir = join(cachedir, digest)
+    with cache_lock(digest, cachedir):
+        sofile = _find_library(probdir, name)
+        if sofile is None:
+            projdir = join(cachedir, "build", digest)
+            sofile = _compile(projdir, probdir, name, prepare(), options)
+        # Remove the problem data of previous users of this cache entry
+        with contextlib.suppress(FileNotFoundError):
+            os.remove(splitext(sofile)[0] + ".csv")
+        yield sofile
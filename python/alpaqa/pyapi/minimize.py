@@ -210,6 +210,9 @@ class MinimizationProblemDescription:
               ``SX`` expands the expressions and generally results in better
               run-time performance, while ``MX`` usually has faster compile
               times.
+            * **compile_options**: :py:class:`alpaqa.casadi_loader.CompileOptions` --
+              Build configuration, optimization level, ``-march=native`` and
+              other flags for the C compiler.
 
         """
 
@@ -0,0 +1,60 @@
+from concurrent.futures import ThreadPoolExecutor
+import os
+import pytest
+import threading
+import time
+
+
+def test_cache_lock(tmp_path):
+    from alpaqa.cache import cache_lock
+
+    active, overlaps = 0, 0
+    mtx = threading.Lock()
+
+    def use_cache(i):
+        nonlocal active, overlaps
+        with cache_lock("key", str(tmp_path)):
+            with mtx:
+                active += 1
+                overlaps += active > 1
+            time.sleep(0.01)
+            with mtx:
+                active -= 1
+
+    with ThreadPoolExecutor(4) as pool:
+        list(pool.map(use_cache, range(16)))
+    assert overlaps == 0
+    assert os.path.isfile(tmp_path / "key.lock")
+
+
+def test_compile_cache(tmp_path, monkeypatch):
+    cs = pytest.importorskip("casadi")
+    from alpaqa.casadi_loader import CompileOptions
+    import alpaqa.casadi_loader as cl
+
+    monkeypatch.setenv("ALPAQA_CACHE_DIR", str(tmp_path))
+
+    def functions():
+        x = cs.SX.sym("x", 2)
+        f = cs.Function("f", [x], [0.5 * cs.sumsqr(x)])
+        g = cs.Function("g", [x], [x])
+        return f, g
+
+    # Identical expressions are only compiled once
+    sofile1 = cl.generate_and_compile_casadi_problem_no_load(*functions(), name="cached")
+    mtime = os.path.getmtime(sofile1)
+    sofile2 = cl.generate_and_compile_casadi_problem_no_load(*functions(), name="cached")
+    assert sofile1 == sofile2
+    assert os.path.getmtime(sofile2) == mtime
+    # Different compiler options result in a different cache entry
+    opts = CompileOptions(optimization="2")
+    sofile3 = cl.generate_and_compile_casadi_problem_no_load(
+        *functions(), name="cached", compile_options=opts
+    )
+    assert sofile3 != sofile1
+    # Concurrent users of the cache load the same library
+    with ThreadPoolExecutor(2) as pool:
+        args = [functions() for _ in range(2)]
+        load = lambda fg: cl.generate_and_compile_casadi_problem(*fg, name="cached")
+        problems = list(pool.map(load, args))
+    assert all(p.n == 2 for p in problems)
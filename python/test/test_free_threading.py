@@ -0,0 +1,116 @@
+from concurrent.futures import ThreadPoolExecutor
+import alpaqa as pa
+import numpy as np
+import os
+import pytest
+import sys
+import threading
+import time
+
+
+def gil_enabled():
+    return getattr(sys, "_is_gil_enabled", lambda: True)()
+
+
+class Rosenbrock(pa.BoxConstrProblem):
+    def __init__(self, n):
+        super().__init__(n, 0)
+
+    def eval_f(self, x):
+        return np.sum((1 - x[:-1]) ** 2 + 100 * (x[1:] - x[:-1] ** 2) ** 2)
+
+    def eval_grad_f(self, x, grad_f):
+        r = x[1:] - x[:-1] ** 2
+        grad_f[:] = 0
+        grad_f[:-1] = -2 * (1 - x[:-1]) - 400 * x[:-1] * r
+        grad_f[1:] += 200 * r
+
+    def eval_g(self, x, gx): ...
+
+    def eval_grad_g_prod(self, x, y, grad_gxy):
+        grad_gxy[:] = 0
+
+
+def solve(i):
+    # Solvers and problems cannot be shared between threads, so create new ones
+    n = 4 + i % 4
+    problem = pa.Problem(Rosenbrock(n))
+    inner = pa.PANOCSolver({"max_iter": 10_000}, pa.LBFGSDirection({"memory": 10}))
+    solver = pa.ALMSolver({"tolerance": 1e-10}, inner)
+    x, y, stats = solver(problem, np.full(n, -1.2))
+    assert stats["status"] == pa.SolverStatus.Converged
+    return x, stats["inner"]["iterations"]
+
+
+def solve_batch(threads, num_solves):
+    t0 = time.perf_counter()
+    with ThreadPoolExecutor(threads) as pool:
+        results = list(pool.map(solve, range(num_solves)))
+    return time.perf_counter() - t0, results
+
+
+@pytest.mark.skipif(not hasattr(sys, "_is_gil_enabled"), reason="requires Python 3.13+")
+def test_module_keeps_gil_disabled():
+    # Importing the extension module should not re-enable the GIL in
+    # free-threaded builds of Python
+    if "t" not in getattr(sys, "abiflags", ""):
+        pytest.skip("requires a free-threaded build of Python")
+    assert not gil_enabled()
+
+
+def test_concurrent_solves():
+    num_solves = 32
+    _, ref = solve_batch(1, num_solves)
+    _, res = solve_batch(4, num_solves)
+    for (x_ref, it_ref), (x, it) in zip(ref, res):
+        assert np.all(x == x_ref)
+        assert it == it_ref
+        assert np.allclose(x, 1)
+
+
+@pytest.mark.skipif(gil_enabled(), reason="requires free-threaded Python")
+@pytest.mark.skipif((os.cpu_count() or 1) < 4, reason="requires at least 4 CPUs")
+@pytest.mark.skipif(
+    not os.environ.get("ALPAQA_BENCHMARK"),
+    reason="timing benchmark, set ALPAQA_BENCHMARK=1 to run",
+)
+def test_concurrent_solves_scaling():
+    num_solves = 64
+    solve_batch(4, 8)  # warm up the solver thread pool
+    t1, _ = solve_batch(1, num_solves)
+    t4, _ = solve_batch(4, num_solves)
+    print(f"1 thread: {t1:.3f} s, 4 threads: {t4:.3f} s, speedup: {t1 / t4:.2f}")
+    # Conservative bound, to avoid spurious failures on busy machines
+    assert t4 < 0.75 * t1
+
+
+def test_same_solver_multiple_threads():
+    # Using the same solver concurrently is an error, also for synchronous
+    # calls, which redirect the solver's output stream
+    problem = pa.Problem(Rosenbrock(4))
+    inner = pa.PANOCSolver({"max_iter": 10_000}, pa.LBFGSDirection({"memory": 10}))
+    solver = pa.ALMSolver({"tolerance": 1e-10}, inner)
+    barrier = threading.Barrier(2)
+
+    class SlowRosenbrock(Rosenbrock):
+        def eval_f(self, x):
+            time.sleep(1e-4)
+            return super().eval_f(x)
+
+    def run(_):
+        barrier.wait()
+        try:
+            solver(pa.Problem(SlowRosenbrock(4)), np.full(4, -1.2), asynchronous=False)
+            return None
+        except RuntimeError as e:
+            return e
+
+    with ThreadPoolExecutor(2) as pool:
+        errors = list(pool.map(run, range(2)))
+    failed = [e for e in errors if e is not None]
+    assert len(failed) <= 1
+    for e in failed:
+        assert "used in multiple threads" in str(e)
+    # The solver can be used again afterwards
+    x, _, stats = solver(problem, np.full(4, -1.2))
+    assert stats["status"] == pa.SolverStatus.Converged
@@ -52,3 +52,167 @@ def test_problem_obj():
     assert problem.provides_get_box_C()
     assert problem.provides_get_box_D()
     assert problem.provides_check()
+
+
+def test_problem_native_functions():
+    import ctypes
+
+    real_p = ctypes.POINTER(ctypes.c_double)
+    f_t = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_void_p, real_p)
+    grad_f_t = ctypes.CFUNCTYPE(None, ctypes.c_void_p, real_p, real_p)
+    scale = ctypes.c_double(3)
+
+    @f_t
+    def eval_f(instance, x):
+        s = ctypes.cast(instance, real_p)[0]
+        return s * (x[0] ** 2 + x[1] ** 2)
+
+    @grad_f_t
+    def eval_grad_f(instance, x, grad_fx):
+        s = ctypes.cast(instance, real_p)[0]
+        grad_fx[0], grad_fx[1] = 2 * s * x[0], 2 * s * x[1]
+
+    class MyNativeProblem(alpaqa.BoxConstrProblem):
+        def __init__(self):
+            super().__init__(2, 0)
+            self.native_functions = {
+                "instance": ctypes.addressof(scale),
+                "eval_f": eval_f,
+                "eval_grad_f": ctypes.cast(eval_grad_f, ctypes.c_void_p).value,
+            }
+
+        def eval_g(self, x, gx): ...
+        def eval_grad_g_prod(self, x, y, grad_gxy):
+            grad_gxy[:] = 0
+
+    problem = alpaqa.Problem(MyNativeProblem())
+    x = np.array([1.0, -2.0])
+    assert problem.eval_f(x) == 15
+    assert np.all(problem.eval_grad_f(x) == [6, -12])
+    assert not problem.provides_eval_f_grad_f()
+
+    class InvalidProblem(MyNativeProblem):
+        def __init__(self):
+            super().__init__()
+            self.native_functions = {"eval_h": 0}
+
+    try:
+        alpaqa.Problem(InvalidProblem())
+        assert False
+    except ValueError as e:
+        assert "eval_h" in str(e)
+
+
+def test_problem_native_functions_dispatch():
+    import ctypes
+
+    Q = np.array([[1.5, 0.5], [0.5, 1.5]])
+    python_calls = {}
+    native_calls = {}
+
+    class PyQuadProblem(alpaqa.BoxConstrProblem):
+        def __init__(self):
+            super().__init__(2, 2)
+            self.D.lowerbound = [-np.inf, 0.5]
+
+        def count(self, name):
+            python_calls[name] = python_calls.get(name, 0) + 1
+
+        def eval_f(self, x):
+            self.count("eval_f")
+            return 0.5 * x @ Q @ x
+
+        def eval_grad_f(self, x, grad_fx):
+            self.count("eval_grad_f")
+            grad_fx[:] = Q @ x
+
+        def eval_g(self, x, gx):
+            self.count("eval_g")
+            gx[:] = x
+
+        def eval_grad_g_prod(self, x, y, grad_gxy):
+            self.count("eval_grad_g_prod")
+            grad_gxy[:] = y
+
+    real_p = ctypes.POINTER(ctypes.c_double)
+    f_t = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_void_p, real_p)
+    vec_t = ctypes.CFUNCTYPE(None, ctypes.c_void_p, real_p, real_p)
+    vec2_t = ctypes.CFUNCTYPE(None, ctypes.c_void_p, real_p, real_p, real_p)
+
+    def count(name):
+        native_calls[name] = native_calls.get(name, 0) + 1
+
+    @f_t
+    def eval_f(instance, x):
+        count("eval_f")
+        x = np.ctypeslib.as_array(x, (2,))
+        return 0.5 * x @ Q @ x
+
+    @vec_t
+    def eval_grad_f(instance, x, grad_fx):
+        count("eval_grad_f")
+        x = np.ctypeslib.as_array(x, (2,))
+        np.ctypeslib.as_array(grad_fx, (2,))[:] = Q @ x
+
+    @vec_t
+    def eval_g(instance, x, gx):
+        count("eval_g")
+        np.ctypeslib.as_array(gx, (2,))[:] = np.ctypeslib.as_array(x, (2,))
+
+    @vec2_t
+    def eval_grad_g_prod(instance, x, y, grad_gxy):
+        count("eval_grad_g_prod")
+        y = np.ctypeslib.as_array(y, (2,))
+        np.ctypeslib.as_array(grad_gxy, (2,))[:] = y
+
+    # Same problem, but the native functions take precedence over the
+    # (inherited) Python methods
+    class NativeQuadProblem(PyQuadProblem):
+        def __init__(self):
+            super().__init__()
+            self.native_functions = {
+                "eval_f": eval_f,
+                "eval_grad_f": eval_grad_f,
+                "eval_g": eval_g,
+                "eval_grad_g_prod": eval_grad_g_prod,
+            }
+
+    py_problem = alpaqa.Problem(PyQuadProblem())
+    native_problem = alpaqa.Problem(NativeQuadProblem())
+
+    # Individual evaluations
+    x, y = np.array([1.0, -2.0]), np.array([0.5, 3.0])
+    for problem in (py_problem, native_problem):
+        assert problem.eval_f(x) == 0.5 * x @ Q @ x
+        assert np.all(problem.eval_grad_f(x) == Q @ x)
+        assert np.all(problem.eval_g(x) == x)
+        assert np.all(problem.eval_grad_g_prod(x, y) == y)
+    assert native_calls == python_calls
+    python_calls.clear()
+    native_calls.clear()
+
+    # Full solve, the solver evaluates the problem from C++
+    def solve(problem):
+        solver = alpaqa.ALMSolver(
+            alpaqa.ALMParams(tolerance=1e-12, dual_tolerance=1e-12),
+            alpaqa.PANOCSolver(
+                alpaqa.PANOCParams(max_iter=200),
+                alpaqa.LBFGSDirection(alpaqa.LBFGS.Params(memory=5)),
+            ),
+        )
+        return solver(problem, x=np.array([3.0, 3.0]), y=np.zeros(2))
+
+    x_py, y_py, stats_py = solve(py_problem)
+    assert stats_py["status"] == alpaqa.SolverStatus.Converged
+    assert python_calls["eval_f"] > 0 and not native_calls
+    py_evaluations = dict(python_calls)
+    python_calls.clear()
+
+    x_nat, y_nat, stats_nat = solve(native_problem)
+    assert stats_nat["status"] == alpaqa.SolverStatus.Converged
+    assert not python_calls
+    assert native_calls == py_evaluations
+    assert np.all(x_nat == x_py)
+    assert np.all(y_nat == y_py)
+    assert stats_nat["inner"]["iterations"] == stats_py["inner"]["iterations"]
+    assert np.linalg.norm(x_nat - [-1 / 6, 0.5]) < 1e-5
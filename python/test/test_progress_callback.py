@@ -0,0 +1,62 @@
+import alpaqa as pa
+import numpy as np
+
+
+class Rosenbrock(pa.BoxConstrProblem):
+    def __init__(self):
+        super().__init__(2, 0)
+
+    def eval_f(self, x):
+        return (1 - x[0]) ** 2 + 100 * (x[1] - x[0] ** 2) ** 2
+
+    def eval_grad_f(self, x, grad_f):
+        grad_f[0] = -2 * (1 - x[0]) - 400 * x[0] * (x[1] - x[0] ** 2)
+        grad_f[1] = 200 * (x[1] - x[0] ** 2)
+
+    def eval_g(self, x, gx): ...
+
+    def eval_grad_g_prod(self, x, y, grad_gxy):
+        grad_gxy[:] = 0
+
+
+def solve(callback, **kwargs):
+    problem = pa.Problem(Rosenbrock())
+    solver = pa.PANOCSolver({"max_iter": 1000}, pa.LBFGSDirection())
+    solver.set_progress_callback(callback, **kwargs)
+    return solver(problem, {"tolerance": 1e-10}, np.array([-1.2, 1.0]))
+
+
+def test_progress_callback_every():
+    calls = []
+
+    def callback(info: pa.PANOCProgressInfo):
+        # Vectors are read-only views, only valid during the callback
+        assert not info.x.flags.writeable
+        calls.append((info.k, info.status, np.copy(info.x_hat)))
+
+    x, stats = solve(callback)
+    assert len(calls) == stats["iterations"] + 1
+    assert np.all(calls[-1][2] == x)
+    calls.clear()
+    x, stats = solve(callback, every=5)
+    # Every fifth iteration, plus the final one
+    busy = [k for k, status, _ in calls if status == pa.SolverStatus.Busy]
+    assert busy == list(range(0, stats["iterations"], 5))
+    assert calls[-1][0] == stats["iterations"]
+    assert calls[-1][1] == pa.SolverStatus.Converged
+    assert np.all(calls[-1][2] == x)
+
+
+def test_progress_callback_min_interval():
+    calls = []
+    x, stats = solve(lambda info: calls.append(info.k), min_interval=3600)
+    # Only the first and the final iteration
+    assert calls == [0, stats["iterations"]]
+
+
+def test_progress_callback_none():
+    problem = pa.Problem(Rosenbrock())
+    solver = pa.PANOCSolver()
+    assert solver.set_progress_callback(lambda info: None) is solver
+    solver.set_progress_callback(None)
+    solver(problem, x=np.array([-1.2, 1.0]))
@@ -39,6 +39,21 @@ def test_nuclear_norm_reshape():
     assert np.allclose(y, U @ Σ_expected @ V.T, rtol=1e-12, atol=1e-12)
 
 
+def test_truncated_nuclear_norm():
+    rng = np.random.default_rng(12345)
+    x = rng.standard_normal((60, 3)) @ rng.standard_normal((3, 40))
+    x += 1e-3 * rng.standard_normal((60, 40))
+    h_full = pa.functions.NuclearNorm(1)
+    h = pa.functions.TruncatedNuclearNorm(1)
+    for _ in range(3):
+        x += 1e-3 * rng.standard_normal((60, 40))
+        hy_full, y_full = pa.prox(h_full, x, 0.5)
+        hy, y = pa.prox(h, x, 0.5)
+        assert h.rank == 3
+        assert abs(hy - hy_full) < 1e-8 * hy_full
+        assert np.allclose(y, y_full, rtol=1e-8, atol=1e-8)
+
+
 def test_l1_norm():
     x = [-1, -0.125, -0.1, 0, 0.05, 0.12, 0.13, 1, 100]
     y_expected = np.array([-0.875, 0, 0, 0, 0, 0, 0.005, 0.875, 99.875])
@@ -143,6 +158,53 @@ def test_box_step():
     assert hy == 0
 
 
+def test_l21_norm():
+    x = np.array([[3, 0.1], [4, 0.2]])
+    hy, y = pa.prox(pa.functions.L21Norm(0.5), x, 2)
+    assert np.allclose(y, [[2.4, 0], [3.2, 0]], rtol=1e-12, atol=1e-12)
+    assert abs(hy - 0.5 * 4) < 1e-12
+    h = pa.functions.L21Norm(1, [0, 2])
+    hy, y = pa.prox(h, [3, 4, 2], 1)
+    assert np.allclose(y.ravel(), [2.4, 3.2, 1], rtol=1e-12, atol=1e-12)
+    assert abs(hy - 5) < 1e-12
+
+
+def test_elastic_net():
+    x = np.array([-2, -0.1, 0.05, 1.5])
+    h = pa.functions.ElasticNet(0.5, 2)
+    hy, y = pa.prox(h, x, 0.5)
+    y_expected = np.sign(x) * np.fmax(np.abs(x) - 0.25, 0) / 2
+    assert np.allclose(y.ravel(), y_expected, rtol=1e-12, atol=1e-12)
+    assert abs(hy - (0.5 * la.norm(y_expected, 1) + la.norm(y_expected) ** 2)) < 1e-12
+
+
+def test_linf_ball():
+    x = np.array([-1, -0.25, 0.25, 2])
+    hy, y = pa.prox(pa.functions.LInfBall(0.5), x)
+    assert np.allclose(y.ravel(), [-0.5, -0.25, 0.25, 0.5], rtol=1e-12, atol=1e-12)
+    assert hy == 0
+
+
+def test_simplex():
+    rng = np.random.default_rng(4321)
+    x = rng.standard_normal(100)
+    hy, y = pa.prox(pa.functions.Simplex(2), x)
+    μ = np.sort(x)[::-1]
+    t = (np.cumsum(μ) - 2) / np.arange(1, len(μ) + 1)
+    θ = t[np.nonzero(μ - t > 0)[0][-1]]
+    assert np.allclose(y.ravel(), np.fmax(x - θ, 0), rtol=1e-12, atol=1e-12)
+    assert hy == 0
+
+
+def test_l1_ball():
+    rng = np.random.default_rng(4321)
+    x = 5 * rng.standard_normal(100)
+    hy, y = pa.prox(pa.functions.L1Ball(3), x)
+    assert abs(la.norm(y.ravel(), 1) - 3) < 1e-10
+    assert np.all(np.sign(y.ravel()) * np.sign(x) >= 0)
+    assert hy == 0
+
+
 if __name__ == "__main__":
     test_nuclear_norm()
     test_nuclear_norm_reshape()
@@ -152,3 +214,8 @@ if __name__ == "__main__":
     test_box()
     test_box_matrix()
     test_box_step()
+    test_l21_norm()
+    test_elastic_net()
+    test_linf_ball()
+    test_simplex()
+    test_l1_ball()
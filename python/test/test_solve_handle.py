@@ -0,0 +1,76 @@
+from copy import deepcopy
+import alpaqa as pa
+import numpy as np
+import pytest
+import time
+
+
+class Rosenbrock(pa.BoxConstrProblem):
+    def __init__(self):
+        super().__init__(2, 0)
+
+    def eval_f(self, x):
+        return (1 - x[0]) ** 2 + 100 * (x[1] - x[0] ** 2) ** 2
+
+    def eval_grad_f(self, x, grad_f):
+        grad_f[0] = -2 * (1 - x[0]) - 400 * x[0] * (x[1] - x[0] ** 2)
+        grad_f[1] = 200 * (x[1] - x[0] ** 2)
+
+    def eval_g(self, x, gx): ...
+
+    def eval_grad_g_prod(self, x, y, grad_gxy):
+        grad_gxy[:] = 0
+
+
+def test_inner_submit():
+    problem = pa.Problem(Rosenbrock())
+    solver = pa.PANOCSolver({"max_iter": 1000}, pa.LBFGSDirection())
+    x0 = np.array([-1.2, 1.0])
+    handle = solver.submit(problem, {"tolerance": 1e-10}, x0)
+    # The solver and problem are in use until the result is retrieved
+    with pytest.raises(RuntimeError, match=r"used in multiple threads"):
+        solver(problem, {"tolerance": 1e-10}, x0)
+    x, stats = handle.result()
+    assert handle.done()
+    assert stats["status"] == pa.SolverStatus.Converged
+    assert np.allclose(x, [1, 1])
+    # The result can be retrieved more than once
+    assert handle.result()[1]["iterations"] == stats["iterations"]
+    # Same result as a blocking call
+    x_sync, stats_sync = solver(problem, {"tolerance": 1e-10}, x0)
+    assert np.all(x == x_sync)
+    assert stats_sync["iterations"] == stats["iterations"]
+
+
+class SlowRosenbrock(Rosenbrock):
+    def eval_grad_f(self, x, grad_f):
+        time.sleep(0.01)
+        super().eval_grad_f(x, grad_f)
+
+
+def test_inner_submit_stop():
+    problem = pa.Problem(SlowRosenbrock())
+    solver = pa.PANOCSolver({"max_iter": 1000}, pa.LBFGSDirection())
+    handle = solver.submit(problem, {"tolerance": 1e-10}, np.array([-1.2, 1.0]))
+    with pytest.raises(TimeoutError):
+        handle.result(timeout=0.01)
+    handle.stop()
+    _, stats = handle.result()
+    assert stats["status"] == pa.SolverStatus.Interrupted
+
+
+def test_alm_submit():
+    problem = pa.Problem(Rosenbrock())
+    solver = pa.ALMSolver(pa.PANOCSolver({"max_iter": 1000}, pa.LBFGSDirection()))
+    handles = [deepcopy(solver).submit(deepcopy(problem)) for _ in range(8)]
+    for handle in handles:
+        x, y, stats = handle.result()
+        assert stats["status"] == pa.SolverStatus.Converged
+        assert np.allclose(x, [1, 1], atol=1e-4)
+
+
+if __name__ == "__main__":
+    test_inner_submit()
+    test_inner_submit_stop()
+    test_alm_submit()
+    print("done.")
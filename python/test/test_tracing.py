@@ -0,0 +1,45 @@
+import json
+import os
+import tempfile
+import alpaqa as pa
+import numpy as np
+import pytest
+
+
+@pytest.mark.skipif(not pa.with_casadi, reason="requires CasADi")
+@pytest.mark.skipif(not pa.tracing.available, reason="requires tracing")
+def test_tracing():
+    import casadi as cs
+
+    x = cs.SX.sym("x", 2)
+    Q = np.array([[1.5, 0.5], [0.5, 1.5]])
+    f = 0.5 * x.T @ Q @ x
+    g = x
+    D = [-np.inf, 0.5], [+np.inf, +np.inf]
+    p = pa.minimize(f, x).subject_to(g, D).compile()
+    solver = pa.ALMSolver(pa.ALMParams(), pa.PANOCSolver())
+    cnt = pa.problem_with_counters(p)
+
+    assert not pa.tracing.is_enabled()
+    pa.tracing.start()
+    assert pa.tracing.is_enabled()
+    x, y, stats = solver(cnt.problem, x=np.array([3, 3]), y=np.zeros((2, )))
+    pa.tracing.stop()
+    assert not pa.tracing.is_enabled()
+    assert stats['status'] == pa.SolverStatus.Converged
+    assert pa.tracing.num_events() > 0
+    assert pa.tracing.num_dropped_events() == 0
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "trace.json")
+        pa.tracing.write_chrome_trace(path)
+        with open(path, encoding="utf-8") as f:
+            events = json.load(f)["traceEvents"]
+    pa.tracing.clear()
+    assert pa.tracing.num_events() == 0
+    names = {e["name"] for e in events}
+    assert {"ALM", "outer_iteration", "PANOC", "iteration"} <= names
+    assert any(e["cat"] == "eval" for e in events)
+    begin = sum(e["ph"] == "B" for e in events)
+    end = sum(e["ph"] == "E" for e in events)
+    assert begin == end
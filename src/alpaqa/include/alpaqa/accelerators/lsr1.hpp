@@ -0,0 +1,146 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace alpaqa {
+
+/// Parameters for the @ref LSR1 class.
+/// @ingroup grp_Parameters
+template <Config Conf = DefaultConfig>
+struct LSR1Params {
+    USING_ALPAQA_CONFIG(Conf);
+
+    /// Length of the history to keep.
+    length_t memory = 10;
+    /// Reject update if @f$ s^\top s \le \text{min_abs_s} @f$.
+    real_t min_abs_s =
+        std::pow(std::numeric_limits<real_t>::epsilon(), real_t(2));
+    /// Reject update if the reciprocal condition number of the middle matrix
+    /// @f$ M @f$ of the compact representation would drop below this value.
+    /// This is the limited-memory equivalent of the usual SR1 safeguard
+    /// @f$ |s^\top (y - Bs)| \ge r \|s\| \|y - Bs\| @f$, and keeps the
+    /// approximation well-defined.
+    real_t min_rcond = std::sqrt(std::numeric_limits<real_t>::epsilon());
+};
+
+/// Limited-memory symmetric rank-one (L-SR1) Hessian approximation, using the
+/// compact representation
+/// @f[ B = \delta I + \Psi M^{-1} \Psi^\top, \quad \Psi = Y - \delta S,
+///     \quad M = D + L + L^\top - \delta S^\top S, @f]
+/// where @f$ D @f$ and @f$ L @f$ are the diagonal and the strictly lower
+/// triangular parts of @f$ S^\top Y @f$. Unlike L-BFGS, the approximation
+/// can be indefinite, so it is meant to be used in trust-region methods.
+/// @see    R. H. Byrd, J. Nocedal, and R. B. Schnabel, “Representations of
+///         quasi-Newton matrices and their use in limited memory methods,”
+///         Mathematical Programming, vol. 63, pp. 129–156, 1994.
+/// @see    J. Brust, J. B. Erway, and R. F. Marcia, “On solving L-SR1
+///         trust-region subproblems,” Computational Optimization and
+///         Applications, vol. 66, pp. 245–266, 2017.
+/// @ingroup grp_Accelerators
+template <Config Conf = DefaultConfig>
+class LSR1 {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+
+    using Params = LSR1Params<config_t>;
+
+    LSR1() = default;
+    LSR1(Params params) : params(params) {}
+    LSR1(Params params, length_t n) : params(params) { resize(n); }
+
+    /// Update the Hessian approximation using the new vectors
+    /// sₖ = xₙₑₓₜ - xₖ and yₖ = gₙₑₓₜ - gₖ.
+    bool update_sy(crvec s, crvec y);
+    /// Update the Hessian approximation using the new iterate xₙₑₓₜ and the
+    /// gradient gₙₑₓₜ in that point.
+    bool update(crvec xₖ, crvec xₙₑₓₜ, crvec gₖ, crvec gₙₑₓₜ);
+
+    /// Compute the product of the Hessian approximation with the vector v.
+    /// If no pairs have been stored yet, @f$ B = \delta_0 I @f$.
+    void apply_hess(crvec v, rvec Bv, real_t δ_0) const;
+
+    /// Minimize the quadratic model @f$ g^\top q + \tfrac12 q^\top B_{JJ} q
+    /// @f$ subject to @f$ \|q\| \le \Delta @f$, where @f$ B_{JJ} @f$ is the
+    /// submatrix of the Hessian approximation with rows and columns in the
+    /// index set @f$ J @f$. The subproblem is solved exactly, using the
+    /// spectral decomposition of @f$ B_{JJ} @f$ obtained from a thin QR
+    /// factorization of @f$ \Psi_J @f$.
+    /// @param  g
+    ///         Gradient of the model, of size @f$ |J| @f$.
+    /// @param  J
+    ///         Index set.
+    /// @param  radius
+    ///         Trust radius @f$ \Delta @f$.
+    /// @param  δ_0
+    ///         Scale of the approximation @f$ B = \delta_0 I @f$ if no pairs
+    ///         have been stored yet.
+    /// @param  q
+    ///         Output: minimizer of the model, of size @f$ |J| @f$.
+    /// @return The value of the model in @p q.
+    real_t solve_trust_region_masked(crvec g, crindexvec J, real_t radius,
+                                     real_t δ_0, rvec q) const;
+
+    /// Throw away the approximation and all previous vectors s and y.
+    void reset();
+    /// Re-allocate storage for a problem with a different size. Causes
+    /// a @ref reset.
+    void resize(length_t n);
+
+    /// Get a string identifier for this accelerator.
+    std::string get_name() const {
+        return "LSR1<" + std::string(config_t::get_name()) + '>';
+    }
+    /// Get the parameters.
+    const Params &get_params() const { return params; }
+
+    /// Get the size of the s and y vectors in the buffer.
+    length_t n() const { return S.rows(); }
+    /// Get the number of previous vectors s and y stored in the buffer.
+    length_t history() const { return params.memory; }
+    /// Get the number of previous s and y vectors currently stored in the
+    /// buffer.
+    length_t current_history() const { return count; }
+    /// Get the scale @f$ \delta @f$ of the initial approximation
+    /// @f$ B_0 = \delta I @f$.
+    real_t get_scale() const { return δ; }
+
+  private:
+    /// Add the pair in column @ref next_col of @ref S and @ref Y to the
+    /// compact representation.
+    bool commit_pair();
+    /// Index of the column of the circular buffer where the next pair will be
+    /// stored.
+    index_t next_col() const { return (start + count) % S.cols(); }
+
+    Params params;
+    /// Circular buffers with one more column than the memory, so that a new
+    /// pair can be checked before overwriting the oldest one.
+    mat S, Y;
+    /// Compact representation, in chronological order.
+    mat Ψ, M_inv;
+    /// Workspaces for the next compact representation.
+    mutable mat Ψ_next, M, M_inv_next;
+    mutable vec work_m, work_m_2;
+    real_t δ      = NaN<config_t>;
+    index_t start = 0;
+    length_t count = 0;
+};
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, LSR1Params, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, LSR1Params, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, LSR1Params, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, LSR1Params, EigenConfigq);)
+
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, LSR1, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, LSR1, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, LSR1, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, LSR1, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
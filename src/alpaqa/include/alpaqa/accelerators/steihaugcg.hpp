@@ -3,9 +3,50 @@
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
 
 namespace alpaqa {
 
+/// Preconditioners for the conjugate gradient iterations of @ref SteihaugCG,
+/// as used by the @ref NewtonTRDirection.
+/// @ingroup grp_Parameters
+enum class SteihaugCGPreconditioner {
+    /// No preconditioning.
+    None,
+    /// Jacobi preconditioner, using the diagonal of the Hessian of the
+    /// augmented Lagrangian @f$ \nabla^2 \psi @f$. Requires
+    /// @ref TypeErasedProblem::eval_hess_ψ.
+    HessianDiagonal,
+    /// Diagonal preconditioner using the column norms of the constraint
+    /// Jacobian, weighted by the penalty factors of the active constraints,
+    /// i.e. the diagonal of the Gauss-Newton approximation
+    /// @f$ J_g^\top \Sigma_{\mathcal{A}} J_g @f$ of the Hessian of the penalty
+    /// term. Does not take the curvature of the objective into account.
+    /// Requires @ref TypeErasedProblem::eval_jac_g.
+    JacobianColumnNorms,
+    /// Limited-memory BFGS approximation of the inverse Hessian, built from
+    /// the most recent Hessian-vector products of the previous CG solves.
+    LBFGS,
+    /// User-supplied preconditioner, see
+    /// @ref NewtonTRDirection::custom_preconditioner.
+    Custom,
+};
+
+inline constexpr const char *enum_name(SteihaugCGPreconditioner s) {
+    using enum SteihaugCGPreconditioner;
+    switch (s) {
+        case None: return "None";
+        case HessianDiagonal: return "HessianDiagonal";
+        case JacobianColumnNorms: return "JacobianColumnNorms";
+        case LBFGS: return "LBFGS";
+        case Custom: return "Custom";
+        default:;
+    }
+    throw std::out_of_range("invalid value for "
+                            "alpaqa::SteihaugCGPreconditioner");
+}
+
 /// Parameters for @ref SteihaugCG.
 /// @ingroup grp_Parameters
 template <Config Conf>
@@ -31,10 +72,29 @@ struct SteihaugCGParams {
     /// \mathrm{max\_iter\_factor} \rceil @f$, where @f$ n @f$ is the number
     /// of free variables of the problem.
     real_t max_iter_factor = 1;
+    /// Preconditioner for the conjugate gradient iterations. Preconditioning
+    /// reduces the number of Hessian-vector products for ill-conditioned
+    /// problems, but the diagonal preconditioners require additional
+    /// evaluations of the Hessian or the constraint Jacobian.
+    SteihaugCGPreconditioner preconditioner = SteihaugCGPreconditioner::None;
+    /// Lower bound on the elements of the diagonal preconditioners, relative
+    /// to the largest element.
+    real_t precond_min_diag = real_t(1e-8);
+    /// Number of Hessian-vector products used by the L-BFGS preconditioner.
+    length_t precond_memory = 5;
 };
 
 /// Steihaug conjugate gradients procedure based on
 /// https://github.com/scipy/scipy/blob/583e70a50573169fc352b5dc6d94588a97c7389a/scipy/optimize/_trustregion_ncg.py#L44
+///
+/// With a preconditioner @f$ M^{-1} @f$, the conjugate gradient iterations
+/// are carried out in the @f$ M @f$-inner product, and the trust region is the
+/// ellipsoid @f$ \|p\|_M = \sqrt{p^\top M p} \le \Delta @f$ (Conn, Gould and
+/// Toint, Trust-Region Methods, §7.5.1). Only in this norm do the norms of the
+/// iterates increase monotonically, which is what justifies stopping at the
+/// first intersection with the boundary. The @f$ M @f$-norms are updated
+/// using the CG recurrences, so @f$ M @f$ itself is never needed.
+/// The stopping criterion uses the Euclidean norm of the residual.
 template <Config Conf>
 struct SteihaugCG {
     USING_ALPAQA_CONFIG(Conf);
@@ -45,31 +105,66 @@ struct SteihaugCG {
     SteihaugCG() = default;
     SteihaugCG(const Params &params) : params{params} {}
 
-    mutable vec z, r, d, Bd, work_eval;
+    mutable vec z, r, d, Bd, Mr, work_eval;
 
     void resize(length_t n) {
         z.resize(n);
         r.resize(n);
         d.resize(n);
         Bd.resize(n);
+        Mr.resize(n);
         work_eval.resize(n);
     }
 
+    /// Identity preconditioner, used when no preconditioner is given.
+    struct NoPreconditioner {
+        void operator()(crvec r, rvec Mr) const { Mr = r; }
+    };
+
     template <class HessFun>
     real_t solve(const auto &grad, const HessFun &hess_prod,
                  real_t trust_radius, rvec step) const {
+        return solve(grad, hess_prod, NoPreconditioner{}, trust_radius, step);
+    }
+
+    /// @param  grad
+    ///         Gradient of the quadratic model.
+    /// @param  hess_prod
+    ///         Function that computes the Hessian-vector product
+    ///         `hess_prod(p, Bp)`.
+    /// @param  precond
+    ///         Function that applies the inverse of a positive definite
+    ///         preconditioner `precond(r, Mr)`, i.e. @f$ M^{-1} r @f$. It
+    ///         should not change during the solve.
+    /// @param  trust_radius
+    ///         Radius of the trust region, in the norm induced by the
+    ///         preconditioner @f$ \|p\|_M @f$.
+    /// @param  step
+    ///         Output: approximate minimizer of the model in the trust region.
+    /// @return The value of the quadratic model in @p step.
+    template <class HessFun, class PrecondFun>
+    real_t solve(const auto &grad, const HessFun &hess_prod,
+                 const PrecondFun &precond, real_t trust_radius,
+                 rvec step) const {
         length_t n = grad.size();
         // get the norm of jacobian and define the origin
         auto v = [n](auto &v) { return v.topRows(n); };
         auto z = v(this->z), r = v(this->r), d = v(this->d), Bd = v(this->Bd);
-        auto g = v(grad);
-        auto s = v(step);
+        auto Mr = v(this->Mr);
+        auto g  = v(grad);
+        auto s  = v(step);
         // init the state for the first iteration
         z.setZero();
-        r               = g;
-        d               = -r;
-        real_t r_sq     = r.squaredNorm();
+        r = g;
+        precond(r, Mr);
+        d               = -Mr;
+        real_t rMr      = r.dot(Mr);
         real_t grad_mag = g.norm();
+        // M-norms of the iterate and the search direction, and their M-inner
+        // product. Without preconditioner, M = I and they are computed
+        // directly.
+        constexpr bool euclidean = std::is_same_v<PrecondFun, NoPreconditioner>;
+        real_t zMz = 0, zMd = 0, dMd = rMr;
 
         // define a default tolerance
         real_t tolerance =
@@ -94,10 +189,10 @@ struct SteihaugCG {
             if (dBd <= 0) {
                 // Look at the two boundary points.
                 // Find both values of t to get the boundary points such that
-                // ||z + t d|| == trust_radius
+                // ||z + t d||_M == trust_radius
                 // and then choose the one with the predicted min value.
                 auto [ta, tb] =
-                    get_boundaries_intersections(z, d, trust_radius);
+                    get_boundaries_intersections(zMz, zMd, dMd, trust_radius);
                 auto &pa   = r; // Reuse storage
                 auto &pb   = d; // Reuse storage
                 pa         = z + ta * d;
@@ -113,29 +208,42 @@ struct SteihaugCG {
                 }
             }
 
-            real_t alpha = r_sq / dBd;
+            real_t alpha = rMr / dBd;
             if (!std::isfinite(alpha)) {
                 s.setConstant(NaN<config_t>);
                 return NaN<config_t>;
             }
-            s = z + alpha * d;
-            if (s.norm() >= trust_radius) {
+            s          = z + alpha * d;
+            real_t sMs = euclidean
+                             ? s.squaredNorm()
+                             : zMz + alpha * (2 * zMd + alpha * dMd);
+            if (std::sqrt(sMs) >= trust_radius) {
                 // Find t >= 0 to get the boundary point such that
-                // ||z + t d|| == trust_radius
+                // ||z + t d||_M == trust_radius
                 auto [ta, tb] =
-                    get_boundaries_intersections(z, d, trust_radius);
+                    get_boundaries_intersections(zMz, zMd, dMd, trust_radius);
                 s = z + tb * d;
                 return eval(s);
             }
             r += alpha * Bd;
-            real_t r_next_sq = r.squaredNorm();
-            real_t r_next    = std::sqrt(r_next_sq);
+            real_t r_next = r.norm();
             if (r_next < tolerance || r_next == 0 || i > max_iter)
                 return eval(s);
-            real_t beta_next = r_next_sq / r_sq;
-            r_sq             = r_next_sq;
-            d                = beta_next * d - r;
+            precond(r, Mr);
+            real_t rMr_next  = r.dot(Mr);
+            real_t beta_next = rMr_next / rMr;
+            rMr              = rMr_next;
+            d                = beta_next * d - Mr;
             z                = s;
+            if constexpr (euclidean) {
+                zMz = z.squaredNorm();
+                zMd = z.dot(d);
+                dMd = d.squaredNorm();
+            } else {
+                zMz = sMs;
+                zMd = beta_next * (zMd + alpha * dMd);
+                dMd = rMr + beta_next * beta_next * dMd;
+            }
             ++i;
         }
     }
@@ -145,9 +253,18 @@ struct SteihaugCG {
     /// Return the two values of t, sorted from low to high.
     static auto get_boundaries_intersections(crvec z, crvec d,
                                              real_t trust_radius) {
-        real_t a = d.squaredNorm();
-        real_t b = 2 * z.dot(d);
-        real_t c = z.squaredNorm() - trust_radius * trust_radius;
+        return get_boundaries_intersections(z.squaredNorm(), z.dot(d),
+                                            d.squaredNorm(), trust_radius);
+    }
+
+    /// Solve the scalar quadratic equation ||z + t d||_M == trust_radius,
+    /// given @f$ z^\top M z @f$, @f$ z^\top M d @f$ and @f$ d^\top M d @f$.
+    /// Return the two values of t, sorted from low to high.
+    static auto get_boundaries_intersections(real_t zMz, real_t zMd,
+                                             real_t dMd, real_t trust_radius) {
+        real_t a = dMd;
+        real_t b = 2 * zMd;
+        real_t c = zMz - trust_radius * trust_radius;
         real_t sqrt_discriminant = std::sqrt(b * b - 4 * a * c);
 
         // The following calculation is mathematically
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/functions/prox.hpp>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace alpaqa::functions {
+
+/// Elastic net regularizer, the sum of an ℓ₁-norm and a squared ℓ₂-norm:
+/// @f$ h(x) = \lambda_1 \|x\|_1 + \tfrac{\lambda_2}{2} \|x\|_2^2 @f$.
+/// @ingroup grp_Functions
+template <Config Conf>
+struct ElasticNet {
+    USING_ALPAQA_CONFIG(Conf);
+
+    ElasticNet(real_t λ1 = 1, real_t λ2 = 1) : λ1{λ1}, λ2{λ2} {
+        if (λ1 < 0 || !std::isfinite(λ1))
+            throw std::invalid_argument("ElasticNet::λ1 must be nonnegative");
+        if (λ2 < 0 || !std::isfinite(λ2))
+            throw std::invalid_argument("ElasticNet::λ2 must be nonnegative");
+    }
+
+    real_t λ1, λ2;
+
+    real_t prox(crmat in, rmat out, real_t γ = 1) {
+        assert(in.rows() == out.rows());
+        assert(in.cols() == out.cols());
+        // Soft-thresholding followed by scaling
+        const real_t step = γ * λ1, scale = 1 / (1 + γ * λ2);
+        out = scale * ((in.array() - step).max(real_t(0)) +
+                       (in.array() + step).min(real_t(0)))
+                          .matrix();
+        return λ1 * out.cwiseAbs().sum() + λ2 / 2 * out.squaredNorm();
+    }
+
+    friend real_t alpaqa_tag_invoke(tag_t<alpaqa::prox>, ElasticNet &self,
+                                    crmat in, rmat out, real_t γ) {
+        return self.prox(std::move(in), std::move(out), γ);
+    }
+};
+
+} // namespace alpaqa::functions
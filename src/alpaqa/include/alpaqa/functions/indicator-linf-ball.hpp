@@ -0,0 +1,40 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/functions/prox.hpp>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace alpaqa::functions {
+
+/// Indicator function of the ℓ∞-ball
+/// @f$ \{ x \mid \|x\|_\infty \le r \} @f$. Its proximal mapping is the
+/// projection onto the ball.
+/// @ingroup grp_Functions
+template <Config Conf>
+struct LInfBall {
+    USING_ALPAQA_CONFIG(Conf);
+
+    LInfBall(real_t radius = 1) : radius{radius} {
+        if (!(radius >= 0))
+            throw std::invalid_argument("LInfBall::radius must be "
+                                        "nonnegative");
+    }
+
+    real_t radius;
+
+    real_t prox(crmat in, rmat out, [[maybe_unused]] real_t γ = 1) {
+        assert(in.rows() == out.rows());
+        assert(in.cols() == out.cols());
+        out = in.cwiseMax(-radius).cwiseMin(radius);
+        return 0;
+    }
+
+    friend real_t alpaqa_tag_invoke(tag_t<alpaqa::prox>, LInfBall &self,
+                                    crmat in, rmat out, real_t γ) {
+        return self.prox(std::move(in), std::move(out), γ);
+    }
+};
+
+} // namespace alpaqa::functions
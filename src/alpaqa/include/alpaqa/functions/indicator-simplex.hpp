@@ -0,0 +1,146 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/functions/prox.hpp>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace alpaqa::functions {
+
+namespace detail {
+
+/// Find @f$ \theta @f$ such that @f$ \sum_i \max(x_i - \theta, 0) = r @f$,
+/// for @f$ r > 0 @f$, using randomized pivoting, in expected linear time
+/// (see @cite duchi2008efficient). The contents of @p x are reordered.
+template <Config Conf, class Rng>
+typename Conf::real_t simplex_threshold(typename Conf::rvec x,
+                                        typename Conf::real_t r, Rng &rng) {
+    USING_ALPAQA_CONFIG(Conf);
+    // Invariant: the elements in [0, lo) are in the support, the support
+    // is contained in [0, hi), s and ρ are the sum and number of elements
+    // in [0, lo).
+    index_t lo = 0, hi = x.size(), ρ = 0;
+    real_t s = 0;
+    while (lo < hi) {
+        // Random pivot, moved to the front
+        auto range = static_cast<std::uint64_t>(hi - lo);
+        auto p     = lo + static_cast<index_t>(rng() % range);
+        std::swap(x(lo), x(p));
+        const real_t v = x(lo);
+        // Move the elements greater than or equal to the pivot to the front
+        index_t i = lo + 1;
+        real_t Δs = v;
+        for (index_t j = lo + 1; j < hi; ++j) {
+            if (x(j) >= v) {
+                Δs += x(j);
+                std::swap(x(i++), x(j));
+            }
+        }
+        index_t Δρ = i - lo;
+        // The pivot is in the support: so are all larger elements
+        if (s + Δs - static_cast<real_t>(ρ + Δρ) * v < r) {
+            s += Δs;
+            ρ += Δρ;
+            lo = i;
+        }
+        // The pivot is not in the support: neither are the smaller elements
+        else {
+            lo = lo + 1;
+            hi = i;
+        }
+    }
+    return (s - r) / static_cast<real_t>(ρ);
+}
+
+} // namespace detail
+
+/// Indicator function of the simplex
+/// @f$ \{ x \mid x \ge 0,\; \sum_i x_i = r \} @f$. Its proximal mapping is
+/// the Euclidean projection onto the simplex, computed in expected linear
+/// time without sorting.
+/// @note   The output is used as workspace, it should not alias the input.
+/// @ingroup grp_Functions
+template <Config Conf>
+struct Simplex {
+    USING_ALPAQA_CONFIG(Conf);
+
+    Simplex(real_t radius = 1) : radius{radius} {
+        if (!(radius > 0) || !std::isfinite(radius))
+            throw std::invalid_argument("Simplex::radius must be positive");
+    }
+
+    real_t radius;
+    /// Random number generator for the choice of pivots.
+    std::minstd_rand rng;
+
+    real_t prox(crmat in, rmat out, [[maybe_unused]] real_t γ = 1) {
+        assert(in.rows() == out.rows());
+        assert(in.cols() == out.cols());
+        assert(out.cols() == 1 || out.outerStride() == out.rows());
+        // Use the output as workspace
+        out = in;
+        mvec work{out.data(), out.size()};
+        real_t θ = detail::simplex_threshold<config_t>(work, radius, rng);
+        out      = (in.array() - θ).max(real_t(0)).matrix();
+        return 0;
+    }
+
+    friend real_t alpaqa_tag_invoke(tag_t<alpaqa::prox>, Simplex &self,
+                                    crmat in, rmat out, real_t γ) {
+        return self.prox(std::move(in), std::move(out), γ);
+    }
+};
+
+/// Indicator function of the ℓ₁-ball @f$ \{ x \mid \|x\|_1 \le r \} @f$.
+/// Its proximal mapping is the Euclidean projection onto the ball, computed
+/// in expected linear time without sorting.
+/// @note   The output is used as workspace, it should not alias the input.
+/// @ingroup grp_Functions
+template <Config Conf>
+struct L1Ball {
+    USING_ALPAQA_CONFIG(Conf);
+
+    L1Ball(real_t radius = 1) : radius{radius} {
+        if (!(radius >= 0) || !std::isfinite(radius))
+            throw std::invalid_argument("L1Ball::radius must be nonnegative");
+    }
+
+    real_t radius;
+    /// Random number generator for the choice of pivots.
+    std::minstd_rand rng;
+
+    real_t prox(crmat in, rmat out, [[maybe_unused]] real_t γ = 1) {
+        assert(in.rows() == out.rows());
+        assert(in.cols() == out.cols());
+        assert(out.cols() == 1 || out.outerStride() == out.rows());
+        if (in.cwiseAbs().sum() <= radius) {
+            out = in;
+            return 0;
+        }
+        if (radius == 0) {
+            out.setZero();
+            return 0;
+        }
+        // Project the magnitudes onto the simplex, using the output as
+        // workspace
+        out = in.cwiseAbs();
+        mvec work{out.data(), out.size()};
+        real_t θ = detail::simplex_threshold<config_t>(work, radius, rng);
+        // Soft-thresholding
+        out = ((in.array() - θ).max(real_t(0)) + //
+               (in.array() + θ).min(real_t(0)))
+                  .matrix();
+        return 0;
+    }
+
+    friend real_t alpaqa_tag_invoke(tag_t<alpaqa::prox>, L1Ball &self,
+                                    crmat in, rmat out, real_t γ) {
+        return self.prox(std::move(in), std::move(out), γ);
+    }
+};
+
+} // namespace alpaqa::functions
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/functions/prox.hpp>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace alpaqa::functions {
+
+/// ℓ₂,₁-norm or group lasso, the sum of the ℓ₂-norms of groups of variables:
+/// @f$ h(x) = \lambda \sum_i \|x_{\mathcal{G}_i}\|_2 @f$.
+///
+/// By default, every column of the input matrix is a group. Alternatively,
+/// the input can be a vector that is split into contiguous groups, specified
+/// by the index of the first element of each group.
+/// @ingroup grp_Functions
+template <Config Conf>
+struct L21Norm {
+    USING_ALPAQA_CONFIG(Conf);
+
+    /// Each column of the input is a group.
+    L21Norm(real_t λ = 1) : λ{λ} {
+        if (λ < 0 || !std::isfinite(λ))
+            throw std::invalid_argument("L21Norm::λ must be nonnegative");
+    }
+    /// Contiguous groups of a vector, group @f$ i @f$ contains the elements
+    /// with indices `group_starts(i)` up to (but not including)
+    /// `group_starts(i + 1)`. The last group extends to the end of the vector.
+    L21Norm(real_t λ, indexvec group_starts)
+        : λ{λ}, group_starts{std::move(group_starts)} {
+        if (λ < 0 || !std::isfinite(λ))
+            throw std::invalid_argument("L21Norm::λ must be nonnegative");
+        const auto &g = this->group_starts;
+        if (g.size() > 0 && g(0) != 0)
+            throw std::invalid_argument("L21Norm: first group should start at "
+                                        "index zero");
+        for (index_t i = 1; i < g.size(); ++i)
+            if (g(i) <= g(i - 1))
+                throw std::invalid_argument("L21Norm: group start indices "
+                                            "should be strictly increasing");
+    }
+
+    real_t λ;
+    indexvec group_starts;
+
+    real_t prox(crmat in, rmat out, real_t γ = 1) {
+        assert(in.rows() == out.rows());
+        assert(in.cols() == out.cols());
+        if (λ == 0) {
+            out = in;
+            return 0;
+        }
+        const real_t γλ = γ * λ;
+        // Scale the group towards zero, returns the norm of the result
+        auto shrink = [γλ](auto &&x, auto &&y) {
+            real_t norm_x = x.norm();
+            real_t factor = norm_x > γλ ? 1 - γλ / norm_x : real_t(0);
+            y             = factor * x;
+            return factor * norm_x;
+        };
+        real_t value = 0;
+        if (group_starts.size() == 0) {
+            for (index_t c = 0; c < in.cols(); ++c)
+                value += shrink(in.col(c), out.col(c));
+        } else {
+            assert(in.cols() == 1);
+            assert(group_starts(group_starts.size() - 1) < in.rows());
+            const auto n = in.rows(), num_groups = group_starts.size();
+            for (index_t i = 0; i < num_groups; ++i) {
+                index_t start = group_starts(i);
+                index_t end   = i + 1 < num_groups ? group_starts(i + 1) : n;
+                value += shrink(in.col(0).segment(start, end - start),
+                                out.col(0).segment(start, end - start));
+            }
+        }
+        return λ * value;
+    }
+
+    friend real_t alpaqa_tag_invoke(tag_t<alpaqa::prox>, L21Norm &self,
+                                    crmat in, rmat out, real_t γ) {
+        return self.prox(std::move(in), std::move(out), γ);
+    }
+};
+
+} // namespace alpaqa::functions
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <alpaqa/config/config.hpp>
+#include <alpaqa/functions/prox.hpp>
+#include <alpaqa/functions/truncated-svd.hpp>
 #include <Eigen/SVD>
 
 namespace alpaqa::functions {
@@ -16,6 +18,11 @@ using DefaultSVD = Eigen::BDCSVD<typename Conf::mat>;
 
 /// Nuclear norm (ℓ₁-norm of singular values).
 /// @ingroup grp_Functions
+/// @tparam SVD
+///         Singular value decomposition to use. If it provides a
+///         `compute_truncated(A, threshold)` member function (such as
+///         @ref TruncatedSVD), only the singular values larger than the
+///         soft-thresholding step size are computed.
 template <Config Conf, class SVD = DefaultSVD<Conf>>
 struct NuclearNorm {
     USING_ALPAQA_CONFIG(Conf);
@@ -48,14 +55,20 @@ struct NuclearNorm {
             out = in;
             return 0;
         }
+        auto compute = [this, threshold{λ * γ}](const auto &A) {
+            if constexpr (requires { svd.compute_truncated(A, threshold); })
+                svd.compute_truncated(A, threshold);
+            else
+                svd.compute(A);
+        };
         if (rows == 0 || cols == 0) { // dynamic size
             assert(in.rows() == out.rows());
             assert(in.cols() == out.cols());
-            svd.compute(in);
+            compute(in);
         } else { // fixed size
             assert(in.size() == rows * cols);
             assert(out.size() == rows * cols);
-            svd.compute(in.reshaped(rows, cols));
+            compute(in.reshaped(rows, cols));
         }
         const length_t n = svd.singularValues().size();
         auto step        = vec::Constant(n, λ * γ);
@@ -80,4 +93,10 @@ struct NuclearNorm {
     }
 };
 
+/// Nuclear norm using a truncated singular value decomposition, which is
+/// more efficient for large matrices if the result has low rank.
+/// @ingroup grp_Functions
+template <Config Conf>
+using TruncatedNuclearNorm = NuclearNorm<Conf, TruncatedSVD<Conf>>;
+
 } // namespace alpaqa::functions
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <Eigen/QR>
+#include <Eigen/SVD>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace alpaqa::functions {
+
+/// Parameters for the @ref TruncatedSVD class.
+template <Config Conf>
+struct TruncatedSVDParams {
+    USING_ALPAQA_CONFIG(Conf);
+    /// Number of singular triplets computed in addition to the number of
+    /// singular values above the threshold in the previous call.
+    length_t oversampling = 8;
+    /// Expected number of singular values above the threshold in the first
+    /// call.
+    length_t initial_rank = 8;
+    /// Maximum number of subspace iterations for a given subspace dimension.
+    unsigned max_iter = 50;
+    /// Relative tolerance on the singular values above the threshold, used to
+    /// stop the subspace iterations.
+    real_t tolerance = std::sqrt(std::numeric_limits<real_t>::epsilon());
+    /// Switch to a full SVD if the subspace dimension exceeds this fraction of
+    /// the smallest dimension of the matrix.
+    real_t full_svd_fraction = real_t(0.25);
+    /// Seed for the random starting vectors.
+    std::uint64_t seed = 0;
+};
+
+/// Partial singular value decomposition that only computes the singular
+/// triplets with singular values above a given threshold, using randomized
+/// subspace iteration (see @cite halko2011finding). The right singular
+/// vectors of the previous decomposition are used as the starting subspace,
+/// and the subspace dimension is chosen based on the number of singular
+/// values above the threshold in the previous decomposition. This makes it
+/// well-suited for proximal methods, where the inputs of subsequent
+/// evaluations are similar.
+///
+/// Can be used as the `SVD` policy of @ref NuclearNorm, which then only
+/// computes the singular values that survive the soft-thresholding.
+/// @ingroup grp_Functions
+template <Config Conf>
+class TruncatedSVD {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+    using Params = TruncatedSVDParams<config_t>;
+
+    TruncatedSVD(const Params &params = {}) : params{params} {}
+    /// Pre-allocate storage for matrices of the given size (the options are
+    /// ignored, thin factors are always computed).
+    TruncatedSVD(length_t rows, length_t cols, unsigned options = 0,
+                 const Params &params = {})
+        : params{params}, U(rows, 0), V(cols, 0) {
+        (void)options;
+    }
+
+    /// Compute the singular triplets of @p A with singular values larger than
+    /// @p threshold.
+    /// Afterwards, either all singular values of @p A were computed, or the
+    /// smallest computed singular value plus the norm of the residual of its
+    /// Ritz triplet is smaller than or equal to @p threshold.
+    template <class Derived>
+    TruncatedSVD &compute_truncated(const Eigen::MatrixBase<Derived> &A,
+                                    real_t threshold) {
+        const length_t m = A.rows(), n = A.cols(), d = std::min(m, n);
+        const bool warm  = V.rows() == n && V.cols() > 0;
+        if (!warm || U.rows() != m)
+            rank = params.initial_rank;
+        length_t l = std::min(d, std::max(rank, length_t{1}) + //
+                                     params.oversampling);
+        while (true) {
+            if (static_cast<real_t>(l) >
+                params.full_svd_fraction * static_cast<real_t>(d)) {
+                compute_full(A);
+                break;
+            }
+            // Starting subspace: previous right singular vectors, completed by
+            // random vectors
+            length_t k0 = (V.rows() == n) ? std::min(l, V.cols()) : 0;
+            Z.resize(n, l);
+            Z.leftCols(k0) = V.leftCols(k0);
+            std::normal_distribution<real_t> nrml{0, 1};
+            Z.rightCols(l - k0) = mat::NullaryExpr(n, l - k0, [&] { //
+                return nrml(rng);
+            });
+            subspace_iteration(A, threshold);
+            // Done if the smallest singular value is below the threshold.
+            // Ritz values are lower bounds, so the smallest one could still
+            // underestimate a singular value above the threshold if its
+            // triplet has not converged. The residual ‖A v - σ u‖ bounds the
+            // distance from σ to a singular value of A.
+            if (l == d || S(l - 1) + ritz_residual(A, l - 1) <= threshold)
+                break;
+            l = std::min(d, 2 * l);
+        }
+        rank = std::count_if(S.begin(), S.end(),
+                             [&](real_t σ) { return σ > threshold; });
+        ++num_computations;
+        return *this;
+    }
+
+    /// Compute all singular triplets of @p A.
+    template <class Derived>
+    TruncatedSVD &compute(const Eigen::MatrixBase<Derived> &A) {
+        compute_full(A);
+        rank = S.size();
+        ++num_computations;
+        return *this;
+    }
+
+    /// Singular values of the last decomposition, in decreasing order.
+    const vec &singularValues() const { return S; }
+    /// Left singular vectors of the last decomposition.
+    const mat &matrixU() const { return U; }
+    /// Right singular vectors of the last decomposition.
+    const mat &matrixV() const { return V; }
+    /// Number of singular values above the threshold in the last
+    /// decomposition.
+    length_t get_rank() const { return rank; }
+    /// Total number of subspace iterations since construction.
+    unsigned get_num_iterations() const { return num_iterations; }
+    /// Number of decompositions that fell back to a full SVD since
+    /// construction.
+    unsigned get_num_full() const { return num_full; }
+    /// Number of decompositions since construction.
+    unsigned get_num_computations() const { return num_computations; }
+
+    Params params;
+
+  private:
+#if EIGEN_VERSION_AT_LEAST(3, 4, 1)
+    using SVD = Eigen::BDCSVD<mat, Eigen::ComputeThinU | Eigen::ComputeThinV>;
+    template <class Derived>
+    static void compute_svd(SVD &svd, const Eigen::MatrixBase<Derived> &A) {
+        svd.compute(A);
+    }
+#else
+    using SVD = Eigen::BDCSVD<mat>;
+    template <class Derived>
+    static void compute_svd(SVD &svd, const Eigen::MatrixBase<Derived> &A) {
+        svd.compute(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    }
+#endif
+
+    /// Orthonormalize the columns of @p Y in place.
+    void orthonormalize(mat &Y) {
+        qr.compute(Y);
+        Y = qr.householderQ() * mat::Identity(Y.rows(), Y.cols());
+    }
+
+    /// Subspace iteration starting from the columns of @ref Z, until the
+    /// singular values above the threshold converge.
+    template <class Derived>
+    void subspace_iteration(const Eigen::MatrixBase<Derived> &A,
+                            real_t threshold) {
+        const length_t l = Z.cols();
+        Q.noalias()      = A * Z;
+        orthonormalize(Q);
+        S_prev.setConstant(l, alpaqa::inf<config_t>);
+        for (unsigned it = 0; it < params.max_iter; ++it) {
+            ++num_iterations;
+            // Rayleigh-Ritz: SVD of the projection Bᵀ = (QᵀA)ᵀ = AᵀQ
+            Z.noalias() = A.transpose() * Q;
+            compute_svd(small_svd, Z);
+            S = small_svd.singularValues();
+            // Check convergence of the singular values above the threshold
+            auto above = [&](real_t σ) { return σ > threshold; };
+            length_t r = std::max<length_t>(
+                1, std::count_if(S.begin(), S.end(), above));
+            real_t tol = params.tolerance * std::max(S(0), threshold);
+            auto ΔS    = (S - S_prev).topRows(r);
+            bool converged = (ΔS.cwiseAbs().array() <= tol).all();
+            if (converged || it + 1 == params.max_iter)
+                break;
+            S_prev = S;
+            // Power step: new subspace spanned by A V
+            Q.noalias() = A * small_svd.matrixU();
+            orthonormalize(Q);
+        }
+        V           = small_svd.matrixU();
+        U.noalias() = Q * small_svd.matrixV();
+    }
+
+    /// Norm of the residual ‖A vⱼ - σⱼ uⱼ‖ of the j-th Ritz triplet computed
+    /// by @ref subspace_iteration (the residual ‖Aᵀuⱼ - σⱼ vⱼ‖ is zero by
+    /// construction).
+    template <class Derived>
+    real_t ritz_residual(const Eigen::MatrixBase<Derived> &A, index_t j) {
+        residual.noalias() = A * V.col(j);
+        residual -= S(j) * U.col(j);
+        return residual.norm();
+    }
+
+    template <class Derived>
+    void compute_full(const Eigen::MatrixBase<Derived> &A) {
+        compute_svd(full_svd, A);
+        S = full_svd.singularValues();
+        U = full_svd.matrixU();
+        V = full_svd.matrixV();
+        ++num_full;
+    }
+
+    mat U, V;
+    vec S, S_prev, residual;
+    mat Q, Z;
+    Eigen::HouseholderQR<mat> qr;
+    SVD small_svd, full_svd;
+    std::mt19937_64 rng{params.seed};
+    length_t rank             = 0;
+    unsigned num_iterations   = 0;
+    unsigned num_full         = 0;
+    unsigned num_computations = 0;
+};
+
+} // namespace alpaqa::functions
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <alpaqa/accelerators/lsr1.hpp>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+#include <Eigen/QR>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace alpaqa {
+
+template <Config Conf>
+bool LSR1<Conf>::update_sy(crvec s, crvec y) {
+    S.col(next_col()) = s;
+    Y.col(next_col()) = y;
+    return commit_pair();
+}
+
+template <Config Conf>
+bool LSR1<Conf>::update(crvec xₖ, crvec xₙₑₓₜ, crvec gₖ, crvec gₙₑₓₜ) {
+    S.col(next_col()) = xₙₑₓₜ - xₖ;
+    Y.col(next_col()) = gₙₑₓₜ - gₖ;
+    return commit_pair();
+}
+
+template <Config Conf>
+bool LSR1<Conf>::commit_pair() {
+    const auto c = next_col();
+    auto s = S.col(c), y = Y.col(c);
+    real_t sᵀs = s.squaredNorm(), sᵀy = s.dot(y), yᵀy = y.squaredNorm();
+    if (sᵀs <= params.min_abs_s || !std::isfinite(sᵀy) || !std::isfinite(yᵀy))
+        return false;
+
+    // Scale of the initial approximation B₀ = δI. Use the curvature along the
+    // newest direction if it is positive, otherwise keep the previous scale.
+    real_t δ_next = δ;
+    if (sᵀy > std::sqrt(std::numeric_limits<real_t>::epsilon()) *
+                  std::sqrt(sᵀs * yᵀy))
+        δ_next = yᵀy / sᵀy;
+    else if (!std::isfinite(δ_next) || δ_next <= 0)
+        δ_next = std::sqrt(yᵀy / sᵀs);
+    if (!(δ_next > 0) || !std::isfinite(δ_next))
+        return false;
+
+    // Columns of the new compact representation, in chronological order
+    const bool drop_oldest = count == params.memory;
+    const index_t start_next = drop_oldest ? (start + 1) % S.cols() : start;
+    const length_t k         = drop_oldest ? count : count + 1;
+    auto col = [&](index_t i) { return (start_next + i) % S.cols(); };
+
+    // M = D + L + Lᵀ - δ SᵀS, Ψ = Y - δ S
+    auto Mk = M.topLeftCorner(k, k);
+    for (index_t i = 0; i < k; ++i) {
+        for (index_t j = 0; j <= i; ++j) {
+            real_t sᵢᵀyⱼ = S.col(col(i)).dot(Y.col(col(j)));
+            real_t sᵢᵀsⱼ = S.col(col(i)).dot(S.col(col(j)));
+            Mk(i, j) = Mk(j, i) = sᵢᵀyⱼ - δ_next * sᵢᵀsⱼ;
+        }
+        Ψ_next.col(i) = Y.col(col(i)) - δ_next * S.col(col(i));
+    }
+    Eigen::PartialPivLU<mat> lu{Mk};
+    if (!(lu.rcond() >= params.min_rcond))
+        return false;
+    M_inv_next.topLeftCorner(k, k) = lu.inverse();
+    if (!M_inv_next.topLeftCorner(k, k).allFinite())
+        return false;
+
+    // Accept the update
+    Ψ.swap(Ψ_next);
+    M_inv.swap(M_inv_next);
+    δ     = δ_next;
+    start = start_next;
+    count = k;
+    return true;
+}
+
+template <Config Conf>
+void LSR1<Conf>::apply_hess(crvec v, rvec Bv, real_t δ_0) const {
+    if (count == 0) {
+        Bv = δ_0 * v;
+        return;
+    }
+    auto w = work_m.topRows(count), Mw = work_m_2.topRows(count);
+    w.noalias()  = Ψ.leftCols(count).transpose() * v;
+    Mw.noalias() = M_inv.topLeftCorner(count, count) * w;
+    Bv           = δ * v;
+    Bv.noalias() += Ψ.leftCols(count) * Mw;
+}
+
+template <Config Conf>
+auto LSR1<Conf>::solve_trust_region_masked(crvec g, crindexvec J,
+                                           real_t radius, real_t δ_0,
+                                           rvec q) const -> real_t {
+    const auto nJ  = J.size();
+    const real_t δ = count > 0 ? this->δ : δ_0;
+    const auto sq  = [](real_t x) { return x * x; };
+    const auto cb  = [](real_t x) { return x * x * x; };
+
+    // Spectral decomposition B_JJ = P diag(λ) Pᵀ + δ (I - P Pᵀ), using the
+    // thin QR factorization Ψ_J = Q R.
+    length_t r = 0;
+    mat P{nJ, 0};
+    vec λ;
+    if (count > 0 && nJ > 0) {
+        mat ΨJ = Ψ(J, Eigen::seqN(0, count));
+        Eigen::ColPivHouseholderQR<mat> qr{ΨJ};
+        r = qr.rank();
+        if (r > 0) {
+            mat Q = qr.householderQ() * mat::Identity(nJ, r);
+            mat R = qr.matrixR().topRows(r).template triangularView<
+                Eigen::Upper>();
+            R     = R * qr.colsPermutation().transpose();
+            mat W = R * M_inv.topLeftCorner(count, count) * R.transpose();
+            Eigen::SelfAdjointEigenSolver<mat> eig{W};
+            λ = eig.eigenvalues().array() + δ;
+            P = Q * eig.eigenvectors();
+        }
+    }
+    vec g_par        = P.transpose() * g;
+    vec g_perp       = g - P * g_par;
+    real_t g_perp_sq = g_perp.squaredNorm();
+    const bool perp  = nJ > r;
+    const real_t λ_min =
+        std::min(r > 0 ? λ(0) : inf<config_t>, perp ? δ : inf<config_t>);
+
+    // Squared norm of the step q(σ) = -(B_JJ + σI)⁻¹ g, and the derivative of
+    // the secular equation φ(σ) = 1/‖q(σ)‖ - 1/Δ.
+    auto norm_sq = [&](real_t σ) {
+        real_t n_sq = perp ? g_perp_sq / sq(δ + σ) : 0;
+        for (index_t i = 0; i < r; ++i)
+            if (g_par(i) != 0)
+                n_sq += sq(g_par(i) / (λ(i) + σ));
+        return n_sq;
+    };
+    auto dφ = [&](real_t σ, real_t n) {
+        real_t d = perp ? g_perp_sq / cb(δ + σ) : 0;
+        for (index_t i = 0; i < r; ++i)
+            if (g_par(i) != 0)
+                d += sq(g_par(i)) / cb(λ(i) + σ);
+        return d / cb(n);
+    };
+
+    real_t σ = 0, τ = 0;
+    if (!(λ_min > 0 && norm_sq(0) <= sq(radius))) {
+        real_t σ_lo = std::max(real_t(0), -λ_min);
+        real_t σ_hi = σ_lo + g.norm() / radius;
+        // Hard case: the gradient is orthogonal to the eigenspace of the most
+        // negative eigenvalue, and the step with σ = -λ_min lies inside the
+        // trust region. Move along the corresponding eigenvector to the
+        // boundary.
+        const real_t ε   = std::numeric_limits<real_t>::epsilon();
+        const real_t tol = std::sqrt(ε) * std::max(real_t(1), std::abs(λ_min));
+        bool hard        = r > 0 && λ_min <= 0 && λ(0) == λ_min;
+        for (index_t i = 0; hard && i < r && λ(i) <= λ_min + tol; ++i)
+            hard = std::abs(g_par(i)) <= ε * g.norm();
+        if (hard) {
+            for (index_t i = 0; i < r && λ(i) <= λ_min + tol; ++i)
+                g_par(i) = 0;
+            real_t n_sq = norm_sq(σ_lo);
+            if (n_sq <= sq(radius)) {
+                σ = σ_lo;
+                τ = std::sqrt(sq(radius) - n_sq);
+            } else {
+                hard = false;
+            }
+        }
+        // Safeguarded Newton iterations on the secular equation
+        if (!hard) {
+            σ = σ_lo;
+            for (int it = 0; it < 100; ++it) {
+                real_t n = std::sqrt(norm_sq(σ));
+                if (std::isfinite(n)) {
+                    if (std::abs(n - radius) <= 1e2 * ε * radius)
+                        break;
+                    real_t φ = 1 / n - 1 / radius;
+                    (φ < 0 ? σ_lo : σ_hi) = σ;
+                    σ -= φ / dφ(σ, n);
+                } else {
+                    σ_lo = σ;
+                }
+                if (!(σ > σ_lo && σ < σ_hi))
+                    σ = (σ_lo + σ_hi) / 2;
+                if (σ_hi - σ_lo <= ε * σ_hi)
+                    break;
+            }
+        }
+    }
+
+    // Compute the step and the model value in the eigenbasis
+    vec q_par = vec::Zero(r);
+    for (index_t i = 0; i < r; ++i)
+        if (g_par(i) != 0)
+            q_par(i) = -g_par(i) / (λ(i) + σ);
+    if (τ > 0)
+        q_par(0) = τ; // eigenvector of the most negative eigenvalue
+    real_t q_perp_scale = perp ? -1 / (δ + σ) : 0;
+    q                   = P * q_par + q_perp_scale * g_perp;
+    return g_par.dot(q_par) + q_perp_scale * g_perp_sq +
+           (q_par.dot(λ.cwiseProduct(q_par)) +
+            δ * sq(q_perp_scale) * g_perp_sq) /
+               2;
+}
+
+template <Config Conf>
+void LSR1<Conf>::reset() {
+    start = 0;
+    count = 0;
+    δ     = NaN<config_t>;
+}
+
+template <Config Conf>
+void LSR1<Conf>::resize(length_t n) {
+    if (params.memory < 1)
+        throw std::invalid_argument("LSR1::Params::memory must be > 0");
+    const auto m = params.memory;
+    S.resize(n, m + 1);
+    Y.resize(n, m + 1);
+    Ψ.resize(n, m);
+    Ψ_next.resize(n, m);
+    M.resize(m, m);
+    M_inv.resize(m, m);
+    M_inv_next.resize(m, m);
+    work_m.resize(m);
+    work_m_2.resize(m);
+    reset();
+}
+
+} // namespace alpaqa
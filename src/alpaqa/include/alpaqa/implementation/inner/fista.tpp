@@ -12,8 +12,10 @@
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/implementation/inner/panoc-helpers.tpp>
 #include <alpaqa/implementation/util/print.tpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/timed.hpp>
+#include <alpaqa/util/trace.hpp>
 
 namespace alpaqa {
 
@@ -87,6 +89,8 @@ auto FISTASolver<Conf>::operator()(
     auto os         = opts.os ? opts.os : this->os;
     auto start_time = std::chrono::steady_clock::now();
     Stats s;
+    ScopedAllocPhase phase{AllocPhase::Setup};
+    ScopedTraceEvent trace{"FISTA", "inner"};
 
     const auto n = problem.get_n();
     const auto m = problem.get_m();
@@ -133,21 +137,26 @@ auto FISTASolver<Conf>::operator()(
 
     // Problem functions -------------------------------------------------------
 
-    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n1, &work_m](Iterate &i) {
+    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n1, &work_m, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx = problem.eval_ψ_grad_ψ(i.x, y, Σ, i.grad_ψ, work_n1, work_m);
     };
-    auto eval_grad_ψ = [&problem, &y, &Σ, &work_n1, &work_m](Iterate &i) {
+    auto eval_grad_ψ = [&problem, &y, &Σ, &work_n1, &work_m, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         problem.eval_grad_ψ(i.x, y, Σ, i.grad_ψ, work_n1, work_m);
     };
-    auto eval_prox_grad_step = [&problem](Iterate &i) {
+    auto eval_prox_grad_step = [&problem, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_prox};
         i.hx̂  = problem.eval_prox_grad_step(i.γ, i.x, i.grad_ψ, i.x̂, i.p);
         i.pᵀp = i.p.squaredNorm();
         i.grad_ψᵀp = i.p.dot(i.grad_ψ);
     };
-    auto eval_ψx̂ = [&problem, &y, &Σ](Iterate &i) {
+    auto eval_ψx̂ = [&problem, &y, &Σ, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx̂ = problem.eval_ψ(i.x̂, y, Σ, i.ŷx̂);
     };
-    auto eval_grad_ψx̂ = [&problem, &work_n1](Iterate &i) {
+    auto eval_grad_ψx̂ = [&problem, &work_n1, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         // assumes that eval_ψx̂ was called first
         problem.eval_grad_L(i.x̂, i.ŷx̂, i.grad_ψx̂, work_n1);
     };
@@ -182,6 +191,7 @@ auto FISTASolver<Conf>::operator()(
         if (!progress_cb)
             return;
         ScopedMallocAllower ma;
+        ScopedAllocPhase cb_phase{AllocPhase::Callback};
         alpaqa::util::Timed timed{s.time_progress_callback};
         progress_cb(ProgressInfo{
             .k          = k,
@@ -205,6 +215,7 @@ auto FISTASolver<Conf>::operator()(
             .outer_iter = opts.outer_iter,
             .problem    = &problem,
             .params     = &params,
+            .stats      = &s,
         });
     };
 
@@ -224,6 +235,7 @@ auto FISTASolver<Conf>::operator()(
     }
     // Finite difference approximation of ∇²ψ in starting point
     else if (params.Lipschitz.L_0 <= 0) {
+        alpaqa::util::Timed t{s.time_evaluations};
         curr->L = Helpers::initial_lipschitz_estimate(
             problem, curr->x, y, Σ, params.Lipschitz.ε, params.Lipschitz.δ,
             params.L_min, params.L_max,
@@ -255,6 +267,9 @@ auto FISTASolver<Conf>::operator()(
 
     ScopedMallocBlocker mb; // Don't allocate in the inner loop
     while (true) {
+        phase.set(AllocPhase::Iteration);
+        ScopedTraceEvent trace_iter{"iteration", "inner", k};
+
         // Proximal gradient step ----------------------------------------------
 
         prev_x̂.swap(curr->x̂); // Remember x̂ₖ
@@ -268,7 +283,10 @@ auto FISTASolver<Conf>::operator()(
 
         // Quadratic upper bound -----------------------------------------------
 
+        phase.set(AllocPhase::LineSearch);
         while (curr->L < params.L_max && qub_violated(*curr)) {
+            alpaqa::util::Timed timer{s.time_linesearch};
+            ScopedTraceEvent trace_ls{"linesearch_trial", "linesearch"};
             curr->γ /= 2;
             curr->L *= 2;
             eval_prox_grad_step(*curr);
@@ -278,6 +296,7 @@ auto FISTASolver<Conf>::operator()(
 
         // Check stopping criteria ---------------------------------------------
 
+        phase.set(AllocPhase::Iteration);
         // Check if we made any progress
         if (no_progress > 0 || k % params.max_no_progress == 0)
             no_progress = curr->x̂ == prev_x̂ ? no_progress + 1 : 0;
@@ -334,6 +353,7 @@ auto FISTASolver<Conf>::operator()(
 
         // Calculate next point ------------------------------------------------
 
+        phase.set(AllocPhase::Direction);
         // Calculate tₖ₊₁
         real_t t_new  = (1 + std::sqrt(1 + 4 * t)) / 2;
         real_t t_prev = std::exchange(t, t_new);
@@ -6,8 +6,11 @@
 #include <alpaqa/inner/panoc-ocp.hpp>
 #include <alpaqa/problem/box.hpp>
 #include <alpaqa/problem/ocproblem.hpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/index-set.hpp>
 #include <alpaqa/util/timed.hpp>
+#include <alpaqa/util/trace.hpp>
+#include <alpaqa/util/usdt.hpp>
 #include <concepts>
 #include <iomanip>
 #include <iostream>
@@ -64,6 +67,8 @@ auto PANOCOCPSolver<Conf>::operator()(
     auto os         = opts.os ? opts.os : this->os;
     auto start_time = std::chrono::steady_clock::now();
     Stats s;
+    ScopedAllocPhase phase{AllocPhase::Setup};
+    ScopedTraceEvent trace{"PANOCOCP", "inner"};
 
     const auto N    = problem.get_N();
     const auto nu   = problem.get_nu();
@@ -442,6 +447,7 @@ auto PANOCOCPSolver<Conf>::operator()(
         if (!progress_cb)
             return;
         ScopedMallocAllower ma;
+        ScopedAllocPhase cb_phase{AllocPhase::Callback};
         alpaqa::util::Timed t{s.time_progress_callback};
         progress_cb({
             .k             = k,
@@ -533,6 +539,8 @@ auto PANOCOCPSolver<Conf>::operator()(
     // Main PANOC loop
     // =========================================================================
     while (true) {
+        phase.set(AllocPhase::Iteration);
+        ScopedTraceEvent trace_iter{"iteration", "inner", k};
 
         // Check stop condition ------------------------------------------------
 
@@ -579,11 +587,13 @@ auto PANOCOCPSolver<Conf>::operator()(
 
         // Calculate Gauss-Newton step -----------------------------------------
 
+        phase.set(AllocPhase::Direction);
         real_t τ_init = 1;
         did_gn        = do_gn_step;
         if (params.disable_acceleration) {
             τ_init = 0;
         } else if (do_gn_step) {
+            ScopedTraceEvent trace_dir{"direction_gn", "direction"};
             auto is_constr_inactive = [&](index_t t, index_t i) {
                 real_t ui = vars.uk(curr->xu, t)(i);
                 // Gradient descent step.
@@ -623,6 +633,7 @@ auto PANOCOCPSolver<Conf>::operator()(
                 lqr.solve_masked(ABk, Jk, q, work_2x);
             }
         } else {
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             if (!enable_lbfgs)
                 throw std::logic_error("enable_lbfgs");
 
@@ -684,6 +695,7 @@ auto PANOCOCPSolver<Conf>::operator()(
 
         // Line search ---------------------------------------------------------
 
+        phase.set(AllocPhase::LineSearch);
         next->γ           = curr->γ;
         next->L           = curr->L;
         τ                 = τ_init;
@@ -719,6 +731,9 @@ auto PANOCOCPSolver<Conf>::operator()(
 
         // Backtracking line search loop
         while (!stop_signal.stop_requested()) {
+            ScopedTraceEvent trace_ls{"linesearch_trial", "linesearch"};
+            ALPAQA_USDT(linesearch_trial, k, usdt::real_bits(τ),
+                        usdt::real_bits(next->γ));
 
             // Recompute step only if τ changed
             if (τ != τ_prev) {
@@ -781,6 +796,7 @@ auto PANOCOCPSolver<Conf>::operator()(
 
         // Update L-BFGS -------------------------------------------------------
 
+        phase.set(AllocPhase::Direction);
         if (enable_lbfgs) {
             const bool force = true;
             assign_extract_u(next->xu, next->u);
@@ -790,6 +806,7 @@ auto PANOCOCPSolver<Conf>::operator()(
             }
             if (!reset_because_gn) { // TODO: this may be too restrictive
                 alpaqa::util::Timed t{s.time_lbfgs_update};
+                ScopedTraceEvent trace_dir{"direction_update", "direction"};
                 s.lbfgs_rejected += dir_rejected = not lbfgs.update(
                     curr->u, next->u, curr->grad_ψ, next->grad_ψ,
                     LBFGS<config_t>::Sign::Positive, force);
@@ -797,7 +814,13 @@ auto PANOCOCPSolver<Conf>::operator()(
         }
 
         // Print ---------------------------------------------------------------
+        phase.set(AllocPhase::Iteration);
         do_progress_cb(k, *curr, q, τ, εₖ, did_gn, nJ, SolverStatus::Busy);
+        ALPAQA_USDT(panococp_iteration, k, usdt::real_bits(εₖ),
+                    usdt::real_bits(curr->γ), usdt::real_bits(τ),
+                    usdt::nanoseconds(s.time_forward),
+                    usdt::nanoseconds(s.time_backward),
+                    usdt::nanoseconds(s.time_lqr_solve));
         if (do_print && (k != 0 || did_gn))
             print_progress_2(q, τ, did_gn, nJ, lqr.min_rcond, dir_rejected);
 
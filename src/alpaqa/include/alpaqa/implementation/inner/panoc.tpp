@@ -11,8 +11,11 @@
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/implementation/inner/panoc-helpers.tpp>
 #include <alpaqa/implementation/util/print.tpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/timed.hpp>
+#include <alpaqa/util/trace.hpp>
+#include <alpaqa/util/usdt.hpp>
 
 namespace alpaqa {
 
@@ -43,6 +46,8 @@ auto PANOCSolver<DirectionProviderT>::operator()(
     auto os         = opts.os ? opts.os : this->os;
     auto start_time = std::chrono::steady_clock::now();
     Stats s;
+    ScopedAllocPhase phase{AllocPhase::Setup};
+    ScopedTraceEvent trace{"PANOC", "inner"};
 
     const auto n = problem.get_n();
     const auto m = problem.get_m();
@@ -100,22 +105,26 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
     // Problem functions -------------------------------------------------------
 
-    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m](Iterate &i) {
+    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx = problem.eval_ψ_grad_ψ(i.x, y, Σ, i.grad_ψ, work_n, work_m);
     };
-    auto eval_prox_grad_step = [&problem](Iterate &i) {
+    auto eval_prox_grad_step = [&problem, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_prox};
         i.hx̂  = problem.eval_prox_grad_step(i.γ, i.x, i.grad_ψ, i.x̂, i.p);
         i.pᵀp = i.p.squaredNorm();
         i.grad_ψᵀp = i.p.dot(i.grad_ψ);
     };
-    auto eval_ψx̂ = [&problem, &y, &Σ, &work_n, this](Iterate &i) {
+    auto eval_ψx̂ = [&problem, &y, &Σ, &work_n, &s, this](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         if (params.eager_gradient_eval)
             i.ψx̂ = problem.eval_ψ_grad_ψ(i.x̂, y, Σ, i.grad_ψx̂, work_n, i.ŷx̂);
         else
             i.ψx̂ = problem.eval_ψ(i.x̂, y, Σ, i.ŷx̂);
         i.have_grad_ψx̂ = params.eager_gradient_eval;
     };
-    auto eval_grad_ψx̂ = [&problem, &work_n](Iterate &i) {
+    auto eval_grad_ψx̂ = [&problem, &work_n, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         problem.eval_grad_L(i.x̂, i.ŷx̂, i.grad_ψx̂, work_n);
         i.have_grad_ψx̂ = true;
     };
@@ -166,6 +175,7 @@ auto PANOCSolver<DirectionProviderT>::operator()(
         if (!progress_cb)
             return;
         ScopedMallocAllower ma;
+        ScopedAllocPhase cb_phase{AllocPhase::Callback};
         alpaqa::util::Timed t{s.time_progress_callback};
         auto &&grad_ψx̂ =
             it.have_grad_ψx̂ ? crvec{it.grad_ψx̂} : crvec{null_vec<config_t>};
@@ -192,6 +202,7 @@ auto PANOCSolver<DirectionProviderT>::operator()(
             .outer_iter = opts.outer_iter,
             .problem    = &problem,
             .params     = &params,
+            .stats      = &s,
         });
     };
 
@@ -203,6 +214,7 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
     // Finite difference approximation of ∇²ψ in starting point
     if (params.Lipschitz.L_0 <= 0) {
+        alpaqa::util::Timed t{s.time_evaluations};
         curr->L = Helpers::initial_lipschitz_estimate(
             problem, curr->x, y, Σ, params.Lipschitz.ε, params.Lipschitz.δ,
             params.L_min, params.L_max,
@@ -247,6 +259,8 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
     ScopedMallocBlocker mb; // Don't allocate in the inner loop
     while (true) {
+        phase.set(AllocPhase::Iteration);
+        ScopedTraceEvent trace_iter{"iteration", "inner", k};
 
         // Check stopping criteria ---------------------------------------------
 
@@ -303,14 +317,20 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
         // Calculate quasi-Newton step -----------------------------------------
 
+        phase.set(AllocPhase::Direction);
         real_t τ_init = NaN<config_t>;
         if (k == 0) { // Initialize L-BFGS
             ScopedMallocAllower ma;
+            ScopedAllocPhase init_phase{AllocPhase::Setup};
+            alpaqa::util::Timed t{s.time_direction_apply};
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             direction.initialize(problem, y, Σ, curr->γ, curr->x, curr->x̂,
                                  curr->p, curr->grad_ψ);
             τ_init = 0;
         }
         if (k > 0 || direction.has_initial_direction()) {
+            alpaqa::util::Timed t{s.time_direction_apply};
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             τ_init = direction.apply(curr->γ, curr->x, curr->x̂, curr->p,
                                      curr->grad_ψ, q)
                          ? 1
@@ -326,6 +346,7 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
         // Line search ---------------------------------------------------------
 
+        phase.set(AllocPhase::LineSearch);
         next->γ                         = curr->γ;
         next->L                         = curr->L;
         τ                               = τ_init;
@@ -356,7 +377,11 @@ auto PANOCSolver<DirectionProviderT>::operator()(
             next->have_grad_ψx̂ = false;
         };
 
+        auto linesearch_t0 = std::chrono::steady_clock::now();
         while (!stop_signal.stop_requested()) {
+            ScopedTraceEvent trace_ls{"linesearch_trial", "linesearch"};
+            ALPAQA_USDT(linesearch_trial, k, usdt::real_bits(τ),
+                        usdt::real_bits(next->γ));
 
             // Recompute step only if τ changed
             if (τ != τ_prev) {
@@ -401,6 +426,8 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
             // Update L-BFGS in candidate (even if we don't accept this point)
             if (update_lbfgs_in_linesearch && !updated_lbfgs) {
+                alpaqa::util::Timed t{s.time_direction_update};
+                ScopedTraceEvent trace_dir{"direction_update", "direction"};
                 s.lbfgs_rejected += dir_rejected = not direction.update(
                     curr->γ, next->γ, curr->x, next->x, curr->p, next->p,
                     curr->grad_ψ, next->grad_ψ);
@@ -420,6 +447,7 @@ auto PANOCSolver<DirectionProviderT>::operator()(
             // QUB and line search satisfied (or τ is 0 and L > L_max)
             break;
         }
+        s.time_linesearch += std::chrono::steady_clock::now() - linesearch_t0;
         // If τ < τ_min the line search failed and we accepted the prox step
         s.linesearch_failures += (τ == 0 && τ_init > 0);
         s.τ_1_accepted += τ == 1;
@@ -432,22 +460,35 @@ auto PANOCSolver<DirectionProviderT>::operator()(
 
         // Update L-BFGS -------------------------------------------------------
 
+        phase.set(AllocPhase::Direction);
         if (!updated_lbfgs) {
             if (curr->γ != next->γ) { // Flush L-BFGS if γ changed
-                direction.changed_γ(next->γ, curr->γ);
+                {
+                    alpaqa::util::Timed t{s.time_direction_update};
+                    ScopedTraceEvent trace_dir{"direction_update", "direction"};
+                    direction.changed_γ(next->γ, curr->γ);
+                }
                 if (params.recompute_last_prox_step_after_stepsize_change) {
                     curr->γ = next->γ;
                     curr->L = next->L;
                     eval_prox_grad_step(*curr);
                 }
             }
+            alpaqa::util::Timed t{s.time_direction_update};
+            ScopedTraceEvent trace_dir{"direction_update", "direction"};
             s.lbfgs_rejected += dir_rejected = not direction.update(
                 curr->γ, next->γ, curr->x, next->x, curr->p, next->p,
                 curr->grad_ψ, next->grad_ψ);
         }
 
         // Print ---------------------------------------------------------------
+        phase.set(AllocPhase::Iteration);
         do_progress_cb(k, *curr, q, τ, εₖ, SolverStatus::Busy);
+        ALPAQA_USDT(panoc_iteration, k, usdt::real_bits(εₖ),
+                    usdt::real_bits(curr->γ), usdt::real_bits(τ),
+                    usdt::nanoseconds(s.time_evaluations),
+                    usdt::nanoseconds(s.time_direction_apply),
+                    usdt::nanoseconds(s.time_linesearch));
         if (do_print && (k != 0 || direction.has_initial_direction()))
             print_progress_2(q, τ, dir_rejected);
 
@@ -11,8 +11,11 @@
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/implementation/inner/panoc-helpers.tpp>
 #include <alpaqa/implementation/util/print.tpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/timed.hpp>
+#include <alpaqa/util/trace.hpp>
+#include <alpaqa/util/usdt.hpp>
 
 namespace alpaqa {
 
@@ -43,6 +46,8 @@ auto PANTRSolver<DirectionProviderT>::operator()(
     auto os         = opts.os ? opts.os : this->os;
     auto start_time = std::chrono::steady_clock::now();
     Stats s;
+    ScopedAllocPhase phase{AllocPhase::Setup};
+    ScopedTraceEvent trace{"PANTR", "inner"};
 
     const auto n = problem.get_n();
     const auto m = problem.get_m();
@@ -81,18 +86,22 @@ auto PANTRSolver<DirectionProviderT>::operator()(
 
     // Problem functions -------------------------------------------------------
 
-    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m](Iterate &i) {
+    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx = problem.eval_ψ_grad_ψ(i.x, y, Σ, i.grad_ψ, work_n, work_m);
     };
-    auto eval_prox_grad_step = [&problem](Iterate &i) {
+    auto eval_prox_grad_step = [&problem, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_prox};
         i.hx̂  = problem.eval_prox_grad_step(i.γ, i.x, i.grad_ψ, i.x̂, i.p);
         i.pᵀp = i.p.squaredNorm();
         i.grad_ψᵀp = i.p.dot(i.grad_ψ);
     };
-    auto eval_ψx̂ = [&problem, &y, &Σ](Iterate &i) {
+    auto eval_ψx̂ = [&problem, &y, &Σ, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx̂ = problem.eval_ψ(i.x̂, y, Σ, i.ŷx̂);
     };
-    auto eval_grad_ψx̂ = [&problem, &work_n](Iterate &i, rvec grad_ψx̂) {
+    auto eval_grad_ψx̂ = [&problem, &work_n, &s](Iterate &i, rvec grad_ψx̂) {
+        alpaqa::util::Timed t{s.time_evaluations};
         problem.eval_grad_L(i.x̂, i.ŷx̂, grad_ψx̂, work_n);
     };
 
@@ -162,6 +171,7 @@ auto PANTRSolver<DirectionProviderT>::operator()(
         if (!progress_cb)
             return;
         ScopedMallocAllower ma;
+        ScopedAllocPhase cb_phase{AllocPhase::Callback};
         alpaqa::util::Timed t{s.time_progress_callback};
         progress_cb(ProgressInfo{
             .k          = k,
@@ -188,6 +198,7 @@ auto PANTRSolver<DirectionProviderT>::operator()(
             .outer_iter = opts.outer_iter,
             .problem    = &problem,
             .params     = &params,
+            .stats      = &s,
         });
     };
 
@@ -199,6 +210,7 @@ auto PANTRSolver<DirectionProviderT>::operator()(
 
     // Finite difference approximation of ∇²ψ in starting point
     if (params.Lipschitz.L_0 <= 0) {
+        alpaqa::util::Timed t{s.time_evaluations};
         curr->L = Helpers::initial_lipschitz_estimate(
             problem, curr->x, y, Σ, params.Lipschitz.ε, params.Lipschitz.δ,
             params.L_min, params.L_max,
@@ -242,6 +254,8 @@ auto PANTRSolver<DirectionProviderT>::operator()(
 
     ScopedMallocBlocker mb; // Don't allocate in the inner loop
     while (true) {
+        phase.set(AllocPhase::Iteration);
+        ScopedTraceEvent trace_iter{"iteration", "inner", k};
 
         // Check stopping criteria ---------------------------------------------
 
@@ -322,12 +336,18 @@ auto PANTRSolver<DirectionProviderT>::operator()(
         // Initialize direction
         if (k == 0) {
             ScopedMallocAllower ma;
+            ScopedAllocPhase init_phase{AllocPhase::Setup};
+            alpaqa::util::Timed t{s.time_direction_apply};
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             direction.initialize(problem, y, Σ, prox->γ, prox->x, prox->x̂,
                                  prox->p, prox->grad_ψ);
         }
 
         // Check if x̂ₖ + q provides sufficient decrease
         auto compute_candidate_fbe = [&](crvec q) {
+            ScopedTraceEvent trace_ls{"trust_region_trial", "linesearch"};
+            ALPAQA_USDT(trust_region_trial, k, usdt::real_bits(Δ),
+                        usdt::real_bits(prox->γ));
             // Candidate step xₖ₊₁ = x̂ₖ + q
             cand->x = prox->x + q;
             // Compute ψ(xₖ₊₁), ∇ψ(xₖ₊₁)
@@ -370,11 +390,13 @@ auto PANTRSolver<DirectionProviderT>::operator()(
 
         // Compute trust region direction from x̂ₖ
         auto compute_trust_region_step = [&](rvec q, real_t Δ) {
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             auto t0 = std::chrono::steady_clock::now();
             real_t q_model = direction.apply(prox->γ, prox->x, prox->x̂, prox->p,
                                              prox->grad_ψ, Δ, q);
             auto t1            = std::chrono::steady_clock::now();
             direction_duration = t1 - t0;
+            s.time_direction_apply += direction_duration;
 
             // Check if step is valid
             if (not q.allFinite()) {
@@ -393,10 +415,12 @@ auto PANTRSolver<DirectionProviderT>::operator()(
         };
 
         // Solve TR subproblem and update radius
+        phase.set(AllocPhase::Direction);
         accept_candidate           = false;
         bool accelerated_iteration = k > 0 || direction.has_initial_direction();
         if (accelerated_iteration && !params.disable_acceleration) {
             if (auto q_model = compute_trust_region_step(q, Δ); q_model < 0) {
+                phase.set(AllocPhase::LineSearch);
                 compute_candidate_fbe(q);
                 ρ                = compute_candidate_ratio(q_model);
                 accept_candidate = ρ >= params.ratio_threshold_acceptable;
@@ -406,28 +430,43 @@ auto PANTRSolver<DirectionProviderT>::operator()(
         }
 
         // Progress callback
+        phase.set(AllocPhase::Iteration);
         do_progress_cb(k, *curr, q, grad_ψx̂, Δ, ρ, εₖ, accept_candidate,
                        SolverStatus::Busy);
+        ALPAQA_USDT(pantr_iteration, k, usdt::real_bits(εₖ),
+                    usdt::real_bits(curr->γ), usdt::real_bits(Δ),
+                    usdt::real_bits(ρ), usdt::nanoseconds(s.time_evaluations),
+                    usdt::nanoseconds(s.time_direction_apply));
 
         // Accept TR step
         if (accept_candidate) {
+            phase.set(AllocPhase::LineSearch);
             // Quadratic upper bound in next iterate
             if (!params.compute_ratio_using_new_stepsize) {
                 eval_ψx̂(*cand);
                 backtrack_qub(*cand);
             }
             // Flush L-BFGS if γ changed
+            phase.set(AllocPhase::Direction);
             if (prox->γ != cand->γ) {
-                direction.changed_γ(cand->γ, prox->γ);
+                {
+                    alpaqa::util::Timed t{s.time_direction_update};
+                    ScopedTraceEvent trace_dir{"direction_update", "direction"};
+                    direction.changed_γ(cand->γ, prox->γ);
+                }
                 if (params.recompute_last_prox_step_after_direction_reset) {
                     std::tie(prox->γ, prox->L) = std::tie(cand->γ, cand->L);
                     eval_prox_grad_step(*prox);
                 }
             }
             // update L-BFGS
-            s.direction_update_rejected += not direction.update(
-                prox->γ, cand->γ, prox->x, cand->x, prox->p, cand->p,
-                prox->grad_ψ, cand->grad_ψ);
+            {
+                alpaqa::util::Timed t{s.time_direction_update};
+                ScopedTraceEvent trace_dir{"direction_update", "direction"};
+                s.direction_update_rejected += not direction.update(
+                    prox->γ, cand->γ, prox->x, cand->x, prox->p, cand->p,
+                    prox->grad_ψ, cand->grad_ψ);
+            }
 
             if (do_print)
                 print_progress_2(q, ρ, true, direction_duration);
@@ -439,20 +478,29 @@ auto PANTRSolver<DirectionProviderT>::operator()(
             if (accelerated_iteration)
                 ++s.accelerated_step_rejected;
             // Quadratic upper bound in x̂ₖ
+            phase.set(AllocPhase::LineSearch);
             eval_ψx̂(*prox);
             backtrack_qub(*prox);
+            phase.set(AllocPhase::Direction);
             if (prox->γ != curr->γ) {
-                direction.changed_γ(prox->γ, curr->γ);
+                {
+                    alpaqa::util::Timed t{s.time_direction_update};
+                    ScopedTraceEvent trace_dir{"direction_update", "direction"};
+                    direction.changed_γ(prox->γ, curr->γ);
+                }
                 if (params.recompute_last_prox_step_after_direction_reset) {
                     std::tie(curr->γ, curr->L) = std::tie(prox->γ, prox->L);
                     eval_prox_grad_step(*curr);
                 }
             }
             // update direction
-            if (params.update_direction_on_prox_step)
+            if (params.update_direction_on_prox_step) {
+                alpaqa::util::Timed t{s.time_direction_update};
+                ScopedTraceEvent trace_dir{"direction_update", "direction"};
                 s.direction_update_rejected += not direction.update(
                     curr->γ, prox->γ, curr->x, prox->x, curr->p, prox->p,
                     curr->grad_ψ, prox->grad_ψ);
+            }
             if (do_print && accelerated_iteration)
                 print_progress_2(q, ρ, false, direction_duration);
             // x̂ₖ becomes new iterate
@@ -463,6 +511,7 @@ auto PANTRSolver<DirectionProviderT>::operator()(
         { // Make sure that we don't rely on any data from previous iterations,
             // reset to NaN:
             ScopedMallocAllower ma;
+            ScopedAllocPhase debug_phase{AllocPhase::Other};
             *prox = {n, m};
             *cand = {n, m};
         }
@@ -11,8 +11,11 @@
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/implementation/inner/panoc-helpers.tpp>
 #include <alpaqa/implementation/util/print.tpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/timed.hpp>
+#include <alpaqa/util/trace.hpp>
+#include <alpaqa/util/usdt.hpp>
 
 namespace alpaqa {
 
@@ -43,6 +46,8 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
     auto os         = opts.os ? opts.os : this->os;
     auto start_time = std::chrono::steady_clock::now();
     Stats s;
+    ScopedAllocPhase phase{AllocPhase::Setup};
+    ScopedTraceEvent trace{"ZeroFPR", "inner"};
 
     const auto n = problem.get_n();
     const auto m = problem.get_m();
@@ -109,21 +114,26 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
     // Problem functions -------------------------------------------------------
 
-    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m](Iterate &i) {
+    auto eval_ψ_grad_ψ = [&problem, &y, &Σ, &work_n, &work_m, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx = problem.eval_ψ_grad_ψ(i.x, y, Σ, i.grad_ψ, work_n, work_m);
     };
-    auto eval_prox_grad_step = [&problem](Iterate &i) {
+    auto eval_prox_grad_step = [&problem, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_prox};
         i.hx̂  = problem.eval_prox_grad_step(i.γ, i.x, i.grad_ψ, i.x̂, i.p);
         i.pᵀp = i.p.squaredNorm();
         i.grad_ψᵀp = i.p.dot(i.grad_ψ);
     };
-    auto eval_cost_in_prox = [&problem, &y, &Σ](Iterate &i) {
+    auto eval_cost_in_prox = [&problem, &y, &Σ, &s](Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         i.ψx̂ = problem.eval_ψ(i.x̂, y, Σ, i.ŷx̂);
     };
-    auto eval_grad_in_prox = [&problem, &prox, &work_n](const Iterate &i) {
+    auto eval_grad_in_prox = [&problem, &prox, &work_n, &s](const Iterate &i) {
+        alpaqa::util::Timed t{s.time_evaluations};
         problem.eval_grad_L(i.x̂, i.ŷx̂, prox->grad_ψ, work_n);
     };
-    auto eval_prox_grad_step_in_prox = [&problem, &prox](const Iterate &i) {
+    auto eval_prox_grad_step_in_prox = [&problem, &prox, &s](const Iterate &i) {
+        alpaqa::util::Timed t{s.time_prox};
         prox->hx̂ = problem.eval_prox_grad_step(i.γ, i.x̂, prox->grad_ψ, prox->x̂,
                                                prox->p);
         prox->pᵀp      = prox->p.squaredNorm();
@@ -176,6 +186,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
         if (!progress_cb)
             return;
         ScopedMallocAllower ma;
+        ScopedAllocPhase cb_phase{AllocPhase::Callback};
         alpaqa::util::Timed t{s.time_progress_callback};
         progress_cb(ProgressInfo{
             .k          = k,
@@ -200,6 +211,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
             .outer_iter = opts.outer_iter,
             .problem    = &problem,
             .params     = &params,
+            .stats      = &s,
         });
     };
 
@@ -211,6 +223,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
     // Finite difference approximation of ∇²ψ in starting point
     if (params.Lipschitz.L_0 <= 0) {
+        alpaqa::util::Timed t{s.time_evaluations};
         curr->L = Helpers::initial_lipschitz_estimate(
             problem, curr->x, y, Σ, params.Lipschitz.ε, params.Lipschitz.δ,
             params.L_min, params.L_max,
@@ -256,6 +269,8 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
     ScopedMallocBlocker mb; // Don't allocate in the inner loop
     while (true) {
+        phase.set(AllocPhase::Iteration);
+        ScopedTraceEvent trace_iter{"iteration", "inner", k};
 
         // Check stopping criteria ---------------------------------------------
 
@@ -310,14 +325,20 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
         // Calculate quasi-Newton step -----------------------------------------
 
+        phase.set(AllocPhase::Direction);
         real_t τ_init = NaN<config_t>;
         if (k == 0) { // Initialize L-BFGS
             ScopedMallocAllower ma;
+            ScopedAllocPhase init_phase{AllocPhase::Setup};
+            alpaqa::util::Timed t{s.time_direction_apply};
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             direction.initialize(problem, y, Σ, curr->γ, curr->x̂, prox->x̂,
                                  prox->p, prox->grad_ψ);
             τ_init = 0;
         }
         if (k > 0 || direction.has_initial_direction()) {
+            alpaqa::util::Timed t{s.time_direction_apply};
+            ScopedTraceEvent trace_dir{"direction", "direction"};
             τ_init = direction.apply(curr->γ, curr->x̂, prox->x̂, prox->p,
                                      prox->grad_ψ, q)
                          ? 1
@@ -333,6 +354,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
         // Line search ---------------------------------------------------------
 
+        phase.set(AllocPhase::LineSearch);
         next->γ                         = curr->γ;
         next->L                         = curr->L;
         τ                               = τ_init;
@@ -359,7 +381,11 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
             eval_ψ_grad_ψ(*next);
         };
 
+        auto linesearch_t0 = std::chrono::steady_clock::now();
         while (!stop_signal.stop_requested()) {
+            ScopedTraceEvent trace_ls{"linesearch_trial", "linesearch"};
+            ALPAQA_USDT(linesearch_trial, k, usdt::real_bits(τ),
+                        usdt::real_bits(next->γ));
 
             // Recompute step only if τ changed
             if (τ != τ_prev) {
@@ -404,6 +430,8 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
             // Update L-BFGS
             if (update_lbfgs_in_linesearch && !updated_lbfgs) {
+                alpaqa::util::Timed t{s.time_direction_update};
+                ScopedTraceEvent trace_dir{"direction_update", "direction"};
                 if (params.update_direction_from_prox_step) {
                     s.lbfgs_rejected += dir_rejected = not direction.update(
                         curr->γ, next->γ, curr->x̂, next->x, prox->p, next->p,
@@ -429,6 +457,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
             // QUB and line search satisfied (or τ is 0 and L > L_max)
             break;
         }
+        s.time_linesearch += std::chrono::steady_clock::now() - linesearch_t0;
         // If τ < τ_min the line search failed and we accepted the prox step
         s.linesearch_failures += (τ == 0 && τ_init > 0);
         s.τ_1_accepted += τ == 1;
@@ -441,15 +470,22 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 
         // Update L-BFGS -------------------------------------------------------
 
+        phase.set(AllocPhase::Direction);
         if (!updated_lbfgs) {
             if (curr->γ != next->γ) { // Flush L-BFGS if γ changed
-                direction.changed_γ(next->γ, curr->γ);
+                {
+                    alpaqa::util::Timed t{s.time_direction_update};
+                    ScopedTraceEvent trace_dir{"direction_update", "direction"};
+                    direction.changed_γ(next->γ, curr->γ);
+                }
                 if (params.recompute_last_prox_step_after_stepsize_change) {
                     curr->γ = next->γ;
                     curr->L = next->L;
                     eval_prox_grad_step_in_prox(*curr);
                 }
             }
+            alpaqa::util::Timed t{s.time_direction_update};
+            ScopedTraceEvent trace_dir{"direction_update", "direction"};
             if (τ > 0 && params.update_direction_from_prox_step) {
                 s.lbfgs_rejected += dir_rejected = not direction.update(
                     curr->γ, next->γ, curr->x̂, next->x, prox->p, next->p,
@@ -462,7 +498,13 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
         }
 
         // Print ---------------------------------------------------------------
+        phase.set(AllocPhase::Iteration);
         do_progress_cb(k, *curr, q, prox->grad_ψ, τ, εₖ, SolverStatus::Busy);
+        ALPAQA_USDT(zerofpr_iteration, k, usdt::real_bits(εₖ),
+                    usdt::real_bits(curr->γ), usdt::real_bits(τ),
+                    usdt::nanoseconds(s.time_evaluations),
+                    usdt::nanoseconds(s.time_direction_apply),
+                    usdt::nanoseconds(s.time_linesearch));
         if (do_print && (k != 0 || direction.has_initial_direction()))
             print_progress_2(q, τ, dir_rejected);
 
@@ -473,6 +515,7 @@ auto ZeroFPRSolver<DirectionProviderT>::operator()(
 #ifndef NDEBUG
         {
             ScopedMallocAllower ma;
+            ScopedAllocPhase debug_phase{AllocPhase::Other};
             *prox = {n, m};
             *next = {n, m};
         }
@@ -7,11 +7,15 @@
 #include <iostream>
 #include <utility>
 
+#include <alpaqa/accelerators/anderson.hpp>
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/implementation/outer/internal/alm-helpers.tpp>
 #include <alpaqa/implementation/util/print.tpp>
 #include <alpaqa/inner/inner-solve-options.hpp>
 #include <alpaqa/inner/internal/solverstatus.hpp>
+#include <alpaqa/util/alloc-accounting.hpp>
+#include <alpaqa/util/trace.hpp>
+#include <alpaqa/util/usdt.hpp>
 
 namespace alpaqa {
 
@@ -21,7 +25,10 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
                                     std::optional<rvec> Σ) {
     using std::chrono::duration_cast;
     using std::chrono::nanoseconds;
-    auto start_time = std::chrono::steady_clock::now();
+    auto start_time   = std::chrono::steady_clock::now();
+    auto start_allocs = alloc_accounting::snapshot();
+    ScopedAllocPhase phase{AllocPhase::Outer};
+    ScopedTraceEvent trace{"ALM", "alm"};
 
     // Check the problem dimensions etc.
     p.check();
@@ -51,6 +58,7 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
         s.outer_iterations = 1;
         s.elapsed_time     = duration_cast<nanoseconds>(time_elapsed);
         s.status           = ps.status;
+        s.allocations      = alloc_accounting::snapshot() - start_allocs;
         return s;
     }
 
@@ -82,8 +90,22 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
     // Inner solver tolerance
     real_t ε = params.initial_tolerance;
 
+    // Anderson acceleration of the multiplier updates
+    const bool accelerate = params.anderson_memory > 0;
+    AndersonAccel<config_t> anderson{{.memory = params.anderson_memory}};
+    vec y_in, y_plain;
+    bool anderson_initialized = false, accelerated = false;
+    if (accelerate) {
+        anderson.resize(m);
+        y_in.resize(m);
+        y_plain.resize(m);
+    }
+
     for (unsigned i = 0; i < params.max_iter; ++i) {
+        ScopedTraceEvent trace_iter{"outer_iteration", "alm", i};
         p.eval_proj_multipliers(y, params.max_multiplier);
+        if (accelerate)
+            y_in = y;
         bool out_of_iter = i + 1 == params.max_iter;
 
         auto time_elapsed   = std::chrono::steady_clock::now() - start_time;
@@ -112,6 +134,11 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
 
         time_elapsed     = std::chrono::steady_clock::now() - start_time;
         bool out_of_time = time_elapsed > params.max_time;
+        ALPAQA_USDT(alm_outer_iteration, i, usdt::real_bits(ε),
+                    usdt::real_bits(norm_e),
+                    static_cast<uint64_t>(ps.iterations),
+                    static_cast<int>(ps.status),
+                    usdt::nanoseconds(time_elapsed));
 
         // Print statistics of current iteration
         if (params.print_interval != 0 && i % params.print_interval == 0) {
@@ -135,6 +162,7 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
             s.outer_iterations = i + 1;
             s.elapsed_time     = duration_cast<nanoseconds>(time_elapsed);
             s.status           = ps.status;
+            s.allocations      = alloc_accounting::snapshot() - start_allocs;
             if (Σ)
                 *Σ = Σ_curr;
             return s;
@@ -154,19 +182,52 @@ ALMSolver<InnerSolverT>::operator()(const Problem &p, rvec x, rvec y,
                                  : out_of_time ? SolverStatus::MaxTime
                                  : out_of_iter ? SolverStatus::MaxIter
                                                : SolverStatus::Busy;
+            s.allocations      = alloc_accounting::snapshot() - start_allocs;
             if (Σ)
                 *Σ = Σ_curr;
             return s;
         }
-        // Update Σ to contain the penalty to use on the next iteration.
-        Helpers::update_penalty_weights(params, params.penalty_update_factor,
-                                        i == 0, error, error_old, norm_e,
-                                        norm_e_old, Σ_curr);
         // Lower the primal tolerance for the inner solver.
-        ε = std::fmax(params.tolerance_update_factor * ε, params.tolerance);
+        real_t ε_old = std::exchange(
+            ε, std::fmax(params.tolerance_update_factor * ε, params.tolerance));
+        // If the accelerated multipliers increased the constraint violation,
+        // discard them and continue with the plain multiplier update from the
+        // previous iteration instead.
+        if (accelerated && norm_e > norm_e_old) {
+            ++s.acceleration_rejections;
+            y.swap(y_plain);
+            anderson.reset();
+            accelerated = false;
+            continue;
+        }
+        // Update Σ to contain the penalty to use on the next iteration.
+        bool Σ_changed = Helpers::update_penalty_weights(
+            params, params.penalty_update_factor, i == 0, error, error_old,
+            norm_e, norm_e_old, Σ_curr);
         // Save previous error
         norm_e_old = norm_e;
         error.swap(error_old);
+        if (!accelerate)
+            continue;
+        // The penalty factors and the inner tolerance define the fixed-point
+        // map, so the history is discarded when they change.
+        accelerated = false;
+        if (Σ_changed || ε != ε_old) {
+            anderson_initialized = false;
+            continue;
+        }
+        // Extrapolate the multipliers, using the fixed-point residual of the
+        // multiplier update y ↦ y + Σ e.
+        y_plain = y;
+        y_in    = y_plain - y_in;
+        if (anderson_initialized) {
+            anderson.compute(y_plain, y_in, y);
+            ++s.accelerated_iterations;
+            accelerated = true;
+        } else {
+            anderson.initialize(y_plain, y_in);
+            anderson_initialized = true;
+        }
     }
     throw std::logic_error("[ALM]   loop error");
 }
@@ -13,29 +13,35 @@ template <Config Conf>
 struct ALMHelpers {
     USING_ALPAQA_CONFIG(Conf);
 
-    static void update_penalty_weights(const ALMParams<config_t> &params,
+    /// Returns true if any of the penalty factors changed.
+    static bool update_penalty_weights(const ALMParams<config_t> &params,
                                        real_t Δ, bool first_iter, rvec e,
                                        rvec old_e, real_t norm_e,
                                        real_t old_norm_e, rvec Σ) {
         const real_t θ = params.rel_penalty_increase_threshold;
         if (norm_e <= params.dual_tolerance) {
-            return;
+            return false;
         }
+        bool changed = false;
         if (params.single_penalty_factor) {
             if (first_iter || norm_e > θ * old_norm_e) {
                 real_t new_Σ = std::fmin(params.max_penalty, Δ * Σ(0));
+                changed      = new_Σ != Σ(0);
                 Σ.setConstant(new_Σ);
             }
         } else {
             for (index_t i = 0; i < e.rows(); ++i) {
                 if (first_iter || std::abs(e(i)) > θ * std::abs(old_e(i))) {
-                    Σ(i) = std::fmin(
+                    real_t new_Σ = std::fmin(
                         params.max_penalty,
                         std::fmax(Δ * std::abs(e(i)) / norm_e, real_t(1)) *
                             Σ(i));
+                    changed = changed || new_Σ != Σ(i);
+                    Σ(i)    = new_Σ;
                 }
             }
         }
+        return changed;
     }
 
     static void initialize_penalty(const TypeErasedProblem<config_t> &p,
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <alpaqa/outer/portfolio.hpp>
+#include <alpaqa/problem/synchronized-problem.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace alpaqa {
+
+template <Config Conf>
+auto PortfolioSolver<Conf>::operator()(const Problem &problem, rvec x, rvec y,
+                                       std::optional<rvec> Σ) -> Stats {
+    std::vector<Problem> problems;
+    if (params.clone_problem && problem.owns_referenced_object()) {
+        problems.assign(entries.size(), problem);
+    } else {
+        // All copies share the same mutex
+        using Synchronized = SynchronizedProblem<config_t>;
+        auto synchronized  = Problem::template make<Synchronized>(
+            Problem{&problem});
+        problems.assign(entries.size(), synchronized);
+    }
+    return operator()(std::span<const Problem>{problems}, x, y, Σ);
+}
+
+template <Config Conf>
+auto PortfolioSolver<Conf>::operator()(const ProblemFactory &make_problem,
+                                       rvec x, rvec y, std::optional<rvec> Σ)
+    -> Stats {
+    std::vector<Problem> problems;
+    problems.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+        problems.push_back(make_problem(static_cast<index_t>(i)));
+    return operator()(std::span<const Problem>{problems}, x, y, Σ);
+}
+
+template <Config Conf>
+auto PortfolioSolver<Conf>::operator()(std::span<const Problem> problems,
+                                       rvec x, rvec y, std::optional<rvec> Σ)
+    -> Stats {
+    using clock = std::chrono::steady_clock;
+    if (problems.size() != entries.size())
+        throw std::invalid_argument(
+            "PortfolioSolver: number of problems (" +
+            std::to_string(problems.size()) +
+            ") does not match the number of solvers (" +
+            std::to_string(entries.size()) + ")");
+    const auto n = entries.size();
+    Stats stats;
+    stats.entries.resize(n);
+    if (n == 0)
+        return stats;
+
+    // State of each of the solver threads
+    struct Worker {
+        vec x, y, Σ;
+        std::ostringstream log;
+        std::function<void()> stop;
+        std::exception_ptr exception;
+    };
+    std::vector<Worker> workers(n);
+    for (auto &w : workers) {
+        w.x = x;
+        w.y = y;
+        if (Σ)
+            w.Σ = *Σ;
+        else
+            w.Σ.setConstant(y.size(), alpaqa::NaN<config_t>);
+    }
+
+    // Shared state, protected by mtx
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t num_done         = 0;
+    index_t first_converged = -1;
+    bool stopping           = false;
+    auto stop_all           = [&] {
+        stopping = true;
+        for (auto &w : workers)
+            if (w.stop)
+                w.stop();
+    };
+
+    const auto t0 = clock::now();
+    auto run      = [&](size_t i) {
+        auto &w                = workers[i];
+        auto set_stop_function = [&](std::function<void()> stop) {
+            std::lock_guard lck{mtx};
+            w.stop = std::move(stop);
+            if (stopping && w.stop)
+                w.stop();
+        };
+        EntryStats s;
+        try {
+            s = entries[i]->solve(problems[i], w.x, w.y, w.Σ, &w.log,
+                                  set_stop_function);
+        } catch (...) {
+            w.exception = std::current_exception();
+            s.name      = entries[i]->name;
+            s.status    = SolverStatus::Exception;
+        }
+        s.elapsed_time = clock::now() - t0;
+        std::lock_guard lck{mtx};
+        bool converged    = s.status == SolverStatus::Converged;
+        stats.entries[i] = std::move(s);
+        if (converged && first_converged < 0) {
+            first_converged = static_cast<index_t>(i);
+            stop_all();
+        }
+        ++num_done;
+        cv.notify_one();
+    };
+
+    // Launch all solvers, and wait for them to finish, stopping all of them
+    // as soon as the first one converges, or when the user calls stop()
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+    auto join_all = [&] {
+        for (auto &t : threads)
+            t.join();
+    };
+    try {
+        for (size_t i = 0; i < n; ++i)
+            threads.emplace_back(run, i);
+    } catch (...) {
+        {
+            std::lock_guard lck{mtx};
+            stop_all();
+        }
+        join_all();
+        throw;
+    }
+    {
+        std::unique_lock lck{mtx};
+        while (num_done < threads.size()) {
+            cv.wait_for(lck, params.poll_interval);
+            if (!stopping && stop_signal.stop_requested())
+                stop_all();
+        }
+    }
+    join_all();
+    stats.elapsed_time = clock::now() - t0;
+
+    // If none of the solvers converged, select the most accurate result
+    index_t winner = first_converged;
+    if (winner < 0) {
+        real_t best_err = inf<config_t>;
+        for (size_t i = 0; i < n; ++i) {
+            if (workers[i].exception)
+                continue;
+            const auto &e = stats.entries[i];
+            real_t err    = std::max(e.ε, e.δ);
+            if (winner < 0 || err < best_err) {
+                winner   = static_cast<index_t>(i);
+                best_err = err;
+            }
+        }
+    }
+    // Only propagate exceptions if all solvers failed
+    if (winner < 0)
+        std::rethrow_exception(workers.front().exception);
+
+    auto &w                = workers[static_cast<size_t>(winner)];
+    const auto &win_stats  = stats.entries[static_cast<size_t>(winner)];
+    stats.winner           = winner;
+    stats.winner_name      = win_stats.name;
+    stats.status           = win_stats.status;
+    stats.time_to_solution = win_stats.elapsed_time;
+    x                      = w.x;
+    y                      = w.y;
+    if (Σ)
+        *Σ = w.Σ;
+    if (os)
+        *os << std::move(w.log).str() << std::flush;
+    return stats;
+}
+
+template <Config Conf>
+std::string PortfolioSolver<Conf>::get_name() const {
+    std::string name = "PortfolioSolver<";
+    for (const auto &e : entries) {
+        if (&e != &entries.front())
+            name += ", ";
+        name += e->get_solver_name();
+    }
+    return name + ">";
+}
+
+} // namespace alpaqa
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <alpaqa/outer/result-cache.hpp>
+
+#include <alpaqa/implementation/util/print.tpp>
+#include <alpaqa/util/io/csv.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <system_error>
+#include <vector>
+
+namespace alpaqa {
+
+namespace detail {
+
+template <std::floating_point F>
+void write_cache_row(std::ostream &os, std::span<const F> v) {
+    std::array<char, 64> buf;
+    for (size_t i = 0; i < v.size(); ++i)
+        os << (i == 0 ? "" : ",") << float_to_str_vw(buf, v[i]);
+    os << '\n';
+}
+
+} // namespace detail
+
+template <Config Conf>
+ResultCacheKey ResultCache<Conf>::make_key(
+    const TypeErasedProblem<config_t> &problem, std::string_view problem_id,
+    std::string_view solver_id, crvec x0, crvec y0) {
+    ResultCacheKey key;
+    key.add(std::string_view{"alpaqa result cache v1"});
+    key.add(sizeof(real_t)).add(std::numeric_limits<real_t>::digits);
+    key.add(problem.get_name());
+    key.add(problem.get_n()).add(problem.get_m());
+    key.add(problem.provides_get_box_C());
+    if (problem.provides_get_box_C()) {
+        const auto &C = problem.get_box_C();
+        key.add(C.lowerbound).add(C.upperbound);
+    }
+    key.add(problem.provides_get_box_D());
+    if (problem.provides_get_box_D()) {
+        const auto &D = problem.get_box_D();
+        key.add(D.lowerbound).add(D.upperbound);
+    }
+    key.add(problem_id).add(solver_id);
+    key.add(x0).add(y0);
+    return key;
+}
+
+template <Config Conf>
+auto ResultCache<Conf>::lookup(const std::string &key)
+    -> std::optional<Result> {
+    std::lock_guard lck{mtx};
+    if (auto it = index.find(key); it != index.end()) {
+        lru.splice(lru.begin(), lru, it->second); // mark as most recently used
+        ++stats.memory_hits;
+        return it->second->second;
+    }
+    if (auto r = lookup_disk(key)) {
+        ++stats.disk_hits;
+        store_memory(key, *r);
+        return r;
+    }
+    ++stats.misses;
+    return std::nullopt;
+}
+
+template <Config Conf>
+void ResultCache<Conf>::store(const std::string &key, Result result) {
+    std::lock_guard lck{mtx};
+    ++stats.stores;
+    if (!store_disk(key, result))
+        ++stats.disk_errors;
+    store_memory(key, std::move(result));
+}
+
+template <Config Conf>
+void ResultCache<Conf>::clear_memory() {
+    std::lock_guard lck{mtx};
+    lru.clear();
+    index.clear();
+}
+
+template <Config Conf>
+void ResultCache<Conf>::store_memory(const std::string &key, Result result) {
+    if (params.max_memory_entries == 0)
+        return;
+    if (auto it = index.find(key); it != index.end()) {
+        it->second->second = std::move(result);
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+    lru.emplace_front(key, std::move(result));
+    index.emplace(key, lru.begin());
+    while (lru.size() > params.max_memory_entries) {
+        index.erase(lru.back().first);
+        lru.pop_back();
+        ++stats.evictions;
+    }
+}
+
+template <Config Conf>
+std::filesystem::path
+ResultCache<Conf>::disk_path(const std::string &key) const {
+    return std::filesystem::path{params.directory} / (key + ".csv");
+}
+
+template <Config Conf>
+auto ResultCache<Conf>::lookup_disk(const std::string &key)
+    -> std::optional<Result> {
+    if (params.directory.empty())
+        return std::nullopt;
+    auto path = disk_path(key);
+    std::ifstream f{path};
+    if (!f)
+        return std::nullopt;
+    // The cache is only an optimization: corrupt or outdated files are
+    // treated as misses.
+    try {
+        Result r;
+        std::string line;
+        auto read_header = [&](std::string_view prefix, std::string &value) {
+            if (!std::getline(f, line) || !line.starts_with(prefix))
+                throw csv::read_error("invalid result cache header");
+            value = line.substr(prefix.size());
+        };
+        std::string version;
+        read_header("# alpaqa result cache ", version);
+        if (version != "v1")
+            return std::nullopt;
+        read_header("# solver: ", r.solver);
+        read_header("# status: ", r.status);
+        vec meta(13);
+        csv::read_row(f, meta);
+        auto to_index = [](real_t x) { return static_cast<index_t>(x); };
+        r.success          = meta(0) != 0;
+        r.ε                = meta(1);
+        r.δ                = meta(2);
+        r.norm_penalty     = meta(3);
+        r.h                = meta(4);
+        r.γ                = meta(5);
+        r.outer_iterations = to_index(meta(6));
+        r.inner_iterations = to_index(meta(7));
+        r.elapsed_time =
+            std::chrono::nanoseconds{static_cast<int64_t>(meta(8))};
+        r.x.resize(to_index(meta(9)));
+        r.y.resize(to_index(meta(10)));
+        r.multipliers_bounds.resize(to_index(meta(11)));
+        r.Σ.resize(to_index(meta(12)));
+        for (vec *v : {&r.x, &r.y, &r.multipliers_bounds, &r.Σ})
+            if (v->size() > 0)
+                csv::read_row(f, *v);
+        f.close();
+        // Mark the file as recently used, for the disk eviction policy
+        std::error_code ec;
+        std::filesystem::last_write_time(
+            path, std::filesystem::file_time_type::clock::now(), ec);
+        return r;
+    } catch (csv::read_error &) {
+        return std::nullopt;
+    }
+}
+
+template <Config Conf>
+bool ResultCache<Conf>::store_disk(const std::string &key,
+                                   const Result &result) {
+    if (params.directory.empty())
+        return true;
+    // The cache is only an optimization: failing to write a result should not
+    // throw away the solution, so errors are reported to the caller instead.
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(params.directory, ec);
+    if (ec)
+        return false;
+    // Write to a temporary file first and then rename it, so other processes
+    // sharing the same directory never see partially written results.
+    auto path = disk_path(key);
+    auto tmp  = path;
+    tmp += ".tmp" + std::to_string(std::random_device{}());
+    bool ok;
+    {
+        std::ofstream f{tmp};
+        if (!f)
+            return false;
+        f << "# alpaqa result cache v1\n"
+          << "# solver: " << result.solver << '\n'
+          << "# status: " << result.status << '\n';
+        std::array<real_t, 13> meta{
+            real_t(result.success),
+            result.ε,
+            result.δ,
+            result.norm_penalty,
+            result.h,
+            result.γ,
+            real_t(result.outer_iterations),
+            real_t(result.inner_iterations),
+            real_t(result.elapsed_time.count()),
+            real_t(result.x.size()),
+            real_t(result.y.size()),
+            real_t(result.multipliers_bounds.size()),
+            real_t(result.Σ.size()),
+        };
+        detail::write_cache_row<real_t>(f, meta);
+        for (const vec *v : {&result.x, &result.y, &result.multipliers_bounds,
+                             &result.Σ})
+            if (v->size() > 0)
+                detail::write_cache_row<real_t>(
+                    f, {v->data(), static_cast<size_t>(v->size())});
+        f.close();
+        ok = !f.fail();
+    }
+    if (ok)
+        fs::rename(tmp, path, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    enforce_disk_limit();
+    return true;
+}
+
+template <Config Conf>
+void ResultCache<Conf>::enforce_disk_limit() {
+    namespace fs = std::filesystem;
+    struct Entry {
+        fs::path path;
+        uintmax_t size;
+        fs::file_time_type time;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    std::error_code ec;
+    fs::directory_iterator it{params.directory, ec};
+    for (; !ec && it != fs::directory_iterator{}; it.increment(ec)) {
+        const auto &e = *it;
+        if (!e.is_regular_file(ec) || e.path().extension() != ".csv")
+            continue;
+        auto size = e.file_size(ec);
+        auto time = e.last_write_time(ec);
+        if (ec)
+            continue;
+        entries.push_back({e.path(), size, time});
+        total += size;
+    }
+    if (total <= params.max_disk_size)
+        return;
+    // Remove the least recently used files first
+    std::ranges::sort(entries, std::less{}, &Entry::time);
+    for (const auto &e : entries) {
+        if (total <= params.max_disk_size)
+            break;
+        if (fs::remove(e.path, ec)) {
+            total -= e.size;
+            ++stats.evictions;
+        }
+    }
+}
+
+} // namespace alpaqa
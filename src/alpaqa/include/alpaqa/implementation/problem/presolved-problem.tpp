@@ -0,0 +1,607 @@
+#pragma once
+
+#include <alpaqa/problem/presolved-problem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace alpaqa {
+
+template <Config Conf>
+PresolvedProblem<Conf>::PresolvedProblem(Problem problem, crvec x0, Params params)
+    : problem{std::move(problem)}, h_is_box_indicator{params.h_is_box_indicator} {
+    if (params.singleton_constraints && !params.h_is_box_indicator)
+        throw std::invalid_argument(
+            "Converting singleton constraints into bounds requires h_is_box_indicator");
+    const auto n = this->problem.get_n(), m = this->problem.get_m();
+    const bool have_C = this->problem.provides_get_box_C();
+    const bool have_D = this->problem.provides_get_box_D();
+    Box C{n}, D{m};
+    if (have_C)
+        C = this->problem.get_box_C();
+    if (have_D)
+        D = this->problem.get_box_D();
+    work_x = vec::Zero(n);
+    work_v.resize(n);
+    work_p.resize(n);
+    work_grad.resize(n);
+    work_y.resize(m);
+    work_Σ.resize(m);
+    work_g.resize(m);
+
+    // Fixed variables
+    indexvec col_map(n);
+    length_t n_red = 0;
+    for (index_t j = 0; j < n; ++j) {
+        bool fixed = params.fixed_variables && have_C && C.lowerbound(j) == C.upperbound(j) &&
+                     std::isfinite(C.lowerbound(j));
+        if (fixed) {
+            col_map(j) = -1;
+            work_x(j)  = C.lowerbound(j);
+            ++stats.fixed_variables;
+        } else {
+            col_map(j) = n_red++;
+        }
+    }
+    reduce_x = n_red < n;
+
+    // Constraints with infinite bounds, and constant constraints
+    indexvec row_map = indexvec::LinSpaced(m, 0, m - 1);
+    if (params.free_constraints && m > 0) {
+        for (index_t i = 0; i < m; ++i) {
+            if (D.lowerbound(i) == -inf<config_t> && D.upperbound(i) == +inf<config_t>) {
+                row_map(i) = -1;
+                ++stats.free_constraints;
+            }
+        }
+        // Rows of the Jacobian without any free variables
+        indexvec rows, cols;
+        sparsity::get_nonzero_indices(this->problem.get_jac_g_sparsity(), rows, cols);
+        indexvec nnz_free = indexvec::Zero(m);
+        for (index_t k = 0; k < rows.size(); ++k)
+            if (col_map(cols(k)) >= 0)
+                ++nnz_free(rows(k));
+        if ((nnz_free.array() == 0 && row_map.array() >= 0).any()) {
+            vec x = x0.cwiseMax(C.lowerbound).cwiseMin(C.upperbound);
+            this->problem.eval_g(x, work_g);
+            for (index_t i = 0; i < m; ++i) {
+                if (nnz_free(i) > 0 || row_map(i) < 0)
+                    continue;
+                if (D.lowerbound(i) <= work_g(i) && work_g(i) <= D.upperbound(i)) {
+                    row_map(i) = -1;
+                    ++stats.redundant_constraints;
+                }
+            }
+        }
+    }
+
+    // Constraints that only depend on a single variable
+    singleton_lb = indexvec::Constant(n, -1);
+    singleton_ub = indexvec::Constant(n, -1);
+    if (params.singleton_constraints && have_C && m > 0)
+        convert_singleton_constraints(x0, C, D, col_map, row_map, params);
+
+    // Number the remaining variables and constraints
+    free_vars.resize(n_red);
+    for (index_t j = 0; j < n; ++j)
+        if (col_map(j) >= 0)
+            free_vars(col_map(j)) = j;
+    reduced_var = col_map;
+    if (reduce_x && !h_is_box_indicator)
+        work_J.resize(n);
+    length_t m_red = 0;
+    for (index_t i = 0; i < m; ++i)
+        if (row_map(i) >= 0)
+            row_map(i) = m_red++;
+    kept_constr.resize(m_red);
+    for (index_t i = 0; i < m; ++i)
+        if (row_map(i) >= 0)
+            kept_constr(row_map(i)) = i;
+    reduce_g = m_red < m;
+
+    // Reduced boxes
+    reduced_boxes              = BoxConstrProblem<config_t>{n_red, m_red};
+    reduced_boxes.C.lowerbound = C.lowerbound(free_vars);
+    reduced_boxes.C.upperbound = C.upperbound(free_vars);
+    reduced_boxes.D.lowerbound = D.lowerbound(kept_constr);
+    reduced_boxes.D.upperbound = D.upperbound(kept_constr);
+
+    // Selection of the nonzeros of the sparse matrices
+    const auto &p = this->problem;
+    if (p.provides_eval_jac_g())
+        reduce_matrix(p.get_jac_g_sparsity(), row_map, col_map, jac_g);
+    if (p.provides_eval_hess_L())
+        reduce_matrix(p.get_hess_L_sparsity(), col_map, col_map, hess_L);
+    if (p.provides_eval_hess_ψ())
+        reduce_matrix(p.get_hess_ψ_sparsity(), col_map, col_map, hess_ψ);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::convert_singleton_constraints(crvec x0, Box &C, const Box &D,
+                                                           crindexvec col_map, rindexvec row_map,
+                                                           const Params &params) {
+    const auto n = problem.get_n(), m = problem.get_m();
+    // Find the rows of the Jacobian with a single (free) variable
+    indexvec rows, cols;
+    sparsity::get_nonzero_indices(problem.get_jac_g_sparsity(), rows, cols);
+    indexvec var = indexvec::Constant(m, -1); // -1: none, -2: multiple
+    for (index_t k = 0; k < rows.size(); ++k) {
+        auto i = rows(k), j = cols(k);
+        if (col_map(j) < 0 || var(i) == -2 || var(i) == j)
+            continue;
+        var(i) = var(i) == -1 ? j : -2;
+    }
+    // Evaluate the constraints and their gradients in two points inside of C
+    // to determine their coefficients
+    vec x_a = x0.cwiseMax(C.lowerbound).cwiseMin(C.upperbound);
+    vec x_b = x_a, Δ = vec::Zero(n);
+    for (index_t i = 0; i < m; ++i) {
+        if (row_map(i) < 0 || var(i) < 0)
+            continue;
+        auto j = var(i);
+        using std::min;
+        real_t up = C.upperbound(j) - x_a(j), down = x_a(j) - C.lowerbound(j);
+        Δ(j) = up >= down ? min(real_t(1), up / 2) : -min(real_t(1), down / 2);
+    }
+    x_b += Δ;
+    auto is_candidate = [&](index_t i) {
+        return row_map(i) >= 0 && var(i) >= 0 && Δ(var(i)) != 0;
+    };
+    bool any = false;
+    for (index_t i = 0; i < m; ++i)
+        any |= is_candidate(i);
+    if (!any)
+        return;
+
+    // Linearity cannot be inferred from function evaluations, it requires the
+    // Hessian of the constraint (or the user's word)
+    const bool check_hess = !params.assume_linear_singletons;
+    if (check_hess && !problem.provides_eval_hess_L())
+        return;
+    vec H;
+    if (check_hess)
+        H.resize(sparsity::get_nnz(problem.get_hess_L_sparsity()));
+    vec g_a(m), g_b(m), grad_a(n), grad_b(n), e_i = vec::Zero(m);
+    auto hess_gi_is_zero = [&](crvec x) {
+        H.setZero();
+        problem.eval_hess_L(x, e_i, 0, H);
+        return (H.array() == 0).all();
+    };
+    problem.eval_g(x_a, g_a);
+    problem.eval_g(x_b, g_b);
+    const auto tol = params.linearity_tolerance;
+    for (index_t i = 0; i < m; ++i) {
+        if (!is_candidate(i))
+            continue;
+        auto j = var(i);
+        e_i(i) = 1;
+        bool affine = !check_hess || (hess_gi_is_zero(x_a) && hess_gi_is_zero(x_b));
+        problem.eval_grad_g_prod(x_a, e_i, grad_a);
+        problem.eval_grad_g_prod(x_b, e_i, grad_b);
+        e_i(i) = 0;
+        real_t a = grad_a(j);
+        using std::abs;
+        using std::max;
+        bool linear = affine && a != 0 && std::isfinite(a) &&
+                      abs(a - grad_b(j)) <= tol * max(real_t(1), abs(a)) &&
+                      abs(g_b(i) - g_a(i) - a * Δ(j)) <=
+                          tol * max({real_t(1), abs(g_a(i)), abs(g_b(i))});
+        if (!linear)
+            continue;
+        // l ≤ a x_j + b ≤ u
+        real_t b = g_a(i) - a * x_a(j);
+        real_t l = (D.lowerbound(i) - b) / a, u = (D.upperbound(i) - b) / a;
+        if (a < 0)
+            std::swap(l, u);
+        real_t new_l = std::max(l, C.lowerbound(j)), new_u = std::min(u, C.upperbound(j));
+        if (!(new_l <= new_u)) // infeasible: leave it to the solver
+            continue;
+        if (l > C.lowerbound(j)) {
+            C.lowerbound(j) = l;
+            singleton_lb(j) = i;
+        }
+        if (u < C.upperbound(j)) {
+            C.upperbound(j) = u;
+            singleton_ub(j) = i;
+        }
+        row_map(i) = -1;
+        singleton_constr.conservativeResize(singleton_constr.size() + 1);
+        singleton_var.conservativeResize(singleton_var.size() + 1);
+        singleton_coef.conservativeResize(singleton_coef.size() + 1);
+        singleton_constr(singleton_constr.size() - 1) = i;
+        singleton_var(singleton_var.size() - 1)       = j;
+        singleton_coef(singleton_coef.size() - 1)     = a;
+        ++stats.singleton_constraints;
+        tightened_C = true;
+    }
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::reduce_matrix(const Sparsity &sp, crindexvec row_map,
+                                           crindexvec col_map, ReducedMatrix &mat) const {
+    using sparsity::Symmetry;
+    indexvec rows, cols;
+    sparsity::get_nonzero_indices(sp, rows, cols);
+    auto symmetry = sparsity::get_symmetry(sp);
+    // Symmetric dense matrices store all elements, only keep one triangle
+    bool dense = sparsity::is_dense(sp);
+    auto keep  = [&](index_t k) {
+        auto r = rows(k), c = cols(k);
+        if (row_map(r) < 0 || col_map(c) < 0)
+            return false;
+        if (dense && symmetry == Symmetry::Upper)
+            return r <= c;
+        if (dense && symmetry == Symmetry::Lower)
+            return r >= c;
+        return true;
+    };
+    length_t nnz = 0;
+    for (index_t k = 0; k < rows.size(); ++k)
+        nnz += keep(k) ? 1 : 0;
+    mat.rows.resize(nnz);
+    mat.cols.resize(nnz);
+    mat.indices.resize(nnz);
+    for (index_t k = 0, l = 0; k < rows.size(); ++k) {
+        if (!keep(k))
+            continue;
+        mat.rows(l)    = row_map(rows(k));
+        mat.cols(l)    = col_map(cols(k));
+        mat.indices(l) = k;
+        ++l;
+    }
+    mat.values.resize(rows.size());
+    mat.symmetry = symmetry;
+    mat.nrows    = (row_map.array() >= 0).count();
+    mat.ncols    = (col_map.array() >= 0).count();
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::ReducedMatrix::get_sparsity() const -> Sparsity {
+    return sparsity::SparseCOO<config_t, index_t>{
+        .rows        = nrows,
+        .cols        = ncols,
+        .symmetry    = symmetry,
+        .row_indices = rows,
+        .col_indices = cols,
+        .order       = sparsity::SparseCOO<config_t, index_t>::Unsorted,
+        .first_index = 0,
+    };
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::reduce_variables(crvec x, rvec x_red) const {
+    x_red = x(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::expand_variables(crvec x_red, rvec x) const {
+    x = expanded_x(x_red);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::reduce_multipliers(crvec y, rvec y_red) const {
+    y_red = y(kept_constr);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::reduce_bound_multipliers(crvec w, rvec w_red) const {
+    w_red = w(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::expand_multipliers(crvec x, crvec y_red, rvec y) const {
+    y.setZero();
+    y(kept_constr) = y_red;
+    if (singleton_constr.size() == 0)
+        return;
+    // Stationarity: ∇f(x) + ∇g(x) y = 0 for the variables whose bounds are
+    // determined by a singleton constraint and that push against that bound.
+    problem.eval_grad_L(x, y, work_grad, work_v);
+    const auto &r = work_grad;
+    for (index_t k = 0; k < singleton_constr.size(); ++k) {
+        auto i = singleton_constr(k), j = singleton_var(k);
+        if ((singleton_ub(j) == i && r(j) < 0) || (singleton_lb(j) == i && r(j) > 0))
+            y(i) = -r(j) / singleton_coef(k);
+    }
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::expand_bound_multipliers(crvec x, crvec y, crvec w_red,
+                                                      rvec w) const {
+    if (reduce_x) {
+        // Stationarity: ∇f(x) + ∇g(x) y + w = 0 for the fixed variables
+        problem.eval_grad_L(x, y, work_grad, work_v);
+        w = -work_grad;
+    }
+    w(free_vars) = w_red;
+    // The bounds derived from singleton constraints are not bounds of the
+    // original problem, their multipliers were moved to y
+    for (index_t k = 0; k < singleton_constr.size(); ++k)
+        w(singleton_var(k)) -= singleton_coef(k) * y(singleton_constr(k));
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::expanded_x(crvec x_red) const -> crvec {
+    if (!reduce_x)
+        return x_red;
+    work_x(free_vars) = x_red;
+    return work_x;
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::expand_y_Σ(crvec y_red, crvec Σ_red) const {
+    // The removed constraints have zero multipliers and unit penalty factors.
+    // Free and redundant constraints don't contribute to ψ, and singleton
+    // constraints only contribute outside of the reduced box C.
+    work_y.setZero();
+    work_y(kept_constr) = y_red;
+    work_Σ.setOnes();
+    work_Σ(kept_constr) = Σ_red;
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_proj_diff_g(crvec z, rvec e) const {
+    if (!reduce_g)
+        return problem.eval_proj_diff_g(z, e);
+    work_y.setZero();
+    work_y(kept_constr) = z;
+    problem.eval_proj_diff_g(work_y, work_g);
+    e = work_g(kept_constr);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_proj_multipliers(rvec y, real_t M) const {
+    if (!reduce_g)
+        return problem.eval_proj_multipliers(y, M);
+    work_y.setZero();
+    work_y(kept_constr) = y;
+    problem.eval_proj_multipliers(work_y, M);
+    y = work_y(kept_constr);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂,
+                                                 rvec p) const -> real_t {
+    if (box_prox())
+        return reduced_boxes.eval_prox_grad_step(γ, x, grad_ψ, x̂, p);
+    if (!reduce_x)
+        return problem.eval_prox_grad_step(γ, x, grad_ψ, x̂, p);
+    // The fixed variables are not moved by the gradient step, and the
+    // proximal operator of h keeps them at their values
+    work_grad.setZero();
+    work_grad(free_vars) = grad_ψ;
+    auto h = problem.eval_prox_grad_step(γ, expanded_x(x), work_grad, work_v, work_p);
+    x̂      = work_v(free_vars);
+    p      = work_p(free_vars);
+    return h;
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ,
+                                                           rindexvec J) const -> index_t {
+    if (box_prox())
+        return reduced_boxes.eval_inactive_indices_res_lna(γ, x, grad_ψ, J);
+    if (!reduce_x)
+        return problem.eval_inactive_indices_res_lna(γ, x, grad_ψ, J);
+    work_grad.setZero();
+    work_grad(free_vars) = grad_ψ;
+    auto nJ = problem.eval_inactive_indices_res_lna(γ, expanded_x(x), work_grad, work_J);
+    index_t nJ_red = 0;
+    for (index_t k = 0; k < nJ; ++k)
+        if (auto j = reduced_var(work_J(k)); j >= 0)
+            J(nJ_red++) = j;
+    return nJ_red;
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_f(crvec x) const -> real_t {
+    return problem.eval_f(expanded_x(x));
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_f(crvec x, rvec grad_fx) const {
+    if (!reduce_x)
+        return problem.eval_grad_f(x, grad_fx);
+    problem.eval_grad_f(expanded_x(x), work_grad);
+    grad_fx = work_grad(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_g(crvec x, rvec gx) const {
+    if (!reduce_g)
+        return problem.eval_g(expanded_x(x), gx);
+    problem.eval_g(expanded_x(x), work_g);
+    gx = work_g(kept_constr);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const {
+    if (reduce_g) {
+        work_y.setZero();
+        work_y(kept_constr) = y;
+    }
+    crvec y_full = reduce_g ? crvec{work_y} : y;
+    if (!reduce_x)
+        return problem.eval_grad_g_prod(x, y_full, grad_gxy);
+    problem.eval_grad_g_prod(expanded_x(x), y_full, work_grad);
+    grad_gxy = work_grad(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_gi(crvec x, index_t i, rvec grad_gi) const {
+    if (!reduce_x)
+        return problem.eval_grad_gi(x, kept_constr(i), grad_gi);
+    problem.eval_grad_gi(expanded_x(x), kept_constr(i), work_grad);
+    grad_gi = work_grad(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_jac_g(crvec x, rvec J_values) const {
+    if (!reduce_x && !reduce_g)
+        return problem.eval_jac_g(x, J_values);
+    problem.eval_jac_g(expanded_x(x), jac_g.values);
+    J_values = jac_g.values(jac_g.indices);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::get_jac_g_sparsity() const -> Sparsity {
+    if (!reduce_x && !reduce_g)
+        return problem.get_jac_g_sparsity();
+    return jac_g.get_sparsity();
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                                              rvec Hv) const {
+    if (reduce_g) {
+        work_y.setZero();
+        work_y(kept_constr) = y;
+    }
+    crvec y_full = reduce_g ? crvec{work_y} : y;
+    if (!reduce_x)
+        return problem.eval_hess_L_prod(x, y_full, scale, v, Hv);
+    work_v.setZero();
+    work_v(free_vars) = v;
+    problem.eval_hess_L_prod(expanded_x(x), y_full, scale, work_v, work_grad);
+    Hv = work_grad(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const {
+    if (reduce_g) {
+        work_y.setZero();
+        work_y(kept_constr) = y;
+    }
+    crvec y_full = reduce_g ? crvec{work_y} : y;
+    if (!reduce_x)
+        return problem.eval_hess_L(x, y_full, scale, H_values);
+    problem.eval_hess_L(expanded_x(x), y_full, scale, hess_L.values);
+    H_values = hess_L.values(hess_L.indices);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::get_hess_L_sparsity() const -> Sparsity {
+    if (!reduce_x)
+        return problem.get_hess_L_sparsity();
+    return hess_L.get_sparsity();
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v,
+                                              rvec Hv) const {
+    if (reduce_g)
+        expand_y_Σ(y, Σ);
+    crvec y_full = reduce_g ? crvec{work_y} : y, Σ_full = reduce_g ? crvec{work_Σ} : Σ;
+    if (!reduce_x)
+        return problem.eval_hess_ψ_prod(x, y_full, Σ_full, scale, v, Hv);
+    work_v.setZero();
+    work_v(free_vars) = v;
+    problem.eval_hess_ψ_prod(expanded_x(x), y_full, Σ_full, scale, work_v, work_grad);
+    Hv = work_grad(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                                         rvec H_values) const {
+    if (reduce_g)
+        expand_y_Σ(y, Σ);
+    crvec y_full = reduce_g ? crvec{work_y} : y, Σ_full = reduce_g ? crvec{work_Σ} : Σ;
+    if (!reduce_x)
+        return problem.eval_hess_ψ(x, y_full, Σ_full, scale, H_values);
+    problem.eval_hess_ψ(expanded_x(x), y_full, Σ_full, scale, hess_ψ.values);
+    H_values = hess_ψ.values(hess_ψ.indices);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::get_hess_ψ_sparsity() const -> Sparsity {
+    if (!reduce_x)
+        return problem.get_hess_ψ_sparsity();
+    return hess_ψ.get_sparsity();
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    if (!reduce_x)
+        return problem.eval_f_grad_f(x, grad_fx);
+    auto f  = problem.eval_f_grad_f(expanded_x(x), work_grad);
+    grad_fx = work_grad(free_vars);
+    return f;
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_f_g(crvec x, rvec g) const -> real_t {
+    if (!reduce_g)
+        return problem.eval_f_g(expanded_x(x), g);
+    auto f = problem.eval_f_g(expanded_x(x), work_g);
+    g      = work_g(kept_constr);
+    return f;
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f,
+                                                     rvec grad_gxy) const {
+    if (reduce_g) {
+        work_y.setZero();
+        work_y(kept_constr) = y;
+    }
+    crvec y_full = reduce_g ? crvec{work_y} : y;
+    if (!reduce_x)
+        return problem.eval_grad_f_grad_g_prod(x, y_full, grad_f, grad_gxy);
+    problem.eval_grad_f_grad_g_prod(expanded_x(x), y_full, work_grad, work_v);
+    grad_f   = work_grad(free_vars);
+    grad_gxy = work_v(free_vars);
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const {
+    if (reduce_g) {
+        work_y.setZero();
+        work_y(kept_constr) = y;
+    }
+    crvec y_full = reduce_g ? crvec{work_y} : y;
+    if (!reduce_x)
+        return problem.eval_grad_L(x, y_full, grad_L, work_n);
+    problem.eval_grad_L(expanded_x(x), y_full, work_grad, work_v);
+    grad_L = work_grad(free_vars);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const -> real_t {
+    if (!reduce_g)
+        return problem.eval_ψ(expanded_x(x), y, Σ, ŷ);
+    expand_y_Σ(y, Σ);
+    auto ψ = problem.eval_ψ(expanded_x(x), work_y, work_Σ, work_g);
+    ŷ      = work_g(kept_constr);
+    return ψ;
+}
+
+template <Config Conf>
+void PresolvedProblem<Conf>::eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                                         rvec work_m) const {
+    if (reduce_g)
+        expand_y_Σ(y, Σ);
+    crvec y_full = reduce_g ? crvec{work_y} : y, Σ_full = reduce_g ? crvec{work_Σ} : Σ;
+    rvec work_m_full = reduce_g ? rvec{work_g} : work_m;
+    if (!reduce_x)
+        return problem.eval_grad_ψ(x, y_full, Σ_full, grad_ψ, work_n, work_m_full);
+    problem.eval_grad_ψ(expanded_x(x), y_full, Σ_full, work_grad, work_v, work_m_full);
+    grad_ψ = work_grad(free_vars);
+}
+
+template <Config Conf>
+auto PresolvedProblem<Conf>::eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                                           rvec work_m) const -> real_t {
+    if (reduce_g)
+        expand_y_Σ(y, Σ);
+    crvec y_full = reduce_g ? crvec{work_y} : y, Σ_full = reduce_g ? crvec{work_Σ} : Σ;
+    rvec work_m_full = reduce_g ? rvec{work_g} : work_m;
+    if (!reduce_x)
+        return problem.eval_ψ_grad_ψ(x, y_full, Σ_full, grad_ψ, work_n, work_m_full);
+    auto ψ = problem.eval_ψ_grad_ψ(expanded_x(x), y_full, Σ_full, work_grad, work_v,
+                                   work_m_full);
+    grad_ψ = work_grad(free_vars);
+    return ψ;
+}
+
+} // namespace alpaqa
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <alpaqa/problem/scaled-problem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <variant>
+
+namespace alpaqa {
+
+namespace detail {
+
+/// Compute the scaling factor @f$ s_r s_c @f$ of each nonzero element.
+template <Config Conf>
+vec<Conf> get_nonzero_scaling(const Sparsity<Conf> &sp, crvec<Conf> row_scaling,
+                              crvec<Conf> col_scaling) {
+    USING_ALPAQA_CONFIG(Conf);
+    indexvec rows, cols;
+    sparsity::get_nonzero_indices(sp, rows, cols);
+    vec scaling(rows.size());
+    for (index_t k = 0; k < rows.size(); ++k)
+        scaling(k) = row_scaling(rows(k)) * col_scaling(cols(k));
+    return scaling;
+}
+
+} // namespace detail
+
+template <Config Conf>
+ScaledProblem<Conf>::ScaledProblem(Problem problem, crvec x0, Params params)
+    : problem{std::move(problem)} {
+    const auto n = this->problem.get_n(), m = this->problem.get_m();
+    work_x.resize(n);
+    work_v.resize(n);
+    work_y.resize(m);
+    work_Σ.resize(m);
+    compute_scaling(x0, params);
+    // Scale the boxes
+    scaled_boxes = BoxConstrProblem<config_t>{n, m};
+    if (this->problem.provides_get_box_C()) {
+        const auto &C             = this->problem.get_box_C();
+        scaled_boxes.C.lowerbound = C.lowerbound.cwiseQuotient(variable_scaling);
+        scaled_boxes.C.upperbound = C.upperbound.cwiseQuotient(variable_scaling);
+    }
+    if (this->problem.provides_get_box_D()) {
+        const auto &D             = this->problem.get_box_D();
+        scaled_boxes.D.lowerbound = D.lowerbound.cwiseProduct(constraint_scaling);
+        scaled_boxes.D.upperbound = D.upperbound.cwiseProduct(constraint_scaling);
+    }
+    // Scaling factors of the nonzeros of the sparse matrices
+    const auto &p = this->problem;
+    if (p.provides_eval_jac_g())
+        jac_g_scaling = detail::get_nonzero_scaling<config_t>(
+            p.get_jac_g_sparsity(), constraint_scaling, variable_scaling);
+    if (p.provides_eval_hess_L())
+        hess_L_scaling = detail::get_nonzero_scaling<config_t>(
+            p.get_hess_L_sparsity(), variable_scaling, variable_scaling);
+    if (p.provides_eval_hess_ψ())
+        hess_ψ_scaling = objective_scaling * detail::get_nonzero_scaling<config_t>(
+                                                 p.get_hess_ψ_sparsity(), variable_scaling,
+                                                 variable_scaling);
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::compute_scaling(crvec x0, const Params &params) {
+    const auto n = problem.get_n(), m = problem.get_m();
+    variable_scaling   = vec::Ones(n);
+    constraint_scaling = vec::Ones(m);
+    objective_scaling  = 1;
+    if (params.method == ProblemScaling::None)
+        return;
+    auto clamp = [&](auto &&s) {
+        return s.cwiseMax(params.min_scaling).cwiseMin(params.max_scaling);
+    };
+
+    // Evaluate the Jacobian of the constraints (if available)
+    indexvec rows, cols;
+    vec J;
+    const bool have_jac = m > 0 && problem.provides_eval_jac_g();
+    if (have_jac) {
+        sparsity::get_nonzero_indices(problem.get_jac_g_sparsity(), rows, cols);
+        J.resize(rows.size());
+        problem.eval_jac_g(x0, J);
+    }
+    // Infinity norms of the rows and columns of D_g J D_x
+    vec row_norms(m), col_norms(n);
+    auto compute_norms = [&] {
+        row_norms.setZero();
+        col_norms.setZero();
+        for (index_t k = 0; k < J.size(); ++k) {
+            auto r = rows(k), c = cols(k);
+            auto a = std::abs(constraint_scaling(r) * J(k) * variable_scaling(c));
+            if (std::isfinite(a)) {
+                row_norms(r) = std::max(row_norms(r), a);
+                col_norms(c) = std::max(col_norms(c), a);
+            }
+        }
+    };
+    // Ruiz equilibration: scale rows and columns by the inverse square roots
+    // of their norms until all norms are close to one.
+    if (params.method == ProblemScaling::Ruiz && m > 0) {
+        if (!have_jac)
+            throw std::invalid_argument("Ruiz scaling requires the Jacobian of the constraints");
+        const bool scale_cols = params.h_is_box_indicator;
+        if (scale_cols && !problem.provides_get_box_C())
+            throw std::invalid_argument("Scaling the variables requires the box C");
+        auto dist_to_one = [](crvec norms) {
+            real_t d = 0;
+            for (auto v : norms)
+                if (v > 0)
+                    d = std::max(d, std::abs(1 - v));
+            return d;
+        };
+        auto inv_sqrt = [](real_t v) { return v > 0 ? 1 / std::sqrt(v) : real_t(1); };
+        for (unsigned i = 0; i < params.ruiz_max_iter; ++i) {
+            compute_norms();
+            auto dist = dist_to_one(row_norms);
+            if (scale_cols)
+                dist = std::max(dist, dist_to_one(col_norms));
+            if (dist <= params.ruiz_tolerance)
+                break;
+            constraint_scaling =
+                clamp(constraint_scaling.cwiseProduct(row_norms.unaryExpr(inv_sqrt)));
+            if (scale_cols)
+                variable_scaling =
+                    clamp(variable_scaling.cwiseProduct(col_norms.unaryExpr(inv_sqrt)));
+        }
+        scale_x = (variable_scaling.array() != 1).any();
+    }
+    // Gradient-based scaling of the constraints
+    if (m > 0) {
+        if (have_jac) {
+            compute_norms();
+        } else {
+            vec grad_gi(n);
+            for (index_t i = 0; i < m; ++i) {
+                problem.eval_grad_gi(x0, i, grad_gi);
+                row_norms(i) =
+                    grad_gi.cwiseProduct(variable_scaling).template lpNorm<Eigen::Infinity>();
+            }
+        }
+        for (index_t i = 0; i < m; ++i)
+            if (std::isfinite(row_norms(i)) && row_norms(i) > params.max_gradient)
+                constraint_scaling(i) *= params.max_gradient / row_norms(i);
+        constraint_scaling = clamp(constraint_scaling);
+    }
+    // Gradient-based scaling of the objective
+    vec grad_f(n);
+    problem.eval_grad_f(x0, grad_f);
+    auto norm_grad_f = grad_f.cwiseProduct(variable_scaling).template lpNorm<Eigen::Infinity>();
+    if (std::isfinite(norm_grad_f) && norm_grad_f > params.max_gradient)
+        objective_scaling = params.max_gradient / norm_grad_f;
+    objective_scaling = std::clamp(objective_scaling, params.min_scaling, params.max_scaling);
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::unscaled_x(crvec x̃) const -> crvec {
+    if (!scale_x)
+        return x̃;
+    work_x = x̃.cwiseProduct(variable_scaling);
+    return work_x;
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::unscale_y_Σ(crvec ỹ, crvec Σ̃) const {
+    // ψ̃(x̃; ỹ, Σ̃) = σ_f ψ(x; y, Σ) with y = D_g ỹ / σ_f, Σ = D_g² Σ̃ / σ_f
+    unscale_multipliers(ỹ, work_y);
+    unscale_penalties(Σ̃, work_Σ);
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_proj_diff_g(crvec z, rvec e) const {
+    // Projection onto D_g D commutes with the (positive) diagonal scaling
+    work_y = z.cwiseQuotient(constraint_scaling);
+    problem.eval_proj_diff_g(work_y, e);
+    e.array() *= constraint_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_proj_multipliers(rvec y, real_t M) const {
+    y.array() *= constraint_scaling.array() / objective_scaling;
+    problem.eval_proj_multipliers(y, M);
+    y.array() *= objective_scaling / constraint_scaling.array();
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂,
+                                              rvec p) const -> real_t {
+    if (scale_x)
+        return scaled_boxes.eval_prox_grad_step(γ, x, grad_ψ, x̂, p);
+    // prox_{γσh}(x - γ∇ψ̃) = prox_{(γσ)h}(x - (γσ)(∇ψ̃/σ))
+    work_x = grad_ψ / objective_scaling;
+    return objective_scaling *
+           problem.eval_prox_grad_step(γ * objective_scaling, x, work_x, x̂, p);
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ,
+                                                        rindexvec J) const -> index_t {
+    if (scale_x)
+        return scaled_boxes.eval_inactive_indices_res_lna(γ, x, grad_ψ, J);
+    work_x = grad_ψ / objective_scaling;
+    return problem.eval_inactive_indices_res_lna(γ * objective_scaling, x, work_x, J);
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_f(crvec x) const -> real_t {
+    return objective_scaling * problem.eval_f(unscaled_x(x));
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_f(crvec x, rvec grad_fx) const {
+    problem.eval_grad_f(unscaled_x(x), grad_fx);
+    grad_fx.array() *= objective_scaling * variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_g(crvec x, rvec gx) const {
+    problem.eval_g(unscaled_x(x), gx);
+    gx.array() *= constraint_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const {
+    work_y = y.cwiseProduct(constraint_scaling);
+    problem.eval_grad_g_prod(unscaled_x(x), work_y, grad_gxy);
+    grad_gxy.array() *= variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_gi(crvec x, index_t i, rvec grad_gi) const {
+    problem.eval_grad_gi(unscaled_x(x), i, grad_gi);
+    grad_gi.array() *= constraint_scaling(i) * variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_jac_g(crvec x, rvec J_values) const {
+    problem.eval_jac_g(unscaled_x(x), J_values);
+    if (J_values.size() > 0)
+        J_values.array() *= jac_g_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                                           rvec Hv) const {
+    work_y = y.cwiseProduct(constraint_scaling);
+    work_v = v.cwiseProduct(variable_scaling);
+    problem.eval_hess_L_prod(unscaled_x(x), work_y, scale * objective_scaling, work_v, Hv);
+    Hv.array() *= variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const {
+    work_y = y.cwiseProduct(constraint_scaling);
+    problem.eval_hess_L(unscaled_x(x), work_y, scale * objective_scaling, H_values);
+    H_values.array() *= hess_L_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v,
+                                           rvec Hv) const {
+    unscale_y_Σ(y, Σ);
+    work_v = v.cwiseProduct(variable_scaling);
+    problem.eval_hess_ψ_prod(unscaled_x(x), work_y, work_Σ, scale, work_v, Hv);
+    Hv.array() *= objective_scaling * variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                                      rvec H_values) const {
+    unscale_y_Σ(y, Σ);
+    problem.eval_hess_ψ(unscaled_x(x), work_y, work_Σ, scale, H_values);
+    H_values.array() *= hess_ψ_scaling.array();
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    auto f = problem.eval_f_grad_f(unscaled_x(x), grad_fx);
+    grad_fx.array() *= objective_scaling * variable_scaling.array();
+    return objective_scaling * f;
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_f_g(crvec x, rvec g) const -> real_t {
+    auto f = problem.eval_f_g(unscaled_x(x), g);
+    g.array() *= constraint_scaling.array();
+    return objective_scaling * f;
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f,
+                                                  rvec grad_gxy) const {
+    work_y = y.cwiseProduct(constraint_scaling);
+    problem.eval_grad_f_grad_g_prod(unscaled_x(x), work_y, grad_f, grad_gxy);
+    grad_f.array() *= objective_scaling * variable_scaling.array();
+    grad_gxy.array() *= variable_scaling.array();
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const {
+    unscale_multipliers(y, work_y);
+    problem.eval_grad_L(unscaled_x(x), work_y, grad_L, work_n);
+    grad_L.array() *= objective_scaling * variable_scaling.array();
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const -> real_t {
+    unscale_y_Σ(y, Σ);
+    auto ψ = problem.eval_ψ(unscaled_x(x), work_y, work_Σ, ŷ);
+    ŷ.array() *= objective_scaling / constraint_scaling.array();
+    return objective_scaling * ψ;
+}
+
+template <Config Conf>
+void ScaledProblem<Conf>::eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                                      rvec work_m) const {
+    unscale_y_Σ(y, Σ);
+    problem.eval_grad_ψ(unscaled_x(x), work_y, work_Σ, grad_ψ, work_n, work_m);
+    grad_ψ.array() *= objective_scaling * variable_scaling.array();
+}
+
+template <Config Conf>
+auto ScaledProblem<Conf>::eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                                        rvec work_m) const -> real_t {
+    unscale_y_Σ(y, Σ);
+    auto ψ = problem.eval_ψ_grad_ψ(unscaled_x(x), work_y, work_Σ, grad_ψ, work_n, work_m);
+    grad_ψ.array() *= objective_scaling * variable_scaling.array();
+    return objective_scaling * ψ;
+}
+
+} // namespace alpaqa
@@ -10,7 +10,10 @@
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/index-set.hpp>
 #include <alpaqa/util/print.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 
@@ -40,7 +43,49 @@ struct ConvexNewtonDirectionParams {
     /// equation 12b in @cite pas2022alpaqa, scaled by this parameter.
     /// Set it to zero to leave out that term.
     real_t hessian_vec_factor = 0;
-    bool quadratic            = false;
+    /// The Hessian of the problem is constant: evaluate it only once.
+    bool quadratic = false;
+    /// Cache the Cholesky factorization of the regularized Hessian of the free
+    /// variables @f$ \mathcal{J} @f$. When only a few indices enter or leave
+    /// @f$ \mathcal{J} @f$ between iterations, the factorization is updated
+    /// instead of recomputed (adding a row and column costs a triangular
+    /// solve, removing one costs a rank-one update of the trailing factor).
+    /// The factorization can only be reused if the Hessian was not
+    /// re-evaluated, so this is mainly useful in combination with
+    /// @ref quadratic. Ignored if @ref ConvexNewtonRegularizationParams::ldlt
+    /// is set.
+    bool update_factorization = true;
+    /// Recompute the factorization from scratch if the number of indices that
+    /// enter or leave @f$ \mathcal{J} @f$ is larger than this fraction of
+    /// @f$ |\mathcal{J}| @f$.
+    real_t max_update_fraction = real_t(0.2);
+    /// The regularization term depends on the current residual, so it is
+    /// different in every iteration. While indices enter or leave
+    /// @f$ \mathcal{J} @f$, the regularization of the cached factorization is
+    /// kept, so the factorization can be updated. If @f$ \mathcal{J} @f$ does
+    /// not change, the factorization is only reused if the regularization
+    /// differs by at most this tolerance from the one that was used to compute
+    /// it, relative to the larger of the two. Set it to zero to refactor
+    /// whenever the regularization changes and @f$ \mathcal{J} @f$ does not.
+    real_t regularization_tolerance = real_t(0.5);
+};
+
+/// Counters for the factorizations of the Hessian of the free variables in
+/// @ref ConvexNewtonDirection.
+struct ConvexNewtonFactorizationStats {
+    /// Number of evaluations of the Hessian of the problem.
+    unsigned hessian_evaluations = 0;
+    /// Number of factorizations computed from scratch.
+    unsigned factorizations = 0;
+    /// Number of times the cached factorization was used as-is.
+    unsigned reuses = 0;
+    /// Number of times the cached factorization was updated because some
+    /// indices entered or left the set of free variables.
+    unsigned updates = 0;
+    /// Total number of rows and columns added during the updates.
+    unsigned indices_added = 0;
+    /// Total number of rows and columns removed during the updates.
+    unsigned indices_removed = 0;
 };
 
 /// @ingroup grp_DirectionProviders
@@ -83,11 +128,20 @@ struct ConvexNewtonDirection {
         // Allocate workspaces
         const auto n = problem.get_n();
         JK.resize(n);
-        JK_old.resize(n);
-        nJ_old = -1;
         H.resize(n, n);
-        HJ_storage.resize(n * n);
         work.resize(n);
+        if (use_factorization_cache()) {
+            HJ_storage.resize(0);
+            L_fact.resize(n, n);
+            J_fact.resize(n);
+            J_fact_pos.setConstant(n, -1);
+        } else {
+            HJ_storage.resize(n * n);
+            L_fact.resize(0, 0);
+            J_fact.resize(0);
+            J_fact_pos.resize(0);
+        }
+        nJ_fact = -1;
         auto sparsity = problem.get_hess_ψ_sparsity();
         if (!is_dense(sparsity))
             std::cerr << "Sparse hessians not yet implemented, converting to "
@@ -123,20 +177,24 @@ struct ConvexNewtonDirection {
                crvec grad_ψxₖ, rvec qₖ) const {
         length_t n = xₖ.size();
         // Evaluate the Hessian
-        if (!have_hess) {
+        bool new_hess = !have_hess;
+        if (new_hess) {
             const auto &y = null_vec<config_t>;
             auto eval_h = [&](rvec v) { problem->eval_hess_L(xₖ, y, 1, v); };
             H_sparsity->convert_values(eval_h, H.reshaped());
             have_hess = direction_params.quadratic;
+            ++fact_stats.hessian_evaluations;
         }
         // Find inactive indices J
         auto nJ = problem->eval_inactive_indices_res_lna(γₖ, xₖ, grad_ψxₖ, JK);
         auto J  = JK.topRows(nJ);
-        auto HJ = HJ_storage.topRows(nJ * nJ).reshaped(nJ, nJ);
-        HJ      = H(J, J);
-        // Regularize the Hessian
+        // Regularization of the Hessian
         real_t res_sq = pₖ.squaredNorm() / (γₖ * γₖ);
         real_t reg    = reg_params.ζ * std::pow(res_sq, reg_params.ν / 2);
+        if (use_factorization_cache())
+            return apply_cached(γₖ, pₖ, qₖ, J, reg, new_hess);
+        auto HJ = HJ_storage.topRows(nJ * nJ).reshaped(nJ, nJ);
+        HJ      = H(J, J);
         HJ += reg * mat::Identity(nJ, nJ);
         // Compute the right-hand side
         qₖ     = pₖ;
@@ -150,7 +208,7 @@ struct ConvexNewtonDirection {
             w = (real_t(1) / γₖ) * pₖ(J);
         }
         // Solve the system
-        if (H_sparsity->get_sparsity().symmetry == sparsity::Symmetry::Upper)
+        if (hess_symmetry() == sparsity::Symmetry::Upper)
             reg_params.ldlt ? solve<Eigen::LDLT<rmat, Eigen::Upper>>(HJ, w)
                             : solve<Eigen::LLT<rmat, Eigen::Upper>>(HJ, w);
         else
@@ -175,17 +233,206 @@ struct ConvexNewtonDirection {
 
     const auto &get_params() const { return direction_params; }
 
+    /// Get the number of Hessian evaluations, factorizations and updates of
+    /// the cached factorization since construction.
+    const ConvexNewtonFactorizationStats &get_factorization_stats() const {
+        return fact_stats;
+    }
+
   private:
+    bool use_factorization_cache() const {
+        return direction_params.update_factorization && !reg_params.ldlt;
+    }
+
+    /// Solve the Newton system using the cached factorization of
+    /// @f$ H_{\mathcal{JJ}} + \text{reg}\,I @f$.
+    bool apply_cached(real_t γₖ, crvec pₖ, rvec qₖ, crindexvec J, real_t reg,
+                      bool new_hess) const {
+        const auto n  = pₖ.size();
+        const auto nJ = J.size();
+        update_factorization(J, reg, new_hess);
+        // The factorization uses its own ordering of the indices in J
+        auto Jf = J_fact.topRows(nJ);
+        // Compute the right-hand side
+        qₖ     = pₖ;
+        rvec w = work.topRows(nJ);
+        w      = (real_t(1) / γₖ) * pₖ(Jf);
+        if (direction_params.hessian_vec_factor != 0) {
+            rindexvec K = JK.bottomRows(n - nJ);
+            detail::IndexSet<config_t>::compute_complement(J, K, n);
+            w -= direction_params.hessian_vec_factor * (H(Jf, K) * qₖ(K));
+        }
+        // Solve the system
+        ScopedMallocAllower ma;
+        auto L = L_fact.topLeftCorner(nJ, nJ);
+        L.template triangularView<Eigen::Lower>().solveInPlace(w);
+        L.template triangularView<Eigen::Lower>().transpose().solveInPlace(w);
+        qₖ(Jf) = w;
+        return true;
+    }
+
+    /// Make sure that @ref L_fact contains the Cholesky factor of the
+    /// regularized Hessian of the variables in @p J (possibly permuted).
+    /// The regularization @ref reg_fact of the cached factorization is kept
+    /// while @p J changes, otherwise the factorization could never be updated.
+    void update_factorization(crindexvec J, real_t reg, bool new_hess) const {
+        const auto nJ = J.size();
+        if (nJ_fact < 0 || new_hess)
+            return refactor(J, reg);
+        // Count the indices that enter and leave J
+        index_t num_added = 0;
+        for (index_t j : J)
+            num_added += J_fact_pos(j) < 0 ? 1 : 0;
+        index_t num_removed = nJ_fact - (nJ - num_added);
+        if (num_added + num_removed == 0) {
+            real_t reg_tol = direction_params.regularization_tolerance *
+                             std::max(reg, reg_fact);
+            if (std::abs(reg - reg_fact) > reg_tol)
+                return refactor(J, reg);
+            ++fact_stats.reuses;
+            return;
+        }
+        auto max_changes = direction_params.max_update_fraction *
+                           static_cast<real_t>(std::max(nJ, nJ_fact));
+        if (static_cast<real_t>(num_added + num_removed) > max_changes)
+            return refactor(J, reg);
+        // Remove the indices that left J (last to first, to keep the
+        // positions of the remaining ones valid)
+        for (index_t i = nJ_fact; i-- > 0;)
+            if (!std::binary_search(J.begin(), J.end(), J_fact(i)))
+                remove_from_factorization(i);
+        // Add the indices that entered J
+        for (index_t j : J)
+            if (J_fact_pos(j) < 0 && !append_to_factorization(j))
+                return refactor(J, reg);
+        ++fact_stats.updates;
+        fact_stats.indices_added += static_cast<unsigned>(num_added);
+        fact_stats.indices_removed += static_cast<unsigned>(num_removed);
+    }
+
+    /// Compute the factorization of the regularized Hessian of the variables
+    /// in @p J from scratch.
+    void refactor(crindexvec J, real_t reg) const {
+        const auto nJ = J.size();
+        for (index_t i = 0; i < nJ_fact; ++i)
+            J_fact_pos(J_fact(i)) = -1;
+        nJ_fact = -1;
+        for (index_t i = 0; i < nJ; ++i)
+            J_fact(i) = J(i), J_fact_pos(J(i)) = i;
+        // J is sorted, so the stored triangle of H(J, J) is that of H
+        auto L = L_fact.topLeftCorner(nJ, nJ);
+        if (hess_symmetry() == sparsity::Symmetry::Upper)
+            L.template triangularView<Eigen::Lower>() = H(J, J).transpose();
+        else
+            L.template triangularView<Eigen::Lower>() = H(J, J);
+        L.diagonal().array() += reg;
+        ScopedMallocAllower ma;
+        Eigen::LLT<rmat, Eigen::Lower> ll{L};
+        if (ll.info() != Eigen::Success) {
+            for (index_t i = 0; i < nJ; ++i)
+                J_fact_pos(J(i)) = -1;
+            throw std::runtime_error("Cholesky factorization failed. "
+                                     "Is the problem convex?");
+        }
+        nJ_fact  = nJ;
+        reg_fact = reg;
+        ++fact_stats.factorizations;
+    }
+
+    /// Remove the row and column at position @p k from the factorization.
+    void remove_from_factorization(index_t k) const {
+        const index_t m = nJ_fact;
+        auto L          = L_fact.topLeftCorner(m, m);
+        // Save the part of column k below the diagonal
+        auto v = work.topRows(m - k - 1);
+        v      = L.col(k).bottomRows(m - k - 1);
+        // Remove row k from the first k columns
+        for (index_t c = 0; c < k; ++c)
+            for (index_t r = k + 1; r < m; ++r)
+                L(r - 1, c) = L(r, c);
+        // Remove column k from the trailing block
+        for (index_t c = k + 1; c < m; ++c)
+            for (index_t r = c; r < m; ++r)
+                L(r - 1, c - 1) = L(r, c);
+        // The trailing block is now the factor of L₂₂L₂₂ᵀ + vvᵀ
+        auto L22 = L_fact.block(k, k, m - k - 1, m - k - 1);
+        for (index_t c = 0; c < L22.cols(); ++c) {
+            real_t Lcc = L22(c, c), vc = v(c);
+            real_t r   = std::sqrt(Lcc * Lcc + vc * vc);
+            real_t cs = r / Lcc, sn = vc / Lcc;
+            L22(c, c)  = r;
+            auto Lb    = L22.col(c).bottomRows(L22.rows() - c - 1);
+            auto vb    = v.bottomRows(v.rows() - c - 1);
+            Lb         = (Lb + sn * vb) / cs;
+            vb         = cs * vb - sn * Lb;
+        }
+        // Update the ordering
+        J_fact_pos(J_fact(k)) = -1;
+        for (index_t i = k + 1; i < m; ++i)
+            J_fact(i - 1) = J_fact(i), J_fact_pos(J_fact(i - 1)) = i - 1;
+        --nJ_fact;
+    }
+
+    sparsity::Symmetry hess_symmetry() const {
+        return H_sparsity->get_sparsity().symmetry;
+    }
+
+    /// Element @f$ (r, c) @f$ of the Hessian, read from the triangle that is
+    /// stored if the Hessian is symmetric.
+    real_t hess_elem(index_t r, index_t c) const {
+        using enum sparsity::Symmetry;
+        switch (hess_symmetry()) {
+            case Upper: return r <= c ? H(r, c) : H(c, r);
+            case Lower: return r >= c ? H(r, c) : H(c, r);
+            case Unsymmetric: [[fallthrough]];
+            default: return H(r, c);
+        }
+    }
+
+    /// Add a row and column for variable @p j to the end of the factorization.
+    /// Returns false if the resulting matrix is not numerically positive
+    /// definite.
+    bool append_to_factorization(index_t j) const {
+        const index_t m = nJ_fact;
+        auto l          = work.topRows(m);
+        for (index_t i = 0; i < m; ++i)
+            l(i) = hess_elem(J_fact(i), j);
+        L_fact.topLeftCorner(m, m)
+            .template triangularView<Eigen::Lower>()
+            .solveInPlace(l);
+        real_t Hjj = H(j, j) + reg_fact;
+        real_t d2  = Hjj - l.squaredNorm();
+        if (!(d2 > std::numeric_limits<real_t>::epsilon() * std::abs(Hjj)))
+            return false;
+        L_fact.row(m).leftCols(m) = l.transpose();
+        L_fact(m, m)              = std::sqrt(d2);
+        J_fact(m)                 = j;
+        J_fact_pos(j)             = m;
+        ++nJ_fact;
+        return true;
+    }
+
     const Problem *problem = nullptr;
 
-    mutable indexvec JK, JK_old;
-    mutable index_t nJ_old = -1;
+    mutable indexvec JK;
     mutable mat H;
     using sp_conv_t = sparsity::SparsityConverter<Sparsity<config_t>,
                                                   sparsity::Dense<config_t>>;
     mutable std::optional<sp_conv_t> H_sparsity;
     mutable vec HJ_storage, work;
     mutable bool have_hess = false;
+    /// Cached Cholesky factor (lower triangular) of the regularized Hessian of
+    /// the variables @ref J_fact.
+    mutable mat L_fact;
+    /// Free variables in the order of the factorization.
+    mutable indexvec J_fact;
+    /// Position of each variable in @ref J_fact, or -1 if not present.
+    mutable indexvec J_fact_pos;
+    /// Size of the cached factorization, or -1 if it is invalid.
+    mutable index_t nJ_fact = -1;
+    /// Regularization used for the cached factorization.
+    mutable real_t reg_fact = 0;
+    mutable ConvexNewtonFactorizationStats fact_stats;
 
   public:
     AcceleratorParams reg_params;
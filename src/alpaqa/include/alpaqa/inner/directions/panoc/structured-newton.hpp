@@ -9,6 +9,8 @@
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/index-set.hpp>
 #include <alpaqa/util/print.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <optional>
@@ -19,16 +21,60 @@
 
 namespace alpaqa {
 
+/// Strategies used by @ref StructuredNewtonDirection to make the (reduced)
+/// Hessian positive definite before solving the Newton system.
+/// @ingroup grp_Parameters
+enum class StructuredNewtonRegularization {
+    /// Full eigenvalue decomposition, eigenvalues smaller than
+    /// @f$ \varepsilon = \mathrm{min\_eig} \cdot (1 + |\lambda_\mathrm{max}|)
+    /// @f$ are replaced by @f$ \varepsilon @f$. Most expensive, but only
+    /// modifies the negative curvature directions.
+    EigenvalueClipping,
+    /// Cholesky factorization of @f$ H + \tau I @f$, where the shift
+    /// @f$ \tau \ge 0 @f$ is increased until the factorization succeeds
+    /// (Algorithm 3.3 in Nocedal and Wright, “Numerical Optimization”).
+    /// Positive definite Hessians are not modified, each failed attempt costs
+    /// an additional factorization.
+    ShiftedCholesky,
+    /// Modified @f$ LDL^\top @f$ factorization of Gill, Murray and Wright,
+    /// which adds a nonnegative diagonal correction @f$ E @f$ during a single
+    /// factorization, such that @f$ H + E = LDL^\top @f$ is positive definite
+    /// and the elements of @f$ L @f$ are bounded (Algorithm 3.4 in Nocedal and
+    /// Wright).
+    ModifiedLDLT,
+};
+
+inline constexpr const char *enum_name(StructuredNewtonRegularization s) {
+    using enum StructuredNewtonRegularization;
+    switch (s) {
+        case EigenvalueClipping: return "EigenvalueClipping";
+        case ShiftedCholesky: return "ShiftedCholesky";
+        case ModifiedLDLT: return "ModifiedLDLT";
+        default:;
+    }
+    throw std::out_of_range("invalid value for "
+                            "alpaqa::StructuredNewtonRegularization");
+}
+
 /// Parameters for the @ref StructuredNewtonDirection class.
 /// @ingroup grp_Parameters
 template <Config Conf>
 struct StructuredNewtonRegularizationParams {
     USING_ALPAQA_CONFIG(Conf);
+    /// Strategy used to make the Hessian positive definite.
+    StructuredNewtonRegularization method =
+        StructuredNewtonRegularization::EigenvalueClipping;
     /// Minimum eigenvalue of the Hessian, scaled by
     /// @f$ 1 + |\lambda_\mathrm{max}| @f$, enforced by regularization using
-    /// a multiple of identity.
+    /// a multiple of identity. For the factorization-based methods, the
+    /// largest absolute diagonal element is used instead of
+    /// @f$ |\lambda_\mathrm{max}| @f$, and this is the smallest shift
+    /// (@ref StructuredNewtonRegularization::ShiftedCholesky) or the smallest
+    /// pivot (@ref StructuredNewtonRegularization::ModifiedLDLT).
     real_t min_eig = std::cbrt(std::numeric_limits<real_t>::epsilon());
-    /// Print the minimum and maximum eigenvalue of the Hessian.
+    /// Print the minimum and maximum eigenvalue of the Hessian
+    /// (@ref StructuredNewtonRegularization::EigenvalueClipping), or the size
+    /// of the regularization (other methods).
     bool print_eig = false;
 };
 
@@ -84,6 +130,8 @@ struct StructuredNewtonDirection {
         JK.resize(n);
         H.resize(n, n);
         HJ_storage.resize(n * n);
+        ldlt_d.resize(n);
+        ldlt_w.resize(n);
         if (!is_dense(problem.get_hess_ψ_sparsity()))
             throw std::logic_error("Sparse hessians not yet implemented");
     }
@@ -133,26 +181,7 @@ struct StructuredNewtonDirection {
         // There are no active indices K
         if (nJ == n) {
             // If all indices are free, we can factor the entire matrix.
-            // Find the minimum eigenvalue to regularize the Hessian matrix and
-            // make it positive definite.
-            ScopedMallocAllower ma;
-            // Find the minimum eigenvalue to regularize the Hessian matrix and
-            // make it positive definite.
-            Eigen::SelfAdjointEigenSolver<mat> eig{H,
-                                                   Eigen::ComputeEigenvectors};
-
-            auto λ_min = eig.eigenvalues().minCoeff(),
-                 λ_max = eig.eigenvalues().maxCoeff();
-
-            if (reg_params.print_eig)
-                std::cout << "λ(H):    " << float_to_str(λ_min, 3) << ", "
-                          << float_to_str(λ_max, 3) << std::endl;
-            // Regularization
-            real_t ε = reg_params.min_eig * (1 + std::abs(λ_max)); // TODO
-            // Solve the system
-            qₖ = eig.eigenvectors().transpose() * qₖ;
-            qₖ = eig.eigenvalues().cwiseMax(ε).asDiagonal().inverse() * qₖ;
-            qₖ = eig.eigenvectors() * qₖ;
+            solve_regularized(H, qₖ, "H");
             return true;
         }
 
@@ -174,25 +203,11 @@ struct StructuredNewtonDirection {
         HJ.template triangularView<Eigen::Lower>() =
             H(J, J).template triangularView<Eigen::Lower>();
 
-        ScopedMallocAllower ma;
-        // Find the minimum eigenvalue to regularize the Hessian matrix and
-        // make it positive definite.
-        Eigen::SelfAdjointEigenSolver<mat> eig{HJ, Eigen::ComputeEigenvectors};
-
-        auto λ_min = eig.eigenvalues().minCoeff(),
-             λ_max = eig.eigenvalues().maxCoeff();
-
-        if (reg_params.print_eig)
-            std::cout << "λ(H_JJ): " << float_to_str(λ_min, 3) << ", "
-                      << float_to_str(λ_max, 3) << std::endl;
-        // Regularization
-        real_t ε = reg_params.min_eig * (1 + std::abs(λ_max)); // TODO
         // Solve the system
         auto qJ = H.col(0).topRows(nJ);
         qJ      = qₖ(J);
-        qJ      = eig.eigenvectors().transpose() * qJ;
-        qJ      = eig.eigenvalues().cwiseMax(ε).asDiagonal().inverse() * qJ;
-        qₖ(J)   = eig.eigenvectors() * qJ;
+        solve_regularized(HJ, qJ, "H_JJ");
+        qₖ(J) = qJ;
         return true;
     }
 
@@ -212,6 +227,117 @@ struct StructuredNewtonDirection {
     const auto &get_params() const { return direction_params; }
 
   private:
+    /// Solve @f$ (A + E) x = b @f$ in place, where @f$ E @f$ makes the matrix
+    /// positive definite, as determined by @ref reg_params. Only the lower
+    /// triangle of @p A is used, it is overwritten.
+    void solve_regularized(rmat A, rvec b, const char *name) const {
+        ScopedMallocAllower ma;
+        using enum StructuredNewtonRegularization;
+        switch (reg_params.method) {
+            case EigenvalueClipping: solve_eig_clip(A, b, name); break;
+            case ShiftedCholesky: solve_shifted_llt(A, b, name); break;
+            case ModifiedLDLT: solve_modified_ldlt(A, b, name); break;
+            default: throw std::invalid_argument("Invalid regularization");
+        }
+    }
+
+    void solve_eig_clip(rmat A, rvec b, const char *name) const {
+        // Find the minimum eigenvalue to regularize the Hessian matrix and
+        // make it positive definite.
+        Eigen::SelfAdjointEigenSolver<mat> eig{A, Eigen::ComputeEigenvectors};
+
+        auto λ_min = eig.eigenvalues().minCoeff(),
+             λ_max = eig.eigenvalues().maxCoeff();
+
+        if (reg_params.print_eig)
+            std::cout << "λ(" << name << "): " << float_to_str(λ_min, 3)
+                      << ", " << float_to_str(λ_max, 3) << std::endl;
+        // Regularization
+        real_t ε = reg_params.min_eig * (1 + std::abs(λ_max)); // TODO
+        // Solve the system
+        b = eig.eigenvectors().transpose() * b;
+        b = eig.eigenvalues().cwiseMax(ε).asDiagonal().inverse() * b;
+        b = eig.eigenvectors() * b;
+    }
+
+    void solve_shifted_llt(rmat A, rvec b, const char *name) const {
+        auto diag          = A.diagonal();
+        const real_t d_min = diag.minCoeff();
+        const real_t d_max = diag.cwiseAbs().maxCoeff();
+        const real_t ε     = reg_params.min_eig * (1 + d_max);
+        // Initial shift: none if the diagonal is larger than ε, otherwise make
+        // the smallest diagonal element equal to ε. Subsequent shifts grow
+        // geometrically, starting from a value that is small relative to the
+        // diagonal.
+        const real_t β = std::max(ε, real_t(1e-3) * d_max);
+        real_t τ       = std::max(real_t(0), ε - d_min);
+        real_t τ_prev  = 0;
+        for (int i = 0;; ++i) {
+            diag.array() += τ - τ_prev;
+            llt.compute(A);
+            if (llt.info() == Eigen::Success)
+                break;
+            if (i >= max_shift_attempts || !std::isfinite(τ))
+                throw std::runtime_error("StructuredNewton: failed to make "
+                                         "the Hessian positive definite");
+            τ_prev = τ;
+            τ      = std::max(2 * τ, β);
+        }
+        if (reg_params.print_eig)
+            std::cout << "τ(" << name << "): " << float_to_str(τ, 3)
+                      << std::endl;
+        llt.solveInPlace(b);
+    }
+
+    void solve_modified_ldlt(rmat A, rvec b, const char *name) const {
+        const auto n = A.rows();
+        auto d = ldlt_d.topRows(n), w = ldlt_w.topRows(n);
+        // Bound on the elements of L, chosen to minimize the bound on the
+        // correction ‖E‖ (Gill, Murray and Wright, 1981)
+        real_t γ = A.diagonal().cwiseAbs().maxCoeff(), ξ = 0;
+        for (index_t j = 0; j + 1 < n; ++j) {
+            auto col = A.col(j).bottomRows(n - j - 1);
+            ξ        = std::max(ξ, col.cwiseAbs().maxCoeff());
+        }
+        const real_t ε_mach = std::numeric_limits<real_t>::epsilon();
+        const real_t n_real = static_cast<real_t>(n);
+        const real_t β_sq =
+            std::max({γ, n > 1 ? ξ / std::sqrt(n_real * n_real - 1) : 0,
+                      ε_mach});
+        const real_t δ = reg_params.min_eig * (1 + γ);
+        real_t max_E   = 0;
+        // Column-wise LDLᵀ, overwriting the lower triangle of A with L (unit
+        // diagonal not stored) and the diagonal with D.
+        for (index_t j = 0; j < n; ++j) {
+            auto c = A.col(j).bottomRows(n - j); // c(0) = c_jj
+            if (j > 0) {
+                auto wj = w.topRows(j);
+                wj      = A.row(j).leftCols(j).transpose().cwiseProduct(
+                    d.topRows(j));
+                c.noalias() -= A.bottomLeftCorner(n - j, j) * wj;
+            }
+            auto c_off   = c.bottomRows(n - j - 1);
+            real_t θ     = n - j > 1 ? c_off.cwiseAbs().maxCoeff() : 0;
+            d(j)         = std::max({std::abs(c(0)), θ * θ / β_sq, δ});
+            max_E        = std::max(max_E, d(j) - c(0));
+            c(0)         = d(j);
+            c_off       /= d(j);
+        }
+        if (reg_params.print_eig)
+            std::cout << "‖E(" << name << ")‖: " << float_to_str(max_E, 3)
+                      << std::endl;
+        // Solve LDLᵀx = b
+        auto L = A.template triangularView<Eigen::UnitLower>();
+        L.solveInPlace(b);
+        b.array() /= d.array();
+        L.transpose().solveInPlace(b);
+    }
+
+    /// Maximum number of increases of the shift for
+    /// @ref StructuredNewtonRegularization::ShiftedCholesky. The shift
+    /// doubles every time, so this is never reached for finite Hessians.
+    static constexpr int max_shift_attempts = 1024;
+
     const Problem *problem = nullptr;
 #ifndef _WIN32
     std::optional<crvec> y = std::nullopt;
@@ -224,6 +350,8 @@ struct StructuredNewtonDirection {
     mutable indexvec JK;
     mutable mat H;
     mutable vec HJ_storage;
+    mutable Eigen::LLT<mat> llt;
+    mutable vec ldlt_d, ldlt_w;
 
   public:
     AcceleratorParams reg_params;
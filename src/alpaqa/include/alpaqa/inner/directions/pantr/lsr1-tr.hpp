@@ -0,0 +1,153 @@
+#pragma once
+
+#include <alpaqa/accelerators/lsr1.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+#include <alpaqa/util/alloc-check.hpp>
+#include <alpaqa/util/index-set.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace alpaqa {
+
+/// Parameters for the @ref LSR1TRDirection class.
+/// @ingroup grp_Parameters
+template <Config Conf>
+struct LSR1TRDirectionParams {
+    USING_ALPAQA_CONFIG(Conf);
+    /// The factor in front of the term @f$ \langle B_{\mathcal{JK}}
+    /// d_{\mathcal {K}}, d_{\mathcal{J}} \rangle @f$ in equation (9) in
+    /// @cite bodard2023pantr, where @f$ B @f$ is the L-SR1 approximation of
+    /// the Hessian.
+    real_t hessian_vec_factor = real_t(1);
+};
+
+/// Trust-region direction for PANTR based on a limited-memory SR1
+/// approximation of the Hessian of @f$ \psi @f$, built from the pairs
+/// @f$ (x_{k+1} - x_k, \nabla\psi(x_{k+1}) - \nabla\psi(x_k)) @f$ generated
+/// by the solver. The trust-region subproblem on the free variables
+/// @f$ \mathcal{J} @f$ is solved exactly using the compact representation of
+/// the approximation, so no Hessian(-vector products) of the problem are
+/// required.
+/// @ingroup grp_DirectionProviders
+template <Config Conf>
+struct LSR1TRDirection {
+    USING_ALPAQA_CONFIG(Conf);
+
+    using Problem           = TypeErasedProblem<config_t>;
+    using LSR1              = alpaqa::LSR1<config_t>;
+    using AcceleratorParams = typename LSR1::Params;
+    using DirectionParams   = LSR1TRDirectionParams<config_t>;
+
+    struct Params {
+        AcceleratorParams accelerator = {};
+        DirectionParams direction     = {};
+    };
+
+    LSR1TRDirection() = default;
+    LSR1TRDirection(const Params &params)
+        : lsr1(params.accelerator), direction_params(params.direction) {}
+    LSR1TRDirection(const AcceleratorParams &params,
+                    const DirectionParams &directionparams = {})
+        : lsr1(params), direction_params(directionparams) {}
+
+    /// @see @ref PANTRDirection::initialize
+    void initialize(const Problem &problem, [[maybe_unused]] crvec y,
+                    [[maybe_unused]] crvec Σ, [[maybe_unused]] real_t γ_0,
+                    [[maybe_unused]] crvec x_0, [[maybe_unused]] crvec x̂_0,
+                    [[maybe_unused]] crvec p_0,
+                    [[maybe_unused]] crvec grad_ψx_0) {
+        if (!problem.provides_eval_inactive_indices_res_lna())
+            throw std::invalid_argument(
+                "LSR1TR requires "
+                "Problem::eval_inactive_indices_res_lna()");
+        // Store a reference to the problem
+        this->problem = &problem;
+        // Resize workspaces
+        const auto n = problem.get_n();
+        JK_sto.resize(n);
+        rJ_sto.resize(n);
+        qJ_sto.resize(n);
+        work.resize(n);
+        // The augmented Lagrangian changed, throw away the previous pairs
+        lsr1.resize(n);
+    }
+
+    /// @see @ref PANTRDirection::has_initial_direction
+    bool has_initial_direction() const { return true; }
+
+    /// @see @ref PANTRDirection::update
+    bool update([[maybe_unused]] real_t γₖ, [[maybe_unused]] real_t γₙₑₓₜ,
+                crvec xₖ, crvec xₙₑₓₜ, [[maybe_unused]] crvec pₖ,
+                [[maybe_unused]] crvec pₙₑₓₜ, crvec grad_ψxₖ,
+                crvec grad_ψxₙₑₓₜ) {
+        ScopedMallocAllower ma;
+        return lsr1.update(xₖ, xₙₑₓₜ, grad_ψxₖ, grad_ψxₙₑₓₜ);
+    }
+
+    /// @see @ref PANTRDirection::apply
+    real_t apply(real_t γₖ, crvec xₖ, [[maybe_unused]] crvec x̂ₖ, crvec pₖ,
+                 crvec grad_ψxₖ, real_t radius, rvec qₖ) const {
+
+        if (!std::isfinite(radius))
+            throw std::logic_error("Invalid trust radius");
+        if (radius < std::numeric_limits<real_t>::epsilon())
+            throw std::logic_error("Trust radius too small");
+
+        // Find inactive and active constraints
+        const auto n = problem->get_n();
+        index_t nJ =
+            problem->eval_inactive_indices_res_lna(γₖ, xₖ, grad_ψxₖ, JK_sto);
+        crindexvec J = JK_sto.topRows(nJ);
+        rindexvec K  = JK_sto.bottomRows(n - nJ);
+        detail::IndexSet<config_t>::compute_complement(J, K, n);
+        auto rJ = rJ_sto.topRows(nJ);
+        auto qJ = qJ_sto.topRows(nJ);
+        rJ      = (-real_t(1) / γₖ) * pₖ(J);
+        qₖ(K)   = pₖ(K);
+        qₖ(J).setZero();
+        real_t norm_qK_sq = pₖ(K).squaredNorm();
+
+        // If no pairs are available yet, the approximation is B = γ⁻¹I
+        const real_t δ_0 = 1 / γₖ;
+
+        // Hessian-vector term
+        if (direction_params.hessian_vec_factor != 0) {
+            lsr1.apply_hess(qₖ, work, δ_0);
+            rJ.noalias() += work(J) * direction_params.hessian_vec_factor;
+        }
+
+        // Exact solution of the trust-region subproblem
+        ScopedMallocAllower ma;
+        real_t qJ_model =
+            lsr1.solve_trust_region_masked(rJ, J, radius, δ_0, qJ);
+        qₖ(J) = qJ;
+        return qJ_model - norm_qK_sq / (2 * γₖ);
+    }
+
+    /// @see @ref PANTRDirection::changed_γ
+    void changed_γ([[maybe_unused]] real_t γₖ, [[maybe_unused]] real_t old_γₖ) {
+    }
+
+    /// @see @ref PANTRDirection::reset
+    void reset() { lsr1.reset(); }
+
+    /// @see @ref PANTRDirection::get_name
+    std::string get_name() const {
+        return "LSR1TRDirection<" + std::string(config_t::get_name()) + '>';
+    }
+
+    auto get_params() const {
+        return std::tie(lsr1.get_params(), direction_params);
+    }
+
+    LSR1 lsr1;
+    DirectionParams direction_params;
+    const Problem *problem = nullptr;
+    mutable indexvec JK_sto;
+    mutable vec rJ_sto;
+    mutable vec qJ_sto;
+    mutable vec work;
+};
+
+} // namespace alpaqa
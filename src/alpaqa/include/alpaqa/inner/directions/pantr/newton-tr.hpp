@@ -1,10 +1,13 @@
 #pragma once
 
+#include <alpaqa/accelerators/lbfgs.hpp>
 #include <alpaqa/accelerators/steihaugcg.hpp>
+#include <alpaqa/problem/sparsity.hpp>
 #include <alpaqa/problem/type-erased-problem.hpp>
 #include <alpaqa/util/alloc-check.hpp>
 #include <alpaqa/util/index-set.hpp>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <optional>
 #include <stdexcept>
@@ -39,6 +42,11 @@ struct NewtonTRDirection {
     using Problem           = TypeErasedProblem<config_t>;
     using AcceleratorParams = SteihaugCGParams<config_t>;
     using DirectionParams   = NewtonTRDirectionParams<config_t>;
+    using Preconditioner    = SteihaugCGPreconditioner;
+    /// Signature of a user-supplied preconditioner, see
+    /// @ref custom_preconditioner.
+    using PreconditionerFun =
+        std::function<void(crvec x, crindexvec J, crvec r, rvec Mr)>;
 
     struct Params {
         AcceleratorParams accelerator = {};
@@ -67,6 +75,21 @@ struct NewtonTRDirection {
             throw std::invalid_argument(
                 "NewtonTR requires "
                 "Problem::eval_inactive_indices_res_lna()");
+        const auto precond = steihaug.params.preconditioner;
+        if (precond == Preconditioner::HessianDiagonal &&
+            !problem.supports_eval_hess_ψ())
+            throw std::invalid_argument(
+                "NewtonTR with HessianDiagonal preconditioner requires "
+                "Problem::eval_hess_ψ()");
+        if (precond == Preconditioner::JacobianColumnNorms &&
+            !problem.provides_eval_jac_g())
+            throw std::invalid_argument(
+                "NewtonTR with JacobianColumnNorms preconditioner requires "
+                "Problem::eval_jac_g()");
+        if (precond == Preconditioner::Custom && !custom_preconditioner)
+            throw std::invalid_argument(
+                "NewtonTR with Custom preconditioner requires "
+                "NewtonTRDirection::custom_preconditioner");
         // Store references to problem and ALM variables
         this->problem = &problem;
         this->y.emplace(y);
@@ -83,6 +106,7 @@ struct NewtonTRDirection {
             work_n_fd.resize(n);
             work_m_fd.resize(m);
         }
+        initialize_preconditioner(problem);
     }
 
     /// @see @ref PANTRDirection::has_initial_direction
@@ -161,7 +185,8 @@ struct NewtonTRDirection {
         };
 
         // Steihaug conjugate gradients
-        real_t qJ_model = steihaug.solve(rJ, hess_vec_mult, radius, qJ);
+        real_t qJ_model = solve_preconditioned(xₖ, J, rJ, hess_vec_mult,
+                                               radius, qJ);
         qₖ(J)           = qJ;
         return qJ_model - norm_qK_sq / (2 * γₖ);
     }
@@ -171,7 +196,7 @@ struct NewtonTRDirection {
     }
 
     /// @see @ref PANTRDirection::reset
-    void reset() {}
+    void reset() { precond_lbfgs.reset(); }
 
     /// @see @ref PANTRDirection::get_name
     std::string get_name() const {
@@ -182,8 +207,168 @@ struct NewtonTRDirection {
         return std::tie(steihaug.params, direction_params);
     }
 
+  private:
+    void initialize_preconditioner(const Problem &problem) {
+        const auto n = problem.get_n(), m = problem.get_m();
+        using enum SteihaugCGPreconditioner;
+        switch (steihaug.params.preconditioner) {
+            case HessianDiagonal: {
+                // Only the diagonal elements of the Hessian are used
+                indexvec rows, cols;
+                sparsity::get_nonzero_indices(problem.get_hess_ψ_sparsity(),
+                                              rows, cols);
+                precond_values.resize(rows.size());
+                auto diag = (rows.array() == cols.array()).count();
+                precond_rows.resize(diag);
+                precond_nz.resize(diag);
+                for (index_t k = 0, i = 0; k < rows.size(); ++k)
+                    if (rows(k) == cols(k)) {
+                        precond_rows(i) = rows(k);
+                        precond_nz(i++) = k;
+                    }
+                precond_diag.resize(n);
+            } break;
+            case JacobianColumnNorms:
+                sparsity::get_nonzero_indices(problem.get_jac_g_sparsity(),
+                                              precond_rows, precond_cols);
+                precond_values.resize(precond_rows.size());
+                precond_diag.resize(n);
+                precond_weights.resize(m);
+                break;
+            case LBFGS:
+                if (steihaug.params.precond_memory < 1)
+                    throw std::invalid_argument(
+                        "NewtonTR with LBFGS preconditioner requires "
+                        "SteihaugCGParams::precond_memory >= 1");
+                // Keep the previous pairs, the Hessian of the augmented
+                // Lagrangian usually changes only slightly between ALM
+                // iterations
+                if (precond_lbfgs.n() != n ||
+                    precond_lbfgs.history() != steihaug.params.precond_memory)
+                    precond_lbfgs = alpaqa::LBFGS<config_t>{
+                        {.memory = steihaug.params.precond_memory}, n};
+                precond_pairs.resize(n, 2 * steihaug.params.precond_memory);
+                precond_work.resize(n);
+                precond_work_2.resize(n);
+                break;
+            case None:
+            case Custom:
+            default: break;
+        }
+    }
+
+    /// Compute the diagonal preconditioner in @ref precond_diag.
+    void compute_diagonal_preconditioner(crvec xₖ, crindexvec J) const {
+        precond_diag.setZero();
+        if (steihaug.params.preconditioner ==
+            SteihaugCGPreconditioner::HessianDiagonal) {
+            problem->eval_hess_ψ(xₖ, *y, *Σ, 1, precond_values);
+            for (index_t k = 0; k < precond_nz.size(); ++k)
+                precond_diag(precond_rows(k)) += precond_values(precond_nz(k));
+        } else {
+            // Weigh the rows of the Jacobian of the active constraints by
+            // the penalty factors: ζ = g(x) + Σ⁻¹y ∉ D
+            const auto &D = problem->get_box_D();
+            auto &ζ       = precond_weights;
+            problem->eval_g(xₖ, ζ);
+            ζ += y->cwiseQuotient(*Σ);
+            precond_weights = ((ζ.array() < D.lowerbound.array()) ||
+                               (ζ.array() > D.upperbound.array()))
+                                  .select(Σ->array(), real_t(0))
+                                  .matrix();
+            problem->eval_jac_g(xₖ, precond_values);
+            for (index_t k = 0; k < precond_values.size(); ++k)
+                precond_diag(precond_cols(k)) +=
+                    precond_weights(precond_rows(k)) *
+                    precond_values(k) * precond_values(k);
+        }
+        // Make sure that the preconditioner is positive definite
+        auto dJ      = precond_diag(J);
+        real_t max_d = dJ.cwiseAbs().maxCoeff();
+        if (!(max_d > 0) || !std::isfinite(max_d)) {
+            precond_diag(J).setOnes();
+        } else {
+            real_t min_d     = max_d * steihaug.params.precond_min_diag;
+            precond_diag(J) = dJ.cwiseAbs().cwiseMax(min_d);
+        }
+    }
+
+    /// Solve the trust-region subproblem using Steihaug CG with the
+    /// configured preconditioner.
+    template <class HessFun>
+    real_t solve_preconditioned(crvec xₖ, crindexvec J, crvec rJ,
+                                const HessFun &hess_vec_mult, real_t radius,
+                                rvec qJ) const {
+        const auto nJ = J.size();
+        using enum SteihaugCGPreconditioner;
+        switch (steihaug.params.preconditioner) {
+            case None: return steihaug.solve(rJ, hess_vec_mult, radius, qJ);
+            case HessianDiagonal:
+            case JacobianColumnNorms: {
+                compute_diagonal_preconditioner(xₖ, J);
+                auto precond = [&](crvec r, rvec Mr) {
+                    Mr.topRows(nJ) = r.topRows(nJ).cwiseQuotient(
+                        precond_diag(J));
+                };
+                return steihaug.solve(rJ, hess_vec_mult, precond, radius, qJ);
+            }
+            case LBFGS: {
+                // The preconditioner has to remain constant during the CG
+                // iterations, so the Hessian-vector products are buffered,
+                // and only added to the L-BFGS estimate after the solve.
+                const auto mem = precond_pairs.cols() / 2;
+                index_t num_pairs = 0;
+                auto hess_vec_mult_rec = [&](crvec p, rvec Bp) {
+                    hess_vec_mult(p, Bp);
+                    auto i = 2 * (num_pairs++ % mem);
+                    precond_pairs.col(i).topRows(nJ)     = p.topRows(nJ);
+                    precond_pairs.col(i + 1).topRows(nJ) = Bp.topRows(nJ);
+                };
+                auto precond = [&](crvec r, rvec Mr) {
+                    precond_work.setZero();
+                    precond_work(J) = r.topRows(nJ);
+                    if (precond_lbfgs.apply_masked(precond_work, -1, J))
+                        Mr.topRows(nJ) = precond_work(J);
+                    else
+                        Mr.topRows(nJ) = r.topRows(nJ);
+                };
+                real_t model = steihaug.solve(rJ, hess_vec_mult_rec, precond,
+                                              radius, qJ);
+                // Add the pairs to the L-BFGS estimate, oldest first
+                for (index_t k = std::max<index_t>(0, num_pairs - mem);
+                     k < num_pairs; ++k) {
+                    auto i = 2 * (k % mem);
+                    precond_work.setZero();
+                    precond_work_2.setZero();
+                    precond_work(J)   = precond_pairs.col(i).topRows(nJ);
+                    precond_work_2(J) = precond_pairs.col(i + 1).topRows(nJ);
+                    precond_lbfgs.update_sy(precond_work, precond_work_2, 0);
+                }
+                return model;
+            }
+            case Custom: {
+                auto precond = [&](crvec r, rvec Mr) {
+                    ScopedMallocAllower ma;
+                    custom_preconditioner(xₖ, J, r.topRows(nJ),
+                                          Mr.topRows(nJ));
+                };
+                return steihaug.solve(rJ, hess_vec_mult, precond, radius, qJ);
+            }
+            default: throw std::logic_error("Invalid preconditioner");
+        }
+    }
+
+  public:
     SteihaugCG<config_t> steihaug;
     DirectionParams direction_params;
+    /// Preconditioner used if @ref SteihaugCGParams::preconditioner is
+    /// @ref SteihaugCGPreconditioner::Custom. It is called as
+    /// `custom_preconditioner(x, J, r, Mr)` and should compute
+    /// @f$ M_{\mathcal{J}}^{-1} r @f$, where @f$ M_{\mathcal{J}} @f$ is a
+    /// positive definite approximation of the Hessian @f$ \nabla^2 \psi(x)
+    /// @f$, restricted to the rows and columns in the index set @f$
+    /// \mathcal{J} @f$ of free variables.
+    PreconditionerFun custom_preconditioner;
     const Problem *problem = nullptr;
 #ifndef _WIN32
     std::optional<crvec> y = std::nullopt;
@@ -196,6 +381,12 @@ struct NewtonTRDirection {
     mutable vec rJ_sto;
     mutable vec qJ_sto;
     mutable vec work, work_2, work_n_fd, work_m_fd;
+    // Preconditioner workspaces
+    mutable vec precond_values, precond_diag, precond_weights;
+    mutable vec precond_work, precond_work_2;
+    mutable indexvec precond_rows, precond_cols, precond_nz;
+    mutable mat precond_pairs;
+    mutable alpaqa::LBFGS<config_t> precond_lbfgs;
 };
 
 } // namespace alpaqa
\ No newline at end of file
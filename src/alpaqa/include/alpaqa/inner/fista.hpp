@@ -65,6 +65,9 @@ struct FISTAStats {
     SolverStatus status = SolverStatus::Busy;
     real_t ε            = inf<config_t>;
     std::chrono::nanoseconds elapsed_time{};
+    std::chrono::nanoseconds time_evaluations{};
+    std::chrono::nanoseconds time_prox{};
+    std::chrono::nanoseconds time_linesearch{};
     std::chrono::nanoseconds time_progress_callback{};
     unsigned iterations          = 0;
     unsigned stepsize_backtracks = 0;
@@ -98,6 +101,7 @@ struct FISTAProgressInfo {
     unsigned outer_iter;
     const TypeErasedProblem<config_t> *problem;
     const FISTAParams<config_t> *params;
+    const FISTAStats<config_t> *stats;
 };
 
 /// FISTA solver for ALM.
@@ -170,6 +174,13 @@ struct InnerStatsAccumulator<FISTAStats<Conf>> {
 
     /// Total elapsed time in the inner solver.
     std::chrono::nanoseconds elapsed_time{};
+    /// Total time spent evaluating the cost and its gradient.
+    std::chrono::nanoseconds time_evaluations{};
+    /// Total time spent computing proximal gradient steps.
+    std::chrono::nanoseconds time_prox{};
+    /// Total time spent backtracking the step size, including the evaluations
+    /// it performs.
+    std::chrono::nanoseconds time_linesearch{};
     /// Total time spent in the user-provided progress callback.
     std::chrono::nanoseconds time_progress_callback{};
     /// Total number of inner FISTA iterations.
@@ -190,6 +201,9 @@ operator+=(InnerStatsAccumulator<FISTAStats<Conf>> &acc,
            const FISTAStats<Conf> &s) {
     acc.iterations += s.iterations;
     acc.elapsed_time += s.elapsed_time;
+    acc.time_evaluations += s.time_evaluations;
+    acc.time_prox += s.time_prox;
+    acc.time_linesearch += s.time_linesearch;
     acc.time_progress_callback += s.time_progress_callback;
     acc.stepsize_backtracks += s.stepsize_backtracks;
     acc.final_γ  = s.final_γ;
@@ -92,6 +92,11 @@ struct PANOCStats {
     SolverStatus status = SolverStatus::Busy;
     real_t ε            = inf<config_t>;
     std::chrono::nanoseconds elapsed_time{};
+    std::chrono::nanoseconds time_evaluations{};
+    std::chrono::nanoseconds time_prox{};
+    std::chrono::nanoseconds time_direction_apply{};
+    std::chrono::nanoseconds time_direction_update{};
+    std::chrono::nanoseconds time_linesearch{};
     std::chrono::nanoseconds time_progress_callback{};
     unsigned iterations            = 0;
     unsigned linesearch_failures   = 0;
@@ -134,6 +139,7 @@ struct PANOCProgressInfo {
     unsigned outer_iter;
     const TypeErasedProblem<config_t> *problem;
     const PANOCParams<config_t> *params;
+    const PANOCStats<config_t> *stats;
 };
 
 /// PANOC solver for ALM.
@@ -214,6 +220,18 @@ struct InnerStatsAccumulator<PANOCStats<Conf>> {
 
     /// Total elapsed time in the inner solver.
     std::chrono::nanoseconds elapsed_time{};
+    /// Total time spent evaluating the cost and its gradient.
+    std::chrono::nanoseconds time_evaluations{};
+    /// Total time spent computing proximal gradient steps.
+    std::chrono::nanoseconds time_prox{};
+    /// Total time spent initializing and applying the (quasi-)Newton
+    /// direction.
+    std::chrono::nanoseconds time_direction_apply{};
+    /// Total time spent updating the (quasi-)Newton direction.
+    std::chrono::nanoseconds time_direction_update{};
+    /// Total time spent in the line search, including the evaluations and
+    /// direction updates it performs.
+    std::chrono::nanoseconds time_linesearch{};
     /// Total time spent in the user-provided progress callback.
     std::chrono::nanoseconds time_progress_callback{};
     /// Total number of inner PANOC iterations.
@@ -255,6 +273,11 @@ operator+=(InnerStatsAccumulator<PANOCStats<Conf>> &acc,
            const PANOCStats<Conf> &s) {
     acc.iterations += s.iterations;
     acc.elapsed_time += s.elapsed_time;
+    acc.time_evaluations += s.time_evaluations;
+    acc.time_prox += s.time_prox;
+    acc.time_direction_apply += s.time_direction_apply;
+    acc.time_direction_update += s.time_direction_update;
+    acc.time_linesearch += s.time_linesearch;
     acc.time_progress_callback += s.time_progress_callback;
     acc.linesearch_failures += s.linesearch_failures;
     acc.linesearch_backtracks += s.linesearch_backtracks;
@@ -102,6 +102,10 @@ struct PANTRStats {
     SolverStatus status = SolverStatus::Busy;
     real_t ε            = inf<config_t>;
     std::chrono::nanoseconds elapsed_time{};
+    std::chrono::nanoseconds time_evaluations{};
+    std::chrono::nanoseconds time_prox{};
+    std::chrono::nanoseconds time_direction_apply{};
+    std::chrono::nanoseconds time_direction_update{};
     std::chrono::nanoseconds time_progress_callback{};
     unsigned iterations                = 0;
     unsigned accelerated_step_rejected = 0;
@@ -143,6 +147,7 @@ struct PANTRProgressInfo {
     unsigned outer_iter;
     const TypeErasedProblem<config_t> *problem;
     const PANTRParams<config_t> *params;
+    const PANTRStats<config_t> *stats;
 };
 
 /// PANTR solver for ALM.
@@ -223,6 +228,15 @@ struct InnerStatsAccumulator<PANTRStats<Conf>> {
 
     /// Total elapsed time in the inner solver.
     std::chrono::nanoseconds elapsed_time{};
+    /// Total time spent evaluating the cost and its gradient.
+    std::chrono::nanoseconds time_evaluations{};
+    /// Total time spent computing proximal gradient steps.
+    std::chrono::nanoseconds time_prox{};
+    /// Total time spent initializing and applying the (quasi-)Newton
+    /// direction.
+    std::chrono::nanoseconds time_direction_apply{};
+    /// Total time spent updating the (quasi-)Newton direction.
+    std::chrono::nanoseconds time_direction_update{};
     /// Total time spent in the user-provided progress callback.
     std::chrono::nanoseconds time_progress_callback{};
     /// Total number of inner PANTR iterations.
@@ -252,6 +266,10 @@ InnerStatsAccumulator<PANTRStats<Conf>> &
 operator+=(InnerStatsAccumulator<PANTRStats<Conf>> &acc,
            const PANTRStats<Conf> &s) {
     acc.elapsed_time += s.elapsed_time;
+    acc.time_evaluations += s.time_evaluations;
+    acc.time_prox += s.time_prox;
+    acc.time_direction_apply += s.time_direction_apply;
+    acc.time_direction_update += s.time_direction_update;
     acc.time_progress_callback += s.time_progress_callback;
     acc.iterations += s.iterations;
     acc.accelerated_step_rejected += s.accelerated_step_rejected;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
+#include <alpaqa/inner/pantr.hpp>
+#include <alpaqa/outer/alm.hpp>
+
+namespace alpaqa {
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigd>);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigf>);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigl>);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigq>);)
+
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigd>>);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigf>>);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigl>>);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigq>>);)
+// clang-format on
+
+} // namespace alpaqa
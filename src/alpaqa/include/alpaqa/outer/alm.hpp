@@ -5,6 +5,7 @@
 #include <alpaqa/inner/internal/solverstatus.hpp>
 #include <alpaqa/outer/internal/alm-helpers.hpp>
 #include <alpaqa/problem/type-erased-problem.hpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 
 #include <chrono>
 #include <iostream>
@@ -60,6 +61,14 @@ struct ALMParams {
 
     /// Use one penalty factor for all m constraints.
     bool single_penalty_factor = false;
+
+    /// Length of the history used to accelerate the outer iterations. The
+    /// multiplier update (inner solve followed by the first-order update of
+    /// y) is treated as a fixed-point map, and Anderson acceleration is
+    /// applied to the Lagrange multipliers. Accelerated multipliers that
+    /// increase the constraint violation are rejected. When set to zero (which
+    /// is the default), the plain first-order multiplier update is used.
+    length_t anderson_memory = 0;
 };
 
 /// Augmented Lagrangian Method solver
@@ -93,6 +102,12 @@ class ALMSolver {
         real_t δ = inf<config_t>;
         /// 2-norm of the final penalty factors @f$ \| \Sigma \|_2 @f$.
         real_t norm_penalty = 0;
+        /// Number of outer iterations that started from Anderson-accelerated
+        /// Lagrange multipliers (see @ref ALMParams::anderson_memory).
+        unsigned accelerated_iterations = 0;
+        /// Number of Anderson-accelerated multipliers that were rejected
+        /// because the constraint violation increased.
+        unsigned acceleration_rejections = 0;
 
         /// Whether the solver converged or not.
         /// @see @ref SolverStatus
@@ -101,6 +116,11 @@ class ALMSolver {
         /// The statistics of the inner solver invocations, accumulated over all
         /// ALM iterations.
         InnerStatsAccumulator<typename InnerSolver::Stats> inner{};
+        /// Heap allocations of the current thread during the solve, per phase
+        /// of the inner and outer solvers. Only available if the allocation
+        /// hook is linked into the executable (see @ref alloc_accounting),
+        /// zero otherwise.
+        AllocStats allocations{};
     };
 
     ALMSolver(Params params, InnerSolver &&inner_solver)
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+#include <alpaqa/inner/internal/solverstatus.hpp>
+#include <alpaqa/outer/alm.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+#include <alpaqa/util/atomic-stop-signal.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace alpaqa {
+
+/// Parameters for the @ref PortfolioSolver.
+/// @ingroup grp_Parameters
+struct PortfolioParams {
+    /// Give each solver its own copy of the problem, so that the problem
+    /// functions can be evaluated concurrently. Problems passed by their
+    /// concrete type are copied using their copy constructor, and copying a
+    /// @ref TypeErasedProblem that owns its problem copies the problem itself.
+    /// Only enable this option if copies of the problem are independent and
+    /// can safely be evaluated in parallel.
+    /// If disabled, or if the problem cannot be copied (e.g. a
+    /// @ref TypeErasedProblem that was created from a pointer), all solvers
+    /// share the same problem, and evaluations are serialized using a mutex
+    /// (see @ref SynchronizedProblem). Use the overload of
+    /// @ref PortfolioSolver::operator()(const ProblemFactory &, rvec, rvec, std::optional<rvec>)
+    /// to create the copies in some other way.
+    bool clone_problem = true;
+    /// How often the main thread checks whether @ref PortfolioSolver::stop
+    /// was called.
+    std::chrono::microseconds poll_interval = std::chrono::milliseconds(10);
+};
+
+/// Summary of the result of one of the solvers in a @ref PortfolioSolver.
+template <Config Conf = DefaultConfig>
+struct PortfolioEntryStats {
+    USING_ALPAQA_CONFIG(Conf);
+
+    /// Name of the solver, as passed to @ref PortfolioSolver::add.
+    std::string name;
+    /// Exit status of the solver. Solvers that were stopped because another
+    /// solver converged first report @ref SolverStatus::Interrupted.
+    SolverStatus status = SolverStatus::Busy;
+    /// Time between the start of the portfolio and the moment this solver
+    /// returned.
+    std::chrono::nanoseconds elapsed_time{};
+    /// Final primal tolerance, see @ref ALMSolver::Stats::ε.
+    real_t ε = inf<config_t>;
+    /// Final dual tolerance, see @ref ALMSolver::Stats::δ.
+    real_t δ = inf<config_t>;
+    /// 2-norm of the final penalty factors.
+    real_t norm_penalty = 0;
+    /// Final step size of the inner solver (if applicable).
+    real_t final_γ = 0;
+    /// Final value of the nonsmooth term of the objective (if applicable).
+    real_t final_h = 0;
+    /// Number of outer ALM iterations.
+    unsigned outer_iterations = 0;
+    /// Total number of inner iterations.
+    unsigned inner_iterations = 0;
+};
+
+namespace detail {
+
+/// Type-erased solver in a @ref PortfolioSolver.
+template <Config Conf>
+struct PortfolioEntry {
+    USING_ALPAQA_CONFIG(Conf);
+    using Problem = TypeErasedProblem<config_t>;
+    using Stats   = PortfolioEntryStats<config_t>;
+
+    explicit PortfolioEntry(std::string name) : name{std::move(name)} {}
+    virtual ~PortfolioEntry() = default;
+
+    /// Solve the problem using a fresh copy of the solver. The given function
+    /// is called with a function that stops that copy, before the solver is
+    /// started. It is called again with an empty function before the copy is
+    /// destroyed.
+    virtual Stats solve(const Problem &problem, rvec x, rvec y, rvec Σ,
+                        std::ostream *os,
+                        const std::function<void(std::function<void()>)>
+                            &set_stop_function) const = 0;
+    [[nodiscard]] virtual std::string get_solver_name() const = 0;
+
+    std::string name;
+};
+
+template <class Solver>
+struct PortfolioEntryImpl : PortfolioEntry<typename Solver::config_t> {
+    using Base = PortfolioEntry<typename Solver::config_t>;
+    USING_ALPAQA_CONFIG_TEMPLATE(Base::config_t);
+    using typename Base::Problem;
+    using typename Base::Stats;
+
+    PortfolioEntryImpl(std::string name, Solver solver)
+        : Base{std::move(name)}, solver{std::move(solver)} {}
+
+    Stats solve(const Problem &problem, rvec x, rvec y, rvec Σ,
+                std::ostream *os,
+                const std::function<void(std::function<void()>)>
+                    &set_stop_function) const override {
+        // Copies of the solvers get their own stop signal
+        Solver local_solver = solver;
+        local_solver.os     = os;
+        set_stop_function([&local_solver] { local_solver.stop(); });
+        try {
+            auto stats = local_solver(problem, x, y, Σ);
+            set_stop_function(nullptr);
+            Stats result{
+                .name             = this->name,
+                .status           = stats.status,
+                .ε                = stats.ε,
+                .δ                = stats.δ,
+                .norm_penalty     = stats.norm_penalty,
+                .outer_iterations = stats.outer_iterations,
+                .inner_iterations = stats.inner.iterations,
+            };
+            if constexpr (requires { stats.inner.final_γ; })
+                result.final_γ = stats.inner.final_γ;
+            if constexpr (requires { stats.inner.final_h; })
+                result.final_h = stats.inner.final_h;
+            return result;
+        } catch (...) {
+            set_stop_function(nullptr);
+            throw;
+        }
+    }
+    [[nodiscard]] std::string get_solver_name() const override {
+        return solver.get_name();
+    }
+
+    Solver solver;
+};
+
+} // namespace detail
+
+/// Runs several solvers on the same problem in parallel threads, and returns
+/// the solution of the first one to converge. As soon as one of the solvers
+/// converges, the others are stopped using their `stop()` method.
+///
+/// Which solver and direction perform best is often hard to predict in
+/// advance. Racing a portfolio of configurations is a simple way to obtain a
+/// time-to-solution close to that of the best configuration, at the cost of
+/// using more threads.
+///
+/// @ingroup    grp_ALMSolver
+template <Config Conf = DefaultConfig>
+class PortfolioSolver {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+
+    using Params     = PortfolioParams;
+    using Problem    = TypeErasedProblem<config_t>;
+    using EntryStats = PortfolioEntryStats<config_t>;
+    /// Function that creates an independent instance of the problem for the
+    /// solver with the given index.
+    using ProblemFactory = std::function<Problem(index_t)>;
+
+    struct Stats {
+        /// Index of the solver whose solution was returned, or -1 if the
+        /// portfolio is empty.
+        index_t winner = -1;
+        /// Name of the solver whose solution was returned.
+        std::string winner_name;
+        /// Status of the solver whose solution was returned. If none of the
+        /// solvers converged, the result of the solver with the smallest
+        /// primal and dual tolerance is returned.
+        SolverStatus status = SolverStatus::Busy;
+        /// Time until the solver whose solution was returned finished.
+        std::chrono::nanoseconds time_to_solution{};
+        /// Time until all solvers finished (including the time it took to
+        /// stop the other solvers).
+        std::chrono::nanoseconds elapsed_time{};
+        /// Results of all solvers, in the order they were added.
+        std::vector<EntryStats> entries;
+    };
+
+    PortfolioSolver(Params params = {}) : params{params} {}
+
+    /// Add an ALM solver to the portfolio. A copy of the solver is made at
+    /// the start of every solve, so the given solver can be reused for
+    /// multiple problems.
+    /// @param  name
+    ///         Name to identify this configuration in the results.
+    /// @param  solver
+    ///         The configured solver.
+    template <class InnerSolver>
+    void add(std::string name, ALMSolver<InnerSolver> solver) {
+        static_assert(
+            std::is_same_v<typename InnerSolver::Problem, Problem>,
+            "Inner solver should accept the type-erased problem of this "
+            "configuration");
+        using Impl = detail::PortfolioEntryImpl<ALMSolver<InnerSolver>>;
+        entries.push_back(
+            std::make_shared<const Impl>(std::move(name), std::move(solver)));
+    }
+    /// @copydoc add(std::string, ALMSolver<InnerSolver>)
+    template <class InnerSolver>
+    void add(ALMSolver<InnerSolver> solver) {
+        auto name = solver.get_name();
+        add(std::move(name), std::move(solver));
+    }
+
+    /// Solve the problem using all solvers in the portfolio.
+    /// The output of each solver is buffered, only the output of the solver
+    /// whose solution is returned is written to @ref os.
+    /// @param  problem
+    ///         The problem to solve. Either copied for every solver, or shared
+    ///         between them, depending on @ref PortfolioParams::clone_problem.
+    /// @param  x
+    ///         Initial guess, overwritten by the solution of the winner.
+    /// @param  y
+    ///         Initial guess for the Lagrange multipliers, overwritten by
+    ///         the multipliers of the winner.
+    /// @param  Σ
+    ///         Optional initial penalty factors (only used if they are finite
+    ///         and nonzero, see @ref ALMSolver::operator()), overwritten by
+    ///         the final penalty factors of the winner.
+    Stats operator()(const Problem &problem, rvec x, rvec y,
+                     std::optional<rvec> Σ = std::nullopt);
+    /// Solve the problem using all solvers in the portfolio, using a separate
+    /// instance of the problem for each solver. Use this overload when the
+    /// problem has to be cloned in some special way.
+    /// @param  problems
+    ///         One problem for each solver, in the order the solvers were
+    ///         added.
+    ///         The problems should be independent, so that they can safely be
+    ///         evaluated from different threads at the same time.
+    /// @param  x
+    ///         Initial guess, overwritten by the solution of the winner.
+    /// @param  y
+    ///         Initial guess for the Lagrange multipliers, overwritten by
+    ///         the multipliers of the winner.
+    /// @param  Σ
+    ///         Optional initial and final penalty factors.
+    Stats operator()(std::span<const Problem> problems, rvec x, rvec y,
+                     std::optional<rvec> Σ = std::nullopt);
+    /// Solve the problem using all solvers in the portfolio, using a separate
+    /// instance of the problem for each solver, created by the given factory.
+    /// @param  make_problem
+    ///         Called once for each solver, in the calling thread, before the
+    ///         solvers are started. The returned problems should be
+    ///         independent, so that they can safely be evaluated from
+    ///         different threads at the same time.
+    /// @param  x
+    ///         Initial guess, overwritten by the solution of the winner.
+    /// @param  y
+    ///         Initial guess for the Lagrange multipliers, overwritten by
+    ///         the multipliers of the winner.
+    /// @param  Σ
+    ///         Optional initial and final penalty factors.
+    Stats operator()(const ProblemFactory &make_problem, rvec x, rvec y,
+                     std::optional<rvec> Σ = std::nullopt);
+    /// Solve the given problem, giving each solver its own copy if
+    /// @ref PortfolioParams::clone_problem is set.
+    template <class P>
+        requires(!std::is_invocable_r_v<Problem, const P &, index_t>)
+    Stats operator()(const P &problem, rvec x, rvec y,
+                     std::optional<rvec> Σ = std::nullopt) {
+        if constexpr (std::is_copy_constructible_v<P>)
+            if (params.clone_problem)
+                return operator()(
+                    ProblemFactory{[&problem](index_t) {
+                        return Problem::template make<P>(problem);
+                    }},
+                    x, y, Σ);
+        return operator()(Problem{&problem}, x, y, Σ);
+    }
+
+    /// Number of solvers in the portfolio.
+    [[nodiscard]] length_t size() const {
+        return static_cast<length_t>(entries.size());
+    }
+    /// Name of the solver with the given index.
+    [[nodiscard]] const std::string &get_entry_name(index_t i) const {
+        return entries.at(static_cast<size_t>(i))->name;
+    }
+    std::string get_name() const;
+
+    /// Abort the computation of all solvers and return the best result so
+    /// far. Can be called from other threads or signal handlers.
+    void stop() { stop_signal.stop(); }
+
+    const Params &get_params() const { return params; }
+
+  private:
+    Params params;
+    std::vector<std::shared_ptr<const detail::PortfolioEntry<config_t>>>
+        entries;
+    AtomicStopSignal stop_signal;
+
+  public:
+    std::ostream *os = &std::cout;
+};
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PortfolioSolver, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PortfolioSolver, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PortfolioSolver, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PortfolioSolver, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+#include <alpaqa/inner/internal/solverstatus.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+namespace alpaqa {
+
+/// Parameters for the @ref ResultCache class.
+/// @ingroup grp_Parameters
+struct ResultCacheParams {
+    /// Maximum number of results to keep in memory. The least recently used
+    /// results are evicted first. Set to zero to disable the in-memory tier.
+    size_t max_memory_entries = 64;
+    /// Directory to store results in. If empty, the on-disk tier is disabled.
+    std::string directory{};
+    /// Maximum total size of the files in the on-disk tier (in bytes). The
+    /// least recently used files are removed first.
+    uintmax_t max_disk_size = uintmax_t{256} << 20;
+};
+
+/// Incremental 64-bit FNV-1a hash, used to build content-addressed keys for
+/// the @ref ResultCache.
+class ResultCacheKey {
+  public:
+    /// Hash raw bytes.
+    ResultCacheKey &add(std::span<const std::byte> data) {
+        for (auto b : data) {
+            state ^= static_cast<uint64_t>(b);
+            state *= prime;
+        }
+        return *this;
+    }
+    /// Hash a string, including its length (to avoid ambiguity between
+    /// consecutive strings).
+    ResultCacheKey &add(std::string_view s) {
+        add(static_cast<uint64_t>(s.size()));
+        return add(std::as_bytes(std::span{s}));
+    }
+    /// Hash an integer or floating-point value.
+    template <class T>
+        requires(std::integral<T> || std::floating_point<T>)
+    ResultCacheKey &add(T t) {
+        if constexpr (std::floating_point<T>)
+            if (t == 0) // Don't distinguish between +0 and -0
+                t = 0;
+        return add(std::as_bytes(std::span{&t, 1}));
+    }
+    /// Hash the size and the elements of a vector.
+    template <class Derived>
+    ResultCacheKey &add(const Eigen::DenseBase<Derived> &v) {
+        add(static_cast<uint64_t>(v.size()));
+        for (auto i = decltype(v.size()){0}; i < v.size(); ++i)
+            add(v(i));
+        return *this;
+    }
+    /// Hash the contents of the given file. Does nothing if the path does not
+    /// refer to a regular file.
+    ALPAQA_EXPORT ResultCacheKey &add_file(const std::filesystem::path &path);
+
+    /// The hash value.
+    [[nodiscard]] uint64_t digest() const { return state; }
+    /// The hash value, as a hexadecimal string of 16 characters.
+    [[nodiscard]] ALPAQA_EXPORT std::string str() const;
+
+  private:
+    static constexpr uint64_t offset_basis = 0xcbf29ce484222325;
+    static constexpr uint64_t prime        = 0x100000001b3;
+    uint64_t state                         = offset_basis;
+};
+
+template <Config Conf>
+struct ALMParams;
+template <Config Conf>
+struct PANOCParams;
+template <Config Conf>
+struct ZeroFPRParams;
+template <Config Conf>
+struct PANTRParams;
+template <Config Conf>
+struct FISTAParams;
+template <Config Conf>
+struct LBFGSParams;
+template <Config Conf>
+struct LBFGSDirectionParams;
+template <Config Conf>
+struct AndersonAccelParams;
+template <Config Conf>
+struct AndersonDirectionParams;
+template <Config Conf>
+struct StructuredLBFGSDirectionParams;
+template <Config Conf>
+struct StructuredNewtonDirectionParams;
+template <Config Conf>
+struct ConvexNewtonDirectionParams;
+template <Config Conf>
+struct SteihaugCGParams;
+template <Config Conf>
+struct NewtonTRDirectionParams;
+template <Config Conf>
+struct LSR1Params;
+template <Config Conf>
+struct LSR1TRDirectionParams;
+
+namespace params {
+
+/// @name Hashing solver parameters
+/// Add the names and values of all members of the given parameter struct to
+/// the key. Only available for the default configuration.
+/// @{
+
+// clang-format off
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const ALMParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const PANOCParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const ZeroFPRParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const PANTRParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const FISTAParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const LBFGSParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const LBFGSDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const AndersonAccelParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const AndersonDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const StructuredLBFGSDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const StructuredNewtonDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const ConvexNewtonDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const SteihaugCGParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const NewtonTRDirectionParams<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const LSR1Params<DefaultConfig> &);
+ALPAQA_EXPORT void add_to_key(ResultCacheKey &, const LSR1TRDirectionParams<DefaultConfig> &);
+// clang-format on
+
+/// @}
+
+} // namespace params
+
+namespace detail {
+
+/// Add the parameters returned by `get_params()` to the key, if they are
+/// known parameter structs (or tuples thereof).
+template <class T>
+void add_params_to_key(ResultCacheKey &key, const T &params) {
+    if constexpr (requires { std::tuple_size<T>::value; })
+        std::apply([&](const auto &...p) { (add_params_to_key(key, p), ...); },
+                   params);
+    else if constexpr (requires { params::add_to_key(key, params); })
+        params::add_to_key(key, params);
+}
+
+/// Add the parameters of an ALM solver, of its inner solver, and of the
+/// direction of the inner solver to the key.
+template <class ALMSolverT>
+void add_solver_params_to_key(ResultCacheKey &key, const ALMSolverT &solver) {
+    add_params_to_key(key, solver.get_params());
+    const auto &inner = solver.inner_solver;
+    if constexpr (requires { inner.get_params(); })
+        add_params_to_key(key, inner.get_params());
+    if constexpr (requires { inner.direction.get_params(); })
+        if constexpr (!std::is_void_v<
+                          decltype(inner.direction.get_params())>)
+            add_params_to_key(key, inner.direction.get_params());
+}
+
+} // namespace detail
+
+/// Result stored in a @ref ResultCache.
+template <Config Conf = DefaultConfig>
+struct CachedResult {
+    USING_ALPAQA_CONFIG(Conf);
+    static constexpr real_t NaN = alpaqa::NaN<config_t>;
+
+    /// Name of the solver that produced this result.
+    std::string solver{};
+    /// Solver status (e.g. the name of the @ref SolverStatus).
+    std::string status{};
+    /// Whether the solver converged.
+    bool success = false;
+    real_t ε = NaN, δ = NaN, norm_penalty = NaN, h = NaN, γ = NaN;
+    index_t outer_iterations = -1, inner_iterations = -1;
+    /// Time it took to compute the original result.
+    std::chrono::nanoseconds elapsed_time{};
+    vec x{};                  ///< Solution.
+    vec y{};                  ///< Multipliers of the general constraints.
+    vec multipliers_bounds{}; ///< Multipliers of the bound constraints.
+    vec Σ{};                  ///< Final penalty factors.
+};
+
+/// Counters to keep track of the effectiveness of a @ref ResultCache.
+struct ResultCacheStats {
+    /// Number of lookups that were served from memory.
+    unsigned memory_hits = 0;
+    /// Number of lookups that were served from disk.
+    unsigned disk_hits = 0;
+    /// Number of lookups that did not find a result.
+    unsigned misses = 0;
+    /// Number of results that were stored.
+    unsigned stores = 0;
+    /// Number of results removed from memory or disk to respect the limits.
+    unsigned evictions = 0;
+    /// Number of results that could not be written to disk (e.g. because the
+    /// directory is read-only or the disk is full). These results are still
+    /// stored in memory.
+    unsigned disk_errors = 0;
+};
+
+/// Content-addressed cache of solver results, with an in-memory LRU tier and
+/// an optional on-disk tier.
+///
+/// Results are identified by a key that is computed from the problem, the
+/// solver configuration and the initial guess, see @ref make_key.
+/// All member functions are thread-safe.
+/// @ingroup grp_ALMSolver
+template <Config Conf = DefaultConfig>
+class ResultCache {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+    using Params = ResultCacheParams;
+    using Result = CachedResult<config_t>;
+    using Stats  = ResultCacheStats;
+
+    ResultCache(Params params = {}) : params{std::move(params)} {}
+
+    /// Compute the key for the given problem, solver and initial guess.
+    /// @param  problem
+    ///         The problem to solve (its name, dimensions and the bounds of
+    ///         the boxes @f$ C @f$ and @f$ D @f$ are hashed).
+    /// @param  problem_id
+    ///         Anything that further identifies the problem and that cannot
+    ///         be inferred from @p problem, e.g. the hash of the shared library
+    ///         it was loaded from and the problem parameters.
+    /// @param  solver_id
+    ///         Identifies the solver and all of its options.
+    /// @param  x0  Initial guess for the decision variables.
+    /// @param  y0  Initial guess for the Lagrange multipliers.
+    [[nodiscard]] static ResultCacheKey
+    make_key(const TypeErasedProblem<config_t> &problem,
+             std::string_view problem_id, std::string_view solver_id, crvec x0,
+             crvec y0);
+
+    /// Look up the result with the given key. Results found on disk are
+    /// promoted to the in-memory tier.
+    [[nodiscard]] std::optional<Result> lookup(const std::string &key);
+    /// Store a result in memory and on disk. Failing to write the result to
+    /// disk is not an error, it is only counted in
+    /// @ref ResultCacheStats::disk_errors.
+    void store(const std::string &key, Result result);
+    /// Remove all results from the in-memory tier.
+    void clear_memory();
+
+    [[nodiscard]] const Params &get_params() const { return params; }
+    [[nodiscard]] Stats get_stats() const {
+        std::lock_guard lck{mtx};
+        return stats;
+    }
+
+  private:
+    void store_memory(const std::string &key, Result result);
+    std::optional<Result> lookup_disk(const std::string &key);
+    [[nodiscard]] bool store_disk(const std::string &key,
+                                  const Result &result);
+    void enforce_disk_limit();
+    [[nodiscard]] std::filesystem::path disk_path(const std::string &key) const;
+
+  private:
+    using lru_list_t = std::list<std::pair<std::string, Result>>;
+    Params params;
+    Stats stats;
+    lru_list_t lru;
+    std::unordered_map<std::string, typename lru_list_t::iterator> index;
+    mutable std::mutex mtx;
+};
+
+/// Invoke an ALM solver, but return the result from the given cache if the
+/// same problem was solved before with the same solver and initial guess.
+/// Results of solves that were interrupted are not stored.
+/// @param  cache       The cache to look up and store the result in.
+/// @param  solver      The ALM solver to invoke on a cache miss.
+/// @param  problem     The problem to solve.
+/// @param  x           Initial guess and solution.
+/// @param  y           Initial guess and solution of the multipliers.
+/// @param  Σ           Optional initial guess and final penalty factors (see
+///                     @ref ALMSolver::operator()). The initial guess is part
+///                     of the key.
+/// @param  problem_id  See @ref ResultCache::make_key.
+/// @param  solver_id   Identifies the solver options that are not included
+///                     automatically. The name of the solver is always
+///                     included. For the default configuration, the
+///                     parameters of the ALM solver, of its inner solver and
+///                     of the inner solver's direction are included as well,
+///                     as long as they are parameter structs provided by
+///                     alpaqa. Other options (e.g. of custom directions or
+///                     accelerators) should be added to this string.
+/// @ingroup grp_ALMSolver
+template <class ALMSolverT>
+typename ALMSolverT::Stats
+solve_cached(ResultCache<typename ALMSolverT::config_t> &cache,
+             ALMSolverT &solver, const typename ALMSolverT::Problem &problem,
+             typename ALMSolverT::rvec x, typename ALMSolverT::rvec y,
+             std::optional<typename ALMSolverT::rvec> Σ = std::nullopt,
+             std::string_view problem_id = {},
+             std::string_view solver_id  = {}) {
+    using config_t = typename ALMSolverT::config_t;
+    using index_t  = typename config_t::index_t;
+    using Stats    = typename ALMSolverT::Stats;
+    auto t0        = std::chrono::steady_clock::now();
+    auto key_hash  = ResultCache<config_t>::make_key(problem, problem_id,
+                                                     solver_id, x, y);
+    key_hash.add(solver.get_name());
+    key_hash.add(Σ.has_value());
+    if (Σ)
+        key_hash.add(*Σ);
+    if constexpr (std::is_same_v<config_t, DefaultConfig>)
+        detail::add_solver_params_to_key(key_hash, solver);
+    auto key = key_hash.str();
+    if (auto r = cache.lookup(key)) {
+        Stats s;
+        x = r->x;
+        y = r->y;
+        if (Σ && r->Σ.size() == Σ->size())
+            *Σ = r->Σ;
+        for (int i = 0; i <= static_cast<int>(SolverStatus::Exception); ++i)
+            if (auto st = static_cast<SolverStatus>(i);
+                r->status == enum_name(st))
+                s.status = st;
+        s.ε                = r->ε;
+        s.δ                = r->δ;
+        s.norm_penalty     = r->norm_penalty;
+        s.outer_iterations = static_cast<unsigned>(r->outer_iterations);
+        if constexpr (requires { s.inner.iterations; })
+            s.inner.iterations = static_cast<unsigned>(r->inner_iterations);
+        s.elapsed_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0);
+        return s;
+    }
+    vec<config_t> Σ_out;
+    if (Σ)
+        Σ_out = *Σ;
+    else
+        Σ_out.setConstant(problem.get_m(), NaN<config_t>);
+    auto s = solver(problem, x, y, Σ_out);
+    if (Σ)
+        *Σ = Σ_out;
+    if (s.status == SolverStatus::Interrupted)
+        return s;
+    CachedResult<config_t> r{
+        .solver           = solver.get_name(),
+        .status           = enum_name(s.status),
+        .success          = s.status == SolverStatus::Converged,
+        .ε                = s.ε,
+        .δ                = s.δ,
+        .norm_penalty     = s.norm_penalty,
+        .outer_iterations = static_cast<index_t>(s.outer_iterations),
+        .elapsed_time     = s.elapsed_time,
+        .x                = x,
+        .y                = y,
+        .Σ                = std::move(Σ_out),
+    };
+    if constexpr (requires { s.inner.iterations; })
+        r.inner_iterations = static_cast<index_t>(s.inner.iterations);
+    if constexpr (requires { s.inner.final_h; })
+        r.h = s.inner.final_h;
+    if constexpr (requires { s.inner.final_γ; })
+        r.γ = s.inner.final_γ;
+    cache.store(key, std::move(r));
+    return s;
+}
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ResultCache, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ResultCache, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ResultCache, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ResultCache, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
@@ -14,6 +14,26 @@ ENUM_TABLE(LBFGSStepSize,                        //
            ENUM_MEMBER(BasedOnCurvature),        //
 );
 
+ENUM_TABLE(SteihaugCGPreconditioner,         //
+           ENUM_MEMBER(None),                //
+           ENUM_MEMBER(HessianDiagonal),     //
+           ENUM_MEMBER(JacobianColumnNorms), //
+           ENUM_MEMBER(LBFGS),               //
+           ENUM_MEMBER(Custom),              //
+);
+
+ENUM_TABLE(StructuredNewtonRegularization,  //
+           ENUM_MEMBER(EigenvalueClipping), //
+           ENUM_MEMBER(ShiftedCholesky),    //
+           ENUM_MEMBER(ModifiedLDLT),       //
+);
+
+ENUM_TABLE(ProblemScaling,         //
+           ENUM_MEMBER(None),     //
+           ENUM_MEMBER(Gradient), //
+           ENUM_MEMBER(Ruiz),     //
+);
+
 PARAMS_TABLE(LBFGSParams<config_t>,            //
              PARAMS_MEMBER(memory, ""),        //
              PARAMS_MEMBER(min_div_fac, ""),   //
@@ -23,6 +43,12 @@ PARAMS_TABLE(LBFGSParams<config_t>,            //
              PARAMS_MEMBER(stepsize, ""),      //
 );
 
+PARAMS_TABLE(LSR1Params<config_t>,         //
+             PARAMS_MEMBER(memory, ""),    //
+             PARAMS_MEMBER(min_abs_s, ""), //
+             PARAMS_MEMBER(min_rcond, ""), //
+);
+
 PARAMS_TABLE(AndersonAccelParams<config_t>,  //
              PARAMS_MEMBER(memory, ""),      //
              PARAMS_MEMBER(min_div_fac, ""), //
@@ -153,14 +179,22 @@ PARAMS_TABLE(NewtonTRDirectionParams<config_t>,       //
              PARAMS_MEMBER(finite_diff_stepsize, ""), //
 );
 
-PARAMS_TABLE(SteihaugCGParams<config_t>,         //
-             PARAMS_MEMBER(tol_scale, ""),       //
-             PARAMS_MEMBER(tol_scale_root, ""),  //
-             PARAMS_MEMBER(tol_max, ""),         //
-             PARAMS_MEMBER(max_iter_factor, ""), //
+PARAMS_TABLE(LSR1TRDirectionParams<config_t>,     //
+             PARAMS_MEMBER(hessian_vec_factor, ""), //
+);
+
+PARAMS_TABLE(SteihaugCGParams<config_t>,          //
+             PARAMS_MEMBER(tol_scale, ""),        //
+             PARAMS_MEMBER(tol_scale_root, ""),   //
+             PARAMS_MEMBER(tol_max, ""),          //
+             PARAMS_MEMBER(max_iter_factor, ""),  //
+             PARAMS_MEMBER(preconditioner, ""),   //
+             PARAMS_MEMBER(precond_min_diag, ""), //
+             PARAMS_MEMBER(precond_memory, ""),   //
 );
 
 PARAMS_TABLE(StructuredNewtonRegularizationParams<config_t>, //
+             PARAMS_MEMBER(method, ""),                      //
              PARAMS_MEMBER(min_eig, ""),                     //
              PARAMS_MEMBER(print_eig, ""),                   //
 );
@@ -175,9 +209,12 @@ PARAMS_TABLE(ConvexNewtonRegularizationParams<config_t>, //
              PARAMS_MEMBER(ldlt, ""),                    //
 );
 
-PARAMS_TABLE(ConvexNewtonDirectionParams<config_t>, //
-             PARAMS_MEMBER(hessian_vec_factor, ""), //
-             PARAMS_MEMBER(quadratic, ""),          //
+PARAMS_TABLE(ConvexNewtonDirectionParams<config_t>,       //
+             PARAMS_MEMBER(hessian_vec_factor, ""),       //
+             PARAMS_MEMBER(quadratic, ""),                //
+             PARAMS_MEMBER(update_factorization, ""),     //
+             PARAMS_MEMBER(max_update_fraction, ""),      //
+             PARAMS_MEMBER(regularization_tolerance, ""), //
 );
 
 PARAMS_TABLE(ALMParams<config_t>,                               //
@@ -197,6 +234,73 @@ PARAMS_TABLE(ALMParams<config_t>,                               //
              PARAMS_MEMBER(print_interval, ""),                 //
              PARAMS_MEMBER(print_precision, ""),                //
              PARAMS_MEMBER(single_penalty_factor, ""),          //
+             PARAMS_MEMBER(anderson_memory, ""),                //
+);
+
+PARAMS_TABLE(ResultCacheParams,                     //
+             PARAMS_MEMBER(max_memory_entries, ""), //
+             PARAMS_MEMBER(directory, ""),          //
+             PARAMS_MEMBER(max_disk_size, ""),      //
+);
+
+PARAMS_TABLE(PresolveParams<config_t>,                  //
+             PARAMS_MEMBER(fixed_variables, ""),          //
+             PARAMS_MEMBER(h_is_box_indicator, ""),       //
+             PARAMS_MEMBER(free_constraints, ""),         //
+             PARAMS_MEMBER(singleton_constraints, ""),    //
+             PARAMS_MEMBER(assume_linear_singletons, ""), //
+             PARAMS_MEMBER(linearity_tolerance, ""),      //
+);
+
+PARAMS_TABLE(synthetic::ChainOCPParams, //
+             PARAMS_MEMBER(N, ""),      //
+             PARAMS_MEMBER(nx, ""),     //
+             PARAMS_MEMBER(nu, ""),     //
+             PARAMS_MEMBER(Ts, ""),     //
+             PARAMS_MEMBER(k, ""),      //
+             PARAMS_MEMBER(k3, ""),     //
+             PARAMS_MEMBER(c, ""),      //
+             PARAMS_MEMBER(q, ""),      //
+             PARAMS_MEMBER(r, ""),      //
+             PARAMS_MEMBER(q_N, ""),    //
+             PARAMS_MEMBER(u_max, ""),  //
+             PARAMS_MEMBER(x_init, ""), //
+);
+
+PARAMS_TABLE(synthetic::LogisticRegressionParams, //
+             PARAMS_MEMBER(samples, ""),          //
+             PARAMS_MEMBER(features, ""),         //
+             PARAMS_MEMBER(density, ""),          //
+             PARAMS_MEMBER(support, ""),          //
+             PARAMS_MEMBER(noise, ""),            //
+             PARAMS_MEMBER(λ_factor, ""),         //
+             PARAMS_MEMBER(seed, ""),             //
+);
+
+PARAMS_TABLE(synthetic::RandomQPParams,    //
+             PARAMS_MEMBER(n, ""),           //
+             PARAMS_MEMBER(m, ""),           //
+             PARAMS_MEMBER(density, ""),     //
+             PARAMS_MEMBER(reg, ""),         //
+             PARAMS_MEMBER(eq_fraction, ""), //
+             PARAMS_MEMBER(seed, ""),        //
+);
+
+PARAMS_TABLE(synthetic::ChainedRosenbrockParams, //
+             PARAMS_MEMBER(n, ""),               //
+             PARAMS_MEMBER(a, ""),               //
+             PARAMS_MEMBER(lb, ""),              //
+             PARAMS_MEMBER(ub, ""),              //
+);
+
+PARAMS_TABLE(ProblemScalingParams<config_t>,        //
+             PARAMS_MEMBER(method, ""),             //
+             PARAMS_MEMBER(max_gradient, ""),       //
+             PARAMS_MEMBER(ruiz_max_iter, ""),      //
+             PARAMS_MEMBER(ruiz_tolerance, ""),     //
+             PARAMS_MEMBER(min_scaling, ""),        //
+             PARAMS_MEMBER(max_scaling, ""),        //
+             PARAMS_MEMBER(h_is_box_indicator, ""), //
 );
 
 #if ALPAQA_WITH_OCP
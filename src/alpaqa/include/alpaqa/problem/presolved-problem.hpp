@@ -0,0 +1,283 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+
+#include <string>
+
+namespace alpaqa {
+
+/// Parameters for the @ref PresolvedProblem class.
+/// @ingroup grp_Parameters
+template <Config Conf = DefaultConfig>
+struct PresolveParams {
+    USING_ALPAQA_CONFIG(Conf);
+
+    /// Eliminate the variables with equal lower and upper bounds.
+    bool fixed_variables = true;
+    /// Whether the nonsmooth term @f$ h @f$ is the indicator of the box
+    /// @f$ C @f$. If set, the proximal gradient step of the reduced problem is
+    /// the projection onto the reduced box. Otherwise, the proximal operator
+    /// of the original problem is used, with the fixed variables at their
+    /// values. Required for @ref singleton_constraints.
+    bool h_is_box_indicator = false;
+    /// Remove the general constraints with infinite lower and upper bounds,
+    /// and constraints that only depend on fixed variables and that are
+    /// satisfied.
+    bool free_constraints = true;
+    /// Convert constraints that depend linearly on a single variable into
+    /// bounds on that variable. A constraint is only considered linear if the
+    /// Hessian of the constraint (evaluated using @ref
+    /// TypeErasedProblem::eval_hess_L with a unit multiplier) is zero, or if
+    /// @ref assume_linear_singletons is set. The coefficients are determined
+    /// by evaluating the constraint and its gradient in two points in
+    /// @f$ C @f$. Requires @ref h_is_box_indicator.
+    bool singleton_constraints = false;
+    /// Treat all constraints that depend on a single variable as linear,
+    /// without checking their Hessians. This is required for problems that do
+    /// not provide @ref TypeErasedProblem::eval_hess_L.
+    bool assume_linear_singletons = false;
+    /// Relative tolerance for the numerical consistency test of the
+    /// coefficients of singleton constraints.
+    real_t linearity_tolerance = real_t(1e-12);
+};
+
+/// Statistics about the reductions performed by a @ref PresolvedProblem.
+template <Config Conf = DefaultConfig>
+struct PresolveStats {
+    USING_ALPAQA_CONFIG(Conf);
+    /// Number of variables that were eliminated.
+    length_t fixed_variables = 0;
+    /// Number of constraints with infinite bounds that were removed.
+    length_t free_constraints = 0;
+    /// Number of constant constraints that were removed.
+    length_t redundant_constraints = 0;
+    /// Number of constraints that were converted into bounds.
+    length_t singleton_constraints = 0;
+};
+
+/// Problem wrapper that eliminates fixed variables and redundant constraints.
+///
+/// The reduced problem has the same objective and constraint functions as the
+/// original problem, but the fixed variables (@f$ \underline x_i =
+/// \overline x_i @f$) are substituted by their values, and the general
+/// constraints with infinite bounds are removed. General constraints of the
+/// form @f$ a x_j + b @f$ are converted into bounds on @f$ x_j @f$.
+/// Use @ref expand_variables, @ref expand_multipliers and
+/// @ref expand_bound_multipliers to map the solution of the reduced problem
+/// back to the original problem.
+///
+/// If @ref PresolveParams::h_is_box_indicator is set, the proximal gradient
+/// step of the reduced problem is the projection onto the reduced box
+/// @f$ C @f$. Otherwise, the proximal operator of the original problem is
+/// evaluated in the full variables, where the fixed variables keep their values
+/// because @f$ h @f$ includes the indicator of @f$ C @f$. The projections onto
+/// @f$ D @f$ and of the multipliers are always delegated to the original
+/// problem, so options such as @ref BoxConstrProblem::penalty_alm_split carry
+/// over to the reduced problem.
+///
+/// The augmented Lagrangian @f$ \psi @f$ of the reduced problem is evaluated by
+/// the original problem, with zero multipliers and unit penalty factors for
+/// the constraints that were removed. Their contributions vanish inside of the
+/// reduced box @f$ C @f$.
+/// @note   The presolved problem keeps some mutable work vectors, so it is not
+///         safe to evaluate the same instance from multiple threads.
+/// @ingroup grp_Problems
+template <Config Conf = DefaultConfig>
+class PresolvedProblem {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+    using Problem  = TypeErasedProblem<config_t>;
+    using Params   = PresolveParams<config_t>;
+    using Stats    = PresolveStats<config_t>;
+    using Box      = alpaqa::Box<config_t>;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+
+    /// Analyze the given problem and build the reduced problem.
+    /// @param  problem
+    ///         The problem to reduce. To avoid making a copy, pass a pointer to
+    ///         the problem, e.g. `Problem{&original}`.
+    /// @param  x0
+    ///         Point in which the singleton constraints are evaluated to
+    ///         determine their coefficients (it is projected onto @f$ C @f$
+    ///         first).
+    /// @param  params
+    ///         Parameters that select which reductions are performed.
+    PresolvedProblem(Problem problem, crvec x0, Params params = {});
+
+    /// @name Conversion between the reduced and the original problem
+    /// @{
+
+    /// Select the free variables.
+    void reduce_variables(crvec x, rvec x_red) const;
+    /// Insert the values of the fixed variables.
+    void expand_variables(crvec x_red, rvec x) const;
+    /// Select the multipliers of the remaining constraints.
+    void reduce_multipliers(crvec y, rvec y_red) const;
+    /// Select the multipliers of the bound constraints of the free variables.
+    void reduce_bound_multipliers(crvec w, rvec w_red) const;
+    /// Compute the multipliers of the original constraints. The multipliers of
+    /// the singleton constraints are recovered from the stationarity
+    /// condition, the other removed constraints have zero multipliers.
+    /// @param  x       Solution of the original problem (see
+    ///                 @ref expand_variables).
+    /// @param  y_red   Multipliers of the reduced problem.
+    /// @param  y       [out] Multipliers of the original problem.
+    void expand_multipliers(crvec x, crvec y_red, rvec y) const;
+    /// Compute the multipliers of the bound constraints of the original
+    /// problem. The multipliers of the fixed variables are recovered from the
+    /// stationarity condition.
+    /// @param  x       Solution of the original problem.
+    /// @param  y       Multipliers of the original problem.
+    /// @param  w_red   Multipliers of the bound constraints of the reduced
+    ///                 problem.
+    /// @param  w       [out] Multipliers of the bound constraints of the
+    ///                 original problem.
+    void expand_bound_multipliers(crvec x, crvec y, crvec w_red, rvec w) const;
+
+    /// Indices of the variables of the original problem that are kept.
+    [[nodiscard]] crindexvec get_free_variables() const { return free_vars; }
+    /// Indices of the constraints of the original problem that are kept.
+    [[nodiscard]] crindexvec get_kept_constraints() const { return kept_constr; }
+    /// Number of eliminated variables and removed constraints.
+    [[nodiscard]] const Stats &get_stats() const { return stats; }
+    /// Whether the reduced problem differs from the original one.
+    [[nodiscard]] bool is_reduced() const { return reduce_x || reduce_g || tightened_C; }
+
+    /// @}
+
+    /// @name Problem functions
+    /// @{
+
+    [[nodiscard]] length_t get_n() const { return free_vars.size(); }
+    [[nodiscard]] length_t get_m() const { return kept_constr.size(); }
+
+    void eval_proj_diff_g(crvec z, rvec e) const;
+    void eval_proj_multipliers(rvec y, real_t M) const;
+    real_t eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂, rvec p) const;
+    index_t eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ, rindexvec J) const;
+    real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_grad_gi(crvec x, index_t i, rvec grad_gi) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const;
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v, rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const;
+    void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v, rvec Hv) const;
+    void eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_ψ_sparsity() const;
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_g(crvec x, rvec g) const;
+    void eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f, rvec grad_gxy) const;
+    void eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const;
+    real_t eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const;
+    void eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const;
+    real_t eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                         rvec work_m) const;
+    const Box &get_box_C() const { return reduced_boxes.C; }
+    const Box &get_box_D() const { return reduced_boxes.D; }
+    void check() const { problem.check(); }
+    [[nodiscard]] std::string get_name() const {
+        return "PresolvedProblem<" + problem.get_name() + ">";
+    }
+
+    /// @}
+
+    /// @name Querying specialized implementations
+    /// @{
+
+    // clang-format off
+    [[nodiscard]] bool provides_eval_inactive_indices_res_lna() const { return box_prox() || problem.provides_eval_inactive_indices_res_lna(); }
+    [[nodiscard]] bool provides_eval_jac_g() const { return problem.provides_eval_jac_g(); }
+    [[nodiscard]] bool provides_get_jac_g_sparsity() const { return problem.provides_get_jac_g_sparsity(); }
+    [[nodiscard]] bool provides_eval_grad_gi() const { return problem.provides_eval_grad_gi(); }
+    [[nodiscard]] bool provides_eval_hess_L_prod() const { return problem.provides_eval_hess_L_prod(); }
+    [[nodiscard]] bool provides_eval_hess_L() const { return problem.provides_eval_hess_L(); }
+    [[nodiscard]] bool provides_get_hess_L_sparsity() const { return problem.provides_get_hess_L_sparsity(); }
+    [[nodiscard]] bool provides_eval_hess_ψ_prod() const { return problem.provides_eval_hess_ψ_prod(); }
+    [[nodiscard]] bool provides_eval_hess_ψ() const { return problem.provides_eval_hess_ψ(); }
+    [[nodiscard]] bool provides_get_hess_ψ_sparsity() const { return problem.provides_get_hess_ψ_sparsity(); }
+    [[nodiscard]] bool provides_eval_f_grad_f() const { return problem.provides_eval_f_grad_f(); }
+    [[nodiscard]] bool provides_eval_f_g() const { return problem.provides_eval_f_g(); }
+    [[nodiscard]] bool provides_eval_grad_f_grad_g_prod() const { return problem.provides_eval_grad_f_grad_g_prod(); }
+    [[nodiscard]] bool provides_eval_grad_L() const { return problem.provides_eval_grad_L(); }
+    [[nodiscard]] bool provides_eval_ψ() const { return problem.provides_eval_ψ(); }
+    [[nodiscard]] bool provides_eval_grad_ψ() const { return problem.provides_eval_grad_ψ(); }
+    [[nodiscard]] bool provides_eval_ψ_grad_ψ() const { return problem.provides_eval_ψ_grad_ψ(); }
+    [[nodiscard]] bool provides_get_box_C() const { return problem.provides_get_box_C(); }
+    [[nodiscard]] bool provides_get_box_D() const { return problem.provides_get_box_D(); }
+    // clang-format on
+
+    /// @}
+
+  public:
+    /// The original problem.
+    Problem problem;
+
+  private:
+    /// Selection of the nonzero elements of a sparse matrix.
+    struct ReducedMatrix {
+        indexvec rows, cols; ///< Indices in the reduced matrix.
+        indexvec indices;    ///< Indices into the values of the original matrix.
+        sparsity::Symmetry symmetry = sparsity::Symmetry::Unsymmetric;
+        length_t nrows = 0, ncols = 0;
+        mutable vec values;  ///< Values of the original matrix.
+        [[nodiscard]] Sparsity get_sparsity() const;
+    };
+
+    /// Whether the proximal operator of the reduced problem is the projection
+    /// onto the reduced box.
+    [[nodiscard]] bool box_prox() const {
+        return h_is_box_indicator && (reduce_x || tightened_C);
+    }
+    /// Expand the reduced variables into the work vector.
+    crvec expanded_x(crvec x_red) const;
+    /// Expand the multipliers and penalty factors into the work vectors.
+    void expand_y_Σ(crvec y_red, crvec Σ_red) const;
+    /// Compute the selection of the elements of a sparse matrix.
+    void reduce_matrix(const Sparsity &sp, crindexvec row_map, crindexvec col_map,
+                       ReducedMatrix &mat) const;
+    /// Find singleton constraints and convert them into bounds.
+    void convert_singleton_constraints(crvec x0, Box &C, const Box &D, crindexvec col_map,
+                                       rindexvec row_map, const Params &params);
+
+  private:
+    Stats stats;
+    bool reduce_x = false, reduce_g = false, tightened_C = false;
+    bool h_is_box_indicator = false;
+    /// Indices of the free variables and the kept constraints.
+    indexvec free_vars, kept_constr;
+    /// Index of each original variable in the reduced problem (or -1).
+    indexvec reduced_var;
+    /// Singleton constraints: constraint index, variable index, coefficient.
+    indexvec singleton_constr, singleton_var;
+    vec singleton_coef;
+    /// For each variable, the singleton constraint that determines its lower
+    /// and upper bound (or -1).
+    indexvec singleton_lb, singleton_ub;
+    /// Values of the fixed variables (and work vector for the full x).
+    mutable vec work_x;
+    mutable vec work_v, work_p, work_grad, work_y, work_Σ, work_g;
+    mutable indexvec work_J;
+    /// Reduced boxes C and D (also used for the projection if @ref box_prox).
+    BoxConstrProblem<config_t> reduced_boxes{0, 0};
+    ReducedMatrix jac_g, hess_L, hess_ψ;
+};
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, PresolveParams, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, PresolveParams, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, PresolveParams, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, PresolveParams, EigenConfigq);)
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PresolvedProblem, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PresolvedProblem, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PresolvedProblem, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, PresolvedProblem, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
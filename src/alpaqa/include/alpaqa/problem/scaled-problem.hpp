@@ -0,0 +1,250 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace alpaqa {
+
+/// Methods for computing the scaling factors of a @ref ScaledProblem.
+/// @ingroup grp_Problems
+enum class ProblemScaling {
+    /// No scaling.
+    None,
+    /// Scale the objective and each constraint such that the infinity norm of
+    /// their gradients in the initial guess does not exceed
+    /// @ref ProblemScalingParams::max_gradient (similar to Ipopt's
+    /// gradient-based NLP scaling). The variables are not scaled.
+    Gradient,
+    /// Ruiz equilibration of the constraint Jacobian in the initial guess,
+    /// which scales both the variables and the constraints, followed by
+    /// gradient-based scaling of the objective and constraints.
+    /// The variables are only scaled if
+    /// @ref ProblemScalingParams::h_is_box_indicator is set, otherwise only
+    /// the rows of the Jacobian are equilibrated.
+    Ruiz,
+};
+
+inline constexpr const char *enum_name(ProblemScaling s) {
+    switch (s) {
+        case ProblemScaling::None: return "None";
+        case ProblemScaling::Gradient: return "Gradient";
+        case ProblemScaling::Ruiz: return "Ruiz";
+        default:;
+    }
+    throw std::out_of_range("invalid value for alpaqa::ProblemScaling");
+}
+
+/// Parameters for the @ref ScaledProblem class.
+/// @ingroup grp_Parameters
+template <Config Conf = DefaultConfig>
+struct ProblemScalingParams {
+    USING_ALPAQA_CONFIG(Conf);
+
+    /// Method used to compute the scaling factors.
+    ProblemScaling method = ProblemScaling::Gradient;
+    /// Maximum infinity norm of the gradients of the objective and constraints
+    /// in the initial guess after scaling.
+    real_t max_gradient = 100;
+    /// Maximum number of Ruiz equilibration iterations.
+    unsigned ruiz_max_iter = 10;
+    /// Stop the Ruiz equilibration once the infinity norms of all nonzero rows
+    /// and columns of the scaled Jacobian are within this distance from one.
+    real_t ruiz_tolerance = real_t(1e-2);
+    /// Lower bound on the scaling factors.
+    real_t min_scaling = real_t(1e-8);
+    /// Upper bound on the scaling factors.
+    real_t max_scaling = real_t(1e8);
+    /// The nonsmooth term @f$ h @f$ of the problem is the indicator of the box
+    /// @f$ C @f$. Scaling the variables is only possible in that case, because
+    /// the proximal operator of a general @f$ h @f$ cannot be evaluated in the
+    /// scaled variables. This cannot be detected automatically, so it is off
+    /// by default.
+    bool h_is_box_indicator = false;
+};
+
+/// Problem wrapper that applies diagonal scaling to the variables, the
+/// objective and the constraints of the given problem:
+/// @f[ \begin{aligned}
+///     & \minimize_{\tilde x} && \sigma_f f(D_x \tilde x)
+///        + \sigma_f h(D_x \tilde x)
+///     \\ & \subjto && D_g\, g(D_x \tilde x) \in D_g D.
+/// \end{aligned} @f]
+/// The scaling factors are computed once, in the constructor, using the
+/// method selected by @ref ProblemScalingParams::method. All evaluations,
+/// the boxes @f$ C @f$ and @f$ D @f$, and the proximal gradient step are
+/// transformed transparently. Use @ref scale_variables and
+/// @ref unscale_variables (and the related functions for the multipliers) to
+/// convert the initial guess and the solution between both spaces.
+///
+/// The Lagrange multipliers of the scaled problem are related to those of the
+/// original problem by @f$ \tilde y = \sigma_f D_g^{-1} y @f$.
+/// @note   The scaled problem keeps some mutable work vectors, so it is not
+///         safe to evaluate the same instance from multiple threads.
+/// @ingroup grp_Problems
+template <Config Conf = DefaultConfig>
+class ScaledProblem {
+  public:
+    USING_ALPAQA_CONFIG(Conf);
+    using Problem  = TypeErasedProblem<config_t>;
+    using Params   = ProblemScalingParams<config_t>;
+    using Box      = alpaqa::Box<config_t>;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+
+    /// Compute the scaling factors for the given problem in the point @p x0.
+    /// @param  problem
+    ///         The problem to scale. To avoid making a copy, pass a pointer to
+    ///         the problem, e.g. `Problem{&original}`.
+    /// @param  x0
+    ///         The initial guess (unscaled) in which the gradients and
+    ///         Jacobians are evaluated.
+    /// @param  params
+    ///         Parameters that determine how the scaling factors are computed.
+    ScaledProblem(Problem problem, crvec x0, Params params = {});
+
+    /// @name Conversion between the scaled and the original problem
+    /// @{
+
+    /// @f$ \tilde x = D_x^{-1} x @f$
+    void scale_variables(crvec x, rvec x̃) const { x̃ = x.cwiseQuotient(variable_scaling); }
+    /// @f$ x = D_x \tilde x @f$
+    void unscale_variables(crvec x̃, rvec x) const { x = x̃.cwiseProduct(variable_scaling); }
+    /// @f$ \tilde y = \sigma_f D_g^{-1} y @f$
+    void scale_multipliers(crvec y, rvec ỹ) const {
+        ỹ = objective_scaling * y.cwiseQuotient(constraint_scaling);
+    }
+    /// @f$ y = \sigma_f^{-1} D_g \tilde y @f$
+    void unscale_multipliers(crvec ỹ, rvec y) const {
+        y = ỹ.cwiseProduct(constraint_scaling) / objective_scaling;
+    }
+    /// Multipliers of the box constraints, @f$ \tilde w = \sigma_f D_x w @f$.
+    void scale_bound_multipliers(crvec w, rvec w̃) const {
+        w̃ = objective_scaling * w.cwiseProduct(variable_scaling);
+    }
+    /// Multipliers of the box constraints, @f$ w = \sigma_f^{-1} D_x^{-1} \tilde w @f$.
+    void unscale_bound_multipliers(crvec w̃, rvec w) const {
+        w = w̃.cwiseQuotient(variable_scaling) / objective_scaling;
+    }
+    /// ALM penalty factors, @f$ \Sigma = \sigma_f^{-1} D_g^2 \tilde \Sigma @f$.
+    void unscale_penalties(crvec Σ̃, rvec Σ) const {
+        Σ = Σ̃.cwiseProduct(constraint_scaling.cwiseAbs2()) / objective_scaling;
+    }
+
+    /// Diagonal of @f$ D_x @f$.
+    [[nodiscard]] crvec get_variable_scaling() const { return variable_scaling; }
+    /// Diagonal of @f$ D_g @f$.
+    [[nodiscard]] crvec get_constraint_scaling() const { return constraint_scaling; }
+    /// @f$ \sigma_f @f$.
+    [[nodiscard]] real_t get_objective_scaling() const { return objective_scaling; }
+    /// Whether the variables are scaled, i.e. @f$ D_x \neq I @f$.
+    [[nodiscard]] bool scales_variables() const { return scale_x; }
+
+    /// @}
+
+    /// @name Problem functions
+    /// @{
+
+    [[nodiscard]] length_t get_n() const { return problem.get_n(); }
+    [[nodiscard]] length_t get_m() const { return problem.get_m(); }
+
+    void eval_proj_diff_g(crvec z, rvec e) const;
+    void eval_proj_multipliers(rvec y, real_t M) const;
+    real_t eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂, rvec p) const;
+    index_t eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ, rindexvec J) const;
+    real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_grad_gi(crvec x, index_t i, rvec grad_gi) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const { return problem.get_jac_g_sparsity(); }
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v, rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const { return problem.get_hess_L_sparsity(); }
+    void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v, rvec Hv) const;
+    void eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_ψ_sparsity() const { return problem.get_hess_ψ_sparsity(); }
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_g(crvec x, rvec g) const;
+    void eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f, rvec grad_gxy) const;
+    void eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const;
+    real_t eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const;
+    void eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const;
+    real_t eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n,
+                         rvec work_m) const;
+    const Box &get_box_C() const { return scaled_boxes.C; }
+    const Box &get_box_D() const { return scaled_boxes.D; }
+    void check() const { problem.check(); }
+    [[nodiscard]] std::string get_name() const {
+        return "ScaledProblem<" + problem.get_name() + ">";
+    }
+
+    /// @}
+
+    /// @name Querying specialized implementations
+    /// @{
+
+    // clang-format off
+    [[nodiscard]] bool provides_eval_inactive_indices_res_lna() const { return scale_x || problem.provides_eval_inactive_indices_res_lna(); }
+    [[nodiscard]] bool provides_eval_jac_g() const { return problem.provides_eval_jac_g(); }
+    [[nodiscard]] bool provides_get_jac_g_sparsity() const { return problem.provides_get_jac_g_sparsity(); }
+    [[nodiscard]] bool provides_eval_grad_gi() const { return problem.provides_eval_grad_gi(); }
+    [[nodiscard]] bool provides_eval_hess_L_prod() const { return problem.provides_eval_hess_L_prod(); }
+    [[nodiscard]] bool provides_eval_hess_L() const { return problem.provides_eval_hess_L(); }
+    [[nodiscard]] bool provides_get_hess_L_sparsity() const { return problem.provides_get_hess_L_sparsity(); }
+    [[nodiscard]] bool provides_eval_hess_ψ_prod() const { return problem.provides_eval_hess_ψ_prod(); }
+    [[nodiscard]] bool provides_eval_hess_ψ() const { return problem.provides_eval_hess_ψ(); }
+    [[nodiscard]] bool provides_get_hess_ψ_sparsity() const { return problem.provides_get_hess_ψ_sparsity(); }
+    [[nodiscard]] bool provides_eval_f_grad_f() const { return problem.provides_eval_f_grad_f(); }
+    [[nodiscard]] bool provides_eval_f_g() const { return problem.provides_eval_f_g(); }
+    [[nodiscard]] bool provides_eval_grad_f_grad_g_prod() const { return problem.provides_eval_grad_f_grad_g_prod(); }
+    [[nodiscard]] bool provides_eval_grad_L() const { return problem.provides_eval_grad_L(); }
+    [[nodiscard]] bool provides_eval_ψ() const { return problem.provides_eval_ψ(); }
+    [[nodiscard]] bool provides_eval_grad_ψ() const { return problem.provides_eval_grad_ψ(); }
+    [[nodiscard]] bool provides_eval_ψ_grad_ψ() const { return problem.provides_eval_ψ_grad_ψ(); }
+    [[nodiscard]] bool provides_get_box_C() const { return problem.provides_get_box_C(); }
+    [[nodiscard]] bool provides_get_box_D() const { return problem.provides_get_box_D(); }
+    // clang-format on
+
+    /// @}
+
+  public:
+    /// The original (unscaled) problem.
+    Problem problem;
+
+  private:
+    /// Evaluate the original problem in @f$ D_x \tilde x @f$.
+    crvec unscaled_x(crvec x̃) const;
+    /// Convert the multipliers and penalty factors of the augmented Lagrangian
+    /// to the original problem.
+    void unscale_y_Σ(crvec ỹ, crvec Σ̃) const;
+    /// Compute the scaling factors.
+    void compute_scaling(crvec x0, const Params &params);
+
+  private:
+    vec variable_scaling, constraint_scaling;
+    real_t objective_scaling = 1;
+    bool scale_x             = false;
+    /// Scaled boxes C and D (also used for the projections if @ref scale_x).
+    BoxConstrProblem<config_t> scaled_boxes{0, 0};
+    /// Scaling factors for the nonzero elements of the sparse matrices.
+    vec jac_g_scaling, hess_L_scaling, hess_ψ_scaling;
+    mutable vec work_x, work_v, work_y, work_Σ;
+};
+
+// clang-format off
+ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, ProblemScalingParams, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, ProblemScalingParams, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, ProblemScalingParams, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(struct, ProblemScalingParams, EigenConfigq);)
+ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ScaledProblem, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ScaledProblem, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ScaledProblem, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_EXTERN_TEMPLATE(class, ScaledProblem, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
@@ -143,6 +143,39 @@ Symmetry get_symmetry(const Sparsity<Conf> &sp) {
     return std::visit([](const auto &s) { return s.symmetry; }, sp.value);
 }
 
+
+/// Get the row and column indices of all structurally nonzero elements of the
+/// given sparsity pattern, in the same order as their values are stored.
+/// Symmetric dense matrices store all elements, so all indices are returned.
+template <Config Conf>
+void get_nonzero_indices(const Sparsity<Conf> &sp, indexvec<Conf> &rows, indexvec<Conf> &cols) {
+    USING_ALPAQA_CONFIG(Conf);
+    auto visitor = detail::overloaded{
+        [&](const Dense<config_t> &d) {
+            rows.resize(d.rows * d.cols);
+            cols.resize(d.rows * d.cols);
+            for (index_t c = 0; c < d.cols; ++c)
+                for (index_t r = 0; r < d.rows; ++r) {
+                    rows(r + c * d.rows) = r;
+                    cols(r + c * d.rows) = c;
+                }
+        },
+        [&]<class I>(const SparseCSC<config_t, I> &csc) {
+            rows = csc.inner_idx.template cast<index_t>();
+            cols.resize(csc.nnz());
+            for (index_t c = 0; c < csc.cols; ++c)
+                for (auto k = csc.outer_ptr(c); k < csc.outer_ptr(c + 1); ++k)
+                    cols(static_cast<index_t>(k)) = c;
+        },
+        [&]<class I>(const SparseCOO<config_t, I> &coo) {
+            auto first = static_cast<index_t>(coo.first_index);
+            rows       = coo.row_indices.template cast<index_t>().array() - first;
+            cols       = coo.col_indices.template cast<index_t>().array() - first;
+        },
+    };
+    std::visit(visitor, sp.value);
+}
+
 } // namespace alpaqa::sparsity
 
 namespace alpaqa {
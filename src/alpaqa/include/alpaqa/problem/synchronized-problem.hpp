@@ -0,0 +1,95 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace alpaqa {
+
+/// @addtogroup grp_Problems
+/// @{
+
+/// Problem wrapper that serializes all evaluations of the given problem using
+/// a mutex, so that the same problem can be used by solvers running in
+/// different threads, even if its evaluations are not thread-safe.
+/// @note   The mutex is stored using a `std::shared_ptr`, which means that
+///         different copies of a @ref SynchronizedProblem instance all share
+///         the same mutex.
+template <Config Conf = DefaultConfig>
+struct SynchronizedProblem {
+    USING_ALPAQA_CONFIG(Conf);
+    using Problem  = TypeErasedProblem<config_t>;
+    using Box      = typename Problem::Box;
+    using Sparsity = sparsity::Sparsity<config_t>;
+
+    /// @param  problem
+    ///         The problem to wrap. To avoid making a copy, pass a pointer to
+    ///         the problem, e.g. `Problem{&original}`.
+    explicit SynchronizedProblem(Problem problem) : problem{std::move(problem)} {}
+
+    // clang-format off
+    void eval_proj_diff_g(crvec z, rvec e) const { std::lock_guard lck{*mtx}; return problem.eval_proj_diff_g(z, e); }
+    void eval_proj_multipliers(rvec y, real_t M) const { std::lock_guard lck{*mtx}; return problem.eval_proj_multipliers(y, M); }
+    real_t eval_prox_grad_step(real_t γ, crvec x, crvec grad_ψ, rvec x̂, rvec p) const { std::lock_guard lck{*mtx}; return problem.eval_prox_grad_step(γ, x, grad_ψ, x̂, p); }
+    index_t eval_inactive_indices_res_lna(real_t γ, crvec x, crvec grad_ψ, rindexvec J) const { std::lock_guard lck{*mtx}; return problem.eval_inactive_indices_res_lna(γ, x, grad_ψ, J); }
+    real_t eval_f(crvec x) const { std::lock_guard lck{*mtx}; return problem.eval_f(x); }
+    void eval_grad_f(crvec x, rvec grad_fx) const { std::lock_guard lck{*mtx}; return problem.eval_grad_f(x, grad_fx); }
+    void eval_g(crvec x, rvec gx) const { std::lock_guard lck{*mtx}; return problem.eval_g(x, gx); }
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const { std::lock_guard lck{*mtx}; return problem.eval_grad_g_prod(x, y, grad_gxy); }
+    void eval_grad_gi(crvec x, index_t i, rvec grad_gi) const { std::lock_guard lck{*mtx}; return problem.eval_grad_gi(x, i, grad_gi); }
+    void eval_jac_g(crvec x, rvec J_values) const { std::lock_guard lck{*mtx}; return problem.eval_jac_g(x, J_values); }
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const { std::lock_guard lck{*mtx}; return problem.get_jac_g_sparsity(); }
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v, rvec Hv) const { std::lock_guard lck{*mtx}; return problem.eval_hess_L_prod(x, y, scale, v, Hv); }
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const { std::lock_guard lck{*mtx}; return problem.eval_hess_L(x, y, scale, H_values); }
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const { std::lock_guard lck{*mtx}; return problem.get_hess_L_sparsity(); }
+    void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v, rvec Hv) const { std::lock_guard lck{*mtx}; return problem.eval_hess_ψ_prod(x, y, Σ, scale, v, Hv); }
+    void eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale, rvec H_values) const { std::lock_guard lck{*mtx}; return problem.eval_hess_ψ(x, y, Σ, scale, H_values); }
+    [[nodiscard]] Sparsity get_hess_ψ_sparsity() const { std::lock_guard lck{*mtx}; return problem.get_hess_ψ_sparsity(); }
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const { std::lock_guard lck{*mtx}; return problem.eval_f_grad_f(x, grad_fx); }
+    real_t eval_f_g(crvec x, rvec g) const { std::lock_guard lck{*mtx}; return problem.eval_f_g(x, g); }
+    void eval_grad_f_grad_g_prod(crvec x, crvec y, rvec grad_f, rvec grad_gxy) const { std::lock_guard lck{*mtx}; return problem.eval_grad_f_grad_g_prod(x, y, grad_f, grad_gxy); }
+    void eval_grad_L(crvec x, crvec y, rvec grad_L, rvec work_n) const { std::lock_guard lck{*mtx}; return problem.eval_grad_L(x, y, grad_L, work_n); }
+    real_t eval_ψ(crvec x, crvec y, crvec Σ, rvec ŷ) const { std::lock_guard lck{*mtx}; return problem.eval_ψ(x, y, Σ, ŷ); }
+    void eval_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const { std::lock_guard lck{*mtx}; return problem.eval_grad_ψ(x, y, Σ, grad_ψ, work_n, work_m); }
+    real_t eval_ψ_grad_ψ(crvec x, crvec y, crvec Σ, rvec grad_ψ, rvec work_n, rvec work_m) const { std::lock_guard lck{*mtx}; return problem.eval_ψ_grad_ψ(x, y, Σ, grad_ψ, work_n, work_m); }
+    const Box &get_box_C() const { return problem.get_box_C(); }
+    const Box &get_box_D() const { return problem.get_box_D(); }
+    void check() const { std::lock_guard lck{*mtx}; return problem.check(); }
+    [[nodiscard]] std::string get_name() const { return problem.get_name(); }
+
+    [[nodiscard]] bool provides_eval_inactive_indices_res_lna() const { return problem.provides_eval_inactive_indices_res_lna(); }
+    [[nodiscard]] bool provides_eval_jac_g() const { return problem.provides_eval_jac_g(); }
+    [[nodiscard]] bool provides_get_jac_g_sparsity() const { return problem.provides_get_jac_g_sparsity(); }
+    [[nodiscard]] bool provides_eval_grad_gi() const { return problem.provides_eval_grad_gi(); }
+    [[nodiscard]] bool provides_eval_hess_L_prod() const { return problem.provides_eval_hess_L_prod(); }
+    [[nodiscard]] bool provides_eval_hess_L() const { return problem.provides_eval_hess_L(); }
+    [[nodiscard]] bool provides_get_hess_L_sparsity() const { return problem.provides_get_hess_L_sparsity(); }
+    [[nodiscard]] bool provides_eval_hess_ψ_prod() const { return problem.provides_eval_hess_ψ_prod(); }
+    [[nodiscard]] bool provides_eval_hess_ψ() const { return problem.provides_eval_hess_ψ(); }
+    [[nodiscard]] bool provides_get_hess_ψ_sparsity() const { return problem.provides_get_hess_ψ_sparsity(); }
+    [[nodiscard]] bool provides_eval_f_grad_f() const { return problem.provides_eval_f_grad_f(); }
+    [[nodiscard]] bool provides_eval_f_g() const { return problem.provides_eval_f_g(); }
+    [[nodiscard]] bool provides_eval_grad_f_grad_g_prod() const { return problem.provides_eval_grad_f_grad_g_prod(); }
+    [[nodiscard]] bool provides_eval_grad_L() const { return problem.provides_eval_grad_L(); }
+    [[nodiscard]] bool provides_eval_ψ() const { return problem.provides_eval_ψ(); }
+    [[nodiscard]] bool provides_eval_grad_ψ() const { return problem.provides_eval_grad_ψ(); }
+    [[nodiscard]] bool provides_eval_ψ_grad_ψ() const { return problem.provides_eval_ψ_grad_ψ(); }
+    [[nodiscard]] bool provides_get_box_C() const { return problem.provides_get_box_C(); }
+    [[nodiscard]] bool provides_get_box_D() const { return problem.provides_get_box_D(); }
+    [[nodiscard]] bool provides_check() const { return problem.provides_check(); }
+    [[nodiscard]] bool provides_get_name() const { return problem.provides_get_name(); }
+    // clang-format on
+
+    [[nodiscard]] length_t get_n() const { return problem.get_n(); }
+    [[nodiscard]] length_t get_m() const { return problem.get_m(); }
+
+    std::shared_ptr<std::mutex> mtx = std::make_shared<std::mutex>();
+    Problem problem;
+};
+
+/// @}
+
+} // namespace alpaqa
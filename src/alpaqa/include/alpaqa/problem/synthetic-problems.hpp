@@ -0,0 +1,388 @@
+#pragma once
+
+#include <alpaqa/config/config.hpp>
+#include <alpaqa/export.hpp>
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <alpaqa/problem/sparsity.hpp>
+
+#include <Eigen/SparseCore>
+
+#include <cstdint>
+#include <string>
+
+/// Problems of tunable size for testing and benchmarking the solvers.
+///
+/// All problems provide the first and second-order derivatives (Jacobians,
+/// Hessians and Hessian-vector products of the Lagrangian and the augmented
+/// Lagrangian), together with their sparsity patterns, so they can be used
+/// with every solver. The random data is generated from a given seed, so the
+/// same parameters result in the same problem (for a given implementation of
+/// the standard library).
+///
+/// @note   The problems use internal work vectors, so a single instance cannot
+///         be evaluated concurrently from multiple threads. Copies can.
+namespace alpaqa::synthetic {
+
+/// Sparsity pattern of a matrix, stored as a compressed sparse column matrix
+/// with sorted row indices.
+struct ALPAQA_EXPORT SparsePattern {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using storage_index_t = int;
+    using spmat    = Eigen::SparseMatrix<real_t, Eigen::ColMajor, storage_index_t>;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+
+    /// Structure of the matrix (the values are not used).
+    spmat pattern;
+    /// Upper for the Hessians (only the upper triangle is stored).
+    sparsity::Symmetry symmetry = sparsity::Symmetry::Unsymmetric;
+
+    /// Number of structurally nonzero elements.
+    [[nodiscard]] length_t nnz() const { return pattern.nonZeros(); }
+    /// Returns a view of the sparsity pattern.
+    [[nodiscard]] Sparsity sparsity() const;
+    /// Index of the element (r, c) in the array of nonzero values.
+    /// @throws std::out_of_range if the element is not part of the pattern.
+    [[nodiscard]] index_t find(index_t r, index_t c) const;
+    /// Map the given array of nonzero values to a sparse matrix.
+    [[nodiscard]] Eigen::Map<const spmat> map(crvec values) const;
+};
+
+/// Assembles the Hessian of the augmented Lagrangian,
+/// @f$ \nabla^2_{xx} L(x, \hat y) + J_g(x)^\top \Sigma_\mathcal{A} J_g(x) @f$,
+/// where @f$ \Sigma_\mathcal{A} @f$ contains the penalty factors of the
+/// active constraints, from the nonzeros of the Hessian of the Lagrangian and
+/// of the Jacobian of the constraints, without allocations.
+///
+/// The product is computed one column at a time, by scattering the
+/// contributions of the rows of the Jacobian into a dense work vector, so the
+/// memory usage is linear in the number of nonzeros of the result.
+struct ALPAQA_EXPORT AugLagHessian {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using Box = alpaqa::Box<config_t>;
+
+    /// Pattern of the Hessian of the augmented Lagrangian (upper triangle).
+    SparsePattern pattern;
+
+    AugLagHessian() = default;
+    /// Compute the pattern of the Hessian and the index maps.
+    AugLagHessian(const SparsePattern &jac_g, const SparsePattern &hess_L);
+
+    /// Compute @f$ \hat y = \Sigma (\zeta - \Pi_D(\zeta)) @f$ with
+    /// @f$ \zeta = g(x) + \Sigma^{-1} y @f$, and the penalty factors
+    /// @f$ \Sigma_i @f$ of the constraints with @f$ \zeta_i \notin D_i @f$
+    /// (zero for the others).
+    static void eval_ŷ_active(const Box &D, crvec g, crvec y, crvec Σ, rvec ŷ,
+                              rvec Σ_active);
+    /// Assemble the nonzeros of the Hessian of the augmented Lagrangian.
+    void assemble(crvec hess_L_values, crvec jac_g_values, crvec Σ_active,
+                  rvec H_values) const;
+
+  private:
+    using index_vec = Eigen::VectorX<SparsePattern::storage_index_t>;
+    /// The pattern of the Jacobian (compressed sparse column).
+    SparsePattern jac_g;
+    /// Index of the nonzeros of @f$ \nabla^2_{xx} L @f$ in @ref pattern.
+    index_vec from_hess_L;
+    /// Compressed sparse row representation of the Jacobian: the column
+    /// indices of row i are `row_col[row_ptr[i]:row_ptr[i+1]]` (sorted), and
+    /// `row_nz` contains the corresponding indices in the array of nonzeros.
+    index_vec row_ptr, row_col, row_nz;
+    mutable vec work;
+};
+
+/// Parameters for the @ref ChainOCP problem.
+/// @ingroup grp_Parameters
+struct ChainOCPParams {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+
+    /// Horizon length.
+    length_t N = 20;
+    /// Number of states (position and velocity of each mass).
+    length_t nx = 8;
+    /// Number of inputs (forces on the last @p nu masses).
+    length_t nu = 2;
+    /// Sampling time.
+    real_t Ts = real_t(0.1);
+    /// Linear stiffness of the springs.
+    real_t k = 1;
+    /// Cubic stiffness of the springs.
+    real_t k3 = 1;
+    /// Damping coefficient.
+    real_t c = real_t(0.1);
+    /// Weight of the states.
+    real_t q = 1;
+    /// Weight of the inputs.
+    real_t r = real_t(1e-2);
+    /// Weight of the terminal state.
+    real_t q_N = 10;
+    /// Bound on the inputs.
+    real_t u_max = 1;
+    /// Initial displacement of the last mass (the springs are stretched
+    /// uniformly).
+    real_t x_init = 1;
+};
+
+/// Optimal control of a chain of masses connected by nonlinear springs, in
+/// multiple-shooting form.
+///
+/// The @f$ M = n_x / 2 @f$ masses move along a line, the first one is
+/// connected to a wall. The spring force is
+/// @f$ s(d) = k d + k_3 d^3 @f$, where @f$ d @f$ is the elongation of the
+/// spring, and every mass has a viscous damping @f$ -c v @f$. The inputs are
+/// forces acting on the last @f$ n_u @f$ masses. The dynamics are discretized
+/// using the explicit Euler method.
+///
+/// The decision variables are
+/// @f$ (u_0, x_1, u_1, x_2, \dots, u_{N-1}, x_N) @f$, the general constraints
+/// are the dynamics @f$ x_{k+1} - \phi(x_k, u_k) = 0 @f$ (with the initial
+/// state @f$ x_0 @f$ fixed), and the inputs are bounded by
+/// @f$ \|u_k\|_\infty \le u_\text{max} @f$. The cost is
+/// @f$ \sum_{k=0}^{N-1} \tfrac12 q \|x_k\|^2 + \tfrac12 r \|u_k\|^2 +
+/// \tfrac12 q_N \|x_N\|^2 @f$ (without the constant term in @f$ x_0 @f$).
+/// @ingroup grp_Problems
+class ALPAQA_EXPORT ChainOCP : public BoxConstrProblem<DefaultConfig> {
+  public:
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using Params   = ChainOCPParams;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+
+    ChainOCP(const Params &params = {});
+
+    Params params;
+    /// Fixed initial state.
+    vec x_init;
+    /// Initial guess for the decision variables.
+    vec initial_guess;
+
+    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const;
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const;
+    void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                     rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_ψ_sparsity() const;
+
+  private:
+    length_t M; ///< Number of masses
+    vec weights;
+    SparsePattern jac_g, hess_L;
+    AugLagHessian hess_ψ;
+    mutable vec work_ŷ, work_Σ, work_J, work_H, work_Jv;
+
+    [[nodiscard]] length_t stage_size() const { return params.nx + params.nu; }
+    /// Offset of @f$ u_k @f$ in the vector of decision variables.
+    [[nodiscard]] index_t u_offset(index_t k) const { return k * stage_size(); }
+    /// Offset of @f$ x_k @f$ in the vector of decision variables (k > 0).
+    [[nodiscard]] index_t x_offset(index_t k) const {
+        return (k - 1) * stage_size() + params.nu;
+    }
+    /// State @f$ x_k @f$ for k ≥ 0.
+    [[nodiscard]] crvec state(crvec x, index_t k) const;
+    /// Elongation of the spring between masses i - 1 and i.
+    [[nodiscard]] real_t elongation(crvec p, index_t i) const;
+    /// Force acting on every mass (without the inputs).
+    void eval_forces(crvec p, crvec v, rvec F) const;
+};
+
+/// Parameters for the @ref LogisticRegression problem.
+/// @ingroup grp_Parameters
+struct LogisticRegressionParams {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+
+    /// Number of data points.
+    length_t samples = 1000;
+    /// Number of features.
+    length_t features = 200;
+    /// Fraction of nonzero elements in the data matrix.
+    real_t density = real_t(0.05);
+    /// Fraction of nonzero weights of the model that generates the labels.
+    real_t support = real_t(0.1);
+    /// Standard deviation of the noise added before thresholding the labels.
+    real_t noise = real_t(0.1);
+    /// ℓ₁-regularization factor, relative to the smallest factor for which
+    /// the solution is zero.
+    real_t λ_factor = real_t(0.1);
+    /// Seed for the random number generator.
+    uint64_t seed = 0;
+};
+
+/// Sparse ℓ₁-regularized logistic regression with random data.
+///
+/// @f[ \minimize_x \frac{1}{m} \sum_{i=1}^{m}
+///     \ln\left(1 + e^{-b_i a_i^\top x}\right) + \lambda \|x\|_1 @f]
+///
+/// The rows @f$ a_i @f$ of the data matrix are sparse and random, the labels
+/// @f$ b_i \in \{-1, +1\} @f$ are generated by a sparse random model.
+/// @ingroup grp_Problems
+class ALPAQA_EXPORT LogisticRegression : public BoxConstrProblem<DefaultConfig> {
+  public:
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using Params   = LogisticRegressionParams;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+    using spmat    = SparsePattern::spmat;
+
+    LogisticRegression(const Params &params = {});
+
+    Params params;
+    /// Data matrix (samples × features).
+    spmat A;
+    /// Labels.
+    vec b;
+    /// Initial guess for the decision variables.
+    vec initial_guess;
+
+    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const;
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const;
+
+  private:
+    SparsePattern jac_g;
+    /// The Hessian is @f$ A^\top W A @f$, it is assembled like the
+    /// constraint term of the Hessian of an augmented Lagrangian.
+    AugLagHessian hess_L;
+    mutable vec work_Ax, work_w, work_zero;
+};
+
+/// Parameters for the @ref RandomQP problem.
+/// @ingroup grp_Parameters
+struct RandomQPParams {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+
+    /// Number of variables.
+    length_t n = 100;
+    /// Number of general constraints.
+    length_t m = 50;
+    /// Fraction of nonzero elements in the factor of the Hessian and in the
+    /// constraint matrix.
+    real_t density = real_t(0.05);
+    /// Regularization added to the diagonal of the Hessian.
+    real_t reg = real_t(1e-2);
+    /// Fraction of the general constraints that are equality constraints.
+    real_t eq_fraction = 0;
+    /// Seed for the random number generator.
+    uint64_t seed = 0;
+};
+
+/// Random sparse convex quadratic program.
+///
+/// @f[ \minimize_x \tfrac12 x^\top Q x + q^\top x \quad
+///     \text{subject to} \quad -1 \le x \le 1, \quad l \le A x \le u, @f]
+///
+/// with @f$ Q = R^\top R + \text{reg}\, I @f$, where @f$ R @f$ and @f$ A @f$
+/// are sparse random matrices. The constraints are always feasible.
+/// @ingroup grp_Problems
+class ALPAQA_EXPORT RandomQP : public BoxConstrProblem<DefaultConfig> {
+  public:
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using Params   = RandomQPParams;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+    using spmat    = SparsePattern::spmat;
+
+    RandomQP(const Params &params = {});
+
+    Params params;
+    /// Hessian of the cost (upper triangle).
+    spmat Q;
+    /// Gradient of the cost in the origin.
+    vec q;
+    /// Constraint matrix.
+    spmat A;
+    /// Initial guess for the decision variables.
+    vec initial_guess;
+
+    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const;
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const;
+    void eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                     rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_ψ_sparsity() const;
+
+  private:
+    SparsePattern jac_g, hess_L;
+    AugLagHessian hess_ψ;
+    mutable vec work_ŷ, work_Σ, work_H, work_Av, work_Qx;
+};
+
+/// Parameters for the @ref ChainedRosenbrock problem.
+/// @ingroup grp_Parameters
+struct ChainedRosenbrockParams {
+    USING_ALPAQA_CONFIG(DefaultConfig);
+
+    /// Number of variables.
+    length_t n = 100;
+    /// Coupling factor (larger is more ill-conditioned).
+    real_t a = 100;
+    /// Lower bound on the variables.
+    real_t lb = real_t(-1.5);
+    /// Upper bound on the variables (the unconstrained minimizer is one).
+    real_t ub = real_t(0.8);
+};
+
+/// Nonconvex bound-constrained chained Rosenbrock function.
+///
+/// @f[ \minimize_{l \le x \le u} \sum_{i=1}^{n-1}
+///     a (x_{i+1} - x_i^2)^2 + (1 - x_i)^2 @f]
+///
+/// The initial guess is the classical @f$ (-1.2, 1, -1.2, 1, \dots) @f$,
+/// clamped to the bounds.
+/// @ingroup grp_Problems
+class ALPAQA_EXPORT ChainedRosenbrock : public BoxConstrProblem<DefaultConfig> {
+  public:
+    USING_ALPAQA_CONFIG(DefaultConfig);
+    using Params   = ChainedRosenbrockParams;
+    using Sparsity = alpaqa::Sparsity<config_t>;
+
+    ChainedRosenbrock(const Params &params = {});
+
+    Params params;
+    /// Initial guess for the decision variables.
+    vec initial_guess;
+
+    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] real_t eval_f(crvec x) const;
+    void eval_grad_f(crvec x, rvec grad_fx) const;
+    real_t eval_f_grad_f(crvec x, rvec grad_fx) const;
+    void eval_g(crvec x, rvec gx) const;
+    void eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const;
+    void eval_jac_g(crvec x, rvec J_values) const;
+    [[nodiscard]] Sparsity get_jac_g_sparsity() const;
+    void eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                          rvec Hv) const;
+    void eval_hess_L(crvec x, crvec y, real_t scale, rvec H_values) const;
+    [[nodiscard]] Sparsity get_hess_L_sparsity() const;
+
+  private:
+    SparsePattern jac_g, hess_L;
+};
+
+} // namespace alpaqa::synthetic
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <alpaqa/export.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+
+namespace alpaqa {
+
+/// Phases of the solvers that heap allocations are attributed to.
+/// @see @ref ScopedAllocPhase
+enum class AllocPhase : uint8_t {
+    Other = 0,  ///< Outside of any solver.
+    Outer,      ///< Outer ALM loop (excluding the inner solver).
+    Setup,      ///< Inner solver initialization (workspaces, directions).
+    Iteration,  ///< Inner solver iterations, other than the phases below.
+    Direction,  ///< Computation and update of the (quasi-)Newton direction.
+    LineSearch, ///< Line search and step size backtracking.
+    Evaluation, ///< Problem function evaluations (@ref ProblemWithCounters).
+    Callback,   ///< User-provided progress callbacks.
+};
+
+/// Number of different @ref AllocPhase values.
+inline constexpr size_t num_alloc_phases = 8;
+
+/// @related    AllocPhase
+inline constexpr const char *enum_name(AllocPhase p) {
+    switch (p) {
+        case AllocPhase::Other: return "other";
+        case AllocPhase::Outer: return "outer";
+        case AllocPhase::Setup: return "setup";
+        case AllocPhase::Iteration: return "iteration";
+        case AllocPhase::Direction: return "direction";
+        case AllocPhase::LineSearch: return "linesearch";
+        case AllocPhase::Evaluation: return "evaluation";
+        case AllocPhase::Callback: return "callback";
+        default:;
+    }
+    throw std::out_of_range("invalid value for alpaqa::AllocPhase");
+}
+
+/// Whether heap allocations in the given phase indicate a problem, i.e. the
+/// phases that are executed in every iteration of the inner solvers, where
+/// all memory should have been allocated up front.
+inline constexpr bool is_allocation_free(AllocPhase p) {
+    switch (p) {
+        case AllocPhase::Iteration:
+        case AllocPhase::Direction:
+        case AllocPhase::LineSearch:
+        case AllocPhase::Evaluation: return true;
+        case AllocPhase::Other:
+        case AllocPhase::Outer:
+        case AllocPhase::Setup:
+        case AllocPhase::Callback: return false;
+        default:;
+    }
+    throw std::out_of_range("invalid value for alpaqa::AllocPhase");
+}
+
+/// Number of heap allocations and the total number of bytes requested.
+struct AllocCount {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+
+    AllocCount &operator+=(AllocCount o) {
+        count += o.count;
+        bytes += o.bytes;
+        return *this;
+    }
+    AllocCount &operator-=(AllocCount o) {
+        count -= o.count;
+        bytes -= o.bytes;
+        return *this;
+    }
+    bool operator==(const AllocCount &) const = default;
+};
+
+/// Heap allocations per solver phase.
+/// @see @ref alloc_accounting
+struct AllocStats {
+    std::array<AllocCount, num_alloc_phases> phases{};
+
+    AllocCount &operator[](AllocPhase p) {
+        return phases[static_cast<size_t>(p)];
+    }
+    const AllocCount &operator[](AllocPhase p) const {
+        return phases[static_cast<size_t>(p)];
+    }
+    /// Sum over all phases.
+    [[nodiscard]] AllocCount total() const {
+        AllocCount t;
+        for (const auto &c : phases)
+            t += c;
+        return t;
+    }
+    /// Sum over all phases for which @ref is_allocation_free is true.
+    [[nodiscard]] AllocCount in_allocation_free_phases() const {
+        AllocCount t;
+        for (size_t i = 0; i < num_alloc_phases; ++i)
+            if (is_allocation_free(static_cast<AllocPhase>(i)))
+                t += phases[i];
+        return t;
+    }
+    AllocStats &operator+=(const AllocStats &o) {
+        for (size_t i = 0; i < num_alloc_phases; ++i)
+            phases[i] += o.phases[i];
+        return *this;
+    }
+    AllocStats &operator-=(const AllocStats &o) {
+        for (size_t i = 0; i < num_alloc_phases; ++i)
+            phases[i] -= o.phases[i];
+        return *this;
+    }
+    friend AllocStats operator-(AllocStats a, const AllocStats &b) {
+        return a -= b;
+    }
+    bool operator==(const AllocStats &) const = default;
+};
+
+/// Prints a table with the number of allocations and bytes per phase.
+/// @related    AllocStats
+ALPAQA_EXPORT std::ostream &operator<<(std::ostream &, const AllocStats &);
+
+/// Accounting of heap allocations, per thread and per @ref AllocPhase.
+///
+/// The library only keeps track of the current phase and of the counters, the
+/// allocations themselves are counted by replacing the global allocation
+/// functions. This is done by linking the `alpaqa::alloc-hook` object library
+/// into an executable (the driver and the tests do this if alpaqa is built
+/// with `ALPAQA_WITH_ALLOC_ACCOUNTING`, which is off by default, because every
+/// phase switch then calls @ref set_phase). Without it, all counters remain
+/// zero and @ref is_enabled returns false.
+namespace alloc_accounting {
+
+/// Returns true if the allocation hook is linked into the executable.
+[[nodiscard]] ALPAQA_EXPORT bool is_enabled() noexcept;
+/// Called by the allocation hook during static initialization.
+ALPAQA_EXPORT void enable() noexcept;
+/// Called by the allocation hook for each allocation of the current thread.
+/// Must not allocate itself.
+ALPAQA_EXPORT void record(size_t bytes) noexcept;
+/// Returns the allocations of the current thread so far.
+[[nodiscard]] ALPAQA_EXPORT AllocStats snapshot() noexcept;
+/// Sets the phase of the current thread, returns the previous phase.
+ALPAQA_EXPORT AllocPhase set_phase(AllocPhase phase) noexcept;
+
+} // namespace alloc_accounting
+
+#ifdef ALPAQA_WITH_ALLOC_ACCOUNTING
+/// Attributes all heap allocations of the current thread to the given phase
+/// for the lifetime of this object, and restores the previous phase when it
+/// goes out of scope.
+struct [[nodiscard]] ScopedAllocPhase {
+    explicit ScopedAllocPhase(AllocPhase phase) noexcept
+        : prev(alloc_accounting::set_phase(phase)) {}
+    ~ScopedAllocPhase() { alloc_accounting::set_phase(prev); }
+    ScopedAllocPhase(const ScopedAllocPhase &)            = delete;
+    ScopedAllocPhase &operator=(const ScopedAllocPhase &) = delete;
+    /// Switch to a different phase without leaving the current scope.
+    void set(AllocPhase phase) noexcept { alloc_accounting::set_phase(phase); }
+    AllocPhase prev;
+};
+#else
+struct [[maybe_unused]] ScopedAllocPhase {
+    explicit ScopedAllocPhase(AllocPhase) noexcept {}
+    void set(AllocPhase) noexcept {}
+};
+#endif
+
+} // namespace alpaqa
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <alpaqa/export.h>
+#include <alpaqa/util/usdt.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace alpaqa {
+
+/// Timeline of the execution of the solvers, recorded as begin and end events
+/// of the ALM outer iterations, the inner iterations, the direction
+/// computations, the line search trials and the problem evaluations (the
+/// latter only if the problem is wrapped in a @ref ProblemWithCounters).
+///
+/// Recording is disabled by default. Once enabled using @ref start, each
+/// thread records its events to its own buffer, which is allocated when the
+/// thread records its first event, and never grows afterwards. When it is
+/// full, further begin events of that thread are dropped, but room is kept
+/// for the end events of the scopes that are still open, so that begin and
+/// end events remain balanced. The timeline can then be exported in the
+/// Chrome Trace Event format using @ref write_chrome_trace, and visualized
+/// using Perfetto (https://ui.perfetto.dev).
+///
+/// @note   @ref start, @ref clear and @ref write_chrome_trace should not be
+///         called while a solver is running in a different thread.
+namespace tracing {
+
+/// Default maximum number of events per thread.
+inline constexpr size_t default_capacity = size_t{1} << 20;
+
+namespace detail {
+ALPAQA_EXPORT extern std::atomic_bool enabled;
+/// Records a begin event. Returns false if the event was dropped, in which
+/// case the corresponding end event should not be recorded either.
+ALPAQA_EXPORT bool begin(const char *name, const char *category,
+                         int64_t arg) noexcept;
+/// Records the end event corresponding to the last begin event.
+ALPAQA_EXPORT void end(const char *name, const char *category) noexcept;
+} // namespace detail
+
+/// Returns true if events are currently being recorded.
+[[nodiscard]] inline bool is_enabled() noexcept {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+/// Discards all previously recorded events, and starts recording new events
+/// in all threads, with room for at most @p capacity events per thread.
+ALPAQA_EXPORT void start(size_t capacity = default_capacity);
+/// Stops recording events. Scopes that are still open when recording is
+/// stopped still record their end events.
+ALPAQA_EXPORT void stop() noexcept;
+/// Stops recording and frees the buffers of all threads.
+ALPAQA_EXPORT void clear();
+/// The number of events recorded since the last call to @ref start.
+[[nodiscard]] ALPAQA_EXPORT size_t num_events();
+/// The number of begin events that were dropped because the buffer of their
+/// thread was full (the corresponding end events are dropped as well).
+[[nodiscard]] ALPAQA_EXPORT size_t num_dropped_events();
+/// Writes all events recorded since the last call to @ref start as a JSON
+/// object in the Chrome Trace Event format.
+ALPAQA_EXPORT void write_chrome_trace(std::ostream &os);
+
+} // namespace tracing
+
+#if defined(ALPAQA_WITH_TRACING) || ALPAQA_HAVE_USDT
+/// Records a begin event when it is constructed and the corresponding end
+/// event when it goes out of scope, if tracing is enabled. Also fires the
+/// `alpaqa:scope_begin` and `alpaqa:scope_end` static tracepoints (see
+/// @ref usdt.hpp).
+/// @see @ref tracing
+struct [[nodiscard]] ScopedTraceEvent {
+    /// @param  name
+    ///         Name of the event, must be a string literal.
+    /// @param  category
+    ///         Category of the event, must be a string literal.
+    /// @param  arg
+    ///         Iteration number (or other index) associated with the event,
+    ///         negative values are not included in the trace.
+    ScopedTraceEvent(const char *name, const char *category,
+                     int64_t arg = -1) noexcept
+        : name(name), category(category) {
+        ALPAQA_USDT(scope_begin, name, category, arg);
+#ifdef ALPAQA_WITH_TRACING
+        if (tracing::is_enabled()) [[unlikely]]
+            active = tracing::detail::begin(name, category, arg);
+#endif
+    }
+    ~ScopedTraceEvent() {
+#ifdef ALPAQA_WITH_TRACING
+        if (active) [[unlikely]]
+            tracing::detail::end(name, category);
+#endif
+        ALPAQA_USDT(scope_end, name, category);
+    }
+    ScopedTraceEvent(const ScopedTraceEvent &)            = delete;
+    ScopedTraceEvent &operator=(const ScopedTraceEvent &) = delete;
+    const char *name;
+    const char *category;
+#ifdef ALPAQA_WITH_TRACING
+    bool active = false;
+#endif
+};
+#else
+struct [[maybe_unused]] ScopedTraceEvent {
+    ScopedTraceEvent(const char *, const char *, int64_t = -1) noexcept {}
+};
+#endif
+
+} // namespace alpaqa
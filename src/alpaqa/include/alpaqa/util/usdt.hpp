@@ -0,0 +1,75 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+/// @file
+/// Statically defined tracepoints (USDT) in the solvers, for use with
+/// bpftrace, perf, SystemTap, etc. on live processes.
+///
+/// The probes use the `sys/sdt.h` header from SystemTap, which only emits a
+/// single `nop` instruction per probe and a note in the `.note.stapsdt` section
+/// of the binary, describing where the probe and its arguments are located.
+/// There is no runtime dependency, and the probes do nothing unless a tracer
+/// attaches to them. If the header is not available (CMake warns about this
+/// when configuring the project) or if the `ALPAQA_WITH_USDT` CMake option is
+/// disabled, the probes are removed, and their arguments are not evaluated.
+///
+/// All probes use the provider name `alpaqa`:
+///
+/// | Probe                 | Arguments                                  |
+/// |-----------------------|--------------------------------------------|
+/// | `scope_begin`         | name, category, index (see @ref tracing)   |
+/// | `scope_end`           | name, category                             |
+/// | `alm_outer_iteration` | i, ε, ‖e‖, inner iter, inner status, t     |
+/// | `panoc_iteration`     | k, εₖ, γ, τ, t_eval, t_dir, t_ls           |
+/// | `zerofpr_iteration`   | k, εₖ, γ, τ, t_eval, t_dir, t_ls           |
+/// | `pantr_iteration`     | k, εₖ, γ, Δ, ρ, t_eval, t_dir              |
+/// | `panococp_iteration`  | k, εₖ, γ, τ, t_forward, t_backward, t_lqr  |
+/// | `linesearch_trial`    | k, τ, γ                                    |
+/// | `trust_region_trial`  | k, Δ, γ                                    |
+///
+/// The `scope_begin` and `scope_end` probes mark the same scopes as the
+/// events of @ref tracing, i.e. the ALM solve and its outer iterations, the
+/// inner solves and iterations, the direction computations, the line search
+/// trials, and the evaluations of problems wrapped in a
+/// @ref ProblemWithCounters. Names and categories are C strings.
+/// The time t of the ALM is the elapsed time since the start of the solve,
+/// the times of the inner solvers are the cumulative times spent in the
+/// evaluations, the direction, the line search, etc. since the start of the
+/// current inner solve. All times are in nanoseconds.
+/// Since eBPF has no floating-point support, the real-valued arguments (ε, γ,
+/// τ, ...) are passed as the bit patterns of IEEE 754 doubles, see
+/// @ref usdt::real_bits.
+///
+/// See `scripts/usdt/phase-latency.bt` for an example.
+
+#if defined(ALPAQA_WITH_USDT) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define ALPAQA_HAVE_USDT 1
+/// Static tracepoint `alpaqa:name` with the given arguments (at most 12).
+#define ALPAQA_USDT(name, ...)                                                 \
+    STAP_PROBEV(alpaqa, name __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define ALPAQA_HAVE_USDT 0
+#define ALPAQA_USDT(name, ...) static_cast<void>(0)
+#endif
+
+namespace alpaqa::usdt {
+
+/// Real-valued probe arguments are passed as the bits of an IEEE 754 double.
+template <class T>
+[[gnu::always_inline]] inline uint64_t real_bits(T x) noexcept {
+    return std::bit_cast<uint64_t>(static_cast<double>(x));
+}
+
+/// Durations are passed as integer nanoseconds.
+template <class Rep, class Period>
+[[gnu::always_inline]] inline int64_t
+nanoseconds(std::chrono::duration<Rep, Period> t) noexcept {
+    using ns = std::chrono::nanoseconds;
+    return static_cast<int64_t>(std::chrono::duration_cast<ns>(t).count());
+}
+
+} // namespace alpaqa::usdt
@@ -0,0 +1,17 @@
+#include <alpaqa/config/config.hpp>
+
+#include <alpaqa/implementation/accelerators/lsr1.tpp>
+
+namespace alpaqa {
+
+ALPAQA_EXPORT_TEMPLATE(struct, LSR1Params, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(struct, LSR1Params, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(struct, LSR1Params, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(struct, LSR1Params, EigenConfigq);)
+
+ALPAQA_EXPORT_TEMPLATE(class, LSR1, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, LSR1, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, LSR1, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, LSR1, EigenConfigq);)
+
+} // namespace alpaqa
\ No newline at end of file
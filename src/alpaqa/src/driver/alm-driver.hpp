@@ -96,6 +96,12 @@ SolverResults run_alm_solver(LoadedProblem &problem, Solver &solver,
     if constexpr (requires { stats.inner.final_h; })
         final_h = stats.inner.final_h;
     decltype(SolverResults::extra) extra{};
+    if (solver.get_params().anderson_memory > 0) {
+        extra.emplace_back("accelerated_outer_iterations",
+                           static_cast<index_t>(stats.accelerated_iterations));
+        extra.emplace_back("outer_acceleration_rejections",
+                           static_cast<index_t>(stats.acceleration_rejections));
+    }
     if constexpr (requires { stats.inner.linesearch_failures; })
         extra.emplace_back(
             "linesearch_failures",
@@ -126,6 +132,41 @@ SolverResults run_alm_solver(LoadedProblem &problem, Solver &solver,
         extra.emplace_back(
             "direction_update_rejected",
             static_cast<index_t>(stats.inner.direction_update_rejected));
+    // Time spent in the different phases of the inner solver
+    using sec     = std::chrono::duration<real_t>;
+    auto add_time = [&extra](const char *name, std::chrono::nanoseconds t) {
+        extra.emplace_back(name, std::chrono::duration_cast<sec>(t).count());
+    };
+    if constexpr (requires { stats.inner.time_evaluations; })
+        add_time("time_evaluations", stats.inner.time_evaluations);
+    if constexpr (requires { stats.inner.time_prox; })
+        add_time("time_prox", stats.inner.time_prox);
+    if constexpr (requires { stats.inner.time_direction_apply; })
+        add_time("time_direction_apply", stats.inner.time_direction_apply);
+    if constexpr (requires { stats.inner.time_direction_update; })
+        add_time("time_direction_update", stats.inner.time_direction_update);
+    if constexpr (requires { stats.inner.time_linesearch; })
+        add_time("time_linesearch", stats.inner.time_linesearch);
+    if constexpr (requires { stats.inner.time_progress_callback; })
+        add_time("time_progress_callback", stats.inner.time_progress_callback);
+    if constexpr (requires {
+                      solver.inner_solver.direction.get_factorization_stats();
+                  }) {
+        const auto &fs =
+            solver.inner_solver.direction.get_factorization_stats();
+        extra.emplace_back("hessian_evaluations",
+                           static_cast<index_t>(fs.hessian_evaluations));
+        extra.emplace_back("factorizations",
+                           static_cast<index_t>(fs.factorizations));
+        extra.emplace_back("factorization_reuses",
+                           static_cast<index_t>(fs.reuses));
+        extra.emplace_back("factorization_updates",
+                           static_cast<index_t>(fs.updates));
+        extra.emplace_back("factorization_indices_added",
+                           static_cast<index_t>(fs.indices_added));
+        extra.emplace_back("factorization_indices_removed",
+                           static_cast<index_t>(fs.indices_removed));
+    }
     return SolverResults{
         .status             = enum_name(stats.status),
         .success            = stats.status == alpaqa::SolverStatus::Converged,
@@ -144,5 +185,8 @@ SolverResults run_alm_solver(LoadedProblem &problem, Solver &solver,
         .outer_iter         = static_cast<index_t>(stats.outer_iterations),
         .inner_iter         = static_cast<index_t>(stats.inner.iterations),
         .extra              = std::move(extra),
+        .allocations        = alpaqa::alloc_accounting::is_enabled()
+                                  ? std::optional{stats.allocations}
+                                  : std::nullopt,
     };
 }
\ No newline at end of file
@@ -4,10 +4,14 @@
 #endif
 
 #include <alpaqa/config/config.hpp>
+#include <alpaqa/outer/result-cache.hpp>
+#include <alpaqa/problem/presolved-problem.hpp>
+#include <alpaqa/problem/scaled-problem.hpp>
 #include <alpaqa/problem/kkt-error.hpp>
 #include <alpaqa/util/demangled-typename.hpp>
 #include <alpaqa/util/print.hpp>
 #include <alpaqa/util/string-util.hpp>
+#include <alpaqa/util/trace.hpp>
 #include <alpaqa-version.h>
 
 #include "fista-driver.hpp"
@@ -17,6 +21,7 @@
 #include "panoc-driver.hpp"
 #include "pantr-driver.hpp"
 #include "param-complete.hpp"
+#include "portfolio-driver.hpp"
 #include "qpalm-driver.hpp"
 #include "results.hpp"
 #include "solver-driver.hpp"
@@ -60,6 +65,15 @@ problem types:
         CasADiProblem::load_numerical_data for more details.
         The problem parameter can be set using the problem.param option.
     cu: Load a CUTEst problem using the CUTEstProblem class.
+        Use problem.load_mode=namespace or problem.load_mode=copy to give
+        each instance of the problem its own copy of CUTEst's global state,
+        so that the portfolio solver can evaluate them in parallel.
+    gen: Generate a problem of tunable size using the synthetic problems
+        in alpaqa/problem/synthetic-problems.hpp. The path is the name of
+        the generator: chain (chain of masses OCP), logreg (sparse logistic
+        regression), qp (random convex QP) or rosenbrock (bound-constrained
+        chained Rosenbrock function). The parameters of the generator can be
+        set using problem.<key>=<value>, e.g. gen:chain problem.N=50.
 
 methods:
     panoc[.<direction>]:
@@ -67,18 +81,33 @@ methods:
         Directions include: lbfgs, struclbfgs, anderson, convex-newton.
     zerofpr[.<direction>]:
         ZeroFPR solver, supports the same directions as PANOC.
-    pantr:
-        PANTR solver. Requires products with the Hessian of the augmented
-        Lagrangian (unless dir.finite_diff=true).
+    pantr[.<direction>]:
+        PANTR solver with the given direction.
+        Directions include: newtontr, lsr1tr.
+        The newtontr direction requires products with the Hessian of the
+        augmented Lagrangian (unless dir.finite_diff=true), lsr1tr uses a
+        limited-memory SR1 approximation instead.
     fista:
         FISTA (fast iterative shrinkage-thresholding algorithm). Only for
         convex problems.
     ipopt:
         Ipopt interior point solver. Requires Jacobian of the constraints
         and Hessian of the Lagrangian (unless finite memory is enabled).
+        When num_exp is set, the repeated solves reuse the structure of
+        the problem (ReOptimizeTNLP), and warm_start=true starts them from
+        the previous primal and dual solution.
     qpalm:
         QPALM proximal ALM QP solver. Assumes that the problem is a QP.
         Requires Jacobian of the constraints and Hessian of the Lagrangian.
+    portfolio:
+        Runs several of the ALM solvers above in parallel threads, and
+        returns the solution of the first one to converge, stopping the
+        others. The methods are selected using the portfolio option, e.g.
+        portfolio=panoc.lbfgs,panoc.struclbfgs,zerofpr,pantr,fista.
+        The alm, solver, dir and accel options apply to all methods.
+        CasADi problems and CUTEst problems with an isolated load_mode are
+        copied for each thread, for other problems, the evaluations are
+        serialized.
 
 options:
     Solver-specific options can be specified as key-value pairs, where the
@@ -95,9 +124,47 @@ options:
     mul_g0:  Initial guess for the multipliers of the general constraints.
     mul_x0:  Initial guess for the multipliers of the bound constraints on x.
     num_exp: Repeat the experiment this many times for more accurate timings.
+    warm_start: Warm-start the repeated experiments (Ipopt only).
     extra_stats: Log more per-iteration solver statistics, such as step sizes,
                  Newton step acceptance, and residuals. Requires `sol' to be set.
     show_funcs: Print an overview of the functions provided by the problem.
+    portfolio: Comma-separated list of methods used by the portfolio solver
+               (default: panoc.lbfgs,panoc.struclbfgs,zerofpr.lbfgs).
+    cache:   Options for caching the solver results on disk, e.g.
+             cache.directory=~/.cache/alpaqa. If the same problem is solved
+             again with the same solver, options and initial guess, the
+             results are loaded from the cache instead of invoking the solver.
+    presolve: Options for reducing the problem before solving, e.g.
+              presolve.fixed_variables=1 eliminates fixed variables,
+              presolve.free_constraints=1 removes constraints with infinite
+              bounds, and presolve.singleton_constraints=1 converts linear
+              constraints of a single variable into bounds (default: none).
+              Linearity is checked using the Hessian of the Lagrangian;
+              for problems without Hessian, the constraints that depend on
+              a single variable are only converted if
+              presolve.assume_linear_singletons=1 is given.
+              Converting singleton constraints requires
+              presolve.h_is_box_indicator=1, which is valid only if the
+              problem has no nonsmooth term other than the box C.
+    scaling: Options for scaling the variables, objective and constraints
+             before solving, e.g. scaling.method=Gradient or
+             scaling.method=Ruiz (default: None). The solution and
+             multipliers are converted back to the original problem.
+             Ruiz scaling only scales the variables if
+             scaling.h_is_box_indicator=1 is given, which is valid only if
+             the problem has no nonsmooth term other than the box C.
+    max_allocs: Exit with an error if the ALM-based solvers perform more than
+                this number of heap allocations in their iterations (i.e. in
+                the direction, line search and evaluation phases). The
+                allocations per phase are always printed when the driver is
+                built with ALPAQA_WITH_ALLOC_ACCOUNTING.
+    trace:   File to write a timeline of the solver execution to, in the
+             Chrome Trace Event format (JSON), which can be opened using
+             Perfetto (https://ui.perfetto.dev). It contains the ALM and inner
+             iterations, the direction computations, the line search trials
+             and the problem evaluations. Requires ALPAQA_WITH_TRACING.
+    trace_capacity: Maximum number of trace events per thread, further events
+                    are dropped (default: 1048576).
 
     The prefix @ can be added to the values of x0, mul_g0 and mul_x0 to read
     the values from the given CSV file.
@@ -258,7 +325,7 @@ auto get_solver_builder(Options &opts) {
         {"panoc", make_panoc_driver}, {"zerofpr", make_zerofpr_driver},
         {"pantr", make_pantr_driver}, {"lbfgsb", make_lbfgsb_driver},
         {"fista", make_fista_driver}, {"ipopt", make_ipopt_driver},
-        {"qpalm", make_qpalm_driver},
+        {"qpalm", make_qpalm_driver}, {"portfolio", make_portfolio_driver},
     };
     // Find the selected solver builder
     auto solver_it = solvers.find(method);
@@ -271,6 +338,245 @@ auto get_solver_builder(Options &opts) {
     return std::make_tuple(std::move(solver_it->second), direction);
 }
 
+/// Compute the key that identifies the combination of problem, solver, options
+/// and initial guess in the result cache.
+std::string get_result_cache_key(const LoadedProblem &problem,
+                                 const Options &opts) {
+    alpaqa::ResultCacheKey problem_id, solver_id;
+    // The problem is identified by the contents of the file it was loaded
+    // from (and of its data file, if any), and by the problem options
+    problem_id.add(problem.name);
+    problem_id.add_file(problem.abs_path);
+    problem_id.add_file(fs::path{problem.abs_path}.replace_extension(".tsv"));
+    problem_id.add(problem.initial_guess_w);
+    // Options that do not affect the solution are excluded from the key
+    auto excluded = [](std::string_view opt) {
+        auto key  = std::get<0>(alpaqa::util::split(opt, "="));
+        auto root = std::get<0>(alpaqa::util::split(key, "."));
+        for (auto e : {"out"sv, "sol"sv, "cache"sv, "num_exp"sv,
+                       "extra_stats"sv, "show_funcs"sv, "max_allocs"sv,
+                       "trace"sv, "trace_capacity"sv})
+            if (root == e)
+                return true;
+        return false;
+    };
+    for (auto opt : opts.options())
+        if (!excluded(opt))
+            solver_id.add(opt);
+#if ALPAQA_WITH_JSON
+    for (const auto &j : opts.json_data())
+        solver_id.add(std::string_view{j.dump()});
+#endif
+    return alpaqa::ResultCache<config_t>::make_key(
+               problem.problem, problem_id.str(), solver_id.str(),
+               problem.initial_guess_x, problem.initial_guess_y)
+        .str();
+}
+
+/// Run the solver, or load its results from the cache.
+SolverResults run_cached(SolverWrapper &solver, LoadedProblem &problem,
+                         const Options &opts,
+                         const alpaqa::ResultCacheParams &cache_params,
+                         std::ostream &os) {
+    if (cache_params.directory.empty())
+        return solver.run(problem, os);
+    alpaqa::ResultCache<config_t> cache{cache_params};
+    auto key         = get_result_cache_key(problem, opts);
+    auto print_stats = [&] {
+        auto stats = cache.get_stats();
+        os << "Result cache " << key << ": " << stats.disk_hits << " hits, "
+           << stats.misses << " misses, " << stats.evictions << " evictions, "
+           << stats.disk_errors << " write errors" << std::endl;
+    };
+    if (auto cached = cache.lookup(key)) {
+        print_stats();
+        return {
+            .status             = cached->status,
+            .success            = cached->success,
+            .evals              = {},
+            .duration           = cached->elapsed_time,
+            .solver             = cached->solver,
+            .h                  = cached->h,
+            .δ                  = cached->δ,
+            .ε                  = cached->ε,
+            .γ                  = cached->γ,
+            .Σ                  = cached->norm_penalty,
+            .solution           = std::move(cached->x),
+            .multipliers        = std::move(cached->y),
+            .multipliers_bounds = std::move(cached->multipliers_bounds),
+            .penalties          = std::move(cached->Σ),
+            .outer_iter         = cached->outer_iterations,
+            .inner_iter         = cached->inner_iterations,
+        };
+    }
+    auto results = solver.run(problem, os);
+    if (results.status != enum_name(alpaqa::SolverStatus::Interrupted))
+        cache.store(key, {
+                             .solver             = results.solver,
+                             .status             = results.status,
+                             .success            = results.success,
+                             .ε                  = results.ε,
+                             .δ                  = results.δ,
+                             .norm_penalty       = results.Σ,
+                             .h                  = results.h,
+                             .γ                  = results.γ,
+                             .outer_iterations   = results.outer_iter,
+                             .inner_iterations   = results.inner_iter,
+                             .elapsed_time       = results.duration,
+                             .x                  = results.solution,
+                             .y                  = results.multipliers,
+                             .multipliers_bounds = results.multipliers_bounds,
+                             .Σ                  = results.penalties,
+                         });
+    print_stats();
+    return results;
+}
+
+/// Scale the problem (if requested), run the solver, and convert the solution
+/// back to the original problem.
+SolverResults run_scaled(SolverWrapper &solver, LoadedProblem &problem,
+                         const Options &opts,
+                         const alpaqa::ResultCacheParams &cache_params,
+                         const alpaqa::ProblemScalingParams<config_t> &params,
+                         std::ostream &os) {
+    if (params.method == alpaqa::ProblemScaling::None)
+        return run_cached(solver, problem, opts, cache_params, os);
+    alpaqa::ScaledProblem<config_t> scaled{
+        alpaqa::TypeErasedProblem<config_t>{&problem.problem},
+        problem.initial_guess_x, params};
+    auto minmax = [](crvec v) {
+        return v.size() == 0 ? std::string{"-"}
+                             : std::to_string(v.minCoeff()) + " … " +
+                                   std::to_string(v.maxCoeff());
+    };
+    os << "Scaling (" << enum_name(params.method) << "):\n"
+       << "  objective:   " << scaled.get_objective_scaling() << '\n'
+       << "  variables:   " << minmax(scaled.get_variable_scaling()) << '\n'
+       << "  constraints: " << minmax(scaled.get_constraint_scaling())
+       << '\n'
+       << std::endl;
+    // The scaled problem shares the evaluation counters and metadata with the
+    // original problem, only the functions and initial guesses differ.
+    LoadedProblem scaled_problem = problem;
+    scaled_problem.problem = alpaqa::TypeErasedProblem<config_t>{&scaled};
+    if (problem.clone)
+        scaled_problem.clone = [&scaled, clone{problem.clone}](auto evals) {
+            auto scaled_clone    = scaled;
+            scaled_clone.problem = clone(std::move(evals));
+            return alpaqa::TypeErasedProblem<config_t>{
+                std::move(scaled_clone)};
+        };
+    scaled.scale_variables(problem.initial_guess_x,
+                           scaled_problem.initial_guess_x);
+    scaled.scale_multipliers(problem.initial_guess_y,
+                             scaled_problem.initial_guess_y);
+    if (problem.initial_guess_w.size() > 0)
+        scaled.scale_bound_multipliers(problem.initial_guess_w,
+                                       scaled_problem.initial_guess_w);
+    auto results = run_cached(solver, scaled_problem, opts, cache_params, os);
+    auto unscale = [](auto convert, vec &v, length_t n) {
+        if (v.size() != n)
+            return;
+        vec scaled_v = std::move(v);
+        v.resize(n);
+        convert(scaled_v, v);
+    };
+    auto n = problem.problem.get_n(), m = problem.problem.get_m();
+    unscale([&](crvec a, rvec b) { scaled.unscale_variables(a, b); },
+            results.solution, n);
+    unscale([&](crvec a, rvec b) { scaled.unscale_multipliers(a, b); },
+            results.multipliers, m);
+    unscale([&](crvec a, rvec b) { scaled.unscale_bound_multipliers(a, b); },
+            results.multipliers_bounds, n);
+    unscale([&](crvec a, rvec b) { scaled.unscale_penalties(a, b); },
+            results.penalties, m);
+    results.h /= scaled.get_objective_scaling();
+    return results;
+}
+
+/// Reduce the problem (if requested), scale it and run the solver, and convert
+/// the solution back to the original problem.
+SolverResults
+run_presolved(SolverWrapper &solver, LoadedProblem &problem,
+              const Options &opts,
+              const alpaqa::ResultCacheParams &cache_params,
+              const alpaqa::PresolveParams<config_t> &params,
+              const alpaqa::ProblemScalingParams<config_t> &scaling,
+              std::ostream &os) {
+    if (!params.fixed_variables && !params.free_constraints &&
+        !params.singleton_constraints)
+        return run_scaled(solver, problem, opts, cache_params, scaling, os);
+    auto t0 = std::chrono::steady_clock::now();
+    alpaqa::PresolvedProblem<config_t> presolved{
+        alpaqa::TypeErasedProblem<config_t>{&problem.problem},
+        problem.initial_guess_x, params};
+    auto t1 = std::chrono::steady_clock::now();
+    std::chrono::duration<double> presolve_time = t1 - t0;
+    const auto &stats = presolved.get_stats();
+    auto n = problem.problem.get_n(), m = problem.problem.get_m();
+    os << "Presolve:\n"
+       << "  variables:   " << n << " → " << presolved.get_n() << " ("
+       << stats.fixed_variables << " fixed)\n"
+       << "  constraints: " << m << " → " << presolved.get_m() << " ("
+       << stats.free_constraints << " free, " << stats.redundant_constraints
+       << " redundant, " << stats.singleton_constraints << " singleton)\n"
+       << "  time:        " << alpaqa::float_to_str(presolve_time.count(), 3)
+       << " s\n"
+       << std::endl;
+    // The reduced problem shares the evaluation counters and metadata with
+    // the original problem, only the functions and initial guesses differ.
+    LoadedProblem reduced = problem;
+    reduced.problem = alpaqa::TypeErasedProblem<config_t>{&presolved};
+    if (problem.clone)
+        reduced.clone = [&presolved, clone{problem.clone}](auto evals) {
+            auto reduced_clone    = presolved;
+            reduced_clone.problem = clone(std::move(evals));
+            return alpaqa::TypeErasedProblem<config_t>{
+                std::move(reduced_clone)};
+        };
+    reduced.initial_guess_x.resize(presolved.get_n());
+    reduced.initial_guess_y.resize(presolved.get_m());
+    presolved.reduce_variables(problem.initial_guess_x,
+                               reduced.initial_guess_x);
+    presolved.reduce_multipliers(problem.initial_guess_y,
+                                 reduced.initial_guess_y);
+    if (problem.initial_guess_w.size() > 0) {
+        reduced.initial_guess_w.resize(presolved.get_n());
+        presolved.reduce_bound_multipliers(problem.initial_guess_w,
+                                           reduced.initial_guess_w);
+    }
+    auto results = run_scaled(solver, reduced, opts, cache_params, scaling, os);
+    vec x(n), y(m);
+    presolved.expand_variables(results.solution, x);
+    if (results.multipliers.size() == presolved.get_m())
+        presolved.expand_multipliers(x, results.multipliers, y);
+    else
+        y.setZero();
+    if (results.multipliers_bounds.size() == presolved.get_n()) {
+        vec w(n);
+        presolved.expand_bound_multipliers(x, y, results.multipliers_bounds, w);
+        results.multipliers_bounds = std::move(w);
+    }
+    if (results.penalties.size() == presolved.get_m()) {
+        vec Σ = vec::Zero(m);
+        Σ(presolved.get_kept_constraints()) = results.penalties;
+        results.penalties = std::move(Σ);
+    }
+    results.solution    = std::move(x);
+    results.multipliers = std::move(y);
+    using index_t       = SolverResults::index_t;
+    results.extra.emplace_back("presolve_time", presolve_time.count());
+    results.extra.emplace_back("presolve_fixed_variables",
+                               index_t{stats.fixed_variables});
+    results.extra.emplace_back("presolve_free_constraints",
+                               index_t{stats.free_constraints});
+    results.extra.emplace_back("presolve_redundant_constraints",
+                               index_t{stats.redundant_constraints});
+    results.extra.emplace_back("presolve_singleton_constraints",
+                               index_t{stats.singleton_constraints});
+    return results;
+}
+
 void store_solution(const fs::path &sol_output_dir, std::ostream &os,
                     BenchmarkResults &results, auto &solver,
                     [[maybe_unused]] const Options &opts,
@@ -371,6 +677,38 @@ int main(int argc, const char *argv[]) try {
     print_problem_description(os, problem, show_funcs);
     os << std::endl;
 
+    // Check whether to cache the results
+    alpaqa::ResultCacheParams cache_params;
+    set_params(cache_params, "cache", opts);
+
+    // Check whether to reduce the problem
+    alpaqa::PresolveParams<config_t> presolve_params{
+        .fixed_variables       = false,
+        .free_constraints      = false,
+        .singleton_constraints = false,
+    };
+    set_params(presolve_params, "presolve", opts);
+
+    // Check whether to scale the problem
+    alpaqa::ProblemScalingParams<config_t> scaling_params{
+        .method = alpaqa::ProblemScaling::None};
+    set_params(scaling_params, "scaling", opts);
+
+    // Check the number of heap allocations in the solver iterations
+    int64_t max_allocs = -1;
+    set_params(max_allocs, "max_allocs", opts);
+
+    // Check whether to record a timeline of the solver execution
+    std::string trace_path;
+    uint64_t trace_capacity = alpaqa::tracing::default_capacity;
+    set_params(trace_path, "trace", opts);
+    set_params(trace_capacity, "trace_capacity", opts);
+#ifndef ALPAQA_WITH_TRACING
+    if (!trace_path.empty())
+        throw std::invalid_argument(
+            "Tracing is not available (ALPAQA_WITH_TRACING is disabled)");
+#endif
+
     // Check options
     auto used       = opts.used();
     auto unused_opt = std::ranges::find(used, 0);
@@ -379,8 +717,25 @@ int main(int argc, const char *argv[]) try {
         throw std::invalid_argument("Unused option: " +
                                     std::string(opts.options()[unused_idx]));
 
-    // Solve
-    auto solver_results = solver->run(problem, os);
+    // Solve (or load the results from the cache)
+    if (!trace_path.empty())
+        alpaqa::tracing::start(static_cast<size_t>(trace_capacity));
+    auto solver_results = run_presolved(*solver, problem, opts, cache_params,
+                                        presolve_params, scaling_params, os);
+    if (!trace_path.empty()) {
+        alpaqa::tracing::stop();
+        os << "Writing trace to " << trace_path << std::endl;
+        std::ofstream trace_file{trace_path};
+        if (!trace_file)
+            throw std::runtime_error("Unable to open " + trace_path);
+        alpaqa::tracing::write_chrome_trace(trace_file);
+        if (auto dropped = alpaqa::tracing::num_dropped_events())
+            os << "Warning: " << dropped
+               << " trace events were dropped, consider increasing "
+                  "trace_capacity"
+               << std::endl;
+        alpaqa::tracing::clear();
+    }
 
     // Compute more statistics
     real_t f     = problem.problem.eval_f(solver_results.solution);
@@ -403,6 +758,20 @@ int main(int argc, const char *argv[]) try {
     if (!sol_output_dir.empty())
         store_solution(sol_output_dir, os, results, solver, opts, args);
 
+    // Fail if the solver allocated too much memory in its iterations
+    if (max_allocs >= 0) {
+        const auto &allocs = solver_results.allocations;
+        if (!allocs)
+            throw std::runtime_error(
+                "Allocation accounting is not available for this solver");
+        auto count = allocs->in_allocation_free_phases().count;
+        if (count > static_cast<uint64_t>(max_allocs))
+            throw std::runtime_error(
+                std::to_string(count) +
+                " heap allocations in the solver iterations (max_allocs=" +
+                std::to_string(max_allocs) + ")");
+    }
+
 } catch (std::exception &e) {
     std::cerr << "Error: " << demangled_typename(typeid(e)) << ":\n  "
               << e.what() << std::endl;
@@ -16,6 +16,10 @@ struct AlpaqaSolverStatsCollector {
         double time;
         real_t gamma = NaN, eps = NaN, delta = NaN, psi = NaN, psi_hat = NaN,
                fbe = NaN, tau = NaN, radius = NaN, rho = NaN;
+        // Cumulative time spent in each phase of the current inner solve
+        double time_evaluations = NaN, time_prox = NaN,
+               time_direction_apply = NaN, time_direction_update = NaN,
+               time_linesearch = NaN;
     };
     std::vector<Record> stats{};
     std::chrono::steady_clock::time_point t0;
@@ -53,8 +57,25 @@ struct AlpaqaSolverStatsCollector {
                       })
             r.delta = norm_inf((progress_info.ŷ - progress_info.y)
                                    .cwiseQuotient(progress_info.Σ));
+        if constexpr (requires { progress_info.stats; })
+            if (const auto *s = progress_info.stats)
+                update_times(r, *s);
         stats.push_back(r);
     }
+
+    static void update_times(Record &r, const auto &s) {
+        using sec = std::chrono::duration<double>;
+        if constexpr (requires { s.time_evaluations; })
+            r.time_evaluations = sec{s.time_evaluations}.count();
+        if constexpr (requires { s.time_prox; })
+            r.time_prox = sec{s.time_prox}.count();
+        if constexpr (requires { s.time_direction_apply; })
+            r.time_direction_apply = sec{s.time_direction_apply}.count();
+        if constexpr (requires { s.time_direction_update; })
+            r.time_direction_update = sec{s.time_direction_update}.count();
+        if constexpr (requires { s.time_linesearch; })
+            r.time_linesearch = sec{s.time_linesearch}.count();
+    }
 };
 
 template <alpaqa::Config Conf>
@@ -71,7 +92,8 @@ struct AlpaqaSolverWrapperStats : SolverWrapper {
     void write_statistics_to_stream(std::ostream &os) override {
         std::array<char, 64> buf;
         os << "outer_iter,inner_iter,time,gamma,eps,delta,psi,psi_hat,fbe,tau,"
-              "radius,rho\n";
+              "radius,rho,time_evaluations,time_prox,time_direction_apply,"
+              "time_direction_update,time_linesearch\n";
         for (const auto &r : collector->stats) {
             os << r.outer_iter << ',' << r.inner_iter << ','
                << alpaqa::float_to_str_vw(buf, r.time) << ','
@@ -83,7 +105,12 @@ struct AlpaqaSolverWrapperStats : SolverWrapper {
                << alpaqa::float_to_str_vw(buf, r.fbe) << ','
                << alpaqa::float_to_str_vw(buf, r.tau) << ','
                << alpaqa::float_to_str_vw(buf, r.radius) << ','
-               << alpaqa::float_to_str_vw(buf, r.rho) << '\n';
+               << alpaqa::float_to_str_vw(buf, r.rho) << ','
+               << alpaqa::float_to_str_vw(buf, r.time_evaluations) << ','
+               << alpaqa::float_to_str_vw(buf, r.time_prox) << ','
+               << alpaqa::float_to_str_vw(buf, r.time_direction_apply) << ','
+               << alpaqa::float_to_str_vw(buf, r.time_direction_update) << ','
+               << alpaqa::float_to_str_vw(buf, r.time_linesearch) << '\n';
         }
     }
 };
\ No newline at end of file
@@ -6,11 +6,9 @@
 #include "fista-driver.hpp"
 #include "solver-driver.hpp"
 
-namespace {
-
 using FISTASolver = alpaqa::FISTASolver<alpaqa::DefaultConfig>;
 
-auto make_inner_fista_solver(Options &opts) {
+FISTASolver make_inner_fista_solver(Options &opts) {
     USING_ALPAQA_CONFIG(FISTASolver::config_t);
     // Settings for the solver
     FISTASolver::Params solver_param;
@@ -21,6 +19,8 @@ auto make_inner_fista_solver(Options &opts) {
     return FISTASolver{solver_param};
 }
 
+namespace {
+
 template <class LoadedProblem>
 SharedSolverWrapper make_fista_driver_impl(std::string_view direction,
                                            Options &opts) {
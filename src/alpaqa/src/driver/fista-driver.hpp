@@ -1,6 +1,7 @@
 #pragma once
 
 #include <alpaqa/config/config.hpp>
+#include <alpaqa/inner/fista.hpp>
 
 #include "options.hpp"
 #include "problem.hpp"
@@ -9,3 +10,6 @@
 
 SharedSolverWrapper make_fista_driver(std::string_view direction,
                                       Options &opts);
+
+alpaqa::FISTASolver<alpaqa::DefaultConfig>
+make_inner_fista_solver(Options &opts);
@@ -49,6 +49,12 @@ problem types:
         CasADiProblem::load_numerical_data for more details.
         The problem parameter can be set using the problem.param option.
     cu: Load a CUTEst problem using the CUTEstProblem class.
+    gen: Generate a problem of tunable size using the synthetic problems
+        in alpaqa/problem/synthetic-problems.hpp. The path is the name of
+        the generator: chain (chain of masses OCP), logreg (sparse logistic
+        regression), qp (random convex QP) or rosenbrock (bound-constrained
+        chained Rosenbrock function). The parameters of the generator can be
+        set using problem.<key>=<value>, e.g. gen:chain problem.N=50.
 
 options:
     --full-print
@@ -2,6 +2,7 @@
 
 #include <alpaqa/ipopt/ipopt-adapter.hpp>
 #include <alpaqa/ipopt/ipopt-enums.hpp>
+#include <alpaqa/ipopt/ipopt-solver.hpp>
 #include <IpIpoptApplication.hpp>
 
 #include <stdexcept>
@@ -14,13 +15,13 @@ namespace {
 
 SolverResults run_ipopt_solver(auto &problem,
                                Ipopt::SmartPtr<Ipopt::IpoptApplication> &solver,
-                               std::ostream &os, unsigned N_exp) {
-    // Ipopt problem adapter
-    using Problem                    = alpaqa::IpoptAdapter;
-    Ipopt::SmartPtr<Ipopt::TNLP> nlp = new Problem(problem.problem);
-    auto *my_nlp                     = dynamic_cast<Problem *>(GetRawPtr(nlp));
+                               std::ostream &os, unsigned N_exp,
+                               bool warm_start) {
+    // Ipopt problem adapter, kept alive for all repetitions
+    alpaqa::IpoptSequentialSolver seq_solver{problem.problem, solver};
+    auto *my_nlp = &seq_solver.get_adapter();
 
-    USING_ALPAQA_CONFIG(Problem::config_t);
+    USING_ALPAQA_CONFIG(alpaqa::IpoptAdapter::config_t);
 
     // Dimensions
     length_t n = problem.problem.get_n(), m = problem.problem.get_m();
@@ -49,24 +50,35 @@ SolverResults run_ipopt_solver(auto &problem,
     }
 
     // Solve the problem
-    auto t0     = std::chrono::steady_clock::now();
-    auto status = solver->OptimizeTNLP(nlp);
-    auto t1     = std::chrono::steady_clock::now();
-
-    // Solve the problems again to average runtimes
-    using ns          = std::chrono::nanoseconds;
-    auto avg_duration = duration_cast<ns>(t1 - t0);
+    auto status         = seq_solver.solve();
+    auto first_duration = seq_solver.get_solve_time();
+
+    // Solve the problems again to average runtimes. The application and the
+    // adapter are reused, so Ipopt does not have to analyze the structure of
+    // the problem again. If requested, the solves are warm-started using the
+    // previous solution, otherwise they start from the same initial guess.
+    auto avg_duration      = first_duration;
+    auto resolve_durations = decltype(avg_duration){};
+    // Copy the initial guess, because warm starting overwrites it
+    vec x0 = my_nlp->initial_guess, y0 = my_nlp->initial_guess_multipliers,
+        z_L0 = my_nlp->initial_guess_bounds_multipliers_l,
+        z_U0 = my_nlp->initial_guess_bounds_multipliers_u;
     os.setstate(std::ios_base::badbit);
     for (unsigned i = 0; i < N_exp; ++i) {
-        my_nlp->initial_guess             = problem.initial_guess_x;
-        my_nlp->initial_guess_multipliers = problem.initial_guess_y;
-
-        auto t0 = std::chrono::steady_clock::now();
-        solver->OptimizeTNLP(nlp);
-        auto t1 = std::chrono::steady_clock::now();
-        avg_duration += duration_cast<ns>(t1 - t0);
+        if (warm_start && my_nlp->results.status !=
+                              Ipopt::SolverReturn::UNASSIGNED) {
+            seq_solver.warm_start();
+        } else {
+            my_nlp->initial_guess                      = x0;
+            my_nlp->initial_guess_multipliers          = y0;
+            my_nlp->initial_guess_bounds_multipliers_l = z_L0;
+            my_nlp->initial_guess_bounds_multipliers_u = z_U0;
+        }
+        status = seq_solver.solve();
+        resolve_durations += seq_solver.get_solve_time();
     }
     os.clear();
+    avg_duration += resolve_durations;
     avg_duration /= (N_exp + 1);
     auto evals = *problem.evaluations;
 
@@ -95,6 +107,15 @@ SolverResults run_ipopt_solver(auto &problem,
         .inner_iter         = nlp_res.iter_count,
         .extra              = {},
     };
+    // Time of the first solve (including the analysis of the structure),
+    // compared to the solves that reuse the application and the adapter
+    using sec = std::chrono::duration<real_t>;
+    results.extra.emplace_back("first_solve_time",
+                               duration_cast<sec>(first_duration).count());
+    if (N_exp > 0)
+        results.extra.emplace_back(
+            "resolve_time",
+            duration_cast<sec>(resolve_durations / N_exp).count());
     if (nlp_res.status != Ipopt::SolverReturn::UNASSIGNED)
         results.multipliers_bounds << nlp_res.solution_z_L,
             nlp_res.solution_z_U;
@@ -136,10 +157,12 @@ SharedSolverWrapper make_ipopt_drive_impl(std::string_view direction,
     auto solver    = make_ipopt_solver(opts);
     unsigned N_exp = 0;
     set_params(N_exp, "num_exp", opts);
+    bool warm_start = false;
+    set_params(warm_start, "warm_start", opts);
     return std::make_shared<SolverWrapper>(
-        [solver{std::move(solver)}, N_exp](
+        [solver{std::move(solver)}, N_exp, warm_start](
             LoadedProblem &problem, std::ostream &os) mutable -> SolverResults {
-            return run_ipopt_solver(problem, solver, os, N_exp);
+            return run_ipopt_solver(problem, solver, os, N_exp, warm_start);
         });
 }
 
@@ -1,3 +1,4 @@
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
 #include <alpaqa/inner/directions/pantr/newton-tr.hpp>
 #include <alpaqa/inner/pantr.hpp>
 #include <alpaqa/util/string-util.hpp>
@@ -47,6 +48,8 @@ SharedSolverWrapper make_pantr_like_solver(std::string_view direction,
     std::map<std::string_view, solver_builder_func> builders{
         {"newtontr", //
          builder(tag_t<alpaqa::NewtonTRDirection<config_t>>())},
+        {"lsr1tr", //
+         builder(tag_t<alpaqa::LSR1TRDirection<config_t>>())},
     };
     if (direction.empty())
         direction = "newtontr";
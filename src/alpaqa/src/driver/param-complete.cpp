@@ -10,6 +10,7 @@
 #include <alpaqa/inner/directions/panoc/lbfgs.hpp>
 #include <alpaqa/inner/directions/panoc/structured-lbfgs.hpp>
 #include <alpaqa/inner/directions/panoc/structured-newton.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
 #include <alpaqa/inner/directions/pantr/newton-tr.hpp>
 #include <alpaqa/inner/fista.hpp>
 #include <alpaqa/inner/internal/lipschitz.hpp>
@@ -18,6 +19,10 @@
 #include <alpaqa/inner/pantr.hpp>
 #include <alpaqa/inner/zerofpr.hpp>
 #include <alpaqa/outer/alm.hpp>
+#include <alpaqa/outer/result-cache.hpp>
+#include <alpaqa/problem/presolved-problem.hpp>
+#include <alpaqa/problem/scaled-problem.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
 #if ALPAQA_WITH_OCP
 #include <alpaqa/inner/panoc-ocp.hpp>
 #endif
@@ -111,9 +116,13 @@ struct Value {};
 struct Struct {};
 
 struct RootOpts {
-    [[no_unique_address]] Value method, out, sol, x0, mul_g0, mul_x0, num_exp;
-    bool extra_stats, show_funcs;
+    [[no_unique_address]] Value method, out, sol, x0, mul_g0, mul_x0, num_exp,
+        portfolio, max_allocs, trace, trace_capacity;
+    bool extra_stats, show_funcs, warm_start;
     Struct problem;
+    ResultCacheParams cache;
+    PresolveParams<config_t> presolve;
+    ProblemScalingParams<config_t> scaling;
 };
 
 #include <alpaqa/params/structs.ipp>
@@ -131,7 +140,15 @@ PARAMS_TABLE(
     PARAMS_MEMBER(num_exp, "Number of times to repeat the experiment"),     //
     PARAMS_MEMBER(extra_stats, "Log more per-iteration solver statistics"), //
     PARAMS_MEMBER(show_funcs, "Print the provided problem functions"),      //
+    PARAMS_MEMBER(warm_start, "Warm-start repeated Ipopt solves"),          //
+    PARAMS_MEMBER(portfolio, "Methods used by the portfolio solver"),       //
     PARAMS_MEMBER(problem, "Options to pass to the problem"),               //
+    PARAMS_MEMBER(cache, "Options for caching the solver results"),         //
+    PARAMS_MEMBER(presolve, "Options for reducing the problem"),            //
+    PARAMS_MEMBER(scaling, "Options for scaling the problem"),              //
+    PARAMS_MEMBER(max_allocs, "Maximum heap allocations in iterations"),    //
+    PARAMS_MEMBER(trace, "File to write a Chrome trace of the solver to"),  //
+    PARAMS_MEMBER(trace_capacity, "Maximum trace events per thread"),       //
 );
 
 PARAMS_TABLE(Struct);
@@ -228,9 +245,12 @@ const dict_t methods{
     {"zerofpr.anderson", {get_results_panoc_like<alpaqa::ZeroFPRSolver<alpaqa::AndersonDirection<config_t>>>, "ZeroFPR + Anderson acceleration solver"}},
     {"zerofpr.convex-newton", {get_results_panoc_like<alpaqa::PANOCSolver<alpaqa::ConvexNewtonDirection<config_t>>>, "ZeroFPR + Newton (for convex problems)"}},
     {"pantr", {get_results_panoc_like<alpaqa::PANTRSolver<alpaqa::NewtonTRDirection<config_t>>>, "PANTR solver"}},
+    {"pantr.newtontr", {get_results_panoc_like<alpaqa::PANTRSolver<alpaqa::NewtonTRDirection<config_t>>>, "PANTR + Newton trust-region solver"}},
+    {"pantr.lsr1tr", {get_results_panoc_like<alpaqa::PANTRSolver<alpaqa::LSR1TRDirection<config_t>>>, "PANTR + L-SR1 trust-region solver (Hessian-free)"}},
     {"fista", {get_results_fista_like<alpaqa::FISTASolver<config_t>>, "FISTA solver"}},
     {"ipopt", {alpaqa::params::get_members<void>, "Ipopt solver"}},
     {"qpalm", {alpaqa::params::get_members<void>, "QPALM solver"}},
+    {"portfolio", {get_results_panoc_like<alpaqa::PANOCSolver<alpaqa::LBFGSDirection<config_t>>>, "Race several solvers in parallel"}},
     // clang-format on
 };
 
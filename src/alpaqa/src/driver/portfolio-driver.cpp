@@ -0,0 +1,203 @@
+#include <alpaqa/inner/directions/panoc/anderson.hpp>
+#include <alpaqa/inner/directions/panoc/convex-newton.hpp>
+#include <alpaqa/inner/directions/panoc/lbfgs.hpp>
+#include <alpaqa/inner/directions/panoc/structured-lbfgs.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
+#include <alpaqa/inner/directions/pantr/newton-tr.hpp>
+#include <alpaqa/inner/panoc.hpp>
+#include <alpaqa/inner/pantr.hpp>
+#include <alpaqa/inner/zerofpr.hpp>
+#include <alpaqa/outer/portfolio.hpp>
+#include <alpaqa/util/string-util.hpp>
+
+#include "alm-driver.hpp"
+#include "cancel.hpp"
+#include "fista-driver.hpp"
+#include "portfolio-driver.hpp"
+#include "solver-driver.hpp"
+
+#include <functional>
+#include <map>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using PortfolioSolver = alpaqa::PortfolioSolver<config_t>;
+
+template <class T>
+struct tag_t {};
+
+/// Add the ALM solver for the given method (e.g. `panoc.lbfgs`) to the
+/// portfolio. All solvers use the same alm, solver, dir and accel options.
+void add_method(PortfolioSolver &portfolio, std::string_view method,
+                Options &opts) {
+    auto add = [&]<class InnerSolver>(tag_t<InnerSolver>) {
+        return [&] {
+            auto inner_solver = make_inner_solver<InnerSolver>(opts);
+            portfolio.add(std::string(method),
+                          make_alm_solver(std::move(inner_solver), opts));
+        };
+    };
+    auto add_fista = [&] {
+        portfolio.add(std::string(method),
+                      make_alm_solver(make_inner_fista_solver(opts), opts));
+    };
+    using alpaqa::PANOCSolver, alpaqa::ZeroFPRSolver, alpaqa::PANTRSolver;
+    using LBFGS        = alpaqa::LBFGSDirection<config_t>;
+    using Anderson     = alpaqa::AndersonDirection<config_t>;
+    using StrucLBFGS   = alpaqa::StructuredLBFGSDirection<config_t>;
+    using ConvexNewton = alpaqa::ConvexNewtonDirection<config_t>;
+    using NewtonTR     = alpaqa::NewtonTRDirection<config_t>;
+    using LSR1TR       = alpaqa::LSR1TRDirection<config_t>;
+    std::map<std::string_view, std::function<void()>> methods{
+        {"panoc.lbfgs", add(tag_t<PANOCSolver<LBFGS>>())},
+        {"panoc.anderson", add(tag_t<PANOCSolver<Anderson>>())},
+        {"panoc.struclbfgs", add(tag_t<PANOCSolver<StrucLBFGS>>())},
+        {"panoc.convex-newton", add(tag_t<PANOCSolver<ConvexNewton>>())},
+        {"zerofpr.lbfgs", add(tag_t<ZeroFPRSolver<LBFGS>>())},
+        {"zerofpr.anderson", add(tag_t<ZeroFPRSolver<Anderson>>())},
+        {"zerofpr.struclbfgs", add(tag_t<ZeroFPRSolver<StrucLBFGS>>())},
+        {"zerofpr.convex-newton", add(tag_t<ZeroFPRSolver<ConvexNewton>>())},
+        {"pantr.newtontr", add(tag_t<PANTRSolver<NewtonTR>>())},
+        {"pantr.lsr1tr", add(tag_t<PANTRSolver<LSR1TR>>())},
+        {"fista", add_fista},
+    };
+    // Select the default direction if none was given
+    std::string full_method{method};
+    if (method == "panoc" || method == "zerofpr")
+        full_method += ".lbfgs";
+    else if (method == "pantr")
+        full_method += ".newtontr";
+    auto method_it = methods.find(full_method);
+    if (method_it == methods.end())
+        throw std::invalid_argument(
+            "Unknown portfolio method '" + std::string(method) + "'\n" +
+            "  Available methods: " +
+            alpaqa::util::join(std::views::keys(methods)));
+    method_it->second();
+}
+
+SolverResults run_portfolio_solver(LoadedProblem &problem,
+                                   PortfolioSolver &solver, std::ostream &os,
+                                   unsigned N_exp) {
+    using Problem = PortfolioSolver::Problem;
+    solver.os     = &os;
+
+    // Give each solver its own copy of the problem if possible, otherwise
+    // all evaluations are serialized
+    std::vector<std::shared_ptr<alpaqa::EvalCounter>> clone_evals;
+    std::vector<Problem> clones;
+    if (problem.clone) {
+        for (index_t i = 0; i < solver.size(); ++i) {
+            clone_evals.push_back(std::make_shared<alpaqa::EvalCounter>());
+            clones.push_back(problem.clone(clone_evals.back()));
+        }
+    }
+    auto solve = [&](rvec x, rvec y, std::optional<rvec> Σ = std::nullopt) {
+        if (clones.empty())
+            return solver(problem.problem, x, y, Σ);
+        return solver(std::span<const Problem>{clones}, x, y, Σ);
+    };
+
+    // Initial guess
+    vec x = problem.initial_guess_x, y = problem.initial_guess_y;
+    // Final penalties
+    vec Σ = vec::Constant(problem.problem.get_m(), alpaqa::NaN<config_t>);
+
+    // Solve the problem
+    auto stats = solve(x, y, Σ);
+
+    // Solve the problems again to average runtimes
+    auto avg_duration = stats.time_to_solution;
+    os.setstate(std::ios_base::badbit); // suppress output
+    for (unsigned i = 0; i < N_exp; ++i) {
+        vec x_exp = problem.initial_guess_x, y_exp = problem.initial_guess_y;
+        auto s    = solve(x_exp, y_exp);
+        if (s.status == alpaqa::SolverStatus::Interrupted) {
+            os.clear();
+            os << "\rInterrupted after " << i << " runs" << std::endl;
+            N_exp = i;
+            break;
+        }
+        avg_duration += s.time_to_solution;
+    }
+    os.clear();
+    avg_duration /= (N_exp + 1);
+
+    solver.os = &std::cout;
+
+    // Store the evaluation counters of all solvers
+    auto evals = *problem.evaluations;
+    for (const auto &e : clone_evals)
+        evals += *e;
+
+    // Results
+    using seconds    = std::chrono::duration<real_t>;
+    const auto &win  = stats.entries[static_cast<size_t>(stats.winner)];
+    auto to_seconds  = [](auto t) { return seconds{t}.count(); };
+    decltype(SolverResults::extra) extra{};
+    extra.emplace_back("portfolio_winner", stats.winner_name);
+    extra.emplace_back("portfolio_time_to_solution",
+                       to_seconds(stats.time_to_solution));
+    extra.emplace_back("portfolio_elapsed_time",
+                       to_seconds(stats.elapsed_time));
+    extra.emplace_back("portfolio_cloned_problems", !clones.empty());
+    for (const auto &e : stats.entries) {
+        extra.emplace_back("portfolio_" + e.name + "_status",
+                           std::string(enum_name(e.status)));
+        extra.emplace_back("portfolio_" + e.name + "_time",
+                           to_seconds(e.elapsed_time));
+    }
+    return SolverResults{
+        .status             = enum_name(stats.status),
+        .success            = stats.status == alpaqa::SolverStatus::Converged,
+        .evals              = evals,
+        .duration           = avg_duration,
+        .solver             = solver.get_name(),
+        .h                  = win.final_h,
+        .δ                  = win.δ,
+        .ε                  = win.ε,
+        .γ                  = win.final_γ,
+        .Σ                  = win.norm_penalty,
+        .solution           = x,
+        .multipliers        = y,
+        .multipliers_bounds = vec(0),
+        .penalties          = Σ,
+        .outer_iter         = static_cast<index_t>(win.outer_iterations),
+        .inner_iter         = static_cast<index_t>(win.inner_iterations),
+        .extra              = std::move(extra),
+    };
+}
+
+} // namespace
+
+SharedSolverWrapper make_portfolio_driver(std::string_view direction,
+                                          Options &opts) {
+    if (!direction.empty())
+        throw std::invalid_argument(
+            "Portfolio solver does not support any directions, use the "
+            "portfolio option to select the methods");
+    std::string methods = "panoc.lbfgs,panoc.struclbfgs,zerofpr.lbfgs";
+    set_params(methods, "portfolio", opts);
+    // Problems without a clone function share counters that are not
+    // thread-safe, so they cannot simply be copied
+    PortfolioSolver solver{{.clone_problem = false}};
+    std::string_view remaining = methods;
+    while (!remaining.empty()) {
+        auto [method, rem] = alpaqa::util::split(remaining, ",");
+        if (!method.empty())
+            add_method(solver, method, opts);
+        remaining = rem;
+    }
+    if (solver.size() == 0)
+        throw std::invalid_argument("Portfolio should contain at least one "
+                                    "method");
+    unsigned N_exp = 0;
+    set_params(N_exp, "num_exp", opts);
+    return std::make_shared<SolverWrapper>(
+        [solver{std::move(solver)}, N_exp](
+            LoadedProblem &problem, std::ostream &os) mutable -> SolverResults {
+            auto cancel = alpaqa::attach_cancellation(solver);
+            return run_portfolio_solver(problem, solver, os, N_exp);
+        });
+}
@@ -2,6 +2,7 @@
 #include <alpaqa/params/params.hpp>
 #include <alpaqa/params/vec-from-file.hpp>
 #include <alpaqa/problem/problem-with-counters.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
 #include <alpaqa/problem/type-erased-problem.hpp>
 #include <alpaqa/util/io/csv.hpp>
 #if ALPAQA_WITH_DL
@@ -88,6 +89,57 @@ void count_problem(LoadedProblem &p) {
         p.nnz_hess_ψ = get_nnz(p.problem.get_hess_ψ_sparsity());
 }
 
+template <class P>
+LoadedProblem load_gen_problem(std::string_view name,
+                               std::span<std::string_view> prob_opts,
+                               Options &opts) {
+    using TEProblem  = alpaqa::TypeErasedProblem<config_t>;
+    using CntProblem = alpaqa::ProblemWithCounters<P>;
+    typename P::Params params;
+    for (auto opt : prob_opts) {
+        auto [key, value] = alpaqa::params::split_key(opt, '=');
+        alpaqa::params::set_param(
+            params, {.full_key = opt, .key = key, .value = value});
+    }
+    LoadedProblem problem{
+        .problem  = TEProblem::make<CntProblem>(std::in_place, params),
+        .abs_path = name,
+        .path     = name,
+    };
+    // The generated problems are self-contained, copies can be evaluated
+    // in parallel
+    problem.clone = [params](std::shared_ptr<alpaqa::EvalCounter> evals) {
+        CntProblem clone{std::in_place, params};
+        clone.evaluations = std::move(evals);
+        return TEProblem{std::move(clone)};
+    };
+    auto &cnt_problem       = problem.problem.as<CntProblem>();
+    auto &gen_problem       = cnt_problem.problem;
+    problem.name            = gen_problem.get_name();
+    problem.evaluations     = cnt_problem.evaluations;
+    problem.initial_guess_x = gen_problem.initial_guess;
+    load_initial_guess(opts, problem);
+    count_problem(problem);
+    return problem;
+}
+
+LoadedProblem load_gen_problem(std::string_view name,
+                               std::span<std::string_view> prob_opts,
+                               Options &opts) {
+    namespace syn = alpaqa::synthetic;
+    if (name == "chain")
+        return load_gen_problem<syn::ChainOCP>(name, prob_opts, opts);
+    if (name == "logreg")
+        return load_gen_problem<syn::LogisticRegression>(name, prob_opts, opts);
+    if (name == "qp")
+        return load_gen_problem<syn::RandomQP>(name, prob_opts, opts);
+    if (name == "rosenbrock")
+        return load_gen_problem<syn::ChainedRosenbrock>(name, prob_opts, opts);
+    throw std::invalid_argument(
+        "Unknown generated problem '" + std::string(name) +
+        "' (expected 'chain', 'logreg', 'qp' or 'rosenbrock')");
+}
+
 #if ALPAQA_WITH_DL
 LoadedProblem load_dl_problem(const fs::path &full_path,
                               std::span<std::string_view> prob_opts,
@@ -139,6 +191,13 @@ LoadedProblem load_cs_problem(const fs::path &full_path,
             "Incorrect problem parameter size (expected " +
             std::to_string(param_size) + ", but got " +
             std::to_string(cs_problem.param.size()) + ")");
+    // Copies of CasADi problems have their own workspaces, so they can be
+    // evaluated in parallel
+    problem.clone = [cs_problem](std::shared_ptr<alpaqa::EvalCounter> evals) {
+        CntProblem clone{cs_problem};
+        clone.evaluations = std::move(evals);
+        return TEProblem{std::move(clone)};
+    };
     load_initial_guess(opts, problem);
     count_problem(problem);
     return problem;
@@ -154,6 +213,20 @@ LoadedProblem load_cu_problem(const fs::path &full_path,
     alpaqa::params::set_params(outsdif_path, "outsdif", prob_opts);
     bool sparse = false;
     alpaqa::params::set_params(sparse, "sparse", prob_opts);
+    std::string load_mode_str = "shared";
+    alpaqa::params::set_params(load_mode_str, "load_mode", prob_opts);
+    using LoadMode = alpaqa::CUTEstLoadMode;
+    LoadMode load_mode;
+    if (load_mode_str == "shared")
+        load_mode = LoadMode::Shared;
+    else if (load_mode_str == "namespace")
+        load_mode = LoadMode::Namespace;
+    else if (load_mode_str == "copy")
+        load_mode = LoadMode::Copy;
+    else
+        throw std::invalid_argument(
+            "Invalid value for problem.load_mode: '" + load_mode_str +
+            "' (expected 'shared', 'namespace' or 'copy')");
     static std::mutex mtx;
     std::unique_lock lck{mtx};
     using TEProblem  = alpaqa::TypeErasedProblem<config_t>;
@@ -161,11 +234,24 @@ LoadedProblem load_cu_problem(const fs::path &full_path,
     using CntProblem = alpaqa::ProblemWithCounters<CuProblem>;
     LoadedProblem problem{
         .problem = TEProblem::make<CntProblem>(std::in_place, full_path.c_str(),
-                                               outsdif_path.c_str(), sparse),
+                                               outsdif_path.c_str(), sparse,
+                                               load_mode),
         .abs_path = fs::absolute(full_path),
         .path     = full_path,
     };
     lck.unlock();
+    // Problems that do not share their global state with other instances can
+    // be evaluated in parallel, so load a new instance for each clone
+    if (load_mode != LoadMode::Shared)
+        problem.clone = [full_path, outsdif_path, sparse, load_mode](
+                            std::shared_ptr<alpaqa::EvalCounter> evals) {
+            std::unique_lock lck{mtx};
+            CntProblem clone{std::in_place, full_path.c_str(),
+                             outsdif_path.c_str(), sparse, load_mode};
+            lck.unlock();
+            clone.evaluations = std::move(evals);
+            return TEProblem{std::move(clone)};
+        };
     auto &cnt_problem       = problem.problem.as<CntProblem>();
     auto &cu_problem        = cnt_problem.problem;
     problem.name            = cu_problem.get_name();
@@ -223,6 +309,8 @@ LoadedProblem load_problem(std::string_view type, const fs::path &dir,
         throw std::logic_error(
             "This version of alpaqa was compiled without CUTEst support");
 #endif
+    } else if (type == "gen") {
+        return load_gen_problem(file.string(), prob_opts, opts);
     }
     throw std::invalid_argument("Unknown problem type '" + std::string(type) +
                                 "'");
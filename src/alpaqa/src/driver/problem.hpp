@@ -7,6 +7,7 @@
 #include "options.hpp"
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 namespace fs = std::filesystem;
@@ -34,6 +35,12 @@ struct LoadedProblem {
                                general_constr_count = std::nullopt;
     std::optional<length_t> nnz_jac_g = std::nullopt, nnz_hess_L = std::nullopt,
                             nnz_hess_ψ = std::nullopt;
+    /// Creates an independent copy of the problem that can be evaluated
+    /// concurrently with the original, and that counts its evaluations in the
+    /// given counters. Empty if the problem cannot safely be copied.
+    std::function<alpaqa::TypeErasedProblem<config_t>(
+        std::shared_ptr<alpaqa::EvalCounter>)>
+        clone = nullptr;
 };
 
 LoadedProblem load_problem(std::string_view type, const fs::path &dir,
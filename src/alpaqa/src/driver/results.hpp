@@ -4,6 +4,7 @@
 #include <alpaqa/problem/kkt-error.hpp>
 #include <alpaqa/problem/ocproblem-counters.hpp>
 #include <alpaqa/problem/problem-counters.hpp>
+#include <alpaqa/util/alloc-accounting.hpp>
 #include <alpaqa/util/print.hpp>
 
 #include <bit>
@@ -12,6 +13,7 @@
 #include <iomanip>
 #include <map>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <string_view>
 #include <variant>
@@ -36,6 +38,8 @@ struct SolverResults {
     using any_stat_t = std::variant<index_t, real_t, std::string, bool, vec,
                                     std::vector<real_t>>;
     std::vector<std::pair<std::string, any_stat_t>> extra{};
+    /// Heap allocations per solver phase (if available).
+    std::optional<alpaqa::AllocStats> allocations{};
 };
 
 struct BenchmarkResults {
@@ -177,6 +181,8 @@ inline void print_results(std::ostream &os, const BenchmarkResults &results) {
         };
         std::visit(print, value);
     }
+    if (solstats.allocations)
+        os << "\nheap allocations:\n" << *solstats.allocations;
     os << std::endl;
 }
 
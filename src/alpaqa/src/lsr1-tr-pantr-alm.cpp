@@ -0,0 +1,19 @@
+#include <alpaqa/implementation/inner/pantr.tpp>
+#include <alpaqa/implementation/outer/alm.tpp>
+#include <alpaqa/lsr1-tr-pantr-alm.hpp>
+
+namespace alpaqa {
+
+// clang-format off
+ALPAQA_EXPORT_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigd>);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigf>);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigl>);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, PANTRSolver, LSR1TRDirection<EigenConfigq>);)
+
+ALPAQA_EXPORT_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigd>>);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigf>>);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigl>>);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, ALMSolver, PANTRSolver<LSR1TRDirection<EigenConfigq>>);)
+// clang-format on
+
+} // namespace alpaqa
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include <alpaqa/implementation/outer/portfolio.tpp>
+
+namespace alpaqa {
+
+// clang-format off
+ALPAQA_EXPORT_TEMPLATE(class, PortfolioSolver, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, PortfolioSolver, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, PortfolioSolver, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, PortfolioSolver, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
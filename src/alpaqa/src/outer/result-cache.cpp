@@ -0,0 +1,31 @@
+#include <alpaqa/implementation/outer/result-cache.tpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace alpaqa {
+
+ResultCacheKey &ResultCacheKey::add_file(const std::filesystem::path &path) {
+    std::ifstream f{path, std::ios::binary};
+    if (!f)
+        return *this;
+    std::array<char, 4096> buf;
+    while (f.read(buf.data(), buf.size()) || f.gcount() > 0)
+        add(std::as_bytes(
+            std::span{buf.data(), static_cast<size_t>(f.gcount())}));
+    return *this;
+}
+
+std::string ResultCacheKey::str() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << state;
+    return std::move(ss).str();
+}
+
+ALPAQA_EXPORT_TEMPLATE(class, ResultCache, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, ResultCache, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, ResultCache, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, ResultCache, EigenConfigq);)
+
+} // namespace alpaqa
@@ -15,6 +15,7 @@
 #include <alpaqa/inner/directions/panoc/lbfgs.hpp>
 #include <alpaqa/inner/directions/panoc/structured-lbfgs.hpp>
 #include <alpaqa/inner/directions/panoc/structured-newton.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
 #include <alpaqa/inner/directions/pantr/newton-tr.hpp>
 #include <alpaqa/inner/fista.hpp>
 #include <alpaqa/inner/internal/lipschitz.hpp>
@@ -23,6 +24,10 @@
 #include <alpaqa/inner/pantr.hpp>
 #include <alpaqa/inner/zerofpr.hpp>
 #include <alpaqa/outer/alm.hpp>
+#include <alpaqa/outer/result-cache.hpp>
+#include <alpaqa/problem/presolved-problem.hpp>
+#include <alpaqa/problem/scaled-problem.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
 #if ALPAQA_WITH_OCP
 #include <alpaqa/inner/panoc-ocp.hpp>
 #endif
@@ -221,22 +226,34 @@ ALPAQA_SET_PARAM_INST(std::chrono::hours);
 
 ALPAQA_SET_PARAM_INST(PANOCStopCrit);
 ALPAQA_SET_PARAM_INST(LBFGSStepSize);
+ALPAQA_SET_PARAM_INST(SteihaugCGPreconditioner);
+ALPAQA_SET_PARAM_INST(StructuredNewtonRegularization);
+ALPAQA_SET_PARAM_INST(ProblemScaling);
 ALPAQA_SET_PARAM_INST(PANOCParams<config_t>);
 ALPAQA_SET_PARAM_INST(FISTAParams<config_t>);
 ALPAQA_SET_PARAM_INST(ZeroFPRParams<config_t>);
 ALPAQA_SET_PARAM_INST(PANTRParams<config_t>);
 ALPAQA_SET_PARAM_INST(LBFGSParams<config_t>);
+ALPAQA_SET_PARAM_INST(LSR1Params<config_t>);
 ALPAQA_SET_PARAM_INST(AndersonAccelParams<config_t>);
 ALPAQA_SET_PARAM_INST(LBFGSDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(AndersonDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(StructuredLBFGSDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(NewtonTRDirectionParams<config_t>);
+ALPAQA_SET_PARAM_INST(LSR1TRDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(SteihaugCGParams<config_t>);
 ALPAQA_SET_PARAM_INST(StructuredNewtonRegularizationParams<config_t>);
 ALPAQA_SET_PARAM_INST(StructuredNewtonDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(ConvexNewtonRegularizationParams<config_t>);
 ALPAQA_SET_PARAM_INST(ConvexNewtonDirectionParams<config_t>);
 ALPAQA_SET_PARAM_INST(ALMParams<config_t>);
+ALPAQA_SET_PARAM_INST(ResultCacheParams);
+ALPAQA_SET_PARAM_INST(PresolveParams<config_t>);
+ALPAQA_SET_PARAM_INST(synthetic::ChainOCPParams);
+ALPAQA_SET_PARAM_INST(synthetic::LogisticRegressionParams);
+ALPAQA_SET_PARAM_INST(synthetic::RandomQPParams);
+ALPAQA_SET_PARAM_INST(synthetic::ChainedRosenbrockParams);
+ALPAQA_SET_PARAM_INST(ProblemScalingParams<config_t>);
 #if ALPAQA_WITH_OCP
 ALPAQA_SET_PARAM_INST(PANOCOCPParams<config_t>);
 #endif
@@ -0,0 +1,107 @@
+#include <alpaqa/outer/result-cache.hpp>
+#include <alpaqa/params/structs.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include <alpaqa/inner/directions/panoc/anderson.hpp>
+#include <alpaqa/inner/directions/panoc/convex-newton.hpp>
+#include <alpaqa/inner/directions/panoc/lbfgs.hpp>
+#include <alpaqa/inner/directions/panoc/structured-lbfgs.hpp>
+#include <alpaqa/inner/directions/panoc/structured-newton.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
+#include <alpaqa/inner/directions/pantr/newton-tr.hpp>
+#include <alpaqa/inner/fista.hpp>
+#include <alpaqa/inner/internal/lipschitz.hpp>
+#include <alpaqa/inner/internal/panoc-stop-crit.hpp>
+#include <alpaqa/inner/panoc.hpp>
+#include <alpaqa/inner/pantr.hpp>
+#include <alpaqa/inner/zerofpr.hpp>
+#include <alpaqa/outer/alm.hpp>
+#include <alpaqa/problem/presolved-problem.hpp>
+#include <alpaqa/problem/scaled-problem.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#if ALPAQA_WITH_OCP
+#include <alpaqa/inner/panoc-ocp.hpp>
+#endif
+
+namespace alpaqa::params {
+
+template <class T>
+void add_member_to_key(ResultCacheKey &key, const T &t);
+
+/// Adds the value of a struct attribute to a @ref ResultCacheKey.
+template <>
+struct attribute_accessor<ResultCacheKey> {
+    template <class T, class T_actual, class A>
+    static attribute_accessor make(A T_actual::*attr, std::string_view = "") {
+        return {
+            .add{[attr](const any_ptr &t, ResultCacheKey &key) {
+                add_member_to_key(key, t.template cast<const T>()->*attr);
+            }},
+        };
+    }
+    std::function<void(const any_ptr &, ResultCacheKey &)> add;
+};
+
+template <class T>
+inline constexpr bool is_duration = false;
+template <class Rep, class Period>
+inline constexpr bool is_duration<std::chrono::duration<Rep, Period>> = true;
+
+using config_t = DefaultConfig;
+
+#include <alpaqa/params/structs.ipp>
+
+template <class T>
+void add_member_to_key(ResultCacheKey &key, const T &t) {
+    if constexpr (requires { attribute_table<T, ResultCacheKey>::table; }) {
+        // Names are included to distinguish e.g. default-initialized members
+        // that were added in newer versions
+        for (const auto &[name, accessor] :
+             attribute_table<T, ResultCacheKey>::table) {
+            key.add(name);
+            accessor.add(&t, key);
+        }
+    } else if constexpr (std::is_enum_v<T>) {
+        key.add(static_cast<std::underlying_type_t<T>>(t));
+    } else if constexpr (std::integral<T> || std::floating_point<T>) {
+        key.add(t);
+    } else if constexpr (is_duration<T>) {
+        key.add(std::chrono::duration_cast<std::chrono::nanoseconds>(t)
+                    .count());
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        key.add(std::string_view{t});
+    } else {
+        static_assert(std::is_void_v<T>, "Unsupported parameter type");
+    }
+}
+
+#define ALPAQA_ADD_TO_KEY(type)                                                \
+    void add_to_key(ResultCacheKey &key, const type<DefaultConfig> &p) {       \
+        add_member_to_key(key, p);                                             \
+    }
+
+ALPAQA_ADD_TO_KEY(ALMParams)
+ALPAQA_ADD_TO_KEY(PANOCParams)
+ALPAQA_ADD_TO_KEY(ZeroFPRParams)
+ALPAQA_ADD_TO_KEY(PANTRParams)
+ALPAQA_ADD_TO_KEY(FISTAParams)
+ALPAQA_ADD_TO_KEY(LBFGSParams)
+ALPAQA_ADD_TO_KEY(LBFGSDirectionParams)
+ALPAQA_ADD_TO_KEY(AndersonAccelParams)
+ALPAQA_ADD_TO_KEY(AndersonDirectionParams)
+ALPAQA_ADD_TO_KEY(StructuredLBFGSDirectionParams)
+ALPAQA_ADD_TO_KEY(StructuredNewtonDirectionParams)
+ALPAQA_ADD_TO_KEY(ConvexNewtonDirectionParams)
+ALPAQA_ADD_TO_KEY(SteihaugCGParams)
+ALPAQA_ADD_TO_KEY(NewtonTRDirectionParams)
+ALPAQA_ADD_TO_KEY(LSR1Params)
+ALPAQA_ADD_TO_KEY(LSR1TRDirectionParams)
+
+#undef ALPAQA_ADD_TO_KEY
+
+} // namespace alpaqa::params
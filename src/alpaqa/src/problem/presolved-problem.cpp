@@ -0,0 +1,16 @@
+#include <alpaqa/implementation/problem/presolved-problem.tpp>
+
+namespace alpaqa {
+
+// clang-format off
+ALPAQA_EXPORT_TEMPLATE(struct, PresolveParams, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(struct, PresolveParams, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(struct, PresolveParams, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(struct, PresolveParams, EigenConfigq);)
+ALPAQA_EXPORT_TEMPLATE(class, PresolvedProblem, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, PresolvedProblem, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, PresolvedProblem, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, PresolvedProblem, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
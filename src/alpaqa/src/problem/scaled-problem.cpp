@@ -0,0 +1,16 @@
+#include <alpaqa/implementation/problem/scaled-problem.tpp>
+
+namespace alpaqa {
+
+// clang-format off
+ALPAQA_EXPORT_TEMPLATE(struct, ProblemScalingParams, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(struct, ProblemScalingParams, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(struct, ProblemScalingParams, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(struct, ProblemScalingParams, EigenConfigq);)
+ALPAQA_EXPORT_TEMPLATE(class, ScaledProblem, EigenConfigd);
+ALPAQA_IF_FLOAT(ALPAQA_EXPORT_TEMPLATE(class, ScaledProblem, EigenConfigf);)
+ALPAQA_IF_LONGD(ALPAQA_EXPORT_TEMPLATE(class, ScaledProblem, EigenConfigl);)
+ALPAQA_IF_QUADF(ALPAQA_EXPORT_TEMPLATE(class, ScaledProblem, EigenConfigq);)
+// clang-format on
+
+} // namespace alpaqa
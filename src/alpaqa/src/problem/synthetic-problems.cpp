@@ -0,0 +1,830 @@
+#include <alpaqa/problem/synthetic-problems.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace alpaqa::synthetic {
+
+namespace {
+
+USING_ALPAQA_CONFIG(DefaultConfig);
+using storage_index_t = SparsePattern::storage_index_t;
+using spmat           = SparsePattern::spmat;
+using triplet_t       = Eigen::Triplet<real_t, storage_index_t>;
+using rng_t           = std::mt19937_64;
+
+spmat from_triplets(length_t rows, length_t cols,
+                    const std::vector<triplet_t> &triplets) {
+    spmat A(rows, cols);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+    A.makeCompressed();
+    return A;
+}
+
+/// Random matrix with normally distributed nonzeros. The positions of the
+/// nonzeros are sampled by skipping a geometrically distributed number of
+/// elements, so the cost is proportional to the number of nonzeros.
+spmat random_sparse(length_t rows, length_t cols, real_t density, rng_t &rng) {
+    if (!(density > 0 && density <= 1))
+        throw std::invalid_argument("density should be in (0, 1]");
+    std::vector<triplet_t> triplets;
+    triplets.reserve(static_cast<size_t>(
+        density * static_cast<real_t>(rows) * static_cast<real_t>(cols) + 1));
+    std::normal_distribution<real_t> normal;
+    std::geometric_distribution<length_t> skip{static_cast<double>(density)};
+    for (index_t c = 0; c < cols; ++c)
+        for (index_t r = skip(rng); r < rows; r += 1 + skip(rng))
+            triplets.emplace_back(static_cast<storage_index_t>(r),
+                                  static_cast<storage_index_t>(c),
+                                  normal(rng));
+    return from_triplets(rows, cols, triplets);
+}
+
+/// Upper triangle of the given sparse matrix, plus a diagonal.
+spmat upper_plus_diag(const spmat &A, real_t diag) {
+    std::vector<triplet_t> triplets;
+    triplets.reserve(static_cast<size_t>(A.nonZeros() + A.cols()));
+    for (index_t c = 0; c < A.outerSize(); ++c) {
+        for (spmat::InnerIterator it(A, c); it; ++it)
+            if (it.row() <= it.col())
+                triplets.emplace_back(it.row(), it.col(), it.value());
+        triplets.emplace_back(c, c, diag);
+    }
+    return from_triplets(A.rows(), A.cols(), triplets);
+}
+
+SparsePattern diagonal_pattern(length_t n) {
+    std::vector<triplet_t> triplets;
+    triplets.reserve(static_cast<size_t>(n));
+    for (index_t i = 0; i < n; ++i)
+        triplets.emplace_back(i, i, 0);
+    return {from_triplets(n, n, triplets), sparsity::Symmetry::Upper};
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------//
+// Sparse matrix helpers
+// ---------------------------------------------------------------------------//
+
+auto SparsePattern::sparsity() const -> Sparsity {
+    using SparseCSC = sparsity::SparseCSC<config_t, storage_index_t>;
+    using map_t     = typename SparseCSC::index_vector_map_t;
+    return SparseCSC{
+        .rows      = pattern.rows(),
+        .cols      = pattern.cols(),
+        .symmetry  = symmetry,
+        .inner_idx = map_t{pattern.innerIndexPtr(), pattern.nonZeros()},
+        .outer_ptr = map_t{pattern.outerIndexPtr(), pattern.cols() + 1},
+        .order     = SparseCSC::SortedRows,
+    };
+}
+
+auto SparsePattern::find(index_t r, index_t c) const -> index_t {
+    const auto *inner = pattern.innerIndexPtr();
+    const auto *begin = inner + pattern.outerIndexPtr()[c];
+    const auto *end   = inner + pattern.outerIndexPtr()[c + 1];
+    const auto *it    = std::lower_bound(begin, end,
+                                         static_cast<storage_index_t>(r));
+    if (it == end || *it != r)
+        throw std::out_of_range("Element (" + std::to_string(r) + ", " +
+                                std::to_string(c) +
+                                ") is not part of the sparsity pattern");
+    return it - inner;
+}
+
+auto SparsePattern::map(crvec values) const -> Eigen::Map<const spmat> {
+    return {pattern.rows(),          pattern.cols(),
+            pattern.nonZeros(),      pattern.outerIndexPtr(),
+            pattern.innerIndexPtr(), values.data()};
+}
+
+AugLagHessian::AugLagHessian(const SparsePattern &jac_g,
+                             const SparsePattern &hess_L)
+    : jac_g{jac_g} {
+    const auto &J = jac_g.pattern;
+    const auto &H = hess_L.pattern;
+    const auto m = J.rows(), n = J.cols();
+    const auto *J_outer = J.outerIndexPtr(), *J_inner = J.innerIndexPtr();
+    // Convert the Jacobian to compressed sparse row format
+    row_ptr = index_vec::Zero(m + 1);
+    row_col.resize(J.nonZeros()), row_nz.resize(J.nonZeros());
+    for (index_t k = 0; k < J.nonZeros(); ++k)
+        ++row_ptr(J_inner[k] + 1);
+    for (index_t i = 0; i < m; ++i)
+        row_ptr(i + 1) += row_ptr(i);
+    index_vec next = row_ptr.topRows(m);
+    for (storage_index_t c = 0; c < n; ++c) {
+        for (auto k = J_outer[c]; k < J_outer[c + 1]; ++k) {
+            auto p     = next(J_inner[k])++;
+            row_col(p) = c;
+            row_nz(p)  = k;
+        }
+    }
+    // The pattern is the union of the patterns of ∇²L and JᵀJ (upper part)
+    std::vector<triplet_t> triplets;
+    triplets.reserve(static_cast<size_t>(H.nonZeros() + n));
+    for (storage_index_t c = 0; c < H.cols(); ++c)
+        for (auto k = H.outerIndexPtr()[c]; k < H.outerIndexPtr()[c + 1]; ++k)
+            triplets.emplace_back(H.innerIndexPtr()[k], c, 0);
+    index_vec last_col = index_vec::Constant(n, -1);
+    for (storage_index_t c = 0; c < n; ++c) {
+        for (auto k = J_outer[c]; k < J_outer[c + 1]; ++k) {
+            auto i = J_inner[k];
+            for (auto p = row_ptr(i); p < row_ptr(i + 1); ++p) {
+                auto r = row_col(p);
+                if (r > c)
+                    break;
+                if (last_col(r) != c) {
+                    last_col(r) = c;
+                    triplets.emplace_back(r, c, 0);
+                }
+            }
+        }
+    }
+    pattern = {from_triplets(n, n, triplets), sparsity::Symmetry::Upper};
+    // Where to add the nonzeros of ∇²L
+    from_hess_L.resize(H.nonZeros());
+    for (storage_index_t c = 0; c < H.cols(); ++c)
+        for (auto k = H.outerIndexPtr()[c]; k < H.outerIndexPtr()[c + 1]; ++k)
+            from_hess_L(k) = static_cast<storage_index_t>(
+                pattern.find(H.innerIndexPtr()[k], c));
+    work = vec::Zero(n);
+}
+
+void AugLagHessian::eval_ŷ_active(const Box &D, crvec g, crvec y, crvec Σ,
+                                  rvec ŷ, rvec Σ_active) {
+    for (index_t i = 0; i < g.size(); ++i) {
+        real_t ζ    = g(i) + y(i) / Σ(i);
+        real_t ẑ    = std::clamp(ζ, D.lowerbound(i), D.upperbound(i));
+        ŷ(i)        = Σ(i) * (ζ - ẑ);
+        Σ_active(i) = ζ != ẑ ? Σ(i) : 0;
+    }
+}
+
+void AugLagHessian::assemble(crvec hess_L_values, crvec jac_g_values,
+                             crvec Σ_active, rvec H_values) const {
+    const auto &J = jac_g.pattern;
+    const auto &H = pattern.pattern;
+    H_values.setZero();
+    for (index_t k = 0; k < from_hess_L.size(); ++k)
+        H_values(from_hess_L(k)) += hess_L_values(k);
+    // Column c of the upper triangle of JᵀΣJ is the sum over all rows i of J
+    // with a nonzero in column c of Σᵢ Jᵢc Jᵢr, for r ≤ c
+    for (index_t c = 0; c < J.cols(); ++c) {
+        for (auto k = J.outerIndexPtr()[c]; k < J.outerIndexPtr()[c + 1]; ++k) {
+            auto i = J.innerIndexPtr()[k];
+            if (Σ_active(i) == 0)
+                continue;
+            real_t Σ_Jic = Σ_active(i) * jac_g_values(k);
+            for (auto p = row_ptr(i); p < row_ptr(i + 1); ++p) {
+                if (row_col(p) > c)
+                    break;
+                work(row_col(p)) += Σ_Jic * jac_g_values(row_nz(p));
+            }
+        }
+        // Gather the column into the Hessian and reset the work vector
+        for (auto q = H.outerIndexPtr()[c]; q < H.outerIndexPtr()[c + 1]; ++q) {
+            auto r = H.innerIndexPtr()[q];
+            H_values(q) += work(r);
+            work(r) = 0;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------//
+// Chain of masses
+// ---------------------------------------------------------------------------//
+
+namespace {
+std::tuple<length_t, length_t> dims(const ChainOCPParams &p) {
+    if (p.N < 1)
+        throw std::invalid_argument("ChainOCP: N should be positive");
+    if (p.nx < 2 || p.nx % 2 != 0)
+        throw std::invalid_argument("ChainOCP: nx should be a positive even "
+                                    "number");
+    if (p.nu < 1 || p.nu > p.nx / 2)
+        throw std::invalid_argument("ChainOCP: nu should be between 1 and "
+                                    "nx / 2");
+    return {p.N * (p.nx + p.nu), p.N * p.nx};
+}
+} // namespace
+
+ChainOCP::ChainOCP(const Params &p)
+    : BoxConstrProblem<config_t>{dims(p)}, params{p} {
+    const auto N = p.N, nx = p.nx, nu = p.nu;
+    M            = nx / 2;
+    // Initial state: uniformly stretched springs, at rest
+    x_init = vec::Zero(nx);
+    for (index_t i = 0; i < M; ++i)
+        x_init(i) = p.x_init * static_cast<real_t>(i + 1) /
+                    static_cast<real_t>(M);
+    // Initial guess: zero inputs, all states equal to the initial state
+    initial_guess = vec::Zero(n);
+    weights.resize(n);
+    for (index_t k = 0; k < N; ++k) {
+        initial_guess.segment(x_offset(k + 1), nx) = x_init;
+        weights.segment(u_offset(k), nu).setConstant(p.r);
+        weights.segment(x_offset(k + 1), nx)
+            .setConstant(k + 1 < N ? p.q : p.q_N);
+        C.lowerbound.segment(u_offset(k), nu).setConstant(-p.u_max);
+        C.upperbound.segment(u_offset(k), nu).setConstant(+p.u_max);
+    }
+    D.lowerbound.setZero();
+    D.upperbound.setZero();
+    // Sparsity of the Jacobian of the dynamics constraints
+    std::vector<triplet_t> triplets;
+    auto add = [&](index_t r, index_t c) {
+        triplets.emplace_back(static_cast<storage_index_t>(r),
+                              static_cast<storage_index_t>(c), 0);
+    };
+    for (index_t k = 0; k < N; ++k) {
+        const auto r0 = k * nx;
+        for (index_t i = 0; i < nx; ++i)
+            add(r0 + i, x_offset(k + 1) + i);
+        for (index_t j = 0; j < nu; ++j)
+            add(r0 + M + M - nu + j, u_offset(k) + j);
+        if (k == 0)
+            continue;
+        const auto c0 = x_offset(k);
+        for (index_t i = 0; i < M; ++i) {
+            add(r0 + i, c0 + i);
+            add(r0 + i, c0 + M + i);
+            add(r0 + M + i, c0 + M + i);
+            add(r0 + M + i, c0 + i);
+            if (i > 0) {
+                add(r0 + M + i, c0 + i - 1);
+                add(r0 + M + i - 1, c0 + i);
+            }
+        }
+    }
+    jac_g = {from_triplets(m, n, triplets), sparsity::Symmetry::Unsymmetric};
+    // Sparsity of the Hessian of the Lagrangian: diagonal cost, tridiagonal
+    // position blocks due to the nonlinear springs
+    triplets.clear();
+    for (index_t i = 0; i < n; ++i)
+        add(i, i);
+    for (index_t k = 1; k < N; ++k)
+        for (index_t i = 1; i < M; ++i)
+            add(x_offset(k) + i - 1, x_offset(k) + i);
+    hess_L = {from_triplets(n, n, triplets), sparsity::Symmetry::Upper};
+    hess_ψ = AugLagHessian{jac_g, hess_L};
+    work_ŷ.resize(m), work_Σ.resize(m), work_Jv.resize(m);
+    work_J.resize(jac_g.nnz()), work_H.resize(hess_L.nnz());
+}
+
+std::string ChainOCP::get_name() const {
+    return "chain of masses (N=" + std::to_string(params.N) +
+           ", nx=" + std::to_string(params.nx) +
+           ", nu=" + std::to_string(params.nu) + ")";
+}
+
+auto ChainOCP::state(crvec x, index_t k) const -> crvec {
+    if (k == 0)
+        return x_init;
+    return x.segment(x_offset(k), params.nx);
+}
+
+auto ChainOCP::elongation(crvec p, index_t i) const -> real_t {
+    return i > 0 ? p(i) - p(i - 1) : p(i);
+}
+
+void ChainOCP::eval_forces(crvec p, crvec v, rvec F) const {
+    auto spring = [&](index_t i) {
+        real_t d = elongation(p, i);
+        return params.k * d + params.k3 * d * d * d;
+    };
+    for (index_t i = 0; i < M; ++i) {
+        F(i) = -spring(i) - params.c * v(i);
+        if (i + 1 < M)
+            F(i) += spring(i + 1);
+    }
+}
+
+auto ChainOCP::eval_f(crvec x) const -> real_t {
+    return real_t(0.5) * (weights.array() * x.array().square()).sum();
+}
+
+void ChainOCP::eval_grad_f(crvec x, rvec grad_fx) const {
+    grad_fx = weights.cwiseProduct(x);
+}
+
+auto ChainOCP::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    eval_grad_f(x, grad_fx);
+    return real_t(0.5) * x.dot(grad_fx);
+}
+
+void ChainOCP::eval_g(crvec x, rvec gx) const {
+    const auto nx = params.nx, nu = params.nu;
+    const auto Ts = params.Ts;
+    for (index_t k = 0; k < params.N; ++k) {
+        auto xk = state(x, k);
+        auto p = xk.topRows(M), v = xk.bottomRows(M);
+        auto u    = x.segment(u_offset(k), nu);
+        auto xk1  = x.segment(x_offset(k + 1), nx);
+        auto gk   = gx.segment(k * nx, nx);
+        auto gk_v = gk.bottomRows(M);
+        eval_forces(p, v, gk_v);
+        gk_v.bottomRows(nu) += u;
+        gk.topRows(M) = xk1.topRows(M) - p - Ts * v;
+        gk_v          = xk1.bottomRows(M) - v - Ts * gk_v;
+    }
+}
+
+void ChainOCP::eval_grad_g_prod(crvec x, crvec y, rvec grad_gxy) const {
+    const auto nx = params.nx, nu = params.nu;
+    const auto Ts = params.Ts, c = params.c;
+    grad_gxy.setZero();
+    for (index_t k = 0; k < params.N; ++k) {
+        auto yk = y.segment(k * nx, nx);
+        auto yp = yk.topRows(M), yv = yk.bottomRows(M);
+        grad_gxy.segment(x_offset(k + 1), nx) += yk;
+        grad_gxy.segment(u_offset(k), nu) -= Ts * yv.bottomRows(nu);
+        if (k == 0)
+            continue;
+        auto p  = x.segment(x_offset(k), M);
+        auto gp = grad_gxy.segment(x_offset(k), M);
+        auto gv = grad_gxy.segment(x_offset(k) + M, M);
+        gp -= yp;
+        gv -= Ts * yp + (1 - Ts * c) * yv;
+        // Product with the (symmetric) stiffness matrix ∂F/∂p
+        for (index_t l = 0; l < M; ++l) {
+            real_t d  = elongation(p, l);
+            real_t ds = params.k + 3 * params.k3 * d * d;
+            real_t δ  = yv(l) - (l > 0 ? yv(l - 1) : 0);
+            gp(l) += Ts * ds * δ;
+            if (l > 0)
+                gp(l - 1) -= Ts * ds * δ;
+        }
+    }
+}
+
+void ChainOCP::eval_jac_g(crvec x, rvec J_values) const {
+    const auto nx = params.nx, nu = params.nu;
+    const auto Ts = params.Ts, c = params.c;
+    auto J        = [&](index_t r, index_t c) -> real_t & {
+        return J_values(jac_g.find(r, c));
+    };
+    J_values.setZero();
+    for (index_t k = 0; k < params.N; ++k) {
+        const auto r0 = k * nx;
+        for (index_t i = 0; i < nx; ++i)
+            J(r0 + i, x_offset(k + 1) + i) = 1;
+        for (index_t j = 0; j < nu; ++j)
+            J(r0 + M + M - nu + j, u_offset(k) + j) = -Ts;
+        if (k == 0)
+            continue;
+        const auto c0 = x_offset(k);
+        auto p        = x.segment(c0, M);
+        for (index_t i = 0; i < M; ++i) {
+            J(r0 + i, c0 + i)         = -1;
+            J(r0 + i, c0 + M + i)     = -Ts;
+            J(r0 + M + i, c0 + M + i) = -(1 - Ts * c);
+        }
+        for (index_t l = 0; l < M; ++l) {
+            real_t d  = elongation(p, l);
+            real_t ds = params.k + 3 * params.k3 * d * d;
+            J(r0 + M + l, c0 + l) += Ts * ds;
+            if (l > 0) {
+                J(r0 + M + l - 1, c0 + l - 1) += Ts * ds;
+                J(r0 + M + l, c0 + l - 1) -= Ts * ds;
+                J(r0 + M + l - 1, c0 + l) -= Ts * ds;
+            }
+        }
+    }
+}
+
+auto ChainOCP::get_jac_g_sparsity() const -> Sparsity {
+    return jac_g.sparsity();
+}
+
+void ChainOCP::eval_hess_L_prod(crvec x, crvec y, real_t scale, crvec v,
+                                rvec Hv) const {
+    const auto Ts = params.Ts;
+    Hv            = scale * weights.cwiseProduct(v);
+    for (index_t k = 1; k < params.N; ++k) {
+        const auto c0 = x_offset(k);
+        auto yv       = y.segment(k * params.nx + M, M);
+        auto p        = x.segment(c0, M);
+        for (index_t l = 0; l < M; ++l) {
+            real_t d   = elongation(p, l);
+            real_t γ   = 6 * params.k3 * d * ((l > 0 ? yv(l - 1) : 0) - yv(l));
+            real_t av  = v(c0 + l) - (l > 0 ? v(c0 + l - 1) : 0);
+            real_t Hav = -Ts * γ * av;
+            Hv(c0 + l) += Hav;
+            if (l > 0)
+                Hv(c0 + l - 1) -= Hav;
+        }
+    }
+}
+
+void ChainOCP::eval_hess_L(crvec x, crvec y, real_t scale,
+                           rvec H_values) const {
+    const auto Ts = params.Ts;
+    auto H        = [&](index_t r, index_t c) -> real_t & {
+        return H_values(hess_L.find(r, c));
+    };
+    H_values.setZero();
+    for (index_t i = 0; i < n; ++i)
+        H(i, i) = scale * weights(i);
+    for (index_t k = 1; k < params.N; ++k) {
+        const auto c0 = x_offset(k);
+        auto yv       = y.segment(k * params.nx + M, M);
+        auto p        = x.segment(c0, M);
+        for (index_t l = 0; l < M; ++l) {
+            real_t d = elongation(p, l);
+            real_t γ = 6 * params.k3 * d * ((l > 0 ? yv(l - 1) : 0) - yv(l));
+            H(c0 + l, c0 + l) -= Ts * γ;
+            if (l > 0) {
+                H(c0 + l - 1, c0 + l - 1) -= Ts * γ;
+                H(c0 + l - 1, c0 + l) += Ts * γ;
+            }
+        }
+    }
+}
+
+auto ChainOCP::get_hess_L_sparsity() const -> Sparsity {
+    return hess_L.sparsity();
+}
+
+void ChainOCP::eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale,
+                                crvec v, rvec Hv) const {
+    eval_g(x, work_ŷ);
+    AugLagHessian::eval_ŷ_active(D, work_ŷ, y, Σ, work_ŷ, work_Σ);
+    eval_hess_L_prod(x, work_ŷ, scale, v, Hv);
+    eval_jac_g(x, work_J);
+    auto J = jac_g.map(work_J);
+    work_Jv.noalias() = J * v;
+    work_Jv.array() *= work_Σ.array();
+    Hv.noalias() += J.transpose() * work_Jv;
+}
+
+void ChainOCP::eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                           rvec H_values) const {
+    eval_g(x, work_ŷ);
+    AugLagHessian::eval_ŷ_active(D, work_ŷ, y, Σ, work_ŷ, work_Σ);
+    eval_hess_L(x, work_ŷ, scale, work_H);
+    eval_jac_g(x, work_J);
+    hess_ψ.assemble(work_H, work_J, work_Σ, H_values);
+}
+
+auto ChainOCP::get_hess_ψ_sparsity() const -> Sparsity {
+    return hess_ψ.pattern.sparsity();
+}
+
+// ---------------------------------------------------------------------------//
+// Logistic regression
+// ---------------------------------------------------------------------------//
+
+namespace {
+/// Logistic loss @f$ \ln(1 + e^{-t}) @f$.
+real_t logistic_loss(real_t t) {
+    return t > 0 ? std::log1p(std::exp(-t)) : -t + std::log1p(std::exp(t));
+}
+/// Derivative of the logistic loss.
+real_t logistic_loss_deriv(real_t t) { return -1 / (1 + std::exp(t)); }
+/// Second derivative of the logistic loss.
+real_t logistic_loss_deriv2(real_t t) {
+    real_t e = std::exp(-std::abs(t));
+    return e / ((1 + e) * (1 + e));
+}
+std::tuple<length_t, length_t> dims(const LogisticRegressionParams &p) {
+    if (p.samples < 1 || p.features < 1)
+        throw std::invalid_argument("LogisticRegression: samples and features "
+                                    "should be positive");
+    return {p.features, 0};
+}
+} // namespace
+
+LogisticRegression::LogisticRegression(const Params &p)
+    : BoxConstrProblem<config_t>{dims(p)}, params{p} {
+    rng_t rng{p.seed};
+    A = random_sparse(p.samples, p.features, p.density, rng);
+    // Labels generated by a sparse model, with noise
+    std::normal_distribution<real_t> normal;
+    std::bernoulli_distribution in_support{static_cast<double>(p.support)};
+    vec x_model = vec::Zero(p.features);
+    for (auto &xi : x_model)
+        if (in_support(rng))
+            xi = normal(rng);
+    b = A * x_model;
+    for (auto &bi : b)
+        bi = bi + p.noise * normal(rng) >= 0 ? 1 : -1;
+    // ℓ₁-regularization relative to the gradient of the loss in the origin
+    const auto μ = 1 / static_cast<real_t>(p.samples);
+    vec Aᵀb      = A.transpose() * b;
+    real_t λ_max = real_t(0.5) * μ * Aᵀb.lpNorm<Eigen::Infinity>();
+    if (p.λ_factor > 0)
+        l1_reg = vec::Constant(1, p.λ_factor * λ_max);
+    initial_guess = vec::Zero(n);
+    jac_g         = {spmat(0, n), sparsity::Symmetry::Unsymmetric};
+    jac_g.pattern.makeCompressed();
+    hess_L    = AugLagHessian{SparsePattern{A}, diagonal_pattern(n)};
+    work_Ax   = vec(p.samples);
+    work_w    = vec(p.samples);
+    work_zero = vec::Zero(n);
+}
+
+std::string LogisticRegression::get_name() const {
+    return "logistic regression (samples=" + std::to_string(params.samples) +
+           ", features=" + std::to_string(params.features) +
+           ", nnz=" + std::to_string(A.nonZeros()) + ")";
+}
+
+auto LogisticRegression::eval_f(crvec x) const -> real_t {
+    const auto μ      = 1 / static_cast<real_t>(params.samples);
+    work_Ax.noalias() = A * x;
+    real_t f          = 0;
+    for (index_t i = 0; i < work_Ax.size(); ++i)
+        f += logistic_loss(b(i) * work_Ax(i));
+    return μ * f;
+}
+
+void LogisticRegression::eval_grad_f(crvec x, rvec grad_fx) const {
+    (void)eval_f_grad_f(x, grad_fx);
+}
+
+auto LogisticRegression::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    const auto μ      = 1 / static_cast<real_t>(params.samples);
+    work_Ax.noalias() = A * x;
+    real_t f          = 0;
+    for (index_t i = 0; i < work_Ax.size(); ++i) {
+        real_t t  = b(i) * work_Ax(i);
+        f        += logistic_loss(t);
+        work_w(i) = μ * b(i) * logistic_loss_deriv(t);
+    }
+    grad_fx.noalias() = A.transpose() * work_w;
+    return μ * f;
+}
+
+void LogisticRegression::eval_g(crvec, rvec) const {}
+
+void LogisticRegression::eval_grad_g_prod(crvec, crvec, rvec grad_gxy) const {
+    grad_gxy.setZero();
+}
+
+void LogisticRegression::eval_jac_g(crvec, rvec) const {}
+
+auto LogisticRegression::get_jac_g_sparsity() const -> Sparsity {
+    return jac_g.sparsity();
+}
+
+void LogisticRegression::eval_hess_L_prod(crvec x, crvec, real_t scale,
+                                          crvec v, rvec Hv) const {
+    const auto μ      = 1 / static_cast<real_t>(params.samples);
+    work_Ax.noalias() = A * x;
+    for (index_t i = 0; i < work_Ax.size(); ++i)
+        work_w(i) = scale * μ * logistic_loss_deriv2(b(i) * work_Ax(i));
+    work_Ax.noalias() = A * v;
+    work_Ax.array() *= work_w.array();
+    Hv.noalias() = A.transpose() * work_Ax;
+}
+
+void LogisticRegression::eval_hess_L(crvec x, crvec, real_t scale,
+                                     rvec H_values) const {
+    const auto μ      = 1 / static_cast<real_t>(params.samples);
+    work_Ax.noalias() = A * x;
+    for (index_t i = 0; i < work_Ax.size(); ++i)
+        work_w(i) = scale * μ * logistic_loss_deriv2(b(i) * work_Ax(i));
+    hess_L.assemble(work_zero, cmvec{A.valuePtr(), A.nonZeros()}, work_w,
+                    H_values);
+}
+
+auto LogisticRegression::get_hess_L_sparsity() const -> Sparsity {
+    return hess_L.pattern.sparsity();
+}
+
+// ---------------------------------------------------------------------------//
+// Random QP
+// ---------------------------------------------------------------------------//
+
+namespace {
+std::tuple<length_t, length_t> dims(const RandomQPParams &p) {
+    if (p.n < 1 || p.m < 0)
+        throw std::invalid_argument("RandomQP: n should be positive and m "
+                                    "nonnegative");
+    return {p.n, p.m};
+}
+} // namespace
+
+RandomQP::RandomQP(const Params &p)
+    : BoxConstrProblem<config_t>{dims(p)}, params{p} {
+    rng_t rng{p.seed};
+    std::normal_distribution<real_t> normal;
+    std::uniform_real_distribution<real_t> uniform{0, 1};
+    std::bernoulli_distribution is_eq{static_cast<double>(p.eq_fraction)};
+    spmat R = random_sparse(n, n, p.density, rng);
+    Q       = upper_plus_diag(R.transpose() * R, p.reg);
+    q       = vec(n);
+    for (auto &qi : q)
+        qi = normal(rng);
+    A = random_sparse(m, n, p.density, rng);
+    // Constraints around a random feasible point
+    vec x_feas(n);
+    for (auto &xi : x_feas)
+        xi = uniform(rng) - real_t(0.5);
+    vec Ax = A * x_feas;
+    C.lowerbound.setConstant(-1);
+    C.upperbound.setConstant(+1);
+    for (index_t i = 0; i < m; ++i) {
+        bool eq          = is_eq(rng);
+        D.lowerbound(i) = eq ? Ax(i) : Ax(i) - uniform(rng);
+        D.upperbound(i) = eq ? Ax(i) : Ax(i) + uniform(rng);
+    }
+    initial_guess = vec::Zero(n);
+    jac_g         = {A, sparsity::Symmetry::Unsymmetric};
+    hess_L        = {Q, sparsity::Symmetry::Upper};
+    hess_ψ        = AugLagHessian{jac_g, hess_L};
+    work_ŷ.resize(m), work_Σ.resize(m), work_Av.resize(m);
+    work_H.resize(Q.nonZeros()), work_Qx.resize(n);
+}
+
+std::string RandomQP::get_name() const {
+    return "random QP (n=" + std::to_string(n) + ", m=" + std::to_string(m) +
+           ", nnz(Q)=" + std::to_string(Q.nonZeros()) +
+           ", nnz(A)=" + std::to_string(A.nonZeros()) + ")";
+}
+
+auto RandomQP::eval_f(crvec x) const -> real_t {
+    work_Qx.noalias() = Q.selfadjointView<Eigen::Upper>() * x;
+    return real_t(0.5) * x.dot(work_Qx) + q.dot(x);
+}
+
+void RandomQP::eval_grad_f(crvec x, rvec grad_fx) const {
+    grad_fx.noalias() = Q.selfadjointView<Eigen::Upper>() * x;
+    grad_fx += q;
+}
+
+auto RandomQP::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    grad_fx.noalias() = Q.selfadjointView<Eigen::Upper>() * x;
+    real_t f          = real_t(0.5) * x.dot(grad_fx) + q.dot(x);
+    grad_fx += q;
+    return f;
+}
+
+void RandomQP::eval_g(crvec x, rvec gx) const { gx.noalias() = A * x; }
+
+void RandomQP::eval_grad_g_prod(crvec, crvec y, rvec grad_gxy) const {
+    grad_gxy.noalias() = A.transpose() * y;
+}
+
+void RandomQP::eval_jac_g(crvec, rvec J_values) const {
+    J_values = cmvec{A.valuePtr(), A.nonZeros()};
+}
+
+auto RandomQP::get_jac_g_sparsity() const -> Sparsity {
+    return jac_g.sparsity();
+}
+
+void RandomQP::eval_hess_L_prod(crvec, crvec, real_t scale, crvec v,
+                                rvec Hv) const {
+    Hv.noalias() = Q.selfadjointView<Eigen::Upper>() * v;
+    Hv *= scale;
+}
+
+void RandomQP::eval_hess_L(crvec, crvec, real_t scale, rvec H_values) const {
+    H_values = scale * cmvec{Q.valuePtr(), Q.nonZeros()};
+}
+
+auto RandomQP::get_hess_L_sparsity() const -> Sparsity {
+    return hess_L.sparsity();
+}
+
+void RandomQP::eval_hess_ψ_prod(crvec x, crvec y, crvec Σ, real_t scale,
+                                crvec v, rvec Hv) const {
+    eval_g(x, work_ŷ);
+    AugLagHessian::eval_ŷ_active(D, work_ŷ, y, Σ, work_ŷ, work_Σ);
+    eval_hess_L_prod(x, y, scale, v, Hv);
+    work_Av.noalias() = A * v;
+    work_Av.array() *= work_Σ.array();
+    Hv.noalias() += A.transpose() * work_Av;
+}
+
+void RandomQP::eval_hess_ψ(crvec x, crvec y, crvec Σ, real_t scale,
+                           rvec H_values) const {
+    eval_g(x, work_ŷ);
+    AugLagHessian::eval_ŷ_active(D, work_ŷ, y, Σ, work_ŷ, work_Σ);
+    eval_hess_L(x, y, scale, work_H);
+    hess_ψ.assemble(work_H, cmvec{A.valuePtr(), A.nonZeros()}, work_Σ,
+                    H_values);
+}
+
+auto RandomQP::get_hess_ψ_sparsity() const -> Sparsity {
+    return hess_ψ.pattern.sparsity();
+}
+
+// ---------------------------------------------------------------------------//
+// Chained Rosenbrock
+// ---------------------------------------------------------------------------//
+
+namespace {
+std::tuple<length_t, length_t> dims(const ChainedRosenbrockParams &p) {
+    if (p.n < 2)
+        throw std::invalid_argument("ChainedRosenbrock: n should be at least "
+                                    "two");
+    if (!(p.lb <= p.ub))
+        throw std::invalid_argument("ChainedRosenbrock: lb should not be "
+                                    "greater than ub");
+    return {p.n, 0};
+}
+} // namespace
+
+ChainedRosenbrock::ChainedRosenbrock(const Params &p)
+    : BoxConstrProblem<config_t>{dims(p)}, params{p} {
+    C.lowerbound.setConstant(p.lb);
+    C.upperbound.setConstant(p.ub);
+    initial_guess.resize(n);
+    for (index_t i = 0; i < n; ++i)
+        initial_guess(i) = std::clamp(i % 2 == 0 ? real_t(-1.2) : real_t(1),
+                                      p.lb, p.ub);
+    jac_g = {spmat(0, n), sparsity::Symmetry::Unsymmetric};
+    jac_g.pattern.makeCompressed();
+    std::vector<triplet_t> triplets;
+    for (index_t i = 0; i < n; ++i) {
+        triplets.emplace_back(i, i, 0);
+        if (i > 0)
+            triplets.emplace_back(i - 1, i, 0);
+    }
+    hess_L = {from_triplets(n, n, triplets), sparsity::Symmetry::Upper};
+}
+
+std::string ChainedRosenbrock::get_name() const {
+    return "chained Rosenbrock (n=" + std::to_string(n) + ")";
+}
+
+auto ChainedRosenbrock::eval_f(crvec x) const -> real_t {
+    const auto a = params.a;
+    real_t f     = 0;
+    for (index_t i = 0; i + 1 < n; ++i) {
+        real_t t = x(i + 1) - x(i) * x(i);
+        f += a * t * t + (1 - x(i)) * (1 - x(i));
+    }
+    return f;
+}
+
+void ChainedRosenbrock::eval_grad_f(crvec x, rvec grad_fx) const {
+    (void)eval_f_grad_f(x, grad_fx);
+}
+
+auto ChainedRosenbrock::eval_f_grad_f(crvec x, rvec grad_fx) const -> real_t {
+    const auto a = params.a;
+    real_t f     = 0;
+    grad_fx.setZero();
+    for (index_t i = 0; i + 1 < n; ++i) {
+        real_t t = x(i + 1) - x(i) * x(i);
+        f += a * t * t + (1 - x(i)) * (1 - x(i));
+        grad_fx(i) += -4 * a * t * x(i) - 2 * (1 - x(i));
+        grad_fx(i + 1) += 2 * a * t;
+    }
+    return f;
+}
+
+void ChainedRosenbrock::eval_g(crvec, rvec) const {}
+
+void ChainedRosenbrock::eval_grad_g_prod(crvec, crvec, rvec grad_gxy) const {
+    grad_gxy.setZero();
+}
+
+void ChainedRosenbrock::eval_jac_g(crvec, rvec) const {}
+
+auto ChainedRosenbrock::get_jac_g_sparsity() const -> Sparsity {
+    return jac_g.sparsity();
+}
+
+void ChainedRosenbrock::eval_hess_L_prod(crvec x, crvec, real_t scale,
+                                         crvec v, rvec Hv) const {
+    const auto a = params.a;
+    Hv.setZero();
+    for (index_t i = 0; i + 1 < n; ++i) {
+        real_t Hii  = 12 * a * x(i) * x(i) - 4 * a * x(i + 1) + 2;
+        real_t Hij  = -4 * a * x(i);
+        real_t Hjj  = 2 * a;
+        Hv(i)      += scale * (Hii * v(i) + Hij * v(i + 1));
+        Hv(i + 1)  += scale * (Hij * v(i) + Hjj * v(i + 1));
+    }
+}
+
+void ChainedRosenbrock::eval_hess_L(crvec x, crvec, real_t scale,
+                                    rvec H_values) const {
+    const auto a = params.a;
+    auto H       = [&](index_t r, index_t c) -> real_t & {
+        return H_values(hess_L.find(r, c));
+    };
+    H_values.setZero();
+    for (index_t i = 0; i + 1 < n; ++i) {
+        H(i, i) += scale * (12 * a * x(i) * x(i) - 4 * a * x(i + 1) + 2);
+        H(i, i + 1) += scale * (-4 * a * x(i));
+        H(i + 1, i + 1) += scale * 2 * a;
+    }
+}
+
+auto ChainedRosenbrock::get_hess_L_sparsity() const -> Sparsity {
+    return hess_L.sparsity();
+}
+
+} // namespace alpaqa::synthetic
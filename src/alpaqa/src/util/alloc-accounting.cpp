@@ -0,0 +1,52 @@
+#include <alpaqa/util/alloc-accounting.hpp>
+
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+
+namespace alpaqa {
+
+namespace alloc_accounting {
+
+namespace {
+// These variables are accessed from within the global allocation functions,
+// so they must be trivially constructible and destructible (accessing them
+// must not trigger any allocations or dynamic initialization).
+std::atomic_bool hook_enabled{false};
+thread_local AllocPhase current_phase = AllocPhase::Other;
+thread_local AllocStats counters{};
+} // namespace
+
+bool is_enabled() noexcept {
+    return hook_enabled.load(std::memory_order_relaxed);
+}
+
+void enable() noexcept { hook_enabled.store(true, std::memory_order_relaxed); }
+
+void record(size_t bytes) noexcept {
+    auto &c = counters[current_phase];
+    ++c.count;
+    c.bytes += bytes;
+}
+
+AllocStats snapshot() noexcept { return counters; }
+
+AllocPhase set_phase(AllocPhase phase) noexcept {
+    auto prev     = current_phase;
+    current_phase = phase;
+    return prev;
+}
+
+} // namespace alloc_accounting
+
+std::ostream &operator<<(std::ostream &os, const AllocStats &s) {
+    for (size_t i = 0; i < num_alloc_phases; ++i) {
+        auto phase = static_cast<AllocPhase>(i);
+        os << std::setw(12) << enum_name(phase) << ": " << std::setw(10)
+           << s.phases[i].count << " allocations, " << std::setw(12)
+           << s.phases[i].bytes << " bytes\n";
+    }
+    return os;
+}
+
+} // namespace alpaqa
@@ -0,0 +1,98 @@
+/// @file
+/// Replacement of the global allocation functions that reports all heap
+/// allocations to @ref alpaqa::alloc_accounting. This file is compiled into
+/// the `alpaqa::alloc-hook` object library, which should only be linked into
+/// executables, never into libraries.
+///
+/// With glibc, the C allocation functions are interposed, which covers
+/// `operator new` as well as the allocations of Eigen, which uses `malloc`
+/// directly. On other platforms (and when using the Address Sanitizer, which
+/// intercepts `malloc` itself), only `operator new` is replaced.
+
+#include <alpaqa/util/alloc-accounting.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ALPAQA_ALLOC_HOOK_MALLOC 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define ALPAQA_ALLOC_HOOK_MALLOC 0
+#endif
+#endif
+#ifndef ALPAQA_ALLOC_HOOK_MALLOC
+#if defined(__GLIBC__)
+#define ALPAQA_ALLOC_HOOK_MALLOC 1
+#else
+#define ALPAQA_ALLOC_HOOK_MALLOC 0
+#endif
+#endif
+
+namespace {
+struct EnableAllocAccounting {
+    EnableAllocAccounting() noexcept { alpaqa::alloc_accounting::enable(); }
+} enable_alloc_accounting;
+} // namespace
+
+#if ALPAQA_ALLOC_HOOK_MALLOC
+
+#include <malloc.h>
+
+extern "C" {
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void *__libc_memalign(size_t, size_t);
+
+// Deallocation is not counted, so free is not replaced: the functions below
+// all forward to the default glibc allocator.
+
+void *malloc(size_t size) noexcept {
+    alpaqa::alloc_accounting::record(size);
+    return __libc_malloc(size);
+}
+void *calloc(size_t num, size_t size) noexcept {
+    alpaqa::alloc_accounting::record(num * size);
+    return __libc_calloc(num, size);
+}
+void *realloc(void *ptr, size_t size) noexcept {
+    alpaqa::alloc_accounting::record(size);
+    return __libc_realloc(ptr, size);
+}
+void *memalign(size_t alignment, size_t size) noexcept {
+    alpaqa::alloc_accounting::record(size);
+    return __libc_memalign(alignment, size);
+}
+void *aligned_alloc(size_t alignment, size_t size) noexcept {
+    alpaqa::alloc_accounting::record(size);
+    return __libc_memalign(alignment, size);
+}
+int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept {
+    if (alignment % sizeof(void *) != 0 ||
+        (alignment & (alignment - 1)) != 0 || alignment == 0)
+        return EINVAL;
+    alpaqa::alloc_accounting::record(size);
+    void *result = __libc_memalign(alignment, size);
+    if (!result)
+        return ENOMEM;
+    *ptr = result;
+    return 0;
+}
+}
+
+#else
+
+// The nothrow, array and sized variants of the operators all forward to the
+// ones defined here.
+
+void *operator new(size_t size) {
+    alpaqa::alloc_accounting::record(size);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+#endif
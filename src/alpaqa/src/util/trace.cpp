@@ -0,0 +1,177 @@
+#include <alpaqa/util/alloc-accounting.hpp>
+#include <alpaqa/util/trace.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace alpaqa::tracing {
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+struct Event {
+    const char *name;
+    const char *category;
+    int64_t timestamp; ///< Nanoseconds since the start of the session
+    int64_t arg;
+    char phase; ///< 'B' for begin events, 'E' for end events
+};
+
+struct ThreadBuffer {
+    std::vector<Event> events;
+    size_t open    = 0; ///< Number of begin events without an end event
+    size_t dropped = 0;
+    size_t thread  = 0;
+};
+
+struct Session {
+    uint64_t id     = 0;
+    size_t capacity = default_capacity;
+    clock::time_point t0{};
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+std::mutex session_mtx;
+Session session;
+std::atomic<uint64_t> session_id{0};
+
+// The buffer of the current thread, valid only if local_session_id is equal
+// to session_id (buffers of previous sessions may have been deallocated).
+thread_local ThreadBuffer *local_buffer = nullptr;
+thread_local uint64_t local_session_id  = 0;
+
+ThreadBuffer *get_local_buffer() noexcept {
+    auto id = session_id.load(std::memory_order_acquire);
+    if (local_session_id == id) [[likely]]
+        return local_buffer;
+    try {
+        // First event of this thread in the current session
+        ScopedAllocPhase phase{AllocPhase::Other};
+        std::lock_guard lck{session_mtx};
+        if (session.id != id)
+            return nullptr;
+        auto buf    = std::make_unique<ThreadBuffer>();
+        buf->thread = session.buffers.size() + 1;
+        buf->events.reserve(session.capacity);
+        local_buffer     = session.buffers.emplace_back(std::move(buf)).get();
+        local_session_id = id;
+        return local_buffer;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+int64_t timestamp() noexcept {
+    auto t = clock::now() - session.t0;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic_bool enabled{false};
+
+bool begin(const char *name, const char *category, int64_t arg) noexcept {
+    auto *buf = get_local_buffer();
+    if (!buf)
+        return false;
+    auto &events = buf->events;
+    // Keep room for the end events of all open scopes, so that begin and end
+    // events remain balanced when the buffer is full
+    if (events.size() + buf->open + 2 > events.capacity()) {
+        ++buf->dropped;
+        return false;
+    }
+    events.push_back({name, category, timestamp(), arg, 'B'});
+    ++buf->open;
+    return true;
+}
+
+void end(const char *name, const char *category) noexcept {
+    // If the session was restarted or cleared since the begin event, there is
+    // no buffer to record to, and allocating one for an unbalanced end event
+    // would be wasteful
+    if (local_session_id != session_id.load(std::memory_order_acquire))
+        return;
+    auto *buf = local_buffer;
+    if (!buf || buf->open == 0)
+        return;
+    buf->events.push_back({name, category, timestamp(), -1, 'E'});
+    --buf->open;
+}
+
+} // namespace detail
+
+void start(size_t capacity) {
+    std::lock_guard lck{session_mtx};
+    session.buffers.clear();
+    session.capacity = capacity;
+    session.t0       = clock::now();
+    session.id       = session_id.load(std::memory_order_relaxed) + 1;
+    session_id.store(session.id, std::memory_order_release);
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop() noexcept {
+    detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+void clear() {
+    stop();
+    std::lock_guard lck{session_mtx};
+    session.buffers.clear();
+    session.buffers.shrink_to_fit();
+    session.id = session_id.load(std::memory_order_relaxed) + 1;
+    session_id.store(session.id, std::memory_order_release);
+}
+
+size_t num_events() {
+    std::lock_guard lck{session_mtx};
+    size_t n = 0;
+    for (const auto &buf : session.buffers)
+        n += buf->events.size();
+    return n;
+}
+
+size_t num_dropped_events() {
+    std::lock_guard lck{session_mtx};
+    size_t n = 0;
+    for (const auto &buf : session.buffers)
+        n += buf->dropped;
+    return n;
+}
+
+void write_chrome_trace(std::ostream &os) {
+    std::lock_guard lck{session_mtx};
+    // Names and categories are string literals without special characters,
+    // so they do not need escaping
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char *sep = "\n";
+    auto flags      = os.flags();
+    os << std::fixed << std::setprecision(3);
+    for (const auto &buf : session.buffers) {
+        os << sep << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+           << buf->thread << R"(,"args":{"name":"alpaqa thread )"
+           << buf->thread << "\"}}";
+        sep = ",\n";
+        for (const auto &e : buf->events) {
+            os << sep << R"({"name":")" << e.name << R"(","cat":")"
+               << e.category << R"(","ph":")" << e.phase
+               << R"(","ts":)" << static_cast<double>(e.timestamp) * 1e-3
+               << R"(,"pid":1,"tid":)" << buf->thread;
+            if (e.arg >= 0)
+                os << R"(,"args":{"k":)" << e.arg << '}';
+            os << '}';
+        }
+    }
+    os << "\n]}\n";
+    os.flags(flags);
+}
+
+} // namespace alpaqa::tracing
@@ -12,8 +12,34 @@
 
 namespace alpaqa {
 
+/// How the shared library of a CUTEst problem is loaded.
+///
+/// CUTEst's Fortran code keeps its state in global (module) variables. When
+/// the same shared library is loaded multiple times using `dlopen`, all
+/// instances share this state, so they cannot be used concurrently.
+enum class CUTEstLoadMode {
+    /// Load the library using `dlopen`. Instances of the same problem share
+    /// their global state.
+    Shared,
+    /// Load the library and all of its dependencies (including the Fortran
+    /// runtime) into a new link-map namespace using `dlmopen(LM_ID_NEWLM)`.
+    /// Each instance is fully isolated and can be evaluated in parallel with
+    /// other instances. Only available with glibc, which supports a limited
+    /// number of namespaces (16, including the main one).
+    Namespace,
+    /// Load a private temporary copy of the library using `dlopen`. The global
+    /// state of the problem library is isolated, its dependencies are shared
+    /// between instances. There is no limit on the number of instances.
+    Copy,
+};
+
 /// Wrapper for CUTEst problems loaded from an external shared library.
 ///
+/// Copies of a problem share the loaded library. To evaluate multiple
+/// instances of the same problem in parallel threads, construct each instance
+/// separately, using @ref CUTEstLoadMode::Namespace or
+/// @ref CUTEstLoadMode::Copy.
+///
 /// @ingroup  grp_Problems
 class CUTEST_INTERFACE_EXPORT CUTEstProblem
     : public BoxConstrProblem<alpaqa::EigenConfigd> {
@@ -24,9 +50,11 @@ class CUTEST_INTERFACE_EXPORT CUTEstProblem
     /// Load a CUTEst problem from the given shared library and OUTSDIF.d file.
     /// If @p so_fname points to a directory, `"PROBLEM.so"` is appended
     /// automatically. If @p outsdif_fname is `nullptr`, the same directory as
-    /// @p so_fname is used.
+    /// @p so_fname is used. The @p mode determines whether the global state of
+    /// the problem is shared with other instances, see @ref CUTEstLoadMode.
     CUTEstProblem(const char *so_fname, const char *outsdif_fname = nullptr,
-                  bool sparse = false);
+                  bool sparse = false,
+                  CUTEstLoadMode mode = CUTEstLoadMode::Shared);
     CUTEstProblem(const CUTEstProblem &);
     CUTEstProblem &operator=(const CUTEstProblem &);
     CUTEstProblem(CUTEstProblem &&) noexcept;
@@ -4,8 +4,12 @@
 #include <alpaqa/problem/sparsity.hpp>
 
 #include <dlfcn.h>
+#include <unistd.h>
 
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <cstdlib>
 #include <filesystem>
 #include <functional>
 #include <iostream>
@@ -14,6 +18,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <vector>
 
 #include "cutest-functions.hpp"
@@ -43,19 +48,67 @@ auto checked(F &&func, std::string_view msg) {
     };
 }
 
+std::shared_ptr<void> handle_to_shared_ptr(void *h) {
+    assert(h);
+#if ALPAQA_NO_DLCLOSE
+    return std::shared_ptr<void>{h, +[](void *) {}};
+#else
+    return std::shared_ptr<void>{h, &::dlclose};
+#endif
+}
+
 std::shared_ptr<void> load_lib(const char *so_filename) {
     assert(so_filename);
     ::dlerror();
     void *h = ::dlopen(so_filename, RTLD_LOCAL | RTLD_NOW);
     if (auto *err = ::dlerror())
         throw std::runtime_error(err);
-    assert(h);
-#if ALPAQA_NO_DLCLOSE
-    return std::shared_ptr<void>{h, +[](void *) {}};
+    return handle_to_shared_ptr(h);
+}
+
+/// Load the library into a new link-map namespace, so that it gets its own
+/// copy of all global variables, including those of its dependencies.
+std::shared_ptr<void> load_lib_new_namespace(const char *so_filename) {
+    assert(so_filename);
+#ifdef __GLIBC__
+    ::dlerror();
+    void *h = ::dlmopen(LM_ID_NEWLM, so_filename, RTLD_LOCAL | RTLD_NOW);
+    if (auto *err = ::dlerror())
+        throw std::runtime_error(err);
+    return handle_to_shared_ptr(h);
 #else
-    return std::shared_ptr<void>{h, &::dlclose};
+    throw std::runtime_error("CUTEstLoadMode::Namespace is not supported on "
+                             "this platform (requires dlmopen)");
 #endif
 }
+
+/// Load a private copy of the library, so that it gets its own copy of all
+/// global variables (but its dependencies are shared).
+std::shared_ptr<void> load_lib_copy(const char *so_filename) {
+    assert(so_filename);
+    namespace fs = std::filesystem;
+    auto tmpl    = fs::temp_directory_path() / "alpaqa-cutest-XXXXXX.so";
+    auto tmp     = tmpl.string();
+    int fd       = ::mkstemps(tmp.data(), 3);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create temporary file " + tmp);
+    ::close(fd);
+    // The file is no longer needed once it has been mapped
+    struct Remove {
+        const std::string &path;
+        ~Remove() { ::unlink(path.c_str()); }
+    } remove{tmp};
+    fs::copy_file(so_filename, tmp, fs::copy_options::overwrite_existing);
+    return load_lib(tmp.c_str());
+}
+
+/// Each instance uses its own Fortran unit numbers, in case the Fortran
+/// runtime is shared between instances.
+alpaqa::cutest::integer next_fortran_units() {
+    static std::atomic<alpaqa::cutest::integer> next{1000};
+    return next.fetch_add(2, std::memory_order_relaxed);
+}
 } // namespace
 
 namespace alpaqa {
@@ -113,13 +166,27 @@ class CUTEstLoader {
     }
 
   public:
-    CUTEstLoader(const char *so_fname, const char *outsdif_fname) {
+    CUTEstLoader(const char *so_fname, const char *outsdif_fname,
+                 CUTEstLoadMode mode) {
         namespace fs = std::filesystem;
         auto path    = fs::path(so_fname);
         if (fs::is_directory(path))
             path /= "PROBLEM.so";
         // Open the shared library
-        so_handle = load_lib(path.c_str());
+        switch (mode) {
+            case CUTEstLoadMode::Shared:
+                so_handle = load_lib(path.c_str());
+                break;
+            case CUTEstLoadMode::Namespace:
+                so_handle = load_lib_new_namespace(path.c_str());
+                break;
+            case CUTEstLoadMode::Copy:
+                so_handle = load_lib_copy(path.c_str());
+                break;
+            default: throw std::invalid_argument("Invalid CUTEstLoadMode");
+        }
+        funit     = next_fortran_units();
+        io_buffer = funit + 1;
 
         // Open the OUTSDIF.d file
         if (outsdif_fname && *outsdif_fname)
@@ -236,9 +303,9 @@ class CUTEstLoader {
     cleanup_t cleanup_outsdif;  ///< Responsible for closing the OUTSDIF.d file
     cleanup_t cutest_terminate; ///< Responsible for calling CUTEST_xterminate
 
-    integer funit     = 42; ///< Fortran Unit Number for OUTSDIF.d file
-    integer iout      = 6;  ///< Fortran Unit Number for standard output
-    integer io_buffer = 11; ///< Fortran Unit Number for internal IO
+    integer funit;     ///< Fortran Unit Number for OUTSDIF.d file
+    integer iout = 6;  ///< Fortran Unit Number for standard output
+    integer io_buffer; ///< Fortran Unit Number for internal IO
 
     integer nvar;      ///< Number of decision variabls
     integer ncon;      ///< Number of constraints
@@ -251,9 +318,9 @@ class CUTEstLoader {
 };
 
 CUTEstProblem::CUTEstProblem(const char *so_fname, const char *outsdif_fname,
-                             bool sparse)
+                             bool sparse, CUTEstLoadMode mode)
     : BoxConstrProblem<config_t>{0, 0}, sparse{sparse} {
-    impl = std::make_unique<CUTEstLoader>(so_fname, outsdif_fname);
+    impl = std::make_unique<CUTEstLoader>(so_fname, outsdif_fname, mode);
     resize(static_cast<length_t>(impl->nvar),
            static_cast<length_t>(impl->ncon));
     x0.resize(n);
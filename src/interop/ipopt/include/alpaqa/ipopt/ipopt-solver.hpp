@@ -0,0 +1,105 @@
+#pragma once
+
+#include <alpaqa/ipopt-adapter-export.h>
+#include <alpaqa/ipopt/ipopt-adapter.hpp>
+
+#include <IpIpoptApplication.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace alpaqa {
+
+/// Solves the same problem (or a sequence of problems with the same structure,
+/// e.g. a parameter sweep) multiple times using a single
+/// @ref Ipopt::IpoptApplication and @ref IpoptAdapter.
+///
+/// The first solve uses `OptimizeTNLP`, subsequent solves use
+/// `ReOptimizeTNLP` with the option `warm_start_same_structure` enabled, so
+/// Ipopt can reuse its internal data structures and the symbolic analysis of
+/// the KKT system. The sparsity conversions of the Jacobian and Hessian are
+/// computed only once, when the adapter is constructed.
+///
+/// Optionally, each solve can be warm-started from the primal solution, the
+/// constraint multipliers and the bound multipliers of the previous one (by
+/// enabling Ipopt's `warm_start_init_point` option). Warm-starting an
+/// interior point method is most effective when the Ipopt options
+/// `warm_start_bound_push`, `warm_start_mult_bound_push` and `mu_init` are
+/// reduced as well.
+///
+/// @note   Options that were set by the user with `allow_clobber = false`
+///         (e.g. using @ref params::set_param) are not overwritten.
+class IPOPT_ADAPTER_EXPORT IpoptSequentialSolver {
+  public:
+    USING_ALPAQA_CONFIG(IpoptAdapter::config_t);
+    using Problem  = IpoptAdapter::Problem;
+    using Results  = IpoptAdapter::Results;
+    using Duration = std::chrono::nanoseconds;
+    /// Called before each solve of @ref solve_batch, with the index of the
+    /// solve and the adapter, e.g. to update the parameters of the problem or
+    /// the initial guess.
+    using BatchUpdate = std::function<void(index_t, IpoptAdapter &)>;
+
+    /// @param  problem
+    ///         The problem to solve. Its sparsity patterns and dimensions
+    ///         should not change after construction.
+    /// @param  app
+    ///         An initialized Ipopt application.
+    IpoptSequentialSolver(const Problem &problem,
+                          Ipopt::SmartPtr<Ipopt::IpoptApplication> app);
+    IpoptSequentialSolver(Problem &&,
+                          Ipopt::SmartPtr<Ipopt::IpoptApplication>) = delete;
+
+    /// Solve the problem, starting from the initial guess stored in the
+    /// adapter (see @ref get_adapter), or from the previous solution if
+    /// @ref warm_start was called.
+    Ipopt::ApplicationReturnStatus solve();
+    /// Use the primal solution, the constraint multipliers and the bound
+    /// multipliers of the last solve as the initial guess for the next one.
+    /// @pre    At least one solve has finished.
+    void warm_start();
+    /// Solve @p count problems in sequence.
+    /// @param  count
+    ///         Number of solves.
+    /// @param  update
+    ///         Called before every solve (may be empty).
+    /// @param  warm_start
+    ///         Start each solve (except the first one) from the solution of
+    ///         the previous one.
+    /// @return The results of every solve.
+    std::vector<Results> solve_batch(length_t count,
+                                     const BatchUpdate &update = {},
+                                     bool warm_start           = false);
+    /// Forget the previous solves: the next call to @ref solve uses
+    /// `OptimizeTNLP` again, e.g. after changing options that affect the
+    /// structure of the problem.
+    void reset() { solved = false, warm_start_next = false; }
+
+    /// Get the underlying problem adapter (initial guesses and results).
+    IpoptAdapter &get_adapter() { return *adapter; }
+    /// @copydoc get_adapter
+    const IpoptAdapter &get_adapter() const { return *adapter; }
+    /// Get the results of the last solve.
+    const Results &get_results() const { return adapter->results; }
+    /// Get the Ipopt application.
+    Ipopt::IpoptApplication &get_application() { return *app; }
+    /// Wall time of the last call to @ref solve.
+    Duration get_solve_time() const { return solve_time; }
+    /// Whether the last call to @ref solve reused the structure of a previous
+    /// solve (i.e. used `ReOptimizeTNLP`).
+    bool is_reoptimized() const { return reoptimized; }
+
+  private:
+    Ipopt::SmartPtr<Ipopt::IpoptApplication> app;
+    Ipopt::SmartPtr<Ipopt::TNLP> nlp;
+    IpoptAdapter *adapter;
+    /// Value of `warm_start_init_point` before the first solve, used for
+    /// solves that are not warm-started.
+    std::string default_warm_start_init_point;
+    Duration solve_time{};
+    bool solved = false, warm_start_next = false, reoptimized = false;
+};
+
+} // namespace alpaqa
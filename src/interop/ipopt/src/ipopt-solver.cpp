@@ -0,0 +1,67 @@
+#include <alpaqa/ipopt/ipopt-solver.hpp>
+
+#include <stdexcept>
+
+namespace alpaqa {
+
+IpoptSequentialSolver::IpoptSequentialSolver(
+    const Problem &problem, Ipopt::SmartPtr<Ipopt::IpoptApplication> app)
+    : app(std::move(app)), nlp(new IpoptAdapter(problem)),
+      adapter(dynamic_cast<IpoptAdapter *>(GetRawPtr(nlp))) {
+    if (!this->app->Options()->GetStringValue(
+            "warm_start_init_point", default_warm_start_init_point, ""))
+        default_warm_start_init_point = "no";
+}
+
+Ipopt::ApplicationReturnStatus IpoptSequentialSolver::solve() {
+    auto &options = *app->Options();
+    reoptimized   = solved;
+    options.SetStringValue("warm_start_same_structure",
+                           reoptimized ? "yes" : "no");
+    options.SetStringValue("warm_start_init_point",
+                           warm_start_next ? "yes"
+                                           : default_warm_start_init_point);
+    adapter->results.status = Ipopt::SolverReturn::UNASSIGNED;
+
+    auto t0     = std::chrono::steady_clock::now();
+    auto status = reoptimized ? app->ReOptimizeTNLP(nlp) //
+                              : app->OptimizeTNLP(nlp);
+    auto t1     = std::chrono::steady_clock::now();
+
+    solve_time      = std::chrono::duration_cast<Duration>(t1 - t0);
+    solved          = true;
+    warm_start_next = false;
+    return status;
+}
+
+void IpoptSequentialSolver::warm_start() {
+    const auto &res = adapter->results;
+    if (res.status == Ipopt::SolverReturn::UNASSIGNED)
+        throw std::logic_error("IpoptSequentialSolver::warm_start: no "
+                               "solution available");
+    adapter->initial_guess                      = res.solution_x;
+    adapter->initial_guess_multipliers          = res.solution_y;
+    adapter->initial_guess_bounds_multipliers_l = res.solution_z_L;
+    adapter->initial_guess_bounds_multipliers_u = res.solution_z_U;
+    warm_start_next                             = true;
+}
+
+auto IpoptSequentialSolver::solve_batch(length_t count,
+                                        const BatchUpdate &update,
+                                        bool warm_start)
+    -> std::vector<Results> {
+    std::vector<Results> results;
+    results.reserve(static_cast<size_t>(count));
+    for (index_t i = 0; i < count; ++i) {
+        if (warm_start && i > 0 &&
+            adapter->results.status != Ipopt::SolverReturn::UNASSIGNED)
+            this->warm_start();
+        if (update)
+            update(i, *adapter);
+        solve();
+        results.push_back(adapter->results);
+    }
+    return results;
+}
+
+} // namespace alpaqa
@@ -1,8 +1,14 @@
+#pragma once
+
 #include <alpaqa/config/config.hpp>
 #include <alpaqa/problem/type-erased-problem.hpp>
 #include <alpaqa/qpalm-adapter-export.h>
 #include <qpalm.hpp>
 
+#include <chrono>
+#include <memory>
+#include <optional>
+
 namespace alpaqa {
 
 struct QPALM_ADAPTER_EXPORT OwningQPALMData : QPALMData {
@@ -18,4 +24,92 @@ struct QPALM_ADAPTER_EXPORT OwningQPALMData : QPALMData {
 QPALM_ADAPTER_EXPORT OwningQPALMData
 build_qpalm_problem(const TypeErasedProblem<EigenConfigd> &problem);
 
-} // namespace alpaqa
\ No newline at end of file
+/// Converts a problem to QPALM format, like @ref build_qpalm_problem, but
+/// keeps the sparsity conversion plan, so that the numerical values of other
+/// problems with the same structure can be loaded without redoing the symbolic
+/// work (e.g. the QPs in a model predictive control loop).
+class QPALM_ADAPTER_EXPORT QPALMProblemUpdater {
+  public:
+    USING_ALPAQA_CONFIG(EigenConfigd);
+    using Problem = TypeErasedProblem<config_t>;
+
+    /// Analyze the sparsity of the given problem and evaluate its matrices and
+    /// vectors.
+    explicit QPALMProblemUpdater(const Problem &problem);
+    QPALMProblemUpdater(QPALMProblemUpdater &&) noexcept;
+    QPALMProblemUpdater &operator=(QPALMProblemUpdater &&) noexcept;
+    ~QPALMProblemUpdater();
+
+    /// Re-evaluate the matrices and vectors of the given problem, without
+    /// changing the sparsity patterns.
+    /// @pre    The problem has the same dimensions and sparsity patterns as the
+    ///         problem that was passed to the constructor, and the same
+    ///         variables have finite bounds.
+    void update(const Problem &problem);
+    /// Load the current values of the QP into the given solver. Only numerical
+    /// values are updated, so QPALM can reuse its workspace and the symbolic
+    /// factorization of the KKT system.
+    /// @note   The constant term of the cost is not updated (it does not
+    ///         affect the solution, only the reported objective value).
+    void update_solver(qpalm::Solver &solver) const;
+
+    /// Get the QP in QPALM format.
+    const OwningQPALMData &get_data() const { return data; }
+    /// Move the QP in QPALM format out of this object.
+    OwningQPALMData release_data() && { return std::move(data); }
+
+  private:
+    struct Plan;
+    std::unique_ptr<Plan> plan;
+    OwningQPALMData data;
+};
+
+/// Solves a sequence of QPs with the same structure using a single QPALM
+/// solver. The first QP is converted using @ref QPALMProblemUpdater and sets
+/// up the solver. For subsequent QPs, only the numerical values are updated,
+/// and the solver is warm-started using the previous primal and dual solution.
+class QPALM_ADAPTER_EXPORT QPALMSequentialSolver {
+  public:
+    USING_ALPAQA_CONFIG(EigenConfigd);
+    using Problem  = TypeErasedProblem<config_t>;
+    using Duration = std::chrono::nanoseconds;
+
+    explicit QPALMSequentialSolver(const qpalm::Settings &settings = {});
+    QPALMSequentialSolver(QPALMSequentialSolver &&) noexcept;
+    QPALMSequentialSolver &operator=(QPALMSequentialSolver &&) noexcept;
+    ~QPALMSequentialSolver();
+
+    /// Solve the QP defined by the given problem.
+    /// @pre    If this is not the first QP since construction or the last call
+    ///         to @ref reset, the problem has the same structure as the first
+    ///         one (see @ref QPALMProblemUpdater::update).
+    void solve(const Problem &problem);
+    /// Forget the current QP structure and solution: the next call to
+    /// @ref solve sets up a new solver from scratch.
+    void reset();
+
+    /// Get the solution of the last QP. The dual solution includes the
+    /// multipliers of the bound constraints, see @ref get_data.
+    qpalm::SolutionView get_solution() const;
+    /// Get the solver statistics of the last QP.
+    const QPALMInfo &get_info() const;
+    /// Get the QP in QPALM format.
+    const OwningQPALMData &get_data() const;
+    /// Time spent converting the problem and setting up or updating the solver
+    /// during the last call to @ref solve (excluding the actual solve).
+    Duration get_setup_time() const { return setup_time; }
+    /// Whether the last call to @ref solve reused the existing solver.
+    bool is_updated() const { return updated; }
+
+    /// Settings for the QPALM solver, applied when setting up a new solver.
+    qpalm::Settings settings;
+
+  private:
+    std::optional<QPALMProblemUpdater> updater;
+    std::unique_ptr<qpalm::Solver> solver;
+    vec x_prev, y_prev;
+    Duration setup_time{};
+    bool updated = false;
+};
+
+} // namespace alpaqa
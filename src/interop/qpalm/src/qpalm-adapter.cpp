@@ -4,6 +4,7 @@
 
 #include <qpalm/sparse.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -121,74 +122,204 @@ int convert_symmetry(sparsity::Symmetry symmetry) {
 
 } // namespace
 
-OwningQPALMData
-build_qpalm_problem(const TypeErasedProblem<EigenConfigd> &problem) {
-    USING_ALPAQA_CONFIG(alpaqa::EigenConfigd);
+struct QPALMProblemUpdater::Plan {
+    using SparseCSC    = sparsity::SparseCSC<config_t, qpalm::sp_index_t>;
+    using Sparsity     = sparsity::Sparsity<config_t>;
+    using SparsityConv = sparsity::SparsityConverter<Sparsity, SparseCSC>;
 
+    explicit Plan(const Problem &problem)
+        : sp_Q{problem.get_hess_L_sparsity(), {.order = SparseCSC::SortedRows}},
+          sp_A{problem.get_jac_g_sparsity(), {.order = SparseCSC::SortedRows}},
+          x{vec::Zero(problem.get_n())}, y{vec::Zero(problem.get_m())},
+          g(problem.get_m()) {}
+
+    /// Conversion of the cost Hessian and constraints Jacobian to QPALM's
+    /// sparse format.
+    SparsityConv sp_Q, sp_A;
+    /// Index of each Jacobian value in the constraint matrix of QPALM, which
+    /// also contains the rows of the bound constraints.
+    indexvec A_idx;
+    /// Values of the constraints Jacobian.
+    vec J_values;
+    /// Indices of the variables with finite bounds.
+    indexvec bounded;
+    /// Point where the problem functions are evaluated (zero), and work vector
+    /// for the constraints.
+    vec x, y, g;
+};
+
+QPALMProblemUpdater::QPALMProblemUpdater(const Problem &problem)
+    : plan{std::make_unique<Plan>(problem)} {
     // Get the dimensions of the problem matrices
     const auto n = problem.get_n(), m = problem.get_m();
+    auto &&C     = problem.get_box_C();
 
-    // Dummy data to evaluate Hessian and Jacobian
-    vec x = vec::Zero(n), y = vec::Zero(m), g(m);
+    { // Allocate the cost Hessian and copy its sparsity pattern
+        const auto &sp_Q = plan->sp_Q.get_sparsity();
+        auto nnz_Q       = static_cast<qpalm::sp_index_t>(sp_Q.nnz());
+        auto symm        = convert_symmetry(sp_Q.symmetry);
+        data.sto->Q      = qpalm::ladel_sparse_create(n, n, nnz_Q, symm);
+        data.Q           = data.sto->Q.get();
+        std::ranges::copy(sp_Q.inner_idx, data.Q->i);
+        std::ranges::copy(sp_Q.outer_ptr, data.Q->p);
+    }
+    { // Allocate the constraints Jacobian and copy its sparsity pattern
+        const auto &sp_A = plan->sp_A.get_sparsity();
+        auto nnz_A       = static_cast<qpalm::sp_index_t>(sp_A.nnz());
+        auto symm        = convert_symmetry(sp_A.symmetry);
+        data.sto->A      = qpalm::ladel_sparse_create(m, n, nnz_A + n, symm);
+        data.A           = data.sto->A.get();
+        std::ranges::copy(sp_A.inner_idx, data.A->i);
+        std::ranges::copy(sp_A.outer_ptr, data.A->p);
+        // Add the bound constraints (the values of the Jacobian are filled in
+        // by update(), they are simply moved around here)
+        add_bound_constr_to_constr_matrix(*data.A, C);
+        // Keep track of where the Jacobian values ended up: the bound
+        // constraint is inserted at the top of its column, so all original
+        // values are shifted by the number of bounded variables up to and
+        // including the current column
+        plan->A_idx.resize(nnz_A);
+        plan->J_values.resize(nnz_A);
+        plan->bounded.resize(n);
+        index_t shift = 0, k = 0;
+        for (index_t col = 0; col < n; ++col) {
+            if (is_bound(C, col))
+                plan->bounded(shift++) = col;
+            auto i0 = sp_A.outer_ptr(col), i1 = sp_A.outer_ptr(col + 1);
+            for (auto i = i0; i < i1; ++i)
+                plan->A_idx(k++) = static_cast<index_t>(i) + shift;
+        }
+        plan->bounded.conservativeResize(shift);
+    }
+    // Allocate the remaining vectors
+    data.sto->q.resize(n);
+    data.q = data.sto->q.data();
+    data.sto->b.lowerbound.resize(data.A->nrow);
+    data.sto->b.upperbound.resize(data.A->nrow);
+    data.bmin = data.sto->b.lowerbound.data();
+    data.bmax = data.sto->b.upperbound.data();
+    data.m    = static_cast<size_t>(data.A->nrow);
+    data.n    = static_cast<size_t>(data.Q->nrow);
+    // Evaluate the actual values
+    update(problem);
+}
 
-    // Construct QPALM problem
-    OwningQPALMData qp;
+QPALMProblemUpdater::QPALMProblemUpdater(QPALMProblemUpdater &&) noexcept =
+    default;
+QPALMProblemUpdater &
+QPALMProblemUpdater::operator=(QPALMProblemUpdater &&) noexcept = default;
+QPALMProblemUpdater::~QPALMProblemUpdater() = default;
 
-    using SparseCSC    = sparsity::SparseCSC<config_t, qpalm::sp_index_t>;
-    using Sparsity     = sparsity::Sparsity<config_t>;
-    using SparsityConv = sparsity::SparsityConverter<Sparsity, SparseCSC>;
+void QPALMProblemUpdater::update(const Problem &problem) {
+    const auto n = problem.get_n(), m = problem.get_m();
+    if (n != plan->x.size() || m != plan->y.size())
+        throw std::invalid_argument(
+            "QPALMProblemUpdater::update: problem dimensions changed");
+    auto &&C = problem.get_box_C(), &&D = problem.get_box_D();
+    // The rows of the bound constraints in A cannot be updated
+    const auto num_bounded = plan->bounded.size();
+    bool same_bounds       = true;
+    index_t k              = 0;
+    for (index_t i = 0; same_bounds && i < n; ++i)
+        if (is_bound(C, i))
+            same_bounds = k < num_bounded && plan->bounded(k++) == i;
+    if (!same_bounds || k != num_bounded)
+        throw std::invalid_argument(
+            "QPALMProblemUpdater::update: the set of variables with finite "
+            "bounds changed");
+    const auto &x = plan->x, &y = plan->y;
     { // Evaluate cost Hessian
-        Sparsity sp_Q_orig = problem.get_hess_L_sparsity();
-        SparsityConv sp_Q{sp_Q_orig, {.order = SparseCSC::SortedRows}};
-        auto nnz_Q = static_cast<qpalm::sp_index_t>(sp_Q.get_sparsity().nnz());
-        auto symm  = convert_symmetry(sp_Q.get_sparsity().symmetry);
-        qp.sto->Q  = qpalm::ladel_sparse_create(n, n, nnz_Q, symm);
-        qp.Q       = qp.sto->Q.get();
-        // Copy sparsity pattern
-        std::ranges::copy(sp_Q.get_sparsity().inner_idx, qp.Q->i);
-        std::ranges::copy(sp_Q.get_sparsity().outer_ptr, qp.Q->p);
-        // Get actual values
-        mvec H_values{qp.Q->x, nnz_Q};
+        auto nnz_Q = static_cast<index_t>(data.Q->p[n]);
+        mvec H_values{data.Q->x, nnz_Q};
         auto eval_h = [&](rvec v) { problem.eval_hess_L(x, y, 1, v); };
-        sp_Q.convert_values(eval_h, H_values);
+        plan->sp_Q.convert_values(eval_h, H_values);
     }
     { // Evaluate constraints Jacobian
-        Sparsity sp_A_orig = problem.get_jac_g_sparsity();
-        SparsityConv sp_A{sp_A_orig, {.order = SparseCSC::SortedRows}};
-        auto nnz_A = static_cast<qpalm::sp_index_t>(sp_A.get_sparsity().nnz());
-        auto symm  = convert_symmetry(sp_A.get_sparsity().symmetry);
-        qp.sto->A  = qpalm::ladel_sparse_create(m, n, nnz_A + n, symm);
-        qp.A       = qp.sto->A.get();
-        // Copy sparsity pattern
-        std::ranges::copy(sp_A.get_sparsity().inner_idx, qp.A->i);
-        std::ranges::copy(sp_A.get_sparsity().outer_ptr, qp.A->p);
-        // Get actual values
-        mvec J_values{qp.A->x, nnz_A};
         auto eval_j = [&](rvec v) { problem.eval_jac_g(x, v); };
-        sp_A.convert_values(eval_j, J_values);
-        // Add the bound constraints
-        add_bound_constr_to_constr_matrix(*qp.A, problem.get_box_C());
+        plan->sp_A.convert_values(eval_j, plan->J_values);
+        auto nnz_A = static_cast<index_t>(data.A->p[n]);
+        mvec{data.A->x, nnz_A}(plan->A_idx) = plan->J_values;
     }
     { // Evaluate constraints
-        problem.eval_g(x, g);
+        problem.eval_g(x, plan->g);
     }
     { // Evaluate cost and cost gradient
-        qp.sto->q.resize(n);
-        qp.q = qp.sto->q.data();
-        qp.c = problem.eval_f_grad_f(x, qp.sto->q);
+        data.c = problem.eval_f_grad_f(x, data.sto->q);
+    }
+    { // Combine bound constraints and linear constraints
+        combine_bound_constr(data.sto->b, C, D, plan->g);
     }
-    { // Combine bound constraints
-        qp.sto->b.lowerbound.resize(qp.A->nrow);
-        qp.sto->b.upperbound.resize(qp.A->nrow);
-        qp.bmin = qp.sto->b.lowerbound.data();
-        qp.bmax = qp.sto->b.upperbound.data();
-        // Combine bound constraints and linear constraints
-        auto &&C = problem.get_box_C(), &&D = problem.get_box_D();
-        combine_bound_constr(qp.sto->b, C, D, g);
+}
+
+void QPALMProblemUpdater::update_solver(qpalm::Solver &solver) const {
+    auto n     = static_cast<index_t>(data.n);
+    auto nnz_Q = static_cast<index_t>(data.Q->p[n]);
+    auto nnz_A = static_cast<index_t>(data.A->p[n]);
+    solver.update_Q_A(cmvec{data.Q->x, nnz_Q}, cmvec{data.A->x, nnz_A});
+    solver.update_q(data.sto->q);
+    solver.update_bounds(data.sto->b.lowerbound, data.sto->b.upperbound);
+}
+
+OwningQPALMData
+build_qpalm_problem(const TypeErasedProblem<EigenConfigd> &problem) {
+    return QPALMProblemUpdater{problem}.release_data();
+}
+
+QPALMSequentialSolver::QPALMSequentialSolver(const qpalm::Settings &settings)
+    : settings{settings} {}
+QPALMSequentialSolver::QPALMSequentialSolver(
+    QPALMSequentialSolver &&) noexcept = default;
+QPALMSequentialSolver &
+QPALMSequentialSolver::operator=(QPALMSequentialSolver &&) noexcept = default;
+QPALMSequentialSolver::~QPALMSequentialSolver() = default;
+
+void QPALMSequentialSolver::solve(const Problem &problem) {
+    auto t0 = std::chrono::steady_clock::now();
+    updated = solver != nullptr;
+    if (updated) {
+        // Same structure: only update the values, and warm start using the
+        // previous solution
+        updater->update(problem);
+        updater->update_solver(*solver);
+        solver->warm_start(x_prev, y_prev);
+    } else {
+        // First QP: analyze the sparsity and set up the solver
+        updater.emplace(problem);
+        solver = std::make_unique<qpalm::Solver>(&updater->get_data(),
+                                                 settings);
     }
-    qp.m = static_cast<size_t>(qp.A->nrow);
-    qp.n = static_cast<size_t>(qp.Q->nrow);
-    return qp;
+    auto t1    = std::chrono::steady_clock::now();
+    setup_time = std::chrono::duration_cast<Duration>(t1 - t0);
+    solver->solve();
+    auto sol = solver->get_solution();
+    x_prev   = sol.x;
+    y_prev   = sol.y;
+}
+
+void QPALMSequentialSolver::reset() {
+    solver.reset();
+    updater.reset();
+    x_prev.resize(0);
+    y_prev.resize(0);
+    updated = false;
+}
+
+qpalm::SolutionView QPALMSequentialSolver::get_solution() const {
+    if (!solver)
+        throw std::logic_error("QPALMSequentialSolver: no QP was solved yet");
+    return solver->get_solution();
+}
+
+const QPALMInfo &QPALMSequentialSolver::get_info() const {
+    if (!solver)
+        throw std::logic_error("QPALMSequentialSolver: no QP was solved yet");
+    return solver->get_info();
+}
+
+const OwningQPALMData &QPALMSequentialSolver::get_data() const {
+    if (!updater)
+        throw std::logic_error("QPALMSequentialSolver: no QP was solved yet");
+    return updater->get_data();
 }
 
-} // namespace alpaqa
\ No newline at end of file
+} // namespace alpaqa
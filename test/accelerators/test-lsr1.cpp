@@ -0,0 +1,230 @@
+#include <alpaqa/accelerators/lsr1.hpp>
+#include <alpaqa/inner/directions/pantr/lsr1-tr.hpp>
+#include <alpaqa/lsr1-tr-pantr-alm.hpp>
+#include <alpaqa/newton-tr-pantr-alm.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+#include <alpaqa/problem/problem-with-counters.hpp>
+
+#include <Eigen/Eigenvalues>
+#include <test-util/eigen-matchers.hpp>
+
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+/// Random pairs (s, y) with y = H s for a symmetric indefinite matrix H.
+struct Pairs {
+    mat S, Y;
+    Pairs(length_t n, length_t m, unsigned seed = 0) {
+        std::mt19937 rng{seed};
+        std::normal_distribution<real_t> nrml{0, 1};
+        auto rand = [&] { return nrml(rng); };
+        mat A     = mat::NullaryExpr(n, n, rand);
+        vec λ     = vec::LinSpaced(n, -2, 5);
+        Eigen::HouseholderQR<mat> qr{A};
+        mat Q = qr.householderQ();
+        mat H = Q * λ.asDiagonal() * Q.transpose();
+        S     = mat::NullaryExpr(n, m, rand);
+        Y     = H * S;
+    }
+};
+
+/// Dense SR1 update of B₀ = δI with the given pairs, oldest first.
+mat dense_sr1(crmat S, crmat Y, real_t δ) {
+    mat B = δ * mat::Identity(S.rows(), S.rows());
+    for (index_t i = 0; i < S.cols(); ++i) {
+        vec r = Y.col(i) - B * S.col(i);
+        B += r * r.transpose() / r.dot(S.col(i));
+    }
+    return B;
+}
+
+/// Explicit matrix of the L-SR1 approximation.
+mat to_dense(const alpaqa::LSR1<config_t> &lsr1, length_t n) {
+    mat B(n, n), I = mat::Identity(n, n);
+    for (index_t i = 0; i < n; ++i)
+        lsr1.apply_hess(I.col(i), B.col(i), 1);
+    return B;
+}
+
+/// Reference solution of the trust-region subproblem using a dense
+/// eigenvalue decomposition and bisection on the secular equation.
+/// Does not handle the hard case.
+vec dense_trust_region(crmat B, crvec g, real_t Δ) {
+    Eigen::SelfAdjointEigenSolver<mat> eig{B};
+    vec λ = eig.eigenvalues(), gv = eig.eigenvectors().transpose() * g;
+    auto step = [&](real_t σ) -> vec {
+        return -(gv.array() / (λ.array() + σ)).matrix();
+    };
+    if (λ(0) > 0 && step(0).norm() <= Δ)
+        return eig.eigenvectors() * step(0);
+    real_t lo = std::max(real_t(0), -λ(0)), hi = lo + g.norm() / Δ;
+    for (int i = 0; i < 200; ++i) {
+        real_t σ = (lo + hi) / 2;
+        (step(σ).norm() > Δ ? lo : hi) = σ;
+    }
+    return eig.eigenvectors() * step(hi);
+}
+
+real_t model(crmat B, crvec g, crvec q) { return g.dot(q) + q.dot(B * q) / 2; }
+
+} // namespace
+
+TEST(LSR1, compactRepresentation) {
+    const length_t n = 8, m = 5;
+    Pairs p{n, 7};
+    alpaqa::LSR1<config_t> lsr1{{.memory = m}, n};
+    for (index_t i = 0; i < p.S.cols(); ++i)
+        ASSERT_TRUE(lsr1.update_sy(p.S.col(i), p.Y.col(i)));
+    EXPECT_EQ(lsr1.current_history(), m);
+    // Only the m most recent pairs are used, with the current scale
+    auto S   = p.S.rightCols(m), Y = p.Y.rightCols(m);
+    mat B    = to_dense(lsr1, n);
+    mat Bref = dense_sr1(S, Y, lsr1.get_scale());
+    EXPECT_THAT(B, EigenAlmostEqual(Bref, 1e-8));
+    // Secant equation holds for the most recent pair
+    EXPECT_THAT(vec(B * S.col(m - 1)), EigenAlmostEqual(Y.col(m - 1), 1e-8));
+    // Scale of the initial approximation uses the newest pair
+    const auto s = S.col(m - 1), y = Y.col(m - 1);
+    if (s.dot(y) > 0) {
+        EXPECT_NEAR(lsr1.get_scale(), y.squaredNorm() / s.dot(y), 1e-10);
+    }
+    // Rejected pairs leave the approximation unchanged
+    EXPECT_FALSE(lsr1.update_sy(vec::Zero(n), vec::Ones(n)));
+    EXPECT_THAT(to_dense(lsr1, n), EigenAlmostEqual(B, 0));
+    lsr1.reset();
+    EXPECT_EQ(lsr1.current_history(), 0);
+    EXPECT_THAT(to_dense(lsr1, n), EigenAlmostEqual(mat::Identity(n, n), 0));
+}
+
+TEST(LSR1, trustRegion) {
+    const length_t n = 12, m = 4;
+    Pairs p{n, m, 1};
+    alpaqa::LSR1<config_t> lsr1{{.memory = m}, n};
+    for (index_t i = 0; i < m; ++i)
+        ASSERT_TRUE(lsr1.update_sy(p.S.col(i), p.Y.col(i)));
+    mat B = to_dense(lsr1, n);
+    std::mt19937 rng{2};
+    std::normal_distribution<real_t> nrml{0, 1};
+    vec g = vec::NullaryExpr(n, [&] { return nrml(rng); });
+
+    indexvec all = indexvec::LinSpaced(n, 0, n - 1);
+    indexvec few(3);
+    few << 1, 4, 9;
+    for (const indexvec &J : {all, few}) {
+        SCOPED_TRACE(J.size());
+        mat BJ = B(J, J);
+        vec gJ = g(J);
+        for (real_t Δ : {1e-2, 1e-1, 1., 1e6}) {
+            SCOPED_TRACE(Δ);
+            vec q(J.size());
+            real_t val = lsr1.solve_trust_region_masked(gJ, J, Δ, 1, q);
+            vec q_ref  = dense_trust_region(BJ, gJ, Δ);
+            EXPECT_LE(q.norm(), Δ * (1 + 1e-10));
+            EXPECT_THAT(q, EigenAlmostEqual(q_ref, 1e-6 * q_ref.norm()));
+            EXPECT_NEAR(val, model(BJ, gJ, q), 1e-9 * std::abs(val));
+            EXPECT_LT(val, 0);
+        }
+        // B_JJ is indefinite, so the unconstrained minimizer does not exist,
+        // and the solution always lies on the boundary.
+        Eigen::SelfAdjointEigenSolver<mat> eig{BJ};
+        if (eig.eigenvalues()(0) < 0) {
+            vec q(J.size());
+            lsr1.solve_trust_region_masked(gJ, J, 10, 1, q);
+            EXPECT_NEAR(q.norm(), 10, 1e-8);
+        }
+    }
+}
+
+TEST(LSR1, trustRegionHardCase) {
+    // B = δI + Ψ M⁻¹ Ψᵀ with a negative eigenvalue along e₀, and a gradient
+    // that is orthogonal to e₀.
+    const length_t n = 4;
+    alpaqa::LSR1<config_t> lsr1{{.memory = 2}, n};
+    vec s = vec::Unit(n, 0), y = -3 * s; // δ = 3
+    ASSERT_TRUE(lsr1.update_sy(s, y));
+    mat B = to_dense(lsr1, n);
+    EXPECT_NEAR(B(0, 0), -3, 1e-12);
+    EXPECT_NEAR(B(1, 1), 3, 1e-12);
+    vec g = vec::Zero(n);
+    g(2)  = 1;
+    vec q(n);
+    indexvec J = indexvec::LinSpaced(n, 0, n - 1);
+    real_t val = lsr1.solve_trust_region_masked(g, J, 2, 1, q);
+    EXPECT_NEAR(q.norm(), 2, 1e-10);
+    EXPECT_NEAR(val, model(B, g, q), 1e-10);
+    // Global minimizer: σ = 3, q₂ = -1/6, q₀ = ±√(4 - 1/36)
+    EXPECT_NEAR(std::abs(q(0)), std::sqrt(4 - real_t(1) / 36), 1e-8);
+    EXPECT_NEAR(q(2), -real_t(1) / 6, 1e-10);
+}
+
+namespace {
+
+// minimize Σ (1 - xᵢ)² + 10 (xᵢ₊₁ - xᵢ²)²
+//     s.t. -1.5 ≤ x ≤ 0.8
+//          Σ xᵢ ≤ 2
+struct RosenbrockProblem {
+    alpaqa::FunctionalProblem<config_t> problem;
+
+    explicit RosenbrockProblem(length_t n) : problem{n, 1} {
+        problem.C.lowerbound.setConstant(-1.5);
+        problem.C.upperbound.setConstant(0.8);
+        problem.D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+        problem.D.upperbound.setConstant(2);
+        problem.f = [](crvec x) {
+            auto n = x.size();
+            auto a = x.topRows(n - 1), b = x.bottomRows(n - 1);
+            return (1 - a.array()).square().sum() +
+                   10 * (b.array() - a.array().square()).square().sum();
+        };
+        problem.grad_f = [](crvec x, rvec g) {
+            auto n = x.size();
+            auto a = x.topRows(n - 1), b = x.bottomRows(n - 1);
+            vec r  = b.array() - a.array().square();
+            g.setZero();
+            g.topRows(n - 1).array() +=
+                -2 * (1 - a.array()) - 40 * r.array() * a.array();
+            g.bottomRows(n - 1) += 20 * r;
+        };
+        problem.g           = [](crvec x, rvec g) { g(0) = x.sum(); };
+        problem.grad_g_prod = [](crvec, crvec y, rvec g) {
+            g.setConstant(y(0));
+        };
+    }
+};
+
+template <class Direction>
+auto solve(Direction direction, vec &x) {
+    RosenbrockProblem rp{20};
+    auto counted = alpaqa::problem_with_counters_ref(rp.problem);
+    alpaqa::ALMParams<config_t> almparams;
+    almparams.tolerance      = 1e-8;
+    almparams.dual_tolerance = 1e-8;
+    alpaqa::ALMSolver<alpaqa::PANTRSolver<Direction>> solver{
+        almparams, {{}, std::move(direction)}};
+    solver.os = nullptr;
+    x.setZero(20);
+    vec y     = vec::Zero(1);
+    auto stat = solver(counted, x, y);
+    EXPECT_EQ(stat.status, alpaqa::SolverStatus::Converged);
+    return *counted.evaluations;
+}
+
+} // namespace
+
+TEST(LSR1, PANTR) {
+    vec x_ref, x;
+    // Newton-TR with finite differences as a reference, since the problem
+    // does not provide Hessian-vector products
+    alpaqa::NewtonTRDirection<config_t>::Params newton_params;
+    newton_params.direction.finite_diff = true;
+    solve(alpaqa::NewtonTRDirection<config_t>{newton_params}, x_ref);
+    auto evals = solve(alpaqa::LSR1TRDirection<config_t>{}, x);
+    EXPECT_THAT(x, EigenAlmostEqual(x_ref, 1e-6));
+    // No Hessian evaluations at all
+    EXPECT_EQ(evals.hess_ψ_prod, 0);
+    EXPECT_EQ(evals.hess_L_prod, 0);
+    EXPECT_EQ(evals.hess_ψ, 0);
+}
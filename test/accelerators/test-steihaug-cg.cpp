@@ -0,0 +1,184 @@
+#include <alpaqa/accelerators/steihaugcg.hpp>
+#include <alpaqa/inner/directions/pantr/newton-tr.hpp>
+#include <alpaqa/inner/pantr.hpp>
+#include <alpaqa/outer/alm.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+#include <alpaqa/problem/problem-with-counters.hpp>
+
+#include <Eigen/Cholesky>
+#include <test-util/eigen-matchers.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+/// Symmetric positive definite matrix with badly scaled rows and columns.
+mat make_ill_conditioned(length_t n) {
+    vec scale = vec::LinSpaced(n, 0, 2).unaryExpr(
+        [](real_t e) { return std::pow(real_t(10), e); });
+    mat A = mat::Identity(n, n) * 2;
+    A.diagonal(1).setConstant(-real_t(0.5));
+    A.diagonal(-1).setConstant(-real_t(0.5));
+    return scale.asDiagonal() * A * scale.asDiagonal();
+}
+
+alpaqa::SteihaugCGParams<config_t> accurate_params() {
+    alpaqa::SteihaugCGParams<config_t> params;
+    params.tol_scale       = 1e-12;
+    params.max_iter_factor = 10;
+    return params;
+}
+
+} // namespace
+
+TEST(SteihaugCG, jacobi) {
+    const length_t n = 50;
+    mat H            = make_ill_conditioned(n);
+    vec g            = vec::LinSpaced(n, -1, 1);
+    vec x_exact      = H.llt().solve(-g);
+
+    alpaqa::SteihaugCG<config_t> cg{accurate_params()};
+    cg.resize(n);
+    unsigned count = 0;
+    auto hess_prod = [&](crvec p, rvec Hp) {
+        ++count;
+        Hp.topRows(n) = H * p;
+    };
+    vec s(n);
+
+    // Unpreconditioned
+    real_t radius = 1e3 * x_exact.norm();
+    real_t model  = cg.solve(g, hess_prod, radius, s);
+    EXPECT_THAT(s, EigenAlmostEqualRel(x_exact, 1e-6));
+    EXPECT_NEAR(model, g.dot(x_exact) / 2, 1e-8 * std::abs(model));
+    auto count_none = std::exchange(count, 0);
+
+    // Jacobi
+    vec diag     = H.diagonal();
+    auto precond = [&](crvec r, rvec Mr) { Mr = r.cwiseQuotient(diag); };
+    model        = cg.solve(g, hess_prod, precond, radius, s);
+    EXPECT_THAT(s, EigenAlmostEqualRel(x_exact, 1e-6));
+    EXPECT_NEAR(model, g.dot(x_exact) / 2, 1e-8 * std::abs(model));
+    auto count_jacobi = std::exchange(count, 0);
+    EXPECT_LT(2 * count_jacobi, count_none);
+
+    // The trust region is measured in the norm induced by the preconditioner
+    auto M_norm = [&](crvec p) {
+        return std::sqrt(p.dot(diag.asDiagonal() * p));
+    };
+    radius = M_norm(x_exact) / 2;
+    model  = cg.solve(g, hess_prod, precond, radius, s);
+    EXPECT_NEAR(M_norm(s), radius, 1e-10 * radius);
+    EXPECT_LT(model, 0);
+    // Without preconditioner, it is the Euclidean norm
+    radius = x_exact.norm() / 2;
+    model  = cg.solve(g, hess_prod, radius, s);
+    EXPECT_NEAR(s.norm(), radius, 1e-10 * radius);
+    EXPECT_LT(model, 0);
+}
+
+TEST(SteihaugCG, negativeCurvaturePreconditioned) {
+    const length_t n = 3;
+    vec h{{1, -1, 2}};
+    vec g{{1, 1, 1}};
+    alpaqa::SteihaugCG<config_t> cg{accurate_params()};
+    cg.resize(n);
+    auto hess_prod = [&](crvec p, rvec Hp) {
+        Hp.topRows(n) = h.cwiseProduct(p);
+    };
+    vec diag{{4, 1, 9}};
+    auto precond = [&](crvec r, rvec Mr) { Mr = r.cwiseQuotient(diag); };
+    vec s(n);
+    real_t radius = 0.5;
+    real_t model  = cg.solve(g, hess_prod, precond, radius, s);
+    // The step ends on the boundary of the ellipsoid ‖s‖_M ≤ Δ
+    EXPECT_NEAR(std::sqrt(s.dot(diag.asDiagonal() * s)), radius, 1e-12);
+    EXPECT_NEAR(model, g.dot(s) + s.dot(h.cwiseProduct(s)) / 2, 1e-12);
+    EXPECT_LT(model, 0);
+}
+
+namespace {
+
+// minimize ½ xᵀHx - 1ᵀx
+//     s.t. -1 ≤ x ≤ 1
+//          1ᵀx ≤ 1
+struct TestProblem {
+    alpaqa::FunctionalProblem<config_t> problem;
+    mat H;
+
+    explicit TestProblem(length_t n)
+        : problem{n, 1}, H{make_ill_conditioned(n)} {
+        problem.C.lowerbound.setConstant(-1);
+        problem.C.upperbound.setConstant(+1);
+        problem.D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+        problem.D.upperbound.setConstant(1);
+        problem.f = [this](crvec x) { return x.dot(H * x) / 2 - x.sum(); };
+        problem.grad_f = [this](crvec x, rvec g) {
+            g = H * x - vec::Ones(x.size());
+        };
+        problem.g           = [](crvec x, rvec g) { g(0) = x.sum(); };
+        problem.grad_g_prod = [](crvec, crvec y, rvec g) {
+            g.setConstant(y(0));
+        };
+        problem.jac_g = [](crvec, rmat J) { J.setOnes(); };
+        problem.hess_ψ_prod = [this](crvec x, crvec y, crvec Σ, real_t scale,
+                                     crvec v, rvec Hv) {
+            Hv = scale * (H * v);
+            if (real_t ζ = x.sum() + y(0) / Σ(0); ζ > 1)
+                Hv.array() += scale * Σ(0) * v.sum();
+        };
+        problem.hess_ψ = [this](crvec x, crvec y, crvec Σ, real_t scale,
+                                rmat Hψ) {
+            Hψ = scale * H;
+            if (real_t ζ = x.sum() + y(0) / Σ(0); ζ > 1)
+                Hψ.array() += scale * Σ(0);
+        };
+    }
+};
+
+using Direction = alpaqa::NewtonTRDirection<config_t>;
+using Solver    = alpaqa::ALMSolver<alpaqa::PANTRSolver<Direction>>;
+
+unsigned solve_count_hess_prod(Direction direction, vec &x) {
+    TestProblem tp{50};
+    auto counted = alpaqa::problem_with_counters_ref(tp.problem);
+    alpaqa::ALMParams<config_t> almparams;
+    almparams.tolerance      = 1e-8;
+    almparams.dual_tolerance = 1e-8;
+    Solver solver{almparams, {{}, std::move(direction)}};
+    solver.os = nullptr;
+    x.setZero(50);
+    vec y     = vec::Zero(1);
+    auto stat = solver(counted, x, y);
+    EXPECT_EQ(stat.status, alpaqa::SolverStatus::Converged);
+    return counted.evaluations->hess_ψ_prod;
+}
+
+} // namespace
+
+TEST(SteihaugCG, preconditionedPANTR) {
+    using Precond = alpaqa::SteihaugCGPreconditioner;
+    Direction::Params params;
+    vec x_ref, x;
+    auto count_none = solve_count_hess_prod(Direction{params}, x_ref);
+
+    for (auto precond : {Precond::HessianDiagonal, Precond::LBFGS,
+                         Precond::JacobianColumnNorms, Precond::Custom}) {
+        SCOPED_TRACE(alpaqa::enum_name(precond));
+        params.accelerator.preconditioner = precond;
+        Direction direction{params};
+        mat H = make_ill_conditioned(50);
+        // Exact inverse of the Hessian of the objective
+        direction.custom_preconditioner = [&](crvec, crindexvec J, crvec r,
+                                              rvec Mr) {
+            mat HJ = H(J, J);
+            Mr     = HJ.llt().solve(r);
+        };
+        auto count = solve_count_hess_prod(std::move(direction), x);
+        EXPECT_THAT(x, EigenAlmostEqual(x_ref, 1e-6));
+        // The Jacobian is not informative for this problem
+        if (precond != Precond::JacobianColumnNorms) {
+            EXPECT_LT(count, count_none);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <alpaqa/functions/nuclear-norm.hpp>
+#include <alpaqa/functions/truncated-svd.hpp>
+
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+/// Random matrix of the given rank plus small noise.
+mat low_rank(length_t rows, length_t cols, length_t rank, real_t noise,
+             std::mt19937 &rng) {
+    std::normal_distribution<real_t> nrml{0, 1};
+    auto rnd = [&](length_t r, length_t c) -> mat {
+        return mat::NullaryExpr(r, c, [&] { return nrml(rng); });
+    };
+    return rnd(rows, rank) * rnd(rank, cols) + noise * rnd(rows, cols);
+}
+
+} // namespace
+
+TEST(NuclearNorm, truncatedSVD) {
+    const length_t rows = 120, cols = 90, rank = 5;
+    std::mt19937 rng{321};
+    std::normal_distribution<real_t> nrml{0, 1};
+    // The singular values of the noise are well below the threshold λ
+    mat A = low_rank(rows, cols, rank, 0.1, rng);
+    alpaqa::functions::NuclearNorm<config_t> full{10, rows, cols};
+    alpaqa::functions::TruncatedNuclearNorm<config_t> truncated{10, rows, cols};
+    mat out_full(rows, cols), out_trunc(rows, cols);
+    for (int k = 0; k < 10; ++k) {
+        SCOPED_TRACE(k);
+        // Small perturbation between evaluations, as in a proximal method
+        A += 1e-2 * mat::NullaryExpr(rows, cols, [&] { return nrml(rng); });
+        real_t h_full  = full.prox(A.reshaped(), out_full.reshaped(), 1);
+        real_t h_trunc = truncated.prox(A.reshaped(), out_trunc.reshaped(), 1);
+        EXPECT_NEAR(h_trunc, h_full, 1e-8 * h_full);
+        EXPECT_THAT(out_trunc, EigenAlmostEqual(out_full, 1e-8 * A.norm()));
+        EXPECT_EQ(truncated.svd.get_rank(), rank);
+    }
+    // Only a few singular triplets were computed
+    EXPECT_LT(truncated.svd.singularValues().size(), 2 * rank + 8);
+    EXPECT_EQ(truncated.svd.get_num_full(), 0u);
+    EXPECT_EQ(truncated.svd.get_num_computations(), 10u);
+}
+
+TEST(NuclearNorm, truncatedSVDRankIncrease) {
+    const length_t rows = 200, cols = 200, rank = 30;
+    std::mt19937 rng{654};
+    mat A = low_rank(rows, cols, rank, 1e-6, rng);
+    alpaqa::functions::TruncatedSVD<config_t> svd;
+    svd.params.initial_rank = 2;
+    // The subspace is enlarged until all singular values above the threshold
+    // are found
+    svd.compute_truncated(A, 1e-2);
+    EXPECT_EQ(svd.get_rank(), rank);
+    Eigen::JacobiSVD<mat> ref{A};
+    EXPECT_THAT(vec(svd.singularValues().topRows(rank)),
+                EigenAlmostEqual(vec(ref.singularValues().topRows(rank)),
+                                 1e-8 * ref.singularValues()(0)));
+    EXPECT_THAT(mat(svd.matrixU() * svd.singularValues().asDiagonal() *
+                    svd.matrixV().transpose()),
+                EigenAlmostEqual(A, 1e-4));
+    // Threshold zero requires all singular values
+    svd.compute_truncated(A, 0);
+    EXPECT_EQ(svd.singularValues().size(), rows);
+    EXPECT_EQ(svd.get_num_full(), 1u);
+}
+
+TEST(NuclearNorm, truncatedSVDUnconverged) {
+    const length_t rows = 60, cols = 50;
+    alpaqa::functions::TruncatedSVD<config_t> svd;
+    svd.params.initial_rank = 1;
+    svd.params.oversampling = 0;
+    const real_t threshold  = 5;
+    // The right singular vector of the first matrix is almost orthogonal to
+    // the dominant right singular vector of the second matrix
+    vec z = vec::Zero(cols);
+    z(0)  = real_t(0.01);
+    z(1)  = 1;
+    z.normalize();
+    mat A1   = 10 * vec::Unit(rows, 0) * z.transpose();
+    mat A2   = mat::Zero(rows, cols);
+    A2(0, 0) = 10;
+    A2(1, 1) = 1;
+    svd.compute_truncated(A1, threshold);
+    ASSERT_EQ(svd.get_rank(), 1);
+    // Warm-started from z, a single power iteration yields a Ritz value below
+    // the threshold, but its triplet has a large residual, so the subspace
+    // must be enlarged
+    svd.params.max_iter = 1;
+    svd.compute_truncated(A2, threshold);
+    const auto &S = svd.singularValues();
+    ASSERT_GE(S.size(), 2);
+    EXPECT_EQ(svd.get_rank(), 1);
+    EXPECT_NEAR(S(0), 10, 1e-10);
+    EXPECT_EQ(svd.get_num_full(), 0u);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <alpaqa/functions/elastic-net.hpp>
+#include <alpaqa/functions/indicator-linf-ball.hpp>
+#include <alpaqa/functions/indicator-simplex.hpp>
+#include <alpaqa/functions/l21-norm.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+vec random_vec(length_t n, real_t scale, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::normal_distribution<real_t> nrml{0, scale};
+    return vec::NullaryExpr(n, [&] { return nrml(rng); });
+}
+
+/// Sort-based projection onto the simplex, for reference.
+vec project_simplex_sort(crvec x, real_t r) {
+    vec μ = x;
+    std::sort(μ.begin(), μ.end(), std::greater<>{});
+    real_t s = 0, θ = 0;
+    for (index_t j = 0; j < μ.size(); ++j) {
+        s += μ(j);
+        real_t t = (s - r) / static_cast<real_t>(j + 1);
+        if (μ(j) - t > 0)
+            θ = t;
+    }
+    return (x.array() - θ).max(0);
+}
+
+} // namespace
+
+TEST(Prox, L21NormColumns) {
+    alpaqa::functions::L21Norm<config_t> h{0.5};
+    mat x(3, 3);
+    x << 1, 0.1, 0, //
+        2, 0.2, 0,  //
+        2, 0.2, 3;
+    mat y(3, 3);
+    real_t γ  = 2;
+    real_t hy = alpaqa::prox(h, x, y, γ);
+    // The norm of each column is reduced by γλ = 1, or set to zero
+    mat y_expected(3, 3);
+    y_expected << 2. / 3, 0, 0, //
+        4. / 3, 0, 0,           //
+        4. / 3, 0, 2;
+    EXPECT_THAT(y, EigenAlmostEqual(y_expected, 1e-14));
+    EXPECT_NEAR(hy, 0.5 * (2 + 0 + 2), 1e-14);
+}
+
+TEST(Prox, L21NormGroups) {
+    indexvec groups(3);
+    groups << 0, 2, 3;
+    alpaqa::functions::L21Norm<config_t> h{1, groups};
+    vec x(5), y(5);
+    x << 3, 4, 0.5, 0, 2;
+    real_t hy = alpaqa::prox(h, x, y, 1);
+    vec y_expected(5);
+    y_expected << 3 * 0.8, 4 * 0.8, 0, 0, 1;
+    EXPECT_THAT(y, EigenAlmostEqual(y_expected, 1e-14));
+    EXPECT_NEAR(hy, 4 + 0 + 1, 1e-14);
+    EXPECT_THROW((alpaqa::functions::L21Norm<config_t>{1, indexvec{{1, 2}}}),
+                 std::invalid_argument);
+}
+
+TEST(Prox, ElasticNet) {
+    alpaqa::functions::ElasticNet<config_t> h{0.5, 2};
+    vec x = random_vec(50, 1, 1), y(50);
+    real_t γ  = 0.5;
+    real_t hy = alpaqa::prox(h, x, y, γ);
+    // Optimality: 0 ∈ y - x + γ(λ1 ∂‖y‖₁ + λ2 y)
+    for (index_t i = 0; i < x.size(); ++i) {
+        real_t r = x(i) - y(i) - γ * h.λ2 * y(i);
+        if (y(i) == 0)
+            EXPECT_LE(std::abs(r), γ * h.λ1 + 1e-14);
+        else
+            EXPECT_NEAR(r, γ * h.λ1 * (y(i) > 0 ? 1 : -1), 1e-14);
+    }
+    EXPECT_NEAR(hy, h.λ1 * y.lpNorm<1>() + h.λ2 / 2 * y.squaredNorm(), 1e-12);
+}
+
+TEST(Prox, LInfBall) {
+    alpaqa::functions::LInfBall<config_t> h{0.5};
+    vec x(4), y(4);
+    x << -1, -0.25, 0.25, 2;
+    EXPECT_EQ(alpaqa::prox(h, x, y, 1), 0);
+    vec y_expected(4);
+    y_expected << -0.5, -0.25, 0.25, 0.5;
+    EXPECT_THAT(y, EigenEqual(y_expected));
+}
+
+TEST(Prox, Simplex) {
+    alpaqa::functions::Simplex<config_t> h{2};
+    for (length_t n : {1, 2, 5, 100, 1000}) {
+        for (real_t scale : {0.01, 1., 10.}) {
+            SCOPED_TRACE(n);
+            SCOPED_TRACE(scale);
+            vec x = random_vec(n, scale, static_cast<unsigned>(n));
+            vec y(n);
+            alpaqa::prox(h, x, y, 1);
+            EXPECT_NEAR(y.sum(), 2, 1e-12 * static_cast<real_t>(n));
+            EXPECT_GE(y.minCoeff(), 0);
+            EXPECT_THAT(y, EigenAlmostEqual(project_simplex_sort(x, 2), 1e-12));
+        }
+    }
+    // Ties
+    vec x = vec::Constant(10, 1), y(10);
+    alpaqa::prox(h, x, y, 1);
+    EXPECT_THAT(y, EigenAlmostEqual(vec::Constant(10, 0.2), 1e-14));
+}
+
+TEST(Prox, L1Ball) {
+    alpaqa::functions::L1Ball<config_t> h{3};
+    // Inside the ball
+    vec x(3), y(3);
+    x << 1, -1, 0.5;
+    alpaqa::prox(h, x, y, 1);
+    EXPECT_THAT(y, EigenEqual(x));
+    // Outside the ball
+    for (length_t n : {2, 10, 1000}) {
+        SCOPED_TRACE(n);
+        vec x = random_vec(n, 5, static_cast<unsigned>(n) + 7), y(n);
+        alpaqa::prox(h, x, y, 1);
+        EXPECT_NEAR(y.lpNorm<1>(), 3, 1e-12 * static_cast<real_t>(n));
+        vec y_expected = x.cwiseSign().cwiseProduct(
+            project_simplex_sort(x.cwiseAbs(), 3));
+        EXPECT_THAT(y, EigenAlmostEqual(y_expected, 1e-12));
+    }
+}
+
+TEST(Prox, SimplexProxStep) {
+    // Projected gradient step, as in Problem::eval_prox_grad_step
+    alpaqa::functions::Simplex<config_t> h{1};
+    vec x = vec::Constant(4, 0.25), grad(4), x̂(4), p(4);
+    grad << 1, 0, 0, -1;
+    real_t γ = 0.1;
+    alpaqa::prox_step(h, x, grad, x̂, p, γ, -γ);
+    vec x̂_expected(4);
+    x̂_expected << 0.15, 0.25, 0.25, 0.35;
+    EXPECT_THAT(x̂, EigenAlmostEqual(x̂_expected, 1e-14));
+    EXPECT_THAT(p, EigenAlmostEqual(vec(x̂_expected - x), 1e-14));
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <alpaqa/inner/directions/panoc/convex-newton.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using Direction = alpaqa::ConvexNewtonDirection<config_t>;
+
+/// Convex quadratic f(x) = ½ xᵀHx with bounds -1 ≤ x ≤ 1.
+struct QuadraticProblem {
+    alpaqa::FunctionalProblem<config_t> problem;
+    /// If @p upper_only is set, only the upper triangle of the Hessian is
+    /// evaluated, the strictly lower triangle is filled with NaN.
+    explicit QuadraticProblem(const mat &H, bool upper_only = false)
+        : problem{H.rows(), 0} {
+        problem.C.lowerbound.setConstant(-1);
+        problem.C.upperbound.setConstant(+1);
+        problem.f      = [H](crvec x) { return x.dot(H * x) / 2; };
+        problem.grad_f = [H](crvec x, rvec g) { g = H * x; };
+        problem.g      = [](crvec, rvec) {};
+        problem.grad_g_prod = [](crvec, crvec, rvec g) { g.setZero(); };
+        problem.hess_L = [H, upper_only](crvec, crvec, real_t scale,
+                                         rmat out) {
+            out = scale * H;
+            if (upper_only)
+                out.triangularView<Eigen::StrictlyLower>().setConstant(
+                    alpaqa::NaN<config_t>);
+        };
+    }
+};
+
+/// Compute the direction in x = 0 for the given gradient (variables with
+/// |grad| > 1 are active).
+vec compute_direction(Direction &dir,
+                      const alpaqa::TypeErasedProblem<config_t> &problem,
+                      crvec grad, bool init) {
+    const auto n   = grad.size();
+    const real_t γ  = 1;
+    vec y(0), Σ(0), x = vec::Zero(n);
+    vec x̂ = (x - γ * grad).cwiseMax(-1).cwiseMin(1);
+    vec p = x̂ - x, q(n);
+    if (init)
+        dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+    EXPECT_TRUE(dir.apply(γ, x, x̂, p, grad, q));
+    return q;
+}
+
+} // namespace
+
+TEST(ConvexNewton, factorizationUpdates) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    const length_t n = 40;
+    std::mt19937 rng{12345};
+    std::normal_distribution<real_t> nrml{0, 1};
+    std::uniform_real_distribution<real_t> unif{-0.5, 0.5};
+    std::uniform_int_distribution<index_t> idx{0, n - 1};
+    mat A = mat::NullaryExpr(n, n, [&] { return nrml(rng); });
+    mat H = A.transpose() * A + mat::Identity(n, n);
+    QuadraticProblem qp{H};
+    TEProblem problem{&qp.problem};
+
+    Direction::Params params;
+    params.accelerator.ζ       = 0;
+    params.direction.quadratic = true;
+    Direction cached{params};
+    params.direction.update_factorization = false;
+    Direction reference{params};
+
+    vec grad = vec::NullaryExpr(n, [&] { return unif(rng); });
+    vec y(0), Σ(0), x = vec::Zero(n);
+    const real_t γ  = 1;
+    auto compute = [&](Direction &dir, bool init) {
+        vec x̂ = (x - γ * grad).cwiseMax(-1).cwiseMin(1);
+        vec p = x̂ - x, q(n);
+        if (init)
+            dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+        EXPECT_TRUE(dir.apply(γ, x, x̂, p, grad, q));
+        return q;
+    };
+    for (index_t k = 0; k < 50; ++k) {
+        SCOPED_TRACE(k);
+        // Move a few variables between the active and the inactive set
+        if (k > 0)
+            for (index_t i = 0; i < 1 + k % 3; ++i) {
+                auto j  = idx(rng);
+                grad(j) = std::abs(grad(j)) < 1 ? 2 * (nrml(rng) > 0 ? 1 : -1)
+                                                : unif(rng);
+            }
+        vec q_ref = compute(reference, k == 0);
+        vec q     = compute(cached, k == 0);
+        EXPECT_THAT(q, EigenAlmostEqual(q_ref, 1e-10));
+    }
+    const auto &stats = cached.get_factorization_stats();
+    EXPECT_EQ(stats.hessian_evaluations, 1u);
+    EXPECT_GE(stats.factorizations, 1u);
+    EXPECT_GT(stats.updates, 0u);
+    EXPECT_GT(stats.indices_added, 0u);
+    EXPECT_GT(stats.indices_removed, 0u);
+    EXPECT_EQ(stats.factorizations + stats.updates + stats.reuses, 50u);
+    EXPECT_EQ(reference.get_factorization_stats().factorizations, 0u);
+}
+
+TEST(ConvexNewton, regularizationChange) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    const length_t n = 10;
+    mat H            = mat::Identity(n, n);
+    H.diagonal().setLinSpaced(1, 2);
+    QuadraticProblem qp{H};
+    TEProblem problem{&qp.problem};
+
+    Direction::Params params;
+    params.accelerator.ζ                      = 1e-2;
+    params.direction.quadratic                = true;
+    params.direction.regularization_tolerance = 0;
+    Direction dir{params};
+    vec y(0), Σ(0), x = vec::Zero(n);
+    const real_t γ  = 1;
+    for (real_t scale : {0.1, 0.2, 0.2}) {
+        vec grad = vec::Constant(n, scale);
+        vec x̂    = (x - γ * grad).cwiseMax(-1).cwiseMin(1);
+        vec p    = x̂ - x, q(n);
+        if (scale == 0.1)
+            dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+        EXPECT_TRUE(dir.apply(γ, x, x̂, p, grad, q));
+        // The regularization depends on the residual ‖p‖/γ
+        real_t reg = params.accelerator.ζ * p.norm() / γ;
+        vec q_ref  = (H + reg * mat::Identity(n, n)).llt().solve(p / γ);
+        EXPECT_THAT(q, EigenAlmostEqual(q_ref, 1e-12));
+    }
+    // A change in regularization requires a new factorization
+    const auto &stats = dir.get_factorization_stats();
+    EXPECT_EQ(stats.hessian_evaluations, 1u);
+    EXPECT_EQ(stats.factorizations, 2u);
+    EXPECT_EQ(stats.reuses, 1u);
+}
+
+TEST(ConvexNewton, regularizationFrozenDuringUpdates) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    const length_t n = 10;
+    mat H            = mat::Identity(n, n);
+    H.diagonal().setLinSpaced(1, 2);
+    QuadraticProblem qp{H};
+    TEProblem problem{&qp.problem};
+
+    Direction::Params params;
+    params.accelerator.ζ       = 1e-2;
+    params.direction.quadratic = true;
+    Direction dir{params};
+    vec y(0), Σ(0), x = vec::Zero(n);
+    const real_t γ  = 1;
+    real_t reg_fact = 0;
+    auto check = [&](real_t scale, bool init, bool refactored) {
+        vec grad = vec::Constant(n, scale);
+        grad(0)  = 2; // variable 0 is active
+        if (init)
+            grad(0) = scale;
+        vec x̂ = (x - γ * grad).cwiseMax(-1).cwiseMin(1);
+        vec p = x̂ - x, q(n);
+        if (init)
+            dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+        EXPECT_TRUE(dir.apply(γ, x, x̂, p, grad, q));
+        real_t reg = params.accelerator.ζ * p.norm() / γ;
+        if (refactored)
+            reg_fact = reg;
+        // Only the free variables are computed using the factorization
+        auto J  = Eigen::seq(init ? 0 : 1, n - 1);
+        mat HJ  = H(J, J) + reg_fact * mat::Identity(J.size(), J.size());
+        vec q_J = HJ.llt().solve(vec(p(J) / γ));
+        EXPECT_THAT(vec(q(J)), EigenAlmostEqual(q_J, 1e-12));
+        return reg;
+    };
+    // All variables are free
+    check(0.1, true, true);
+    // Variable 0 becomes active and the regularization changes: the
+    // factorization is updated using the previous regularization
+    real_t reg = check(0.2, false, false);
+    EXPECT_GT(reg, 2 * reg_fact);
+    // Same active set, the regularization differs too much
+    check(0.2, false, true);
+    // Same active set, small change in regularization
+    check(0.21, false, false);
+    const auto &stats = dir.get_factorization_stats();
+    EXPECT_EQ(stats.factorizations, 2u);
+    EXPECT_EQ(stats.updates, 1u);
+    EXPECT_EQ(stats.reuses, 1u);
+}
+
+TEST(ConvexNewton, upperTriangularHessian) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    const length_t n = 20;
+    std::mt19937 rng{54321};
+    std::normal_distribution<real_t> nrml{0, 1};
+    std::uniform_real_distribution<real_t> unif{-0.5, 0.5};
+    std::uniform_int_distribution<index_t> idx{0, n - 1};
+    mat A = mat::NullaryExpr(n, n, [&] { return nrml(rng); });
+    mat H = A.transpose() * A + mat::Identity(n, n);
+    QuadraticProblem qp{H, true};
+    TEProblem problem{&qp.problem};
+
+    Direction::Params params;
+    params.accelerator.ζ                 = 0;
+    params.direction.quadratic           = true;
+    params.direction.max_update_fraction = 1;
+    Direction cached{params};
+    vec grad = vec::NullaryExpr(n, [&] { return unif(rng); });
+    for (index_t k = 0; k < 20; ++k) {
+        SCOPED_TRACE(k);
+        if (k > 0)
+            for (index_t i = 0; i < 2; ++i) {
+                auto j  = idx(rng);
+                grad(j) = std::abs(grad(j)) < 1 ? 2 : unif(rng);
+            }
+        // Exact solution using the full Hessian
+        vec q_ref = -grad.cwiseMax(-1).cwiseMin(1);
+        indexvec J(n);
+        length_t nJ = 0;
+        for (index_t i = 0; i < n; ++i)
+            if (std::abs(grad(i)) < 1)
+                J(nJ++) = i;
+        J.conservativeResize(nJ);
+        mat HJ  = H(J, J);
+        vec qJ   = q_ref(J);
+        HJ.llt().solveInPlace(qJ);
+        q_ref(J) = qJ;
+        vec q    = compute_direction(cached, problem, grad, k == 0);
+        EXPECT_THAT(q, EigenAlmostEqual(q_ref, 1e-10));
+    }
+    EXPECT_GT(cached.get_factorization_stats().updates, 0u);
+}
+
+TEST(ConvexNewton, failedFactorization) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    const length_t n = 6;
+    // The leading 3×3 block is indefinite, its 2×2 principal submatrices are
+    // positive definite
+    mat H                  = mat::Identity(n, n);
+    H.topLeftCorner(3, 3) += mat::Constant(3, 3, -0.6);
+    H.diagonal().topRows(3).setOnes();
+    QuadraticProblem qp{H};
+    TEProblem problem{&qp.problem};
+
+    Direction::Params params;
+    params.accelerator.ζ                 = 0;
+    params.direction.quadratic           = true;
+    params.direction.max_update_fraction = 1;
+    Direction cached{params};
+    params.direction.update_factorization = false;
+    Direction reference{params};
+
+    vec grad = vec::Constant(n, 0.1);
+    EXPECT_THROW(compute_direction(cached, problem, grad, true),
+                 std::runtime_error);
+    // Variable 2 is active
+    grad(2) = 2;
+    vec q_ref = compute_direction(reference, problem, grad, true);
+    EXPECT_THAT(compute_direction(cached, problem, grad, false),
+                EigenAlmostEqual(q_ref, 1e-12));
+    // Variable 1 is active, variable 2 is free again
+    grad(1) = 2, grad(2) = 0.1;
+    q_ref = compute_direction(reference, problem, grad, false);
+    EXPECT_THAT(compute_direction(cached, problem, grad, false),
+                EigenAlmostEqual(q_ref, 1e-12));
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <alpaqa/implementation/outer/alm.tpp>
+#include <alpaqa/inner/fista.hpp>
+#include <alpaqa/newton-tr-pantr-alm.hpp>
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#include <alpaqa/zerofpr-alm.hpp>
+
+#include <chrono>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+namespace syn = alpaqa::synthetic;
+using std::chrono::nanoseconds;
+
+/// Solve the problem using the given ALM solver, and check the consistency of
+/// the time spent in the different phases of the inner solver, both in the
+/// final statistics and in the statistics passed to the progress callback.
+template <class InnerSolver, class P>
+auto check_phase_times(InnerSolver inner_solver, const P &problem) {
+    unsigned num_callbacks = 0;
+    nanoseconds prev_eval{};
+    inner_solver.set_progress_callback([&](const auto &info) {
+        ASSERT_NE(info.stats, nullptr);
+        if (info.k > 0) {
+            EXPECT_GE(info.stats->time_evaluations, prev_eval);
+        }
+        prev_eval = info.stats->time_evaluations;
+        ++num_callbacks;
+    });
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.tolerance      = 1e-6;
+    almparam.dual_tolerance = 1e-6;
+    almparam.max_iter       = 100;
+    alpaqa::ALMSolver<InnerSolver> solver{almparam, std::move(inner_solver)};
+    vec x = problem.initial_guess, y = vec::Zero(problem.get_m());
+    auto stats = solver(problem, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_GT(num_callbacks, 0u);
+    const auto &s = stats.inner;
+    EXPECT_GT(s.time_evaluations, nanoseconds{0});
+    EXPECT_GT(s.time_prox, nanoseconds{0});
+    // Evaluations, proximal steps and directions are timed separately
+    auto total = s.time_evaluations + s.time_prox;
+    if constexpr (requires { s.time_direction_apply; }) {
+        EXPECT_GT(s.time_direction_apply, nanoseconds{0});
+        EXPECT_GT(s.time_direction_update, nanoseconds{0});
+        total += s.time_direction_apply + s.time_direction_update;
+    }
+    EXPECT_LE(total, s.elapsed_time);
+    if constexpr (requires { s.time_linesearch; }) {
+        EXPECT_LE(s.time_linesearch, s.elapsed_time);
+    }
+    return stats;
+}
+
+} // namespace
+
+TEST(PhaseTimes, panoc) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using InnerSolver = alpaqa::PANOCSolver<Direction>;
+    InnerSolver::Params panocparam;
+    panocparam.max_iter = 10000;
+    auto stats = check_phase_times(InnerSolver{panocparam, {{.memory = 20}}},
+                                   syn::ChainOCP{{.N = 10, .nx = 6, .nu = 1}});
+    // The line search includes the evaluations of the candidate iterates
+    EXPECT_GT(stats.inner.time_linesearch, nanoseconds{0});
+}
+
+TEST(PhaseTimes, zerofpr) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using InnerSolver = alpaqa::ZeroFPRSolver<Direction>;
+    InnerSolver::Params zfprparam;
+    zfprparam.max_iter = 10000;
+    auto stats = check_phase_times(InnerSolver{zfprparam, {{.memory = 20}}},
+                                   syn::RandomQP{{.n = 50, .m = 20}});
+    EXPECT_GT(stats.inner.time_linesearch, nanoseconds{0});
+}
+
+TEST(PhaseTimes, pantr) {
+    using Direction   = alpaqa::NewtonTRDirection<config_t>;
+    using InnerSolver = alpaqa::PANTRSolver<Direction>;
+    InnerSolver::Params pantrparam;
+    pantrparam.max_iter = 10000;
+    check_phase_times(InnerSolver{pantrparam, {}},
+                      syn::ChainedRosenbrock{{.n = 20, .a = 10}});
+}
+
+TEST(PhaseTimes, fista) {
+    using InnerSolver = alpaqa::FISTASolver<config_t>;
+    InnerSolver::Params fistaparam;
+    fistaparam.max_iter = 100000;
+    check_phase_times(InnerSolver{fistaparam},
+                      syn::RandomQP{{.n = 50, .m = 20}});
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <alpaqa/inner/directions/panoc/structured-newton.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+#include <array>
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using Direction = alpaqa::StructuredNewtonDirection<config_t>;
+using Reg       = alpaqa::StructuredNewtonRegularization;
+
+/// Symmetric matrix with the given eigenvalues and random eigenvectors.
+mat random_symmetric(crvec λ, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::normal_distribution<real_t> nrml{0, 1};
+    const auto n = λ.size();
+    mat A        = mat::NullaryExpr(n, n, [&] { return nrml(rng); });
+    Eigen::HouseholderQR<mat> qr{A};
+    mat Q = qr.householderQ();
+    return Q * λ.asDiagonal() * Q.transpose();
+}
+
+/// Unconstrained quadratic f(x) = ½ xᵀHx + cᵀx with box constraints.
+struct QuadraticProblem {
+    alpaqa::FunctionalProblem<config_t> problem;
+    QuadraticProblem(const mat &H, const vec &c, const vec &lb, const vec &ub)
+        : problem{H.rows(), 0} {
+        problem.C.lowerbound = lb;
+        problem.C.upperbound = ub;
+        problem.f = [H, c](crvec x) { return x.dot(H * x) / 2 + c.dot(x); };
+        problem.grad_f = [H, c](crvec x, rvec g) { g = H * x + c; };
+        problem.g      = [](crvec, rvec) {};
+        problem.grad_g_prod = [](crvec, crvec, rvec g) { g.setZero(); };
+        problem.hess_L = [H](crvec, crvec, real_t scale, rmat out) {
+            out = scale * H;
+        };
+    }
+};
+
+/// Compute the structured Newton direction in x = 0.
+vec direction(Reg method, const QuadraticProblem &qp, const vec &c,
+              real_t γ = 1) {
+    using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+    TEProblem problem{&qp.problem};
+    const auto n = qp.problem.get_n();
+    Direction::Params params;
+    params.accelerator.method = method;
+    Direction dir{params};
+    vec y(0), Σ(0), x = vec::Zero(n), grad = c;
+    vec x̂ = (x - γ * grad)
+                 .cwiseMax(qp.problem.C.lowerbound)
+                 .cwiseMin(qp.problem.C.upperbound);
+    vec p = x̂ - x, q(n);
+    dir.initialize(problem, y, Σ, γ, x, x̂, p, grad);
+    EXPECT_TRUE(dir.apply(γ, x, x̂, p, grad, q));
+    return q;
+}
+
+const std::array methods{Reg::EigenvalueClipping, Reg::ShiftedCholesky,
+                         Reg::ModifiedLDLT};
+
+} // namespace
+
+TEST(StructuredNewton, positiveDefinite) {
+    const length_t n = 12;
+    vec λ            = vec::LinSpaced(n, 1, 10);
+    mat H            = random_symmetric(λ, 1);
+    vec c            = vec::LinSpaced(n, -1, 1);
+    const auto inf   = alpaqa::inf<config_t>;
+    QuadraticProblem qp{H, c, vec::Constant(n, -inf), vec::Constant(n, +inf)};
+    vec q_newton = -H.llt().solve(c);
+    for (auto method : methods) {
+        SCOPED_TRACE(enum_name(method));
+        vec q = direction(method, qp, c);
+        // Eigenvalue clipping and the shifted Cholesky factorization leave
+        // positive definite matrices unchanged
+        if (method != Reg::ModifiedLDLT)
+            EXPECT_THAT(q, EigenAlmostEqual(q_newton, 1e-10));
+        // The modified LDLᵀ factorization may perturb the matrix, but the
+        // direction should still be close to the Newton direction
+        else
+            EXPECT_LT((q - q_newton).norm(), 0.5 * q_newton.norm());
+    }
+}
+
+TEST(StructuredNewton, positiveDefiniteDiagonallyDominant) {
+    const length_t n = 8;
+    mat H            = mat::Constant(n, n, 0.1);
+    H.diagonal().setLinSpaced(2, 5);
+    vec c          = vec::LinSpaced(n, -1, 1);
+    const auto inf = alpaqa::inf<config_t>;
+    QuadraticProblem qp{H, c, vec::Constant(n, -inf), vec::Constant(n, +inf)};
+    vec q_newton = -H.llt().solve(c);
+    // No modification is needed, all methods result in the Newton step
+    for (auto method : methods) {
+        SCOPED_TRACE(enum_name(method));
+        EXPECT_THAT(direction(method, qp, c),
+                    EigenAlmostEqual(q_newton, 1e-10));
+    }
+}
+
+TEST(StructuredNewton, indefinite) {
+    const length_t n = 15;
+    vec λ            = vec::LinSpaced(n, -4, 6);
+    mat H            = random_symmetric(λ, 2);
+    vec c            = vec::LinSpaced(n, -1, 2);
+    const auto inf   = alpaqa::inf<config_t>;
+    QuadraticProblem qp{H, c, vec::Constant(n, -inf), vec::Constant(n, +inf)};
+    for (auto method : methods) {
+        SCOPED_TRACE(enum_name(method));
+        vec q = direction(method, qp, c);
+        ASSERT_TRUE(q.allFinite());
+        // Descent direction
+        EXPECT_LT(q.dot(c), 0);
+        // The direction solves a positive definite system (H + E) q = -c,
+        // for the shifted Cholesky method, E is a multiple of the identity
+        if (method == Reg::ShiftedCholesky) {
+            vec r    = H * q + c;
+            real_t τ = -r.dot(q) / q.squaredNorm();
+            EXPECT_THAT(r, EigenAlmostEqual(vec(-τ * q), 1e-8));
+            EXPECT_GE(τ, -λ.minCoeff());
+        }
+    }
+}
+
+TEST(StructuredNewton, activeSet) {
+    const length_t n = 10;
+    vec λ            = vec::LinSpaced(n, -3, 5);
+    mat H            = random_symmetric(λ, 3);
+    vec c            = vec::LinSpaced(n, -2, 2);
+    const auto inf   = alpaqa::inf<config_t>;
+    // Bounds are active for the variables with the largest gradients
+    vec lb = vec::Constant(n, -inf), ub = vec::Constant(n, +inf);
+    ub(0) = 0.5, lb(n - 1) = -0.5;
+    QuadraticProblem qp{H, c, lb, ub};
+    indexvec J = indexvec::LinSpaced(n - 2, 1, n - 2);
+    mat HJ     = H(J, J);
+    vec cJ     = c(J);
+    for (auto method : methods) {
+        SCOPED_TRACE(enum_name(method));
+        vec q = direction(method, qp, c);
+        // Active variables follow the projected gradient step
+        EXPECT_DOUBLE_EQ(q(0), 0.5);
+        EXPECT_DOUBLE_EQ(q(n - 1), -0.5);
+        // Inactive variables follow a descent direction of the reduced problem
+        EXPECT_LT(q(J).dot(cJ), 0);
+    }
+    // Same result as the eigenvalue clipping of the reduced Hessian
+    Eigen::SelfAdjointEigenSolver<mat> eig{HJ};
+    real_t ε = Direction::AcceleratorParams{}.min_eig *
+               (1 + std::abs(eig.eigenvalues().maxCoeff()));
+    vec qJ   = -eig.eigenvectors() *
+             (eig.eigenvalues().cwiseMax(ε).asDiagonal().inverse() *
+              (eig.eigenvectors().transpose() * cJ));
+    EXPECT_THAT(vec(direction(Reg::EigenvalueClipping, qp, c)(J)),
+                EigenAlmostEqual(qJ, 1e-10));
+}
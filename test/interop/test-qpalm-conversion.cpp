@@ -114,4 +114,110 @@ TEST(qpalm, convertConstraints) {
     for (auto r = 0; index_t i : bound_indices)
         I(r++, i) = 1;
     EXPECT_THAT(A.toDense().topRows(num_bound_constr), EigenEqual(I));
-}
\ No newline at end of file
+}
+
+#ifdef ALPAQA_WITH_QPALM
+
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <alpaqa/qpalm/qpalm-adapter.hpp>
+
+namespace {
+
+/// minimize  ½ xᵀQx + qᵀx
+///     s.t.  l ≤ Ax ≤ u
+///           -1 ≤ x₀ ≤ 1, x₁ free, x₂ ≤ 2
+struct QP : alpaqa::BoxConstrProblem<config_t> {
+    mat Q{{4, 1, 0}, {1, 2, 0}, {0, 0, 1}}, A{{1, 1, 0}, {0, 1, -1}};
+    vec q{{1, -1, 2}};
+
+    QP() : BoxConstrProblem{3, 2} {
+        C.lowerbound(0) = -1;
+        C.upperbound(0) = +1;
+        C.upperbound(2) = +2;
+        D.lowerbound << -alpaqa::inf<config_t>, -1;
+        D.upperbound << 1, 1;
+    }
+    real_t eval_f(crvec x) const { return x.dot(Q * x) / 2 + q.dot(x); }
+    void eval_grad_f(crvec x, rvec g) const { g = Q * x + q; }
+    void eval_g(crvec x, rvec g) const { g = A * x; }
+    void eval_grad_g_prod(crvec, crvec y, rvec g) const {
+        g = A.transpose() * y;
+    }
+    void eval_jac_g(crvec, rvec J) const { J = A.reshaped(); }
+    void eval_hess_L(crvec, crvec, real_t scale, rvec H) const {
+        H = scale * Q.reshaped();
+    }
+};
+
+mat to_dense(const ladel_sparse_matrix &M) {
+    mat D = mat::Zero(M.nrow, M.ncol);
+    for (index_t c = 0; c < static_cast<index_t>(M.ncol); ++c)
+        for (auto k = M.p[c]; k < M.p[c + 1]; ++k)
+            D(static_cast<index_t>(M.i[k]), c) = M.x[k];
+    return D;
+}
+
+void expect_same_data(const alpaqa::OwningQPALMData &a,
+                      const alpaqa::OwningQPALMData &b) {
+    ASSERT_EQ(a.n, b.n);
+    ASSERT_EQ(a.m, b.m);
+    auto n = static_cast<index_t>(a.n), m = static_cast<index_t>(a.m);
+    EXPECT_THAT(to_dense(*a.Q), EigenEqual(to_dense(*b.Q)));
+    EXPECT_THAT(to_dense(*a.A), EigenEqual(to_dense(*b.A)));
+    EXPECT_THAT(cmvec(a.q, n), EigenEqual(cmvec(b.q, n)));
+    EXPECT_THAT(cmvec(a.bmin, m), EigenEqual(cmvec(b.bmin, m)));
+    EXPECT_THAT(cmvec(a.bmax, m), EigenEqual(cmvec(b.bmax, m)));
+    EXPECT_EQ(a.c, b.c);
+}
+
+} // namespace
+
+/**
+ * @test
+ * Updating the values of a converted problem gives the same QP as converting
+ * the modified problem from scratch, and the warm-started sequential solver
+ * finds the same solution as a new solver.
+ */
+TEST(qpalm, updateProblem) {
+    QP qp;
+    alpaqa::TypeErasedProblem<config_t> problem{&qp};
+    alpaqa::QPALMProblemUpdater updater{problem};
+    expect_same_data(updater.get_data(), alpaqa::build_qpalm_problem(problem));
+
+    qpalm::Settings settings;
+    settings.eps_abs = 1e-10;
+    settings.eps_rel = 1e-10;
+    alpaqa::QPALMSequentialSolver sequential{settings};
+    sequential.solve(problem);
+    EXPECT_FALSE(sequential.is_updated());
+
+    // Change all numerical values, but keep the structure
+    qp.Q(0, 0) = 3;
+    qp.Q(0, 1) = qp.Q(1, 0) = -0.5;
+    qp.A(1, 2)              = -2;
+    qp.q << -1, 0.5, 1;
+    qp.C.lowerbound(0) = -0.5;
+    qp.C.upperbound(2) = 0.25;
+    qp.D.upperbound(0) = 0.5;
+    updater.update(problem);
+    expect_same_data(updater.get_data(), alpaqa::build_qpalm_problem(problem));
+
+    sequential.solve(problem);
+    EXPECT_TRUE(sequential.is_updated());
+    expect_same_data(sequential.get_data(),
+                     alpaqa::build_qpalm_problem(problem));
+    alpaqa::QPALMSequentialSolver fresh{settings};
+    fresh.solve(problem);
+    EXPECT_FALSE(fresh.is_updated());
+    EXPECT_EQ(sequential.get_info().status_val, fresh.get_info().status_val);
+    EXPECT_THAT(vec(sequential.get_solution().x),
+                EigenAlmostEqual(vec(fresh.get_solution().x), 1e-8));
+    EXPECT_THAT(vec(sequential.get_solution().y),
+                EigenAlmostEqual(vec(fresh.get_solution().y), 1e-8));
+
+    // The set of bounded variables cannot change
+    qp.C.upperbound(1) = 1;
+    EXPECT_THROW(updater.update(problem), std::invalid_argument);
+}
+
+#endif
@@ -420,3 +420,51 @@ struct NewtonTRFiniteDiff {
 using PANTRDirectionTypes =
     ::testing::Types<NewtonTRHessVec, NewtonTRFiniteDiff>;
 INSTANTIATE_TYPED_TEST_SUITE_P(ALM, PANTR, PANTRDirectionTypes);
+
+TEST(ALM, andersonMultipliers) {
+    USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+    using namespace alpaqa;
+
+    auto [op, nx, nu] = build_ms_problem();
+
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+
+    // The penalty is bounded, so the plain multiplier updates converge slowly
+    ALMSolver::Params almparam;
+    almparam.tolerance             = 1e-8;
+    almparam.dual_tolerance        = 1e-6;
+    almparam.penalty_update_factor = 5;
+    almparam.initial_penalty       = 1;
+    almparam.initial_tolerance     = 1e-8;
+    almparam.max_penalty           = 2;
+    almparam.max_iter              = 500;
+
+    PANOCSolver::Params panocparam;
+    panocparam.max_iter = 1000;
+
+    auto solve = [&](length_t memory) {
+        almparam.anderson_memory = memory;
+        ALMSolver solver{almparam, {panocparam, {}}};
+        vec x = vec::Constant(op.get_n(), 5), y = vec::Ones(op.get_m());
+        auto stats = solver(op, x, y);
+        std::cout << "Anderson memory " << memory
+                  << ": Inner: " << stats.inner.iterations
+                  << ", Outer: " << stats.outer_iterations
+                  << ", Accelerated: " << stats.accelerated_iterations
+                  << ", Rejected: " << stats.acceleration_rejections
+                  << std::endl;
+        return std::tuple{stats, x, y};
+    };
+    auto [stats, x, y]          = solve(0);
+    auto [stats_aa, x_aa, y_aa] = solve(5);
+
+    EXPECT_EQ(stats.status, SolverStatus::Converged);
+    EXPECT_EQ(stats_aa.status, SolverStatus::Converged);
+    EXPECT_EQ(stats.accelerated_iterations, 0);
+    EXPECT_GT(stats_aa.accelerated_iterations, 0);
+    EXPECT_LT(4 * stats_aa.outer_iterations, stats.outer_iterations);
+    EXPECT_THAT(x_aa, EigenAlmostEqual(x, 1e-5));
+    EXPECT_THAT(y_aa, EigenAlmostEqual(y, 1e-4));
+}
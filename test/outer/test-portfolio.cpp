@@ -0,0 +1,206 @@
+#include <alpaqa/outer/portfolio.hpp>
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+#include <alpaqa/zerofpr-alm.hpp>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+// minimize ½‖x - (1, 2)‖²
+//     s.t. x₀ + x₁ ≤ 1
+//          -10 ≤ x ≤ 10
+alpaqa::FunctionalProblem<config_t> make_problem() {
+    alpaqa::Box<config_t> C{2}, D{1};
+    C.lowerbound.setConstant(-10);
+    C.upperbound.setConstant(+10);
+    D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+    D.upperbound.setConstant(1);
+    alpaqa::FunctionalProblem<config_t> op{C, D};
+    op.f      = [](crvec x) { return (x - vec{{1, 2}}).squaredNorm() / 2; };
+    op.grad_f = [](crvec x, rvec g) { g = x - vec{{1, 2}}; };
+    op.g      = [](crvec x, rvec g) { g(0) = x.sum(); };
+    op.grad_g_prod = [](crvec, crvec y, rvec g) { g.setConstant(y(0)); };
+    return op;
+}
+
+using PANOCSolver   = alpaqa::PANOCSolver<alpaqa::LBFGSDirection<config_t>>;
+using ZeroFPRSolver = alpaqa::ZeroFPRSolver<alpaqa::LBFGSDirection<config_t>>;
+
+/// Solver that never converges, because its tolerance is zero.
+auto make_slow_solver() {
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.tolerance      = 0;
+    almparam.dual_tolerance = 0;
+    almparam.max_iter       = std::numeric_limits<unsigned>::max();
+    almparam.max_time       = std::chrono::minutes(1);
+    return alpaqa::ALMSolver<ZeroFPRSolver>{almparam, {{}, {}}};
+}
+
+auto make_fast_solver() {
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.tolerance      = 1e-10;
+    almparam.dual_tolerance = 1e-10;
+    return alpaqa::ALMSolver<PANOCSolver>{almparam, {{}, {}}};
+}
+
+} // namespace
+
+TEST(PortfolioSolver, cancelLosers) {
+    for (bool clone : {false, true}) {
+        SCOPED_TRACE(clone);
+        alpaqa::PortfolioSolver<config_t> solver{{.clone_problem = clone}};
+        solver.add("slow", make_slow_solver());
+        solver.add("fast", make_fast_solver());
+        ASSERT_EQ(solver.size(), 2);
+        EXPECT_EQ(solver.get_entry_name(0), "slow");
+
+        auto op = make_problem();
+        alpaqa::TypeErasedProblem<config_t> p{op};
+        vec x = vec::Zero(2), y = vec::Zero(1), Σ(1);
+        auto stats = solver(p, x, y, Σ);
+        EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+        EXPECT_EQ(stats.winner, 1);
+        EXPECT_EQ(stats.winner_name, "fast");
+        ASSERT_EQ(stats.entries.size(), 2);
+        EXPECT_EQ(stats.entries[0].status, alpaqa::SolverStatus::Interrupted);
+        EXPECT_LT(stats.entries[0].elapsed_time, std::chrono::seconds(30));
+        EXPECT_LE(stats.time_to_solution, stats.elapsed_time);
+        EXPECT_THAT(x, EigenAlmostEqual(vec{{0, 1}}, 1e-8));
+        EXPECT_THAT(y, EigenAlmostEqual(vec{{1}}, 1e-8));
+        EXPECT_GT(Σ(0), 0);
+    }
+}
+
+TEST(PortfolioSolver, noneConverged) {
+    alpaqa::PortfolioSolver<config_t> solver;
+    alpaqa::ALMParams<config_t> params;
+    params.max_iter       = 3;
+    params.dual_tolerance = 1e-10;
+    params.tolerance      = 1e-10;
+    auto accurate_params  = params;
+    params.tolerance      = 1e-1;
+    solver.add("inaccurate",
+               alpaqa::ALMSolver<ZeroFPRSolver>{params, {{}, {}}});
+    solver.add("accurate",
+               alpaqa::ALMSolver<ZeroFPRSolver>{accurate_params, {{}, {}}});
+    auto op = make_problem();
+    vec x = vec::Zero(2), y = vec::Zero(1);
+    auto stats = solver(op, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::MaxIter);
+    EXPECT_EQ(stats.winner, 1);
+    for (const auto &e : stats.entries)
+        EXPECT_EQ(e.status, alpaqa::SolverStatus::MaxIter);
+}
+
+TEST(PortfolioSolver, separateProblems) {
+    alpaqa::PortfolioSolver<config_t> solver;
+    solver.add(make_fast_solver());
+    EXPECT_EQ(solver.get_name(), "PortfolioSolver<" +
+                                     make_fast_solver().get_name() + ">");
+    auto op = make_problem();
+    using Problem = alpaqa::TypeErasedProblem<config_t>;
+    std::vector<Problem> problems(2, Problem{op});
+    vec x = vec::Zero(2), y = vec::Zero(1);
+    EXPECT_THROW(solver(std::span<const Problem>{problems}, x, y),
+                 std::invalid_argument);
+    problems.pop_back();
+    auto stats = solver(std::span<const Problem>{problems}, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_EQ(stats.winner, 0);
+}
+
+TEST(PortfolioSolver, stop) {
+    alpaqa::PortfolioSolver<config_t> solver;
+    solver.add(make_slow_solver());
+    solver.add(make_slow_solver());
+    solver.stop();
+    auto op = make_problem();
+    vec x = vec::Zero(2), y = vec::Zero(1);
+    auto stats = solver(op, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Interrupted);
+    for (const auto &e : stats.entries)
+        EXPECT_EQ(e.status, alpaqa::SolverStatus::Interrupted);
+}
+
+TEST(PortfolioSolver, warmStartPenalty) {
+    // A single ALM iteration returns the initial penalty factors
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.max_iter = 1;
+    alpaqa::PortfolioSolver<config_t> solver;
+    solver.add(alpaqa::ALMSolver<PANOCSolver>{almparam, {{}, {}}});
+    auto op = make_problem();
+    vec x = vec::Zero(2), y = vec::Zero(1), Σ{{1234}};
+    auto stats = solver(op, x, y, Σ);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::MaxIter);
+    EXPECT_EQ(Σ(0), 1234);
+}
+
+TEST(PortfolioSolver, parallelEvaluation) {
+    // Count the number of threads evaluating the gradient at the same time
+    struct Concurrency {
+        std::atomic<int> active = 0, max_active = 0;
+    };
+    auto make_counting_problem = [](std::shared_ptr<Concurrency> c) {
+        auto op   = make_problem();
+        op.grad_f = [c](crvec x, rvec g) {
+            int a = ++c->active;
+            for (int m = c->max_active; a > m;)
+                c->max_active.compare_exchange_weak(m, a);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            g = x - vec{{1, 2}};
+            --c->active;
+        };
+        return op;
+    };
+    using Problem = alpaqa::TypeErasedProblem<config_t>;
+    for (bool clone : {false, true}) {
+        SCOPED_TRACE(clone);
+        alpaqa::PortfolioSolver<config_t> solver{{.clone_problem = clone}};
+        solver.add(make_fast_solver());
+        solver.add(make_fast_solver());
+        auto c  = std::make_shared<Concurrency>();
+        auto op = make_counting_problem(c);
+        vec x = vec::Zero(2), y = vec::Zero(1);
+        // Concrete problem type
+        auto stats = solver(op, x, y);
+        EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+        EXPECT_EQ(c->max_active > 1, clone);
+        // Type-erased problem that owns its problem
+        c->max_active = 0;
+        x.setZero(), y.setZero();
+        stats = solver(Problem{op}, x, y);
+        EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+        EXPECT_EQ(c->max_active > 1, clone);
+        // Type-erased problem that refers to the problem cannot be copied
+        c->max_active = 0;
+        x.setZero(), y.setZero();
+        stats = solver(Problem{&op}, x, y);
+        EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+        EXPECT_EQ(c->max_active, 1);
+    }
+}
+
+TEST(PortfolioSolver, problemFactory) {
+    alpaqa::PortfolioSolver<config_t> solver;
+    solver.add(make_fast_solver());
+    solver.add(make_fast_solver());
+    using Problem = alpaqa::TypeErasedProblem<config_t>;
+    std::vector<index_t> indices;
+    auto make = [&](index_t i) {
+        indices.push_back(i);
+        return Problem{make_problem()};
+    };
+    vec x = vec::Zero(2), y = vec::Zero(1);
+    auto stats = solver(make, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_EQ(indices, (std::vector<index_t>{0, 1}));
+    EXPECT_THAT(x, EigenAlmostEqual(vec{{0, 1}}, 1e-8));
+}
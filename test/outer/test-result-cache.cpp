@@ -0,0 +1,231 @@
+#include <alpaqa/outer/result-cache.hpp>
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+auto make_result(real_t v) {
+    alpaqa::CachedResult<config_t> r;
+    r.solver           = "test";
+    r.status           = "Converged";
+    r.success          = true;
+    r.ε                = 1e-8;
+    r.δ                = 1e-9;
+    r.outer_iterations = 3;
+    r.inner_iterations = 42;
+    r.elapsed_time     = std::chrono::milliseconds(7);
+    r.x                = vec::Constant(3, v);
+    r.y                = vec::Constant(2, -v);
+    r.Σ                = vec::Constant(2, 10);
+    return r;
+}
+
+} // namespace
+
+TEST(ResultCache, key) {
+    alpaqa::ResultCacheKey k1, k2;
+    EXPECT_EQ(k1.str(), k2.str());
+    EXPECT_EQ(k1.str().size(), 16);
+    k1.add(std::string_view{"ab"}).add(std::string_view{"c"});
+    k2.add(std::string_view{"a"}).add(std::string_view{"bc"});
+    EXPECT_NE(k1.str(), k2.str());
+    alpaqa::ResultCacheKey k3, k4;
+    k3.add(vec::Constant(2, 0.));
+    k4.add(vec::Constant(2, -0.));
+    EXPECT_EQ(k3.str(), k4.str());
+}
+
+TEST(ResultCache, memoryLRU) {
+    alpaqa::ResultCache<config_t> cache{{.max_memory_entries = 2}};
+    cache.store("a", make_result(1));
+    cache.store("b", make_result(2));
+    ASSERT_TRUE(cache.lookup("a")); // a is now most recently used
+    cache.store("c", make_result(3));
+    EXPECT_FALSE(cache.lookup("b"));
+    auto a = cache.lookup("a");
+    ASSERT_TRUE(a);
+    EXPECT_THAT(a->x, EigenEqual(vec::Constant(3, 1)));
+    EXPECT_TRUE(cache.lookup("c"));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(stats.memory_hits, 3);
+    EXPECT_EQ(stats.disk_hits, 0);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.stores, 3);
+    EXPECT_EQ(stats.evictions, 1);
+}
+
+TEST(ResultCache, disk) {
+    namespace fs = std::filesystem;
+    auto dir     = fs::temp_directory_path() / "alpaqa-test-result-cache";
+    fs::remove_all(dir);
+    {
+        alpaqa::ResultCache<config_t> cache{{.directory = dir.string()}};
+        auto r = make_result(1.25);
+        r.h    = alpaqa::inf<config_t>;
+        cache.store("a", r);
+    }
+    alpaqa::ResultCache<config_t> cache{{.directory = dir.string()}};
+    auto r = cache.lookup("a");
+    ASSERT_TRUE(r);
+    auto expected = make_result(1.25);
+    EXPECT_EQ(r->solver, expected.solver);
+    EXPECT_EQ(r->status, expected.status);
+    EXPECT_EQ(r->success, expected.success);
+    EXPECT_EQ(r->ε, expected.ε);
+    EXPECT_EQ(r->δ, expected.δ);
+    EXPECT_TRUE(std::isnan(r->norm_penalty));
+    EXPECT_EQ(r->h, alpaqa::inf<config_t>);
+    EXPECT_EQ(r->outer_iterations, expected.outer_iterations);
+    EXPECT_EQ(r->inner_iterations, expected.inner_iterations);
+    EXPECT_EQ(r->elapsed_time, expected.elapsed_time);
+    EXPECT_THAT(r->x, EigenEqual(expected.x));
+    EXPECT_THAT(r->y, EigenEqual(expected.y));
+    EXPECT_EQ(r->multipliers_bounds.size(), 0);
+    EXPECT_THAT(r->Σ, EigenEqual(expected.Σ));
+    EXPECT_TRUE(cache.lookup("a"));
+    EXPECT_FALSE(cache.lookup("b"));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(stats.disk_hits, 1);
+    EXPECT_EQ(stats.memory_hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    fs::remove_all(dir);
+}
+
+TEST(ResultCache, diskLimit) {
+    namespace fs = std::filesystem;
+    auto dir     = fs::temp_directory_path() / "alpaqa-test-result-cache-lim";
+    fs::remove_all(dir);
+    alpaqa::ResultCache<config_t> cache{{
+        .max_memory_entries = 0,
+        .directory          = dir.string(),
+        .max_disk_size      = 1,
+    }};
+    cache.store("a", make_result(1));
+    EXPECT_FALSE(cache.lookup("a"));
+    EXPECT_EQ(cache.get_stats().evictions, 1);
+    fs::remove_all(dir);
+}
+
+TEST(ResultCache, solveCached) {
+    alpaqa::Box<config_t> C{2}, D{1};
+    C.lowerbound.setConstant(-10);
+    C.upperbound.setConstant(+10);
+    D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+    D.upperbound.setConstant(1);
+
+    // minimize ½‖x - 1‖² s.t. x₀ + x₁ ≤ 1
+    alpaqa::FunctionalProblem<config_t> op{C, D};
+    op.f      = [](crvec x) { return (x.array() - 1).square().sum() / 2; };
+    op.grad_f = [](crvec x, rvec g) { g = x.array() - 1; };
+    op.g      = [](crvec x, rvec g) { g(0) = x.sum(); };
+    op.grad_g_prod = [](crvec, crvec y, rvec g) { g.setConstant(y(0)); };
+
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-8;
+    almparam.dual_tolerance = 1e-8;
+    ALMSolver solver{almparam, PANOCSolver{{}, {}}};
+    alpaqa::ResultCache<config_t> cache;
+    alpaqa::TypeErasedProblem<config_t> problem{&op};
+
+    vec x1 = vec::Zero(2), y1 = vec::Zero(1);
+    auto s1 = solve_cached(cache, solver, problem, x1, y1, {}, "problem");
+    EXPECT_EQ(s1.status, alpaqa::SolverStatus::Converged);
+    EXPECT_THAT(x1, EigenAlmostEqual(vec::Constant(2, 0.5), 1e-6));
+
+    vec x2 = vec::Zero(2), y2 = vec::Zero(1);
+    auto s2 = solve_cached(cache, solver, problem, x2, y2, {}, "problem");
+    EXPECT_EQ(s2.status, s1.status);
+    EXPECT_EQ(s2.outer_iterations, s1.outer_iterations);
+    EXPECT_EQ(s2.inner.iterations, s1.inner.iterations);
+    EXPECT_EQ(s2.ε, s1.ε);
+    EXPECT_THAT(x2, EigenEqual(x1));
+    EXPECT_THAT(y2, EigenEqual(y1));
+
+    // A different problem identifier should not hit the cache
+    vec x3 = vec::Zero(2), y3 = vec::Zero(1);
+    solve_cached(cache, solver, problem, x3, y3, {}, "other problem");
+    // Neither should a problem with different bounds
+    op.D.upperbound.setConstant(2);
+    vec x4 = vec::Zero(2), y4 = vec::Zero(1);
+    solve_cached(cache, solver, problem, x4, y4, {}, "problem");
+    EXPECT_THAT(x4, EigenAlmostEqual(vec::Constant(2, 1), 1e-6));
+    // Nor should a solver with different parameters
+    op.D.upperbound.setConstant(1);
+    almparam.tolerance = 1e-9;
+    ALMSolver solver5{almparam, PANOCSolver{{}, {}}};
+    vec x5 = vec::Zero(2), y5 = vec::Zero(1);
+    solve_cached(cache, solver5, problem, x5, y5, {}, "problem");
+    // Or with different inner solver parameters
+    PANOCSolver::Params panocparam;
+    panocparam.max_iter = 1234;
+    ALMSolver solver6{almparam, PANOCSolver{panocparam, {}}};
+    vec x6 = vec::Zero(2), y6 = vec::Zero(1);
+    solve_cached(cache, solver6, problem, x6, y6, {}, "problem");
+    auto stats = cache.get_stats();
+    EXPECT_EQ(stats.memory_hits, 1);
+    EXPECT_EQ(stats.misses, 5);
+    EXPECT_EQ(stats.stores, 5);
+}
+
+TEST(ResultCache, solveCachedPenalty) {
+    alpaqa::Box<config_t> C{1}, D{1};
+    D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+    D.upperbound.setConstant(-1);
+
+    // minimize ½x² s.t. x ≤ -1
+    alpaqa::FunctionalProblem<config_t> op{C, D};
+    op.f           = [](crvec x) { return x.squaredNorm() / 2; };
+    op.grad_f      = [](crvec x, rvec g) { g = x; };
+    op.g           = [](crvec x, rvec g) { g = x; };
+    op.grad_g_prod = [](crvec, crvec y, rvec g) { g = y; };
+
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver solver{{}, PANOCSolver{{}, {}}};
+    alpaqa::ResultCache<config_t> cache;
+    alpaqa::TypeErasedProblem<config_t> problem{&op};
+
+    vec x1 = vec::Zero(1), y1 = vec::Zero(1), Σ1 = vec::Zero(1);
+    solve_cached(cache, solver, problem, x1, y1, Σ1);
+    EXPECT_GT(Σ1(0), 0);
+    // The final penalty factors are returned on a cache hit
+    vec x2 = vec::Zero(1), y2 = vec::Zero(1), Σ2 = vec::Zero(1);
+    solve_cached(cache, solver, problem, x2, y2, Σ2);
+    EXPECT_EQ(cache.get_stats().memory_hits, 1);
+    EXPECT_THAT(x2, EigenEqual(x1));
+    EXPECT_THAT(Σ2, EigenEqual(Σ1));
+    // Different initial penalty factors result in a different key
+    vec x3 = vec::Zero(1), y3 = vec::Zero(1), Σ3 = vec::Constant(1, 1e3);
+    solve_cached(cache, solver, problem, x3, y3, Σ3);
+    EXPECT_EQ(cache.get_stats().misses, 2);
+}
+
+TEST(ResultCache, diskError) {
+    namespace fs = std::filesystem;
+    // Use a regular file as the cache directory, so writing always fails
+    auto dir = fs::temp_directory_path() / "alpaqa-test-result-cache-err";
+    fs::remove_all(dir);
+    std::ofstream{dir} << "not a directory";
+    alpaqa::ResultCache<config_t> cache{{.directory = dir.string()}};
+    EXPECT_NO_THROW(cache.store("a", make_result(1)));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(stats.stores, 1);
+    EXPECT_EQ(stats.disk_errors, 1);
+    // The result is still available from memory
+    auto r = cache.lookup("a");
+    ASSERT_TRUE(r);
+    EXPECT_THAT(r->x, EigenEqual(make_result(1).x));
+    EXPECT_EQ(cache.get_stats().memory_hits, 1);
+    fs::remove_all(dir);
+}
@@ -0,0 +1,255 @@
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/box-constr-problem.hpp>
+#include <alpaqa/problem/presolved-problem.hpp>
+
+#include <test-util/eigen-matchers.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+// minimize ½(x₀ - 1)² + ½(x₁ - 1)² + ½(x₃ - 2)²
+//     s.t. x₀ + x₁ + x₂ ≤ 1
+//          x₃ free
+//          2 x₁ - 1 ≤ -0.8      (singleton: x₁ ≤ 0.1)
+//          0 ≤ x₂² ≤ 1          (only depends on fixed variables)
+//          -10 ≤ x ≤ 10, x₂ = 0.5
+struct Problem : alpaqa::BoxConstrProblem<config_t> {
+    using Base = alpaqa::BoxConstrProblem<config_t>;
+    Eigen::VectorX<int> rows{{0, 0, 0, 1, 2, 3}}, cols{{0, 1, 2, 3, 1, 2}};
+
+    Problem() : Base{4, 4} {
+        C.lowerbound.setConstant(-10);
+        C.upperbound.setConstant(+10);
+        C.lowerbound(2) = C.upperbound(2) = 0.5;
+        D.lowerbound << -inf, -inf, -inf, 0;
+        D.upperbound << 1, +inf, -0.8, 1;
+    }
+    real_t eval_f(crvec x) const {
+        return (std::pow(x(0) - 1, 2) + std::pow(x(1) - 1, 2) +
+                std::pow(x(3) - 2, 2)) /
+               2;
+    }
+    void eval_grad_f(crvec x, rvec g) const {
+        g << x(0) - 1, x(1) - 1, 0, x(3) - 2;
+    }
+    void eval_g(crvec x, rvec g) const {
+        g << x(0) + x(1) + x(2), x(3), 2 * x(1) - 1, x(2) * x(2);
+    }
+    void eval_grad_g_prod(crvec x, crvec y, rvec g) const {
+        g << y(0), y(0) + 2 * y(2), y(0) + 2 * x(2) * y(3), y(1);
+    }
+    void eval_jac_g(crvec x, rvec J) const { J << 1, 1, 1, 1, 2, 2 * x(2); }
+    alpaqa::Sparsity<config_t> get_jac_g_sparsity() const {
+        return alpaqa::sparsity::SparseCOO<config_t, int>{
+            .rows        = 4,
+            .cols        = 4,
+            .row_indices = rows,
+            .col_indices = cols,
+        };
+    }
+
+  private:
+    static constexpr real_t inf = alpaqa::inf<config_t>;
+};
+
+/// Same problem, but with the Hessian of the Lagrangian, which is needed to
+/// verify the linearity of the singleton constraints.
+struct ProblemWithHess : Problem {
+    void eval_hess_L(crvec, crvec y, real_t scale, rvec H) const {
+        H.setZero();
+        H(0)  = scale;
+        H(5)  = scale;
+        H(10) = 2 * y(3);
+        H(15) = scale;
+    }
+};
+
+} // namespace
+
+TEST(PresolvedProblem, reductions) {
+    ProblemWithHess op;
+    alpaqa::PresolvedProblem<config_t> pp{
+        alpaqa::TypeErasedProblem<config_t>{&op},
+        vec::Zero(4),
+        {.h_is_box_indicator = true, .singleton_constraints = true}};
+    ASSERT_TRUE(pp.is_reduced());
+    EXPECT_EQ(pp.get_n(), 3);
+    EXPECT_EQ(pp.get_m(), 1);
+    const auto &stats = pp.get_stats();
+    EXPECT_EQ(stats.fixed_variables, 1);
+    EXPECT_EQ(stats.free_constraints, 1);
+    EXPECT_EQ(stats.redundant_constraints, 1);
+    EXPECT_EQ(stats.singleton_constraints, 1);
+    EXPECT_THAT(pp.get_free_variables(), EigenEqual(indexvec{{0, 1, 3}}));
+    EXPECT_THAT(pp.get_kept_constraints(), EigenEqual(indexvec{{0}}));
+    EXPECT_THAT(pp.get_box_C().upperbound,
+                EigenAlmostEqual(vec{{10, 0.1, 10}}, 1e-14));
+    EXPECT_THAT(pp.get_box_D().upperbound, EigenEqual(vec{{1}}));
+
+    alpaqa::TypeErasedProblem<config_t> tpp{&pp};
+    vec x{{0.3, -0.2, 4}}, x_full(4), g(1), grad(3), J(2);
+    pp.expand_variables(x, x_full);
+    EXPECT_THAT(x_full, EigenEqual(vec{{0.3, -0.2, 0.5, 4}}));
+    EXPECT_DOUBLE_EQ(tpp.eval_f(x), op.eval_f(x_full));
+    tpp.eval_g(x, g);
+    EXPECT_THAT(g, EigenAlmostEqual(vec{{0.6}}, 1e-14));
+    tpp.eval_grad_f(x, grad);
+    EXPECT_THAT(grad, EigenAlmostEqual(vec{{-0.7, -1.2, 2}}, 1e-14));
+    auto J_sp = alpaqa::sparsity::get_nnz(tpp.get_jac_g_sparsity());
+    ASSERT_EQ(J_sp, 2);
+    tpp.eval_jac_g(x, J);
+    EXPECT_THAT(J, EigenEqual(vec{{1, 1}}));
+}
+
+TEST(PresolvedProblem, nonlinearSingleton) {
+    ProblemWithHess op;
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::PresolvedProblem<config_t> pp{p,
+                                          vec::Zero(4),
+                                          {
+                                              .fixed_variables       = false,
+                                              .h_is_box_indicator    = true,
+                                              .free_constraints      = false,
+                                              .singleton_constraints = true,
+                                          }};
+    // Without eliminating x₂, the constraint x₂² is a nonlinear singleton,
+    // while x₃ and 2 x₁ - 1 are linear singletons
+    EXPECT_EQ(pp.get_n(), 4);
+    EXPECT_EQ(pp.get_m(), 2);
+    EXPECT_EQ(pp.get_stats().singleton_constraints, 2);
+    EXPECT_THAT(pp.get_kept_constraints(), EigenEqual(indexvec{{0, 3}}));
+}
+
+TEST(PresolvedProblem, singletonWithoutHess) {
+    // Locally linear, but not globally: the constraint x₁ + (x₁)₊² must not
+    // be converted based on evaluations in two points with x₁ ≤ 0
+    struct PiecewiseProblem : Problem {
+        mutable real_t min_x1 = +alpaqa::inf<config_t>;
+        void eval_g(crvec x, rvec g) const {
+            Problem::eval_g(x, g);
+            g(2) += std::pow(std::max(x(1), real_t(0)), 2);
+            min_x1 = std::min(min_x1, x(1));
+        }
+    };
+    PiecewiseProblem op;
+    op.C.lowerbound(1) = -0.5;
+    op.C.upperbound(1) = 0;
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::PresolvedProblem<config_t> pp{
+        p, vec::Zero(4),
+        {.h_is_box_indicator = true, .singleton_constraints = true}};
+    // Without Hessian, linearity cannot be verified
+    EXPECT_EQ(pp.get_stats().singleton_constraints, 0);
+    EXPECT_THAT(pp.get_kept_constraints(), EigenEqual(indexvec{{0, 2}}));
+    // Unless the user guarantees it
+    alpaqa::PresolvedProblem<config_t> pp_lin{
+        p,
+        vec::Zero(4),
+        {.h_is_box_indicator       = true,
+         .singleton_constraints    = true,
+         .assume_linear_singletons = true}};
+    EXPECT_EQ(pp_lin.get_stats().singleton_constraints, 1);
+    EXPECT_THAT(pp_lin.get_kept_constraints(), EigenEqual(indexvec{{0}}));
+    EXPECT_THAT(pp_lin.get_box_C().upperbound,
+                EigenAlmostEqual(vec{{10, 0, 10}}, 1e-14));
+    EXPECT_THAT(pp_lin.get_box_C().lowerbound,
+                EigenAlmostEqual(vec{{-10, -0.5, -10}}, 1e-14));
+    // The constraints are only evaluated inside of C
+    EXPECT_GE(op.min_x1, -0.5);
+}
+
+TEST(PresolvedProblem, solve) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-10;
+    almparam.dual_tolerance = 1e-10;
+    ALMSolver solver{almparam, PANOCSolver{{}, {}}};
+
+    ProblemWithHess op;
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    vec x = vec::Zero(4), y = vec::Zero(4);
+    auto stats = solver(p, x, y);
+    ASSERT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_THAT(x, EigenAlmostEqual(vec{{0.4, 0.1, 0.5, 2}}, 1e-8));
+
+    alpaqa::PresolvedProblem<config_t> pp{
+        p, vec::Zero(4),
+        {.h_is_box_indicator = true, .singleton_constraints = true}};
+    vec x_red = vec::Zero(pp.get_n()), y_red = vec::Zero(pp.get_m());
+    auto red_stats = solver(pp, x_red, y_red);
+    ASSERT_EQ(red_stats.status, alpaqa::SolverStatus::Converged);
+    vec x_full(4), y_full(4);
+    pp.expand_variables(x_red, x_full);
+    pp.expand_multipliers(x_full, y_red, y_full);
+    EXPECT_THAT(x_full, EigenAlmostEqual(x, 1e-8));
+    EXPECT_THAT(y_full, EigenAlmostEqual(vec{{0.6, 0, 0.15, 0}}, 1e-7));
+    EXPECT_THAT(y_full, EigenAlmostEqual(y, 1e-7));
+}
+
+TEST(PresolvedProblem, singletonRequiresBoxIndicator) {
+    ProblemWithHess op;
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    EXPECT_THROW(alpaqa::PresolvedProblem<config_t>(
+                     p, vec::Zero(4), {.singleton_constraints = true}),
+                 std::invalid_argument);
+}
+
+TEST(PresolvedProblem, nonsmoothCost) {
+    // With an ℓ₁ term, h is not the indicator of C, the reduced problem has to
+    // use the original proximal operator
+    struct L1Problem : ProblemWithHess {
+        // Custom proximal operator that still exposes the box C
+        bool provides_get_box_C() const { return true; }
+    };
+    L1Problem op;
+    op.l1_reg            = vec::Constant(1, 0.25);
+    op.penalty_alm_split = 1;
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::PresolvedProblem<config_t> pp{p, vec::Zero(4)};
+    ASSERT_EQ(pp.get_stats().fixed_variables, 1);
+    ASSERT_THAT(pp.get_kept_constraints(), EigenEqual(indexvec{{0, 2}}));
+    alpaqa::TypeErasedProblem<config_t> tpp{&pp};
+
+    // Proximal gradient step
+    vec x{{0.3, -0.2, 4}}, grad{{0.4, -1.2, 2}}, x̂(3), p̂(3);
+    vec x_full(4), grad_full{{0.4, -1.2, 0, 2}}, x̂_full(4), p̂_full(4);
+    pp.expand_variables(x, x_full);
+    real_t γ = 0.5;
+    auto h   = tpp.eval_prox_grad_step(γ, x, grad, x̂, p̂);
+    auto h_full = p.eval_prox_grad_step(γ, x_full, grad_full, x̂_full, p̂_full);
+    EXPECT_DOUBLE_EQ(h, h_full);
+    EXPECT_THAT(x̂, EigenEqual(vec{x̂_full({0, 1, 3})}));
+    EXPECT_THAT(p̂, EigenEqual(vec{p̂_full({0, 1, 3})}));
+    EXPECT_DOUBLE_EQ(x̂_full(2), 0.5);
+    // Inactive indices
+    indexvec J(3);
+    auto nJ = tpp.eval_inactive_indices_res_lna(γ, x, grad, J);
+    ASSERT_EQ(nJ, 2);
+    EXPECT_THAT(J.topRows(nJ), EigenEqual(indexvec{{1, 2}}));
+
+    // The first constraint is handled by the quadratic penalty method
+    vec y{{1, 2}};
+    tpp.eval_proj_multipliers(y, 10);
+    EXPECT_THAT(y, EigenEqual(vec{{0, 2}}));
+
+    // Solution
+    op.penalty_alm_split = 0;
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-10;
+    almparam.dual_tolerance = 1e-10;
+    ALMSolver solver{almparam, PANOCSolver{{}, {}}};
+    vec x_sol = vec::Zero(4), y_sol = vec::Zero(4);
+    auto stats = solver(p, x_sol, y_sol);
+    ASSERT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    vec x_red = vec::Zero(pp.get_n()), y_red = vec::Zero(pp.get_m());
+    auto red_stats = solver(pp, x_red, y_red);
+    ASSERT_EQ(red_stats.status, alpaqa::SolverStatus::Converged);
+    pp.expand_variables(x_red, x_full);
+    EXPECT_THAT(x_full, EigenAlmostEqual(x_sol, 1e-8));
+}
@@ -0,0 +1,172 @@
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/functional-problem.hpp>
+#include <alpaqa/problem/scaled-problem.hpp>
+
+#include <test-util/eigen-matchers.hpp>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+
+// minimize ½(100 x₀ - 1)² + ½(x₁ - 2)²
+//     s.t. 1000 x₀ + 0.01 x₁ ≤ 1
+//          -10 ≤ x ≤ 10
+alpaqa::FunctionalProblem<config_t> make_problem() {
+    alpaqa::Box<config_t> C{2}, D{1};
+    C.lowerbound.setConstant(-10);
+    C.upperbound.setConstant(+10);
+    D.lowerbound.setConstant(-alpaqa::inf<config_t>);
+    D.upperbound.setConstant(1);
+    alpaqa::FunctionalProblem<config_t> op{C, D};
+    op.f = [](crvec x) {
+        return (std::pow(100 * x(0) - 1, 2) + std::pow(x(1) - 2, 2)) / 2;
+    };
+    op.grad_f = [](crvec x, rvec g) {
+        g(0) = 100 * (100 * x(0) - 1);
+        g(1) = x(1) - 2;
+    };
+    op.g           = [](crvec x, rvec g) { g(0) = 1000 * x(0) + 0.01 * x(1); };
+    op.grad_g_prod = [](crvec, crvec y, rvec g) {
+        g(0) = 1000 * y(0);
+        g(1) = 0.01 * y(0);
+    };
+    op.jac_g = [](crvec, rmat J) { J << 1000, 0.01; };
+    return op;
+}
+
+} // namespace
+
+TEST(ScaledProblem, none) {
+    auto op = make_problem();
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::ScaledProblem<config_t> sp{
+        p, vec::Zero(2), {.method = alpaqa::ProblemScaling::None}};
+    EXPECT_EQ(sp.get_objective_scaling(), 1);
+    EXPECT_THAT(sp.get_variable_scaling(), EigenEqual(vec::Ones(2)));
+    EXPECT_THAT(sp.get_constraint_scaling(), EigenEqual(vec::Ones(1)));
+    EXPECT_FALSE(sp.scales_variables());
+}
+
+TEST(ScaledProblem, gradient) {
+    auto op = make_problem();
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::ScaledProblem<config_t> sp{
+        p,
+        vec::Zero(2),
+        {.method = alpaqa::ProblemScaling::Gradient, .max_gradient = 10},
+    };
+    EXPECT_FALSE(sp.scales_variables());
+    EXPECT_DOUBLE_EQ(sp.get_objective_scaling(), 10. / 100.);
+    EXPECT_DOUBLE_EQ(sp.get_constraint_scaling()(0), 10. / 1000.);
+    EXPECT_THAT(sp.get_box_D().upperbound,
+                EigenAlmostEqual(vec::Constant(1, 0.01), 1e-15));
+}
+
+TEST(ScaledProblem, ruizConsistency) {
+    auto op = make_problem();
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::ScaledProblem<config_t> sp{
+        p,
+        vec::Zero(2),
+        {.method = alpaqa::ProblemScaling::Ruiz, .h_is_box_indicator = true},
+    };
+    ASSERT_TRUE(sp.scales_variables());
+    alpaqa::TypeErasedProblem<config_t> tsp{&sp};
+
+    vec x(2), y(1), Σ(1), x̃(2), ỹ(1), Σ̃(1);
+    x << 0.003, -1.5;
+    y << 0.7;
+    Σ << 20;
+    sp.scale_variables(x, x̃);
+    sp.scale_multipliers(y, ỹ);
+
+    auto σ      = sp.get_objective_scaling();
+    crvec d_x   = sp.get_variable_scaling();
+    crvec d_g   = sp.get_constraint_scaling();
+    vec work_n1 = vec::Zero(2), work_n2 = vec::Zero(2), work_m1(1), work_m2(1);
+    Σ̃           = σ * Σ.cwiseQuotient(d_g.cwiseAbs2());
+    vec Σ_check(1);
+    sp.unscale_penalties(Σ̃, Σ_check);
+    EXPECT_THAT(Σ_check, EigenAlmostEqual(Σ, 1e-12));
+
+    // Objective, constraints and augmented Lagrangian
+    EXPECT_NEAR(tsp.eval_f(x̃), σ * p.eval_f(x), 1e-12);
+    vec g(1), g̃(1);
+    p.eval_g(x, g);
+    tsp.eval_g(x̃, g̃);
+    EXPECT_THAT(g̃, EigenAlmostEqual(d_g.cwiseProduct(g), 1e-12));
+    vec ŷ(1), ŷ̃(1), ŷ_check(1);
+    auto ψ = p.eval_ψ(x, y, Σ, ŷ), ψ̃ = tsp.eval_ψ(x̃, ỹ, Σ̃, ŷ̃);
+    EXPECT_NEAR(ψ̃, σ * ψ, 1e-10);
+    sp.unscale_multipliers(ŷ̃, ŷ_check);
+    EXPECT_THAT(ŷ_check, EigenAlmostEqual(ŷ, 1e-10));
+
+    // Gradients
+    vec grad_ψ(2), grad_ψ̃(2);
+    p.eval_grad_ψ(x, y, Σ, grad_ψ, work_n1, work_m1);
+    tsp.eval_grad_ψ(x̃, ỹ, Σ̃, grad_ψ̃, work_n2, work_m2);
+    EXPECT_THAT(grad_ψ̃,
+                EigenAlmostEqual(σ * d_x.cwiseProduct(grad_ψ), 1e-10));
+    vec J(2), J̃(2);
+    p.eval_jac_g(x, J);
+    tsp.eval_jac_g(x̃, J̃);
+    EXPECT_THAT(J̃, EigenAlmostEqual(d_g(0) * J.cwiseProduct(d_x), 1e-10));
+
+    // Boxes
+    vec C_ub = vec::Constant(2, 10).cwiseQuotient(d_x);
+    EXPECT_THAT(tsp.get_box_C().upperbound, EigenAlmostEqual(C_ub, 1e-10));
+    EXPECT_THAT(tsp.get_box_D().upperbound, EigenAlmostEqual(d_g, 1e-15));
+}
+
+TEST(ScaledProblem, ruizGeneralH) {
+    auto op = make_problem();
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    alpaqa::ScaledProblem<config_t> sp{
+        p, vec::Zero(2), {.method = alpaqa::ProblemScaling::Ruiz}};
+    // Without knowing that h is the indicator of C, only the constraints and
+    // the objective are scaled, and the prox of the original problem is used
+    EXPECT_FALSE(sp.scales_variables());
+    EXPECT_THAT(sp.get_variable_scaling(), EigenEqual(vec::Ones(2)));
+    EXPECT_LT(sp.get_constraint_scaling()(0), 1);
+    alpaqa::TypeErasedProblem<config_t> tsp{&sp};
+    vec x(2), grad(2), x̂(2), p_(2), x̂_check(2), p_check(2);
+    x << 9, -9;
+    grad << -100, 100;
+    auto σ = sp.get_objective_scaling();
+    tsp.eval_prox_grad_step(0.5, x, grad, x̂, p_);
+    p.eval_prox_grad_step(0.5 * σ, x, grad / σ, x̂_check, p_check);
+    EXPECT_THAT(x̂, EigenAlmostEqual(x̂_check, 1e-12));
+}
+
+TEST(ScaledProblem, solve) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-10;
+    almparam.dual_tolerance = 1e-10;
+    almparam.max_iter       = 100;
+    PANOCSolver::Params panocparam;
+    panocparam.max_iter = 10'000;
+    ALMSolver solver{almparam, PANOCSolver{panocparam, {}}};
+
+    auto op = make_problem();
+    alpaqa::TypeErasedProblem<config_t> p{&op};
+    vec x = vec::Zero(2), y = vec::Zero(1);
+    auto stats = solver(p, x, y);
+    ASSERT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+
+    for (auto method :
+         {alpaqa::ProblemScaling::Gradient, alpaqa::ProblemScaling::Ruiz}) {
+        SCOPED_TRACE(enum_name(method));
+        alpaqa::ScaledProblem<config_t> sp{
+            p, vec::Zero(2), {.method = method, .h_is_box_indicator = true}};
+        vec x̃ = vec::Zero(2), ỹ = vec::Zero(1), x_s(2), y_s(1);
+        auto scaled_stats = solver(sp, x̃, ỹ);
+        ASSERT_EQ(scaled_stats.status, alpaqa::SolverStatus::Converged);
+        sp.unscale_variables(x̃, x_s);
+        sp.unscale_multipliers(ỹ, y_s);
+        EXPECT_THAT(x_s, EigenAlmostEqual(x, 1e-6));
+        EXPECT_THAT(y_s, EigenAlmostEqual(y, 1e-4 * std::abs(y(0))));
+    }
+}
@@ -0,0 +1,181 @@
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/sparsity-conversions.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#include <alpaqa/problem/type-erased-problem.hpp>
+
+#include <test-util/eigen-matchers.hpp>
+
+#include <random>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+using TEProblem = alpaqa::TypeErasedProblem<config_t>;
+namespace syn   = alpaqa::synthetic;
+
+/// Evaluate a matrix with the given sparsity pattern as a dense matrix.
+template <class F>
+mat to_dense(alpaqa::Sparsity<config_t> sp, F &&eval) {
+    using Dense = alpaqa::sparsity::Dense<config_t>;
+    alpaqa::sparsity::SparsityConverter<alpaqa::Sparsity<config_t>, Dense> cvt{
+        sp};
+    const Dense &d = cvt;
+    mat M(d.rows, d.cols);
+    cvt.convert_values(eval, M.reshaped());
+    return M;
+}
+
+/// Central finite-difference approximation of the Jacobian of @p fun.
+template <class F>
+mat finite_diff(F &&fun, crvec x, length_t rows) {
+    const real_t h = 1e-6;
+    mat J(rows, x.size());
+    vec xh = x, fp(rows), fm(rows);
+    for (index_t i = 0; i < x.size(); ++i) {
+        xh(i) = x(i) + h;
+        fun(xh, fp);
+        xh(i) = x(i) - h;
+        fun(xh, fm);
+        xh(i)    = x(i);
+        J.col(i) = (fp - fm) / (2 * h);
+    }
+    return J;
+}
+
+/// Compare all derivatives and sparse matrices of the problem to finite
+/// differences and to each other.
+void check_derivatives(const TEProblem &p, crvec x0) {
+    const auto n = p.get_n(), m = p.get_m();
+    std::mt19937 rng{12345};
+    std::uniform_real_distribution<real_t> uni{-1, 1};
+    auto rand_vec = [&](length_t size) {
+        return vec{vec::NullaryExpr(size, [&] { return uni(rng); })};
+    };
+    vec x = x0 + real_t(0.1) * rand_vec(n), y = rand_vec(m),
+        Σ = rand_vec(m).cwiseAbs() + vec::Constant(m, 1), v = rand_vec(n);
+    const real_t scale = 0.7;
+    // Gradient of the cost
+    vec grad_f(n), grad_f2(n);
+    p.eval_grad_f(x, grad_f);
+    auto f = [&](crvec x, rvec fx) { fx(0) = p.eval_f(x); };
+    EXPECT_THAT(grad_f, EigenAlmostEqual(
+                            vec{finite_diff(f, x, 1).transpose()}, 1e-6));
+    EXPECT_NEAR(p.eval_f_grad_f(x, grad_f2), p.eval_f(x), 1e-12);
+    EXPECT_THAT(grad_f2, EigenAlmostEqual(grad_f, 1e-12));
+    // Jacobian of the constraints
+    auto g = [&](crvec x, rvec gx) { p.eval_g(x, gx); };
+    mat J  = to_dense(p.get_jac_g_sparsity(),
+                      [&](rvec J_values) { p.eval_jac_g(x, J_values); });
+    EXPECT_THAT(J, EigenAlmostEqual(finite_diff(g, x, m), 1e-5));
+    vec grad_gy(n);
+    p.eval_grad_g_prod(x, y, grad_gy);
+    EXPECT_THAT(grad_gy, EigenAlmostEqual(vec{J.transpose() * y}, 1e-10));
+    // Hessian of the Lagrangian
+    auto grad_L = [&](crvec x, rvec gL) {
+        vec work(n);
+        p.eval_grad_f(x, gL);
+        p.eval_grad_g_prod(x, y, work);
+        gL = scale * gL + work;
+    };
+    mat H_L = to_dense(p.get_hess_L_sparsity(), [&](rvec H_values) {
+        p.eval_hess_L(x, y, scale, H_values);
+    });
+    EXPECT_THAT(H_L, EigenAlmostEqual(finite_diff(grad_L, x, n), 1e-4));
+    vec Hv(n);
+    p.eval_hess_L_prod(x, y, scale, v, Hv);
+    EXPECT_THAT(Hv, EigenAlmostEqual(vec{H_L * v}, 1e-10));
+    // Hessian of the augmented Lagrangian
+    auto grad_ψ = [&](crvec x, rvec gψ) {
+        vec work_n(n), work_m(m);
+        p.eval_grad_ψ(x, y, Σ, gψ, work_n, work_m);
+    };
+    ASSERT_TRUE(p.supports_eval_hess_ψ());
+    mat H_ψ = to_dense(p.get_hess_ψ_sparsity(), [&](rvec H_values) {
+        p.eval_hess_ψ(x, y, Σ, 1, H_values);
+    });
+    EXPECT_THAT(H_ψ, EigenAlmostEqual(finite_diff(grad_ψ, x, n), 1e-4));
+    p.eval_hess_ψ_prod(x, y, Σ, 1, v, Hv);
+    EXPECT_THAT(Hv, EigenAlmostEqual(vec{H_ψ * v}, 1e-10));
+}
+
+/// Solve the problem using PANOC and the augmented Lagrangian method.
+template <class P>
+void check_solve(const P &problem) {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using PANOCSolver = alpaqa::PANOCSolver<Direction>;
+    using ALMSolver   = alpaqa::ALMSolver<PANOCSolver>;
+    ALMSolver::Params almparam;
+    almparam.tolerance      = 1e-6;
+    almparam.dual_tolerance = 1e-6;
+    almparam.max_iter       = 100;
+    PANOCSolver::Params panocparam;
+    panocparam.max_iter = 10000;
+    ALMSolver solver{almparam, {panocparam, {{.memory = 20}}}};
+    vec x = problem.initial_guess, y = vec::Zero(problem.get_m());
+    auto stats = solver(TEProblem{&problem}, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_LE(stats.ε, 1e-6);
+    EXPECT_LE(stats.δ, 1e-6);
+}
+
+} // namespace
+
+TEST(SyntheticProblems, chainDerivatives) {
+    syn::ChainOCP problem{{.N = 5, .nx = 8, .nu = 2}};
+    EXPECT_EQ(problem.get_n(), 5 * (8 + 2));
+    EXPECT_EQ(problem.get_m(), 5 * 8);
+    check_derivatives(TEProblem{&problem}, problem.initial_guess);
+}
+
+TEST(SyntheticProblems, chainSolve) {
+    syn::ChainOCP problem{{.N = 10, .nx = 6, .nu = 1}};
+    check_solve(problem);
+}
+
+TEST(SyntheticProblems, chainInvalid) {
+    EXPECT_THROW(syn::ChainOCP({.nx = 7}), std::invalid_argument);
+    EXPECT_THROW(syn::ChainOCP({.nx = 4, .nu = 3}), std::invalid_argument);
+}
+
+TEST(SyntheticProblems, logregDerivatives) {
+    syn::LogisticRegression problem{
+        {.samples = 40, .features = 15, .density = 0.3}};
+    EXPECT_EQ(problem.get_n(), 15);
+    EXPECT_EQ(problem.get_m(), 0);
+    EXPECT_EQ(problem.l1_reg.size(), 1);
+    check_derivatives(TEProblem{&problem}, problem.initial_guess);
+}
+
+TEST(SyntheticProblems, logregSolve) {
+    syn::LogisticRegression problem{
+        {.samples = 200, .features = 50, .density = 0.1}};
+    check_solve(problem);
+}
+
+TEST(SyntheticProblems, logregSeed) {
+    syn::LogisticRegression a{{.seed = 1}}, b{{.seed = 1}}, c{{.seed = 2}};
+    EXPECT_TRUE(a.A.isApprox(b.A));
+    EXPECT_THAT(a.b, EigenEqual(b.b));
+    EXPECT_FALSE(a.A.isApprox(c.A));
+}
+
+TEST(SyntheticProblems, qpDerivatives) {
+    syn::RandomQP problem{
+        {.n = 20, .m = 12, .density = 0.2, .eq_fraction = 0.5}};
+    check_derivatives(TEProblem{&problem}, problem.initial_guess);
+}
+
+TEST(SyntheticProblems, qpSolve) {
+    syn::RandomQP problem{{.n = 50, .m = 20, .density = 0.1}};
+    check_solve(problem);
+}
+
+TEST(SyntheticProblems, rosenbrockDerivatives) {
+    syn::ChainedRosenbrock problem{{.n = 10}};
+    check_derivatives(TEProblem{&problem}, problem.initial_guess);
+}
+
+TEST(SyntheticProblems, rosenbrockSolve) {
+    syn::ChainedRosenbrock problem{{.n = 20, .a = 10}};
+    check_solve(problem);
+}
@@ -0,0 +1,21 @@
+# Lists the SystemTap SDT notes of the given library using readelf, and checks
+# that all probes of the alpaqa provider are present.
+# Usage: cmake -D READELF=<readelf> -D LIBRARY=<library> -P check-usdt-probes.cmake
+
+execute_process(COMMAND "${READELF}" --notes --wide "${LIBRARY}"
+                OUTPUT_VARIABLE notes
+                RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${READELF} failed on ${LIBRARY} (${result})")
+endif()
+if (NOT notes MATCHES "\\.note\\.stapsdt")
+    message(FATAL_ERROR "${LIBRARY} has no .note.stapsdt section")
+endif()
+foreach (probe IN ITEMS scope_begin scope_end alm_outer_iteration
+                        panoc_iteration zerofpr_iteration pantr_iteration
+                        linesearch_trial trust_region_trial)
+    if (NOT notes MATCHES "Provider: alpaqa[ \t\r\n]+Name: ${probe}[ \t\r\n]")
+        message(FATAL_ERROR "${LIBRARY} does not contain probe alpaqa:${probe}")
+    endif()
+endforeach()
+message(STATUS "Found all USDT probes in ${LIBRARY}")
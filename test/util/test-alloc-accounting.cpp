@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <alpaqa/implementation/outer/alm.tpp>
+#include <alpaqa/inner/fista.hpp>
+#include <alpaqa/newton-tr-pantr-alm.hpp>
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/problem-with-counters.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#include <alpaqa/util/alloc-accounting.hpp>
+#include <alpaqa/zerofpr-alm.hpp>
+
+#include <cstdlib>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+namespace syn = alpaqa::synthetic;
+using alpaqa::AllocPhase;
+
+/// Prevents the compiler from eliding the allocations in the tests.
+void *volatile sink = nullptr;
+
+/// Allocations are only counted if the allocation hook is linked into the test
+/// executable (ALPAQA_WITH_ALLOC_ACCOUNTING). If it is, the hook must be
+/// active, otherwise the tests below would pass without checking anything.
+#ifdef ALPAQA_TEST_ALLOC_HOOK
+#define SKIP_IF_NO_ALLOC_ACCOUNTING()                                          \
+    ASSERT_TRUE(alpaqa::alloc_accounting::is_enabled())                        \
+        << "Allocation hook is linked but not active"
+#else
+#define SKIP_IF_NO_ALLOC_ACCOUNTING()                                          \
+    do {                                                                       \
+        if (!alpaqa::alloc_accounting::is_enabled())                           \
+            GTEST_SKIP() << "Allocation accounting not available";             \
+    } while (0)
+#endif
+
+/// Solve the problem using the given ALM solver and check that no heap
+/// allocations occur in the inner solver iterations and the evaluations.
+template <class Solver, class P>
+void check_allocation_free(Solver solver, const P &problem) {
+    auto counted = alpaqa::problem_with_counters_ref(problem);
+    vec x = problem.initial_guess, y = vec::Zero(problem.get_m());
+    auto stats = solver(counted, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+    EXPECT_GT(stats.inner.iterations, 0u);
+    EXPECT_GT(counted.evaluations->prox_grad_step, 0u);
+    const auto &allocs = stats.allocations;
+    for (auto phase : {AllocPhase::Iteration, AllocPhase::Direction,
+                       AllocPhase::LineSearch, AllocPhase::Evaluation})
+        EXPECT_EQ(allocs[phase].count, 0u) << enum_name(phase);
+    EXPECT_EQ(allocs.in_allocation_free_phases(), alpaqa::AllocCount{});
+    // Workspaces are allocated by the inner solver for each outer iteration
+    EXPECT_GE(allocs[AllocPhase::Setup].count, stats.outer_iterations);
+    EXPECT_GT(allocs[AllocPhase::Setup].bytes, 0u);
+    EXPECT_GT(allocs[AllocPhase::Outer].count, 0u);
+    EXPECT_EQ(allocs.total().count, allocs[AllocPhase::Setup].count +
+                                        allocs[AllocPhase::Outer].count);
+}
+
+alpaqa::ALMParams<config_t> alm_params() {
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.tolerance      = 1e-6;
+    almparam.dual_tolerance = 1e-6;
+    almparam.max_iter       = 100;
+    return almparam;
+}
+
+} // namespace
+
+TEST(AllocAccounting, phases) {
+    SKIP_IF_NO_ALLOC_ACCOUNTING();
+    auto before = alpaqa::alloc_accounting::snapshot();
+    {
+        alpaqa::ScopedAllocPhase phase{AllocPhase::Direction};
+        sink = std::malloc(100);
+        std::free(sink);
+        {
+            alpaqa::ScopedAllocPhase inner_phase{AllocPhase::Evaluation};
+            auto *p = new double[10];
+            sink    = p;
+            delete[] p;
+        }
+        phase.set(AllocPhase::LineSearch);
+        vec v(1000);
+        sink = v.data();
+    }
+    auto diff = alpaqa::alloc_accounting::snapshot() - before;
+    EXPECT_EQ(diff[AllocPhase::Direction].count, 1u);
+    EXPECT_EQ(diff[AllocPhase::Direction].bytes, 100u);
+    EXPECT_EQ(diff[AllocPhase::Evaluation].count, 1u);
+    EXPECT_GE(diff[AllocPhase::Evaluation].bytes, 10 * sizeof(double));
+    EXPECT_EQ(diff[AllocPhase::LineSearch].count, 1u);
+    EXPECT_GE(diff[AllocPhase::LineSearch].bytes, 1000 * sizeof(real_t));
+    EXPECT_EQ(diff[AllocPhase::Setup].count, 0u);
+    // The previous phase is restored at the end of the scope
+    auto current = alpaqa::alloc_accounting::set_phase(AllocPhase::Other);
+    EXPECT_EQ(current, AllocPhase::Other);
+}
+
+TEST(AllocAccounting, panoc) {
+    SKIP_IF_NO_ALLOC_ACCOUNTING();
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using InnerSolver = alpaqa::PANOCSolver<Direction>;
+    InnerSolver::Params panocparam;
+    panocparam.max_iter = 10000;
+    alpaqa::ALMSolver<InnerSolver> solver{alm_params(),
+                                          {panocparam, {{.memory = 20}}}};
+    check_allocation_free(solver, syn::ChainOCP{{.N = 10, .nx = 6, .nu = 1}});
+}
+
+TEST(AllocAccounting, zerofpr) {
+    SKIP_IF_NO_ALLOC_ACCOUNTING();
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using InnerSolver = alpaqa::ZeroFPRSolver<Direction>;
+    InnerSolver::Params zfprparam;
+    zfprparam.max_iter = 10000;
+    alpaqa::ALMSolver<InnerSolver> solver{alm_params(),
+                                          {zfprparam, {{.memory = 20}}}};
+    check_allocation_free(solver, syn::RandomQP{{.n = 50, .m = 20}});
+}
+
+TEST(AllocAccounting, pantr) {
+    SKIP_IF_NO_ALLOC_ACCOUNTING();
+    using Direction   = alpaqa::NewtonTRDirection<config_t>;
+    using InnerSolver = alpaqa::PANTRSolver<Direction>;
+    InnerSolver::Params pantrparam;
+    pantrparam.max_iter = 10000;
+    alpaqa::ALMSolver<InnerSolver> solver{alm_params(), {pantrparam, {}}};
+    check_allocation_free(solver, syn::ChainedRosenbrock{{.n = 20, .a = 10}});
+}
+
+TEST(AllocAccounting, fista) {
+    SKIP_IF_NO_ALLOC_ACCOUNTING();
+    using InnerSolver = alpaqa::FISTASolver<config_t>;
+    InnerSolver::Params fistaparam;
+    fistaparam.max_iter = 100000;
+    alpaqa::ALMSolver<InnerSolver> solver{alm_params(), {fistaparam}};
+    check_allocation_free(solver, syn::RandomQP{{.n = 50, .m = 20}});
+}
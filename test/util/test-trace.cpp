@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <alpaqa/implementation/outer/alm.tpp>
+#include <alpaqa/panoc-alm.hpp>
+#include <alpaqa/problem/problem-with-counters.hpp>
+#include <alpaqa/problem/synthetic-problems.hpp>
+#include <alpaqa/util/trace.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+USING_ALPAQA_CONFIG(alpaqa::DefaultConfig);
+namespace syn     = alpaqa::synthetic;
+namespace tracing = alpaqa::tracing;
+
+#ifndef ALPAQA_WITH_TRACING
+#define SKIP_IF_NO_TRACING() GTEST_SKIP() << "Tracing not available"
+#else
+#define SKIP_IF_NO_TRACING() static_cast<void>(0)
+#endif
+
+/// Solve a small problem using PANOC-ALM, with the evaluations wrapped in a
+/// @ref alpaqa::ProblemWithCounters.
+void solve() {
+    using Direction   = alpaqa::LBFGSDirection<config_t>;
+    using InnerSolver = alpaqa::PANOCSolver<Direction>;
+    alpaqa::ALMParams<config_t> almparam;
+    almparam.tolerance      = 1e-6;
+    almparam.dual_tolerance = 1e-6;
+    alpaqa::ALMSolver<InnerSolver> solver{almparam, {{}, {{.memory = 10}}}};
+    syn::RandomQP problem{{.n = 20, .m = 10}};
+    auto counted = alpaqa::problem_with_counters_ref(problem);
+    vec x = problem.initial_guess, y = vec::Zero(problem.get_m());
+    auto stats = solver(counted, x, y);
+    EXPECT_EQ(stats.status, alpaqa::SolverStatus::Converged);
+}
+
+/// Count the number of occurrences of @p needle in @p s.
+size_t count(const std::string &s, const std::string &needle) {
+    size_t n = 0;
+    for (auto i = s.find(needle); i != s.npos; i = s.find(needle, i + 1))
+        ++n;
+    return n;
+}
+
+} // namespace
+
+TEST(Trace, disabled) {
+    tracing::clear();
+    EXPECT_FALSE(tracing::is_enabled());
+    solve();
+    EXPECT_EQ(tracing::num_events(), 0u);
+}
+
+TEST(Trace, alm) {
+    SKIP_IF_NO_TRACING();
+    tracing::start();
+    EXPECT_TRUE(tracing::is_enabled());
+    solve();
+    tracing::stop();
+    EXPECT_FALSE(tracing::is_enabled());
+    EXPECT_GT(tracing::num_events(), 0u);
+    EXPECT_EQ(tracing::num_dropped_events(), 0u);
+    std::ostringstream os;
+    tracing::write_chrome_trace(os);
+    auto json = os.str();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+    for (auto name : {"\"ALM\"", "\"outer_iteration\"", "\"PANOC\"",
+                      "\"iteration\"", "\"direction\"", "\"direction_update\"",
+                      "\"linesearch_trial\"", "\"eval_prox_grad_step\""})
+        EXPECT_NE(json.find(name), json.npos) << name;
+    EXPECT_EQ(count(json, "\"ph\":\"B\""), count(json, "\"ph\":\"E\""));
+    EXPECT_EQ(count(json, "\"ph\":\"B\"") + count(json, "\"ph\":\"E\""),
+              tracing::num_events());
+    // Events recorded after stopping are ignored
+    solve();
+    EXPECT_EQ(count(json, "\"ph\":\"B\"") * 2, tracing::num_events());
+    tracing::clear();
+    EXPECT_EQ(tracing::num_events(), 0u);
+}
+
+TEST(Trace, dropped) {
+    SKIP_IF_NO_TRACING();
+    tracing::start(64);
+    solve();
+    tracing::stop();
+    EXPECT_LE(tracing::num_events(), 64u);
+    EXPECT_GT(tracing::num_dropped_events(), 0u);
+    std::ostringstream os;
+    tracing::write_chrome_trace(os);
+    auto json = os.str();
+    // Begin and end events remain balanced when the buffer is full
+    EXPECT_EQ(count(json, "\"ph\":\"B\""), count(json, "\"ph\":\"E\""));
+    EXPECT_NE(json.find("\"ALM\""), json.npos);
+    tracing::clear();
+}
+
+TEST(Trace, clearedWhileOpen) {
+    SKIP_IF_NO_TRACING();
+    tracing::start();
+    {
+        alpaqa::ScopedTraceEvent ev{"scope", "test"};
+        tracing::clear();
+        tracing::start();
+    }
+    // The end event of a scope of a previous session does not allocate a
+    // buffer in the new session
+    std::ostringstream os;
+    tracing::write_chrome_trace(os);
+    EXPECT_EQ(os.str().find("thread_name"), std::string::npos);
+    EXPECT_EQ(tracing::num_events(), 0u);
+    tracing::clear();
+}